@@ -0,0 +1,310 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "harness/harness.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <utility>
+
+namespace harness {
+
+namespace {
+
+std::int64_t now()
+{ return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+std::vector<std::unique_ptr<benchmark>>& benchmarks()
+{
+	static std::vector<std::unique_ptr<benchmark>> instance;
+	return instance;
+}
+
+std::vector<std::pair<std::string, std::string>>& context()
+{
+	static std::vector<std::pair<std::string, std::string>> instance;
+	return instance;
+}
+
+struct options
+{
+	std::string filter = ".*";
+	double min_time = 0.2;
+	std::size_t repetitions = 3;
+	std::string json;
+	bool list = false;
+};
+
+struct result
+{
+	std::string name;
+	std::uint64_t iterations;
+	/// @brief The times per iteration in nanoseconds, one per repetition.
+	std::vector<double> times;
+	/// @brief The items per iteration.
+	double items;
+	double median, min, mean, stddev;
+};
+
+std::string escape(const std::string& s)
+{
+	std::string t;
+	for (char c : s)
+	{
+		if (c == '"' || c == '\\') t += '\\';
+		t += c;
+	}
+	return t;
+}
+
+state run_once(const benchmark& b, std::int64_t argument, std::uint64_t iterations)
+{
+	state s(iterations, argument);
+	b.function(s);
+	return s;
+}
+
+/// @brief Determine the number of iterations for which a run takes at least the minimal time.
+std::uint64_t calibrate(const benchmark& b, std::int64_t argument, double min_time)
+{
+	static const std::uint64_t max_iterations = 1000000000;
+	std::uint64_t iterations = 1;
+	while (true)
+	{
+		const double seconds = run_once(b, argument, iterations).get_seconds();
+		if (seconds >= min_time || iterations >= max_iterations)
+		{ return iterations; }
+		// Aim 40% past the minimal time, but grow by at most a factor of 10.
+		const double factor = seconds <= 0.0 ? 10.0 : std::min(10.0, 1.4 * min_time / seconds);
+		iterations = std::min(max_iterations, std::max(iterations + 1, static_cast<std::uint64_t>(iterations * factor)));
+	}
+}
+
+result measure(const benchmark& b, const std::string& name, std::int64_t argument, const options& o)
+{
+	result r;
+	r.name = name;
+	r.iterations = calibrate(b, argument, o.min_time);
+	r.items = 0.0;
+	for (std::size_t i = 0; i < o.repetitions; ++i)
+	{
+		const auto s = run_once(b, argument, r.iterations);
+		r.times.push_back(s.get_seconds() * 1e9 / r.iterations);
+		r.items = static_cast<double>(s.get_items_processed()) / r.iterations;
+	}
+	auto sorted = r.times;
+	std::sort(sorted.begin(), sorted.end());
+	const std::size_t n = sorted.size();
+	r.median = n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+	r.min = sorted.front();
+	r.mean = 0.0;
+	for (auto t : sorted) r.mean += t;
+	r.mean /= n;
+	r.stddev = 0.0;
+	for (auto t : sorted) r.stddev += (t - r.mean) * (t - r.mean);
+	r.stddev = n > 1 ? std::sqrt(r.stddev / (n - 1)) : 0.0;
+	return r;
+}
+
+void write_json(std::ostream& os, const options& o, const std::vector<result>& results)
+{
+	char date[64];
+	const std::time_t t = std::time(nullptr);
+	std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&t));
+	os << "{\n  \"context\": {\n";
+	os << "    \"date\": \"" << date << "\",\n";
+	os << "    \"min_time\": " << o.min_time << ",\n";
+	os << "    \"repetitions\": " << o.repetitions;
+	for (const auto& e : context())
+	{ os << ",\n    \"" << escape(e.first) << "\": \"" << escape(e.second) << "\""; }
+	os << "\n  },\n  \"benchmarks\": [";
+	for (std::size_t i = 0; i < results.size(); ++i)
+	{
+		const auto& r = results[i];
+		os << (i ? ",\n" : "\n") << "    {\n";
+		os << "      \"name\": \"" << escape(r.name) << "\",\n";
+		os << "      \"iterations\": " << r.iterations << ",\n";
+		os << "      \"time_unit\": \"ns\",\n";
+		os << "      \"median\": " << r.median << ",\n";
+		os << "      \"min\": " << r.min << ",\n";
+		os << "      \"mean\": " << r.mean << ",\n";
+		os << "      \"stddev\": " << r.stddev << ",\n";
+		os << "      \"items_per_second\": " << (r.median > 0.0 ? r.items * 1e9 / r.median : 0.0) << "\n";
+		os << "    }";
+	}
+	os << "\n  ]\n}\n";
+}
+
+bool parse(int argc, char **argv, options& o)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string a = argv[i];
+		auto value = [&a](const char *prefix, std::string& v)
+		{
+			const std::size_t n = std::strlen(prefix);
+			if (a.compare(0, n, prefix) != 0) return false;
+			v = a.substr(n);
+			return true;
+		};
+		std::string v;
+		if (value("--filter=", v)) o.filter = v;
+		else if (value("--min-time=", v)) o.min_time = std::stod(v);
+		else if (value("--repetitions=", v)) o.repetitions = std::max<std::size_t>(1, std::stoul(v));
+		else if (value("--json=", v)) o.json = v;
+		else if (a == "--list") o.list = true;
+		else
+		{
+			std::cerr << "unknown option `" << a << "`" << std::endl
+			          << "usage: " << argv[0] << " [--filter=<regex>] [--min-time=<seconds>] [--repetitions=<n>] [--json=<path>|-] [--list]" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+state::state(std::uint64_t iterations, std::int64_t argument) :
+	m_iterations(iterations), m_remaining(iterations), m_argument(argument), m_items(0),
+	m_started(false), m_seconds(0.0), m_start(0)
+{}
+
+bool state::keep_running()
+{
+	if (!m_started)
+	{
+		m_started = true;
+		m_start = now();
+	}
+	if (m_remaining != 0)
+	{
+		--m_remaining;
+		return true;
+	}
+	pause_timing();
+	return false;
+}
+
+void state::pause_timing()
+{ m_seconds += (now() - m_start) * 1e-9; }
+
+void state::resume_timing()
+{ m_start = now(); }
+
+benchmark::benchmark(std::string name, harness::function function) :
+	name(std::move(name)), function(function)
+{}
+
+benchmark *benchmark::argument(std::int64_t argument)
+{
+	arguments.push_back(argument);
+	return this;
+}
+
+benchmark *register_benchmark(const char *name, function function)
+{
+	benchmarks().push_back(std::make_unique<benchmark>(name, function));
+	return benchmarks().back().get();
+}
+
+bool add_context(const char *key, const std::string& value)
+{
+	context().emplace_back(key, value);
+	return true;
+}
+
+int run(int argc, char **argv)
+{
+	options o;
+	if (!parse(argc, argv, o)) return EXIT_FAILURE;
+	std::regex filter;
+	try
+	{ filter = std::regex(o.filter); }
+	catch (const std::regex_error&)
+	{
+		std::cerr << "invalid filter `" << o.filter << "`" << std::endl;
+		return EXIT_FAILURE;
+	}
+#if !defined(__OPTIMIZE__) && !defined(NDEBUG)
+	std::cerr << "warning: the benchmarks were compiled without optimizations" << std::endl;
+#endif
+	std::vector<result> results;
+	// If the JSON is written to the standard output, the table is written to the standard error.
+	std::FILE *table = o.json == "-" ? stderr : stdout;
+	if (!o.list)
+	{
+		std::fprintf(table, "%-48s %14s %14s %14s %16s\n", "benchmark", "iterations", "median [ns]", "min [ns]", "items/s");
+	}
+	for (const auto& b : benchmarks())
+	{
+		const bool has_arguments = !b->arguments.empty();
+		const std::vector<std::int64_t> arguments = has_arguments ? b->arguments : std::vector<std::int64_t>{ 0 };
+		for (auto argument : arguments)
+		{
+			const std::string name = has_arguments ? b->name + "/" + std::to_string(argument) : b->name;
+			if (!std::regex_search(name, filter)) continue;
+			if (o.list)
+			{
+				std::printf("%s\n", name.c_str());
+				continue;
+			}
+			results.push_back(measure(*b, name, argument, o));
+			const auto& r = results.back();
+			std::fprintf(table, "%-48s %14llu %14.2f %14.2f %16.4g\n", r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+			            r.median, r.min, r.median > 0.0 ? r.items * 1e9 / r.median : 0.0);
+			std::fflush(table);
+		}
+	}
+	if (!o.list && !o.json.empty())
+	{
+		if (o.json == "-")
+		{ write_json(std::cout, o, results); }
+		else
+		{
+			std::ofstream os(o.json);
+			write_json(os, o, results);
+			if (!os)
+			{
+				std::cerr << "unable to write `" << o.json << "`" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	return EXIT_SUCCESS;
+}
+
+} // namespace harness
+
+int main(int argc, char **argv)
+{ return harness::run(argc, argv); }
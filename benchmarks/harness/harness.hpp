@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file harness/harness.hpp
+/// @brief A self-contained microbenchmark harness.
+/// @author Michael Heilmann
+/// @detail
+/// A benchmark is a function taking a harness::state. The function performs its setup,
+/// then repeats the measured operation while harness::state::keep_running returns @a true:
+/// @code
+/// static void add(harness::state& state)
+/// {
+///   std::vector<float> x(state.argument()), y(state.argument());
+///   while (state.keep_running())
+///   {
+///     for (size_t i = 0; i < x.size(); ++i) x[i] += y[i];
+///     harness::do_not_optimize(x.data());
+///   }
+///   state.set_items_processed(state.iterations() * x.size());
+/// }
+/// HARNESS_BENCHMARK(add)->argument(16)->argument(4096);
+/// @endcode
+/// The harness determines the number of iterations such that a run takes at least the minimal time,
+/// then performs a number of repetitions of runs and reports the median, the minimum, the mean, and the standard deviation
+/// of the time per iteration.
+/// </br>
+/// The command-line options of the executable are
+/// - <c>--filter=&lt;regex&gt;</c>: run only the benchmarks whose names contain a match of the regular expression,
+/// - <c>--min-time=&lt;seconds&gt;</c>: the minimal time of a run (default 0.2),
+/// - <c>--repetitions=&lt;n&gt;</c>: the number of repetitions (default 3),
+/// - <c>--json=&lt;path&gt;</c>: also write the results as JSON to the file, or to the standard output if the path is <c>-</c>,
+/// - <c>--list</c>: list the names of the benchmarks and exit.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace harness {
+
+/// @brief Prevent the compiler from optimizing away the computation of a value.
+/// @param value the value
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	const volatile char *p = reinterpret_cast<const volatile char *>(&value);
+	(void)*p;
+#endif
+}
+
+/// @brief Prevent the compiler from assuming memory is not read or written.
+inline void clobber_memory()
+{
+#if defined(__GNUC__)
+	asm volatile("" : : : "memory");
+#endif
+}
+
+/// @brief The state of a run of a benchmark.
+struct state
+{
+	/// @brief Construct this state.
+	/// @param iterations the number of iterations
+	/// @param argument the argument
+	state(std::uint64_t iterations, std::int64_t argument);
+
+	/// @brief Get if the benchmark shall perform another iteration.
+	/// @return @a true if the benchmark shall perform another iteration, @a false otherwise
+	/// @remark The first call starts the timer, the call returning @a false stops the timer.
+	bool keep_running();
+
+	/// @brief Pause the timer.
+	void pause_timing();
+
+	/// @brief Resume the timer.
+	void resume_timing();
+
+	/// @brief Get the argument of this run.
+	/// @return the argument
+	std::int64_t argument() const { return m_argument; }
+
+	/// @brief Get the number of iterations of this run.
+	/// @return the number of iterations
+	std::uint64_t iterations() const { return m_iterations; }
+
+	/// @brief Set the number of items processed by all iterations of this run.
+	/// @param items the number of items
+	void set_items_processed(std::uint64_t items) { m_items = items; }
+
+	/// @brief Get the number of items processed by all iterations of this run.
+	/// @return the number of items
+	std::uint64_t get_items_processed() const { return m_items; }
+
+	/// @brief Get the measured time of this run.
+	/// @return the time in seconds
+	double get_seconds() const { return m_seconds; }
+
+private:
+	std::uint64_t m_iterations;
+	std::uint64_t m_remaining;
+	std::int64_t m_argument;
+	std::uint64_t m_items;
+	bool m_started;
+	double m_seconds;
+	std::int64_t m_start;
+
+}; // struct state
+
+/// @brief The type of a benchmark function.
+using function = void (*)(state&);
+
+/// @brief A registered benchmark.
+struct benchmark
+{
+	/// @brief Construct this benchmark.
+	/// @param name the name
+	/// @param function the function
+	benchmark(std::string name, harness::function function);
+
+	/// @brief Add an argument.
+	/// @param argument the argument
+	/// @return this benchmark
+	/// @remark For each argument, the benchmark is run with that argument and reported as <c>name/argument</c>.
+	/// If no argument is added, the benchmark is run with the argument @a 0 and reported as <c>name</c>.
+	benchmark *argument(std::int64_t argument);
+
+	std::string name;
+	harness::function function;
+	std::vector<std::int64_t> arguments;
+
+}; // struct benchmark
+
+/// @brief Register a benchmark.
+/// @param name the name
+/// @param function the function
+/// @return the benchmark
+benchmark *register_benchmark(const char *name, function function);
+
+/// @brief Add an entry to the context reported with the results.
+/// @param key the key
+/// @param value the value
+/// @return @a true
+bool add_context(const char *key, const std::string& value);
+
+/// @brief Run the benchmarks selected by the command-line arguments.
+/// @param argc, argv the command-line arguments
+/// @return @a 0 on success, a non-zero value on failure
+int run(int argc, char **argv);
+
+} // namespace harness
+
+#define HARNESS_CONCATENATE_(x, y) x##y
+#define HARNESS_CONCATENATE(x, y) HARNESS_CONCATENATE_(x, y)
+
+/// @brief Register a benchmark function.
+/// @remark Expands to a declaration initialized with an expression of type harness::benchmark *.
+/// Calls of harness::benchmark::argument may be appended.
+#define HARNESS_BENCHMARK(function) \
+	static ::harness::benchmark *HARNESS_CONCATENATE(harness_benchmark_, __LINE__) = ::harness::register_benchmark(#function, function)
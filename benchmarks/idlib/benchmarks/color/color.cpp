@@ -0,0 +1,327 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace color {
+
+using rgbaf = idlib::color<idlib::RGBAf>;
+using rgbab = idlib::color<idlib::RGBAb>;
+using rgbf = idlib::color<idlib::RGBf>;
+using srgbab = idlib::color<idlib::sRGBAb>;
+
+static std::vector<rgbaf> random_rgbaf(size_t n, std::uint64_t stream)
+{
+	idlib::rng rng(idlib::rng_engine::philox4x32, seed, stream);
+	std::vector<single> c(4 * n);
+	rng.fill(idlib::span<single>(c), idlib::interval<single>(0.0f, 1.0f));
+	std::vector<rgbaf> colors;
+	for (size_t i = 0; i < n; ++i)
+	{ colors.push_back(rgbaf(c[4 * i + 0], c[4 * i + 1], c[4 * i + 2], c[4 * i + 3])); }
+	return colors;
+}
+
+static void rgbaf_lineary_interpolate(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_rgbaf(n, 0), y = random_rgbaf(n, 1);
+	std::vector<rgbaf> z(n, rgbaf::black());
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = idlib::lineary_interpolate(x[i], y[i], 0.25f);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbaf_lineary_interpolate)->argument(1024);
+
+static void rgbaf_add(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_rgbaf(n, 0), y = random_rgbaf(n, 1);
+	std::vector<rgbaf> z(n, rgbaf::black());
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = x[i] + y[i];
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbaf_add)->argument(1024);
+
+static void rgbaf_invert(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_rgbaf(n, 0);
+	std::vector<rgbaf> z(n, rgbaf::black());
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = idlib::invert(x[i]);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbaf_invert)->argument(1024);
+
+static void rgbf_brighten(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbf> x;
+	for (const auto& c : random_rgbaf(n, 0)) x.push_back(rgbf(c.get_r(), c.get_g(), c.get_b()));
+	std::vector<rgbf> z(n, rgbf::black());
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = idlib::brighten(x[i], 0.25f);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbf_brighten)->argument(1024);
+
+static void rgbaf_to_rgbab(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_rgbaf(n, 0);
+	std::vector<rgbab> z(n, rgbab::black());
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = rgbab(x[i]);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbaf_to_rgbab)->argument(1024);
+
+static void rgbab_to_rgbaf(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbab> x;
+	for (const auto& c : random_rgbaf(n, 0)) x.push_back(rgbab(c));
+	std::vector<rgbaf> z(n, rgbaf::black());
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = rgbaf(x[i]);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbab_to_rgbaf)->argument(1024);
+
+static void rgbaf_to_rgbab_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_rgbaf(n, 0);
+	std::vector<rgbab> z(n, rgbab::black());
+	while (state.keep_running())
+	{
+		idlib::convert_colors<idlib::RGBAb, idlib::RGBAf>(x, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbaf_to_rgbab_span)->argument(1024);
+
+static void rgbab_to_rgbaf_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbab> x;
+	for (const auto& c : random_rgbaf(n, 0)) x.push_back(rgbab(c));
+	std::vector<rgbaf> z(n, rgbaf::black());
+	while (state.keep_running())
+	{
+		idlib::convert_colors<idlib::RGBAf, idlib::RGBAb>(x, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbab_to_rgbaf_span)->argument(1024);
+
+static void rgbf_to_rgbab_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbf> x;
+	for (const auto& c : random_rgbaf(n, 0)) x.push_back(rgbf(c.get_r(), c.get_g(), c.get_b()));
+	std::vector<rgbab> z(n, rgbab::black());
+	while (state.keep_running())
+	{
+		idlib::convert_colors<idlib::RGBAb, idlib::RGBf>(x, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbf_to_rgbab_span)->argument(1024);
+
+static void rgbaf_to_srgbab_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_rgbaf(n, 0);
+	std::vector<srgbab> z(n);
+	while (state.keep_running())
+	{
+		idlib::convert_colors<idlib::sRGBAb, idlib::RGBAf>(x, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbaf_to_srgbab_span)->argument(1024);
+
+static void srgbab_to_rgbaf_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<srgbab> x(n);
+	idlib::convert_colors<idlib::sRGBAb, idlib::RGBAf>(random_rgbaf(n, 0), x, 1);
+	std::vector<rgbaf> z(n, rgbaf::black());
+	while (state.keep_running())
+	{
+		idlib::convert_colors<idlib::RGBAf, idlib::sRGBAb>(x, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(srgbab_to_rgbaf_span)->argument(1024);
+
+static void rgbaf_lerp_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_rgbaf(n, 0), y = random_rgbaf(n, 1);
+	std::vector<rgbaf> z(n, rgbaf::black());
+	while (state.keep_running())
+	{
+		idlib::lerp<idlib::RGBAf>(x, y, 0.25f, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbaf_lerp_span)->argument(1024);
+
+static void rgbab_lerp_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbab> x, y;
+	for (const auto& c : random_rgbaf(n, 0)) x.push_back(rgbab(c));
+	for (const auto& c : random_rgbaf(n, 1)) y.push_back(rgbab(c));
+	std::vector<rgbab> z(n, rgbab::black());
+	while (state.keep_running())
+	{
+		idlib::lerp<idlib::RGBAb>(x, y, 0.25f, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbab_lerp_span)->argument(1024);
+
+static void rgbaf_gradient(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbaf> z(n, rgbaf::black());
+	while (state.keep_running())
+	{
+		idlib::gradient<idlib::RGBAf>(rgbaf::red(), rgbaf::blue(), z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbaf_gradient)->argument(1024);
+
+static void rgbab_gradient(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbab> z(n, rgbab::black());
+	while (state.keep_running())
+	{
+		idlib::gradient<idlib::RGBAb>(rgbab::red(), rgbab::blue(), z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbab_gradient)->argument(1024);
+
+static void rgbaf_composite_over_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbaf> x = random_rgbaf(n, 0), y = random_rgbaf(n, 1);
+	idlib::premultiply<idlib::RGBAf>(x, x, 1);
+	idlib::premultiply<idlib::RGBAf>(y, y, 1);
+	std::vector<rgbaf> z(n, rgbaf::black());
+	while (state.keep_running())
+	{
+		idlib::composite<idlib::RGBAf>(idlib::composite_operator::over, x, y, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbaf_composite_over_span)->argument(1024);
+
+static void rgbab_composite_over_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbab> x, y;
+	for (const auto& c : random_rgbaf(n, 0)) x.push_back(rgbab(c));
+	for (const auto& c : random_rgbaf(n, 1)) y.push_back(rgbab(c));
+	idlib::premultiply<idlib::RGBAb>(x, x, 1);
+	idlib::premultiply<idlib::RGBAb>(y, y, 1);
+	std::vector<rgbab> z(n, rgbab::black());
+	while (state.keep_running())
+	{
+		idlib::composite<idlib::RGBAb>(idlib::composite_operator::over, x, y, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbab_composite_over_span)->argument(1024);
+
+static void rgbab_premultiply_span(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<rgbab> x;
+	for (const auto& c : random_rgbaf(n, 0)) x.push_back(rgbab(c));
+	std::vector<rgbab> z(n, rgbab::black());
+	while (state.keep_running())
+	{
+		idlib::premultiply<idlib::RGBAb>(x, z, 1);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(rgbab_premultiply_span)->argument(1024);
+
+} } } // namespace idlib::benchmarks::color
@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks {
+
+static std::string compiler()
+{
+#if defined(__clang__)
+	return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+	return "GCC " __VERSION__;
+#elif defined(_MSC_VER)
+	return "MSVC " + std::to_string(_MSC_VER);
+#else
+	return "unknown";
+#endif
+}
+
+static std::string simd()
+{
+#if defined(IDLIB_WITH_AVX)
+	return "avx";
+#elif defined(IDLIB_WITH_SSE41)
+	return "sse4.1";
+#elif defined(IDLIB_WITH_SSE2)
+	return "sse2";
+#else
+	return "none";
+#endif
+}
+
+static std::string optimization()
+{
+#if defined(__OPTIMIZE__) || defined(NDEBUG)
+	return "on";
+#else
+	return "off";
+#endif
+}
+
+// The context allows for rejecting comparisons of results obtained under different configurations.
+static const bool context = harness::add_context("compiler", compiler()) &&
+                            harness::add_context("simd", simd()) &&
+                            harness::add_context("optimization", optimization());
+
+} } // namespace idlib::benchmarks
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/benchmarks/data.hpp
+/// @brief Deterministic input data of the benchmarks.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "harness/harness.hpp"
+#include "idlib/idlib.hpp"
+
+namespace idlib { namespace benchmarks {
+
+/// @brief The seed of the input data. All runs of a benchmark process the same input data.
+constexpr std::uint64_t seed = 2018;
+
+/// @brief Generate vectors with components in \f$[-1000,+1000]\f$.
+/// @param n the number of vectors
+/// @return the vectors
+template <typename Scalar, size_t Dimensionality>
+std::vector<idlib::vector<Scalar, Dimensionality>> random_vectors(size_t n)
+{
+	idlib::rng rng(seed);
+	const idlib::interval<Scalar> interval(Scalar(-1000), Scalar(+1000));
+	std::vector<idlib::vector<Scalar, Dimensionality>> vectors;
+	for (size_t i = 0; i < n; ++i)
+	{ vectors.push_back(idlib::random<idlib::vector<Scalar, Dimensionality>>(&rng, interval)); }
+	return vectors;
+}
+
+/// @brief Generate points with coordinates in \f$[-1000,+1000]\f$.
+/// @param n the number of points
+/// @return the points
+template <typename Scalar, size_t Dimensionality>
+std::vector<idlib::point<idlib::vector<Scalar, Dimensionality>>> random_points(size_t n)
+{
+	idlib::rng rng(seed);
+	const idlib::interval<Scalar> interval(Scalar(-1000), Scalar(+1000));
+	std::vector<idlib::point<idlib::vector<Scalar, Dimensionality>>> points;
+	for (size_t i = 0; i < n; ++i)
+	{ points.push_back(idlib::random<idlib::point<idlib::vector<Scalar, Dimensionality>>>(&rng, interval)); }
+	return points;
+}
+
+/// @brief Generate scalars in an interval.
+/// @param n the number of scalars
+/// @param interval the interval
+/// @return the scalars
+template <typename Scalar>
+std::vector<Scalar> random_scalars(size_t n, const idlib::interval<Scalar>& interval)
+{
+	idlib::rng rng(seed);
+	std::vector<Scalar> scalars(n);
+	rng.fill(idlib::span<Scalar>(scalars), interval);
+	return scalars;
+}
+
+} } // namespace idlib::benchmarks
@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace geometry {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using axis_aligned_box_3s = idlib::axis_aligned_box<point_3s>;
+using ray_3s = idlib::ray<point_3s>;
+using bvh_3s = idlib::bvh<point_3s, uint32_t>;
+
+/// @brief Generate small boxes scattered in \f$[-1000,+1000]^3\f$.
+static std::vector<axis_aligned_box_3s> small_boxes(size_t n)
+{
+	const auto p = random_points<single, 3>(2 * n);
+	std::vector<axis_aligned_box_3s> boxes;
+	for (size_t i = 0; i < n; ++i)
+	{ boxes.push_back(axis_aligned_box_3s(p[2 * i], p[2 * i] + (p[2 * i + 1] - p[2 * i]) * 0.005f)); }
+	return boxes;
+}
+
+static std::vector<uint32_t> indices(size_t n)
+{
+	std::vector<uint32_t> v(n);
+	for (size_t i = 0; i < n; ++i) v[i] = uint32_t(i);
+	return v;
+}
+
+static void bvh_build(harness::state& state, size_t thread_count)
+{
+	const auto boxes = small_boxes(state.argument());
+	const auto payloads = indices(boxes.size());
+	idlib::bvh_options options;
+	options.thread_count = thread_count;
+	while (state.keep_running())
+	{
+		bvh_3s bvh(boxes, payloads, options);
+		harness::do_not_optimize(bvh.get_nodes().data());
+	}
+	state.set_items_processed(state.iterations() * boxes.size());
+}
+
+static void bvh_3s_build_single_thread(harness::state& state)
+{ bvh_build(state, 1); }
+HARNESS_BENCHMARK(bvh_3s_build_single_thread)->argument(65536)->argument(1048576);
+
+static void bvh_3s_build_all_threads(harness::state& state)
+{ bvh_build(state, 0); }
+HARNESS_BENCHMARK(bvh_3s_build_all_threads)->argument(65536)->argument(1048576);
+
+/// @brief Box queries of boxes of size about 50 against the hierarchy.
+static void bvh_3s_query_box(harness::state& state)
+{
+	const auto boxes = small_boxes(state.argument());
+	const bvh_3s bvh(boxes, indices(boxes.size()));
+	const auto queries = random_points<single, 3>(1024);
+	while (state.keep_running())
+	{
+		size_t count = 0;
+		for (const auto& q : queries)
+		{ bvh.query(axis_aligned_box_3s(q, q + vector_3s(50.0f, 50.0f, 50.0f)), [&count](const axis_aligned_box_3s&, uint32_t) { count++; }); }
+		harness::do_not_optimize(count);
+	}
+	state.set_items_processed(state.iterations() * queries.size());
+}
+HARNESS_BENCHMARK(bvh_3s_query_box)->argument(65536)->argument(1048576);
+
+/// @brief The same queries as bvh_3s_query_box by a linear scan.
+static void axis_aligned_box_3s_scan_box(harness::state& state)
+{
+	const auto boxes = small_boxes(state.argument());
+	const auto queries = random_points<single, 3>(16);
+	while (state.keep_running())
+	{
+		size_t count = 0;
+		for (const auto& q : queries)
+		{
+			const axis_aligned_box_3s b(q, q + vector_3s(50.0f, 50.0f, 50.0f));
+			for (const auto& x : boxes)
+			{ count += idlib::is_intersecting(x, b) ? 1 : 0; }
+		}
+		harness::do_not_optimize(count);
+	}
+	state.set_items_processed(state.iterations() * queries.size());
+}
+HARNESS_BENCHMARK(axis_aligned_box_3s_scan_box)->argument(65536)->argument(1048576);
+
+static void bvh_3s_query_ray(harness::state& state)
+{
+	const auto boxes = small_boxes(state.argument());
+	const bvh_3s bvh(boxes, indices(boxes.size()));
+	const auto origins = random_points<single, 3>(1024);
+	const auto directions = random_vectors<single, 3>(1024);
+	std::vector<ray_3s> rays;
+	for (size_t i = 0; i < origins.size(); ++i)
+	{ rays.push_back(ray_3s(origins[i], directions[i])); }
+	while (state.keep_running())
+	{
+		size_t count = 0;
+		for (const auto& r : rays)
+		{ bvh.query(r, [&count](const axis_aligned_box_3s&, uint32_t, single) { count++; }); }
+		harness::do_not_optimize(count);
+	}
+	state.set_items_processed(state.iterations() * rays.size());
+}
+HARNESS_BENCHMARK(bvh_3s_query_ray)->argument(65536)->argument(1048576);
+
+} } } // namespace idlib::benchmarks::geometry
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace geometry {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+
+static void point_3s_enclose_box(harness::state& state)
+{
+	const auto points = random_points<single, 3>(state.argument());
+	while (state.keep_running())
+	{
+		auto box = idlib::enclose_points<point_3s>(points);
+		harness::do_not_optimize(&box);
+	}
+	state.set_items_processed(state.iterations() * points.size());
+}
+HARNESS_BENCHMARK(point_3s_enclose_box)->argument(4194304);
+
+/// @brief The naive loop which idlib::enclose_points is compared with.
+static void point_3s_enclose_box_naive(harness::state& state)
+{
+	const auto points = random_points<single, 3>(state.argument());
+	while (state.keep_running())
+	{
+		point_3s lower = points[0], upper = points[0];
+		for (const auto& p : points)
+		{
+			for (size_t c = 0; c < 3; ++c)
+			{
+				lower[c] = std::min(lower[c], p[c]);
+				upper[c] = std::max(upper[c], p[c]);
+			}
+		}
+		auto box = idlib::axis_aligned_box<point_3s>(lower, upper);
+		harness::do_not_optimize(&box);
+	}
+	state.set_items_processed(state.iterations() * points.size());
+}
+HARNESS_BENCHMARK(point_3s_enclose_box_naive)->argument(4194304);
+
+static void point_3s_enclose_sphere_ritter(harness::state& state)
+{
+	const auto points = random_points<single, 3>(state.argument());
+	while (state.keep_running())
+	{
+		auto sphere = idlib::enclose_points_ritter<point_3s>(points);
+		harness::do_not_optimize(&sphere);
+	}
+	state.set_items_processed(state.iterations() * points.size());
+}
+HARNESS_BENCHMARK(point_3s_enclose_sphere_ritter)->argument(4194304);
+
+static void point_3s_enclose_sphere_welzl(harness::state& state)
+{
+	const auto points = random_points<single, 3>(state.argument());
+	while (state.keep_running())
+	{
+		auto sphere = idlib::enclose_points_welzl<point_3s>(points);
+		harness::do_not_optimize(&sphere);
+	}
+	state.set_items_processed(state.iterations() * points.size());
+}
+HARNESS_BENCHMARK(point_3s_enclose_sphere_welzl)->argument(4194304);
+
+} } } // namespace idlib::benchmarks::geometry
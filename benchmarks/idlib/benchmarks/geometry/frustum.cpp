@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace geometry {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using frustum_3s = idlib::frustum<point_3s>;
+using matrix_4s = idlib::matrix<single, 4, 4>;
+using batch_3s = idlib::vector_batch<single, 3>;
+
+/// @brief A perspective frustum looking along the negative z-axis which contains about a tenth of the random points.
+static frustum_3s make_frustum()
+{
+	return frustum_3s(matrix_4s(1.0f, 0.0f, 0.0f, 0.0f,
+	                            0.0f, 1.0f, 0.0f, 0.0f,
+	                            0.0f, 0.0f, -1.002f, -2.002f,
+	                            0.0f, 0.0f, -1.0f, 0.0f));
+}
+
+static void cull_spheres(harness::state& state, size_t thread_count)
+{
+	const frustum_3s f = make_frustum();
+	const batch_3s centers(random_vectors<single, 3>(state.argument()));
+	const auto radii = random_scalars<single>(centers.size(), idlib::interval<single>(0.0f, 10.0f));
+	std::vector<uint32_t> visible((centers.size() + 31) / 32);
+	while (state.keep_running())
+	{
+		idlib::cull_spheres(f, centers, radii, visible, thread_count);
+		harness::do_not_optimize(visible.data());
+	}
+	state.set_items_processed(state.iterations() * centers.size());
+}
+
+static void sphere_3s_cull_single_thread(harness::state& state)
+{ cull_spheres(state, 1); }
+HARNESS_BENCHMARK(sphere_3s_cull_single_thread)->argument(65536)->argument(2097152);
+
+static void sphere_3s_cull_all_threads(harness::state& state)
+{ cull_spheres(state, 0); }
+HARNESS_BENCHMARK(sphere_3s_cull_all_threads)->argument(2097152);
+
+static void cull_boxes(harness::state& state, size_t thread_count)
+{
+	const frustum_3s f = make_frustum();
+	const batch_3s min(random_vectors<single, 3>(state.argument()));
+	batch_3s max(min.size());
+	idlib::add(min, batch_3s(std::vector<vector_3s>(min.size(), vector_3s(5.0f, 5.0f, 5.0f))), max);
+	std::vector<uint32_t> visible((min.size() + 31) / 32);
+	while (state.keep_running())
+	{
+		idlib::cull_boxes(f, min, max, visible, thread_count);
+		harness::do_not_optimize(visible.data());
+	}
+	state.set_items_processed(state.iterations() * min.size());
+}
+
+static void box_3s_cull_single_thread(harness::state& state)
+{ cull_boxes(state, 1); }
+HARNESS_BENCHMARK(box_3s_cull_single_thread)->argument(65536);
+
+static void box_3s_cull_all_threads(harness::state& state)
+{ cull_boxes(state, 0); }
+HARNESS_BENCHMARK(box_3s_cull_all_threads)->argument(2097152);
+
+/// @brief The same visibility as sphere_3s_cull_single_thread by idlib::is_intersecting.
+static void sphere_3s_cull_scalar(harness::state& state)
+{
+	const frustum_3s f = make_frustum();
+	const auto centers = random_points<single, 3>(state.argument());
+	const auto radii = random_scalars<single>(centers.size(), idlib::interval<single>(0.0f, 10.0f));
+	std::vector<uint32_t> visible((centers.size() + 31) / 32);
+	while (state.keep_running())
+	{
+		std::fill(visible.begin(), visible.end(), 0);
+		for (size_t i = 0; i < centers.size(); ++i)
+		{
+			if (idlib::is_intersecting(f, sphere_3s(centers[i], radii[i]))) visible[i / 32] |= uint32_t(1) << (i % 32);
+		}
+		harness::do_not_optimize(visible.data());
+	}
+	state.set_items_processed(state.iterations() * centers.size());
+}
+HARNESS_BENCHMARK(sphere_3s_cull_scalar)->argument(65536);
+
+/// @brief The same visibility as box_3s_cull_single_thread by idlib::is_intersecting.
+static void box_3s_cull_scalar(harness::state& state)
+{
+	const frustum_3s f = make_frustum();
+	const auto min = random_points<single, 3>(state.argument());
+	std::vector<uint32_t> visible((min.size() + 31) / 32);
+	while (state.keep_running())
+	{
+		std::fill(visible.begin(), visible.end(), 0);
+		for (size_t i = 0; i < min.size(); ++i)
+		{
+			if (idlib::is_intersecting(f, box_3s(min[i], min[i] + vector_3s(5.0f, 5.0f, 5.0f)))) visible[i / 32] |= uint32_t(1) << (i % 32);
+		}
+		harness::do_not_optimize(visible.data());
+	}
+	state.set_items_processed(state.iterations() * min.size());
+}
+HARNESS_BENCHMARK(box_3s_cull_scalar)->argument(65536);
+
+} } } // namespace idlib::benchmarks::geometry
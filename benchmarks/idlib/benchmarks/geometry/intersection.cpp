@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace geometry {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using axis_aligned_box_3s = idlib::axis_aligned_box<point_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+
+static std::vector<axis_aligned_box_3s> random_boxes(size_t n)
+{
+	const auto p = random_points<single, 3>(2 * n);
+	std::vector<axis_aligned_box_3s> boxes;
+	for (size_t i = 0; i < n; ++i)
+	{ boxes.push_back(axis_aligned_box_3s(p[2 * i], p[2 * i] + (p[2 * i + 1] - p[2 * i]) * 0.125f)); }
+	return boxes;
+}
+
+static std::vector<sphere_3s> random_spheres(size_t n)
+{
+	const auto p = random_points<single, 3>(n);
+	const auto r = random_scalars<single>(n, idlib::interval<single>(1.0f, 250.0f));
+	std::vector<sphere_3s> spheres;
+	for (size_t i = 0; i < n; ++i)
+	{ spheres.push_back(sphere_3s(p[i], r[i])); }
+	return spheres;
+}
+
+/// @brief Test each element of a sequence against each element of another sequence.
+template <typename A, typename B, typename O>
+static void all_pairs(harness::state& state, const std::vector<A>& a, const std::vector<B>& b, O operation)
+{
+	while (state.keep_running())
+	{
+		size_t count = 0;
+		for (const auto& x : a)
+			for (const auto& y : b)
+				count += operation(x, y) ? 1 : 0;
+		harness::do_not_optimize(count);
+	}
+	state.set_items_processed(state.iterations() * a.size() * b.size());
+}
+
+static void axis_aligned_box_3s_is_intersecting_axis_aligned_box_3s(harness::state& state)
+{
+	const auto a = random_boxes(state.argument());
+	all_pairs(state, a, a, [](const axis_aligned_box_3s& x, const axis_aligned_box_3s& y) { return idlib::is_intersecting(x, y); });
+}
+HARNESS_BENCHMARK(axis_aligned_box_3s_is_intersecting_axis_aligned_box_3s)->argument(256);
+
+static void axis_aligned_box_3s_is_intersecting_point_3s(harness::state& state)
+{
+	const auto a = random_boxes(state.argument());
+	const auto b = random_points<single, 3>(state.argument());
+	all_pairs(state, a, b, [](const axis_aligned_box_3s& x, const point_3s& y) { return idlib::is_intersecting(x, y); });
+}
+HARNESS_BENCHMARK(axis_aligned_box_3s_is_intersecting_point_3s)->argument(256);
+
+static void sphere_3s_is_intersecting_sphere_3s(harness::state& state)
+{
+	const auto a = random_spheres(state.argument());
+	all_pairs(state, a, a, [](const sphere_3s& x, const sphere_3s& y) { return idlib::is_intersecting(x, y); });
+}
+HARNESS_BENCHMARK(sphere_3s_is_intersecting_sphere_3s)->argument(256);
+
+static void axis_aligned_box_3s_is_enclosing_point_3s(harness::state& state)
+{
+	const auto a = random_boxes(state.argument());
+	const auto b = random_points<single, 3>(state.argument());
+	all_pairs(state, a, b, [](const axis_aligned_box_3s& x, const point_3s& y) { return idlib::is_enclosing(x, y); });
+}
+HARNESS_BENCHMARK(axis_aligned_box_3s_is_enclosing_point_3s)->argument(256);
+
+static void sphere_3s_is_enclosing_point_3s(harness::state& state)
+{
+	const auto a = random_spheres(state.argument());
+	const auto b = random_points<single, 3>(state.argument());
+	all_pairs(state, a, b, [](const sphere_3s& x, const point_3s& y) { return idlib::is_enclosing(x, y); });
+}
+HARNESS_BENCHMARK(sphere_3s_is_enclosing_point_3s)->argument(256);
+
+} } } // namespace idlib::benchmarks::geometry
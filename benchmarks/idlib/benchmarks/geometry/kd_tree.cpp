@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace geometry {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using kd_tree_3s = idlib::kd_tree<point_3s>;
+
+static void point_3s_kd_tree_build(harness::state& state)
+{
+	const auto points = random_points<single, 3>(state.argument());
+	while (state.keep_running())
+	{
+		kd_tree_3s tree(points);
+		harness::do_not_optimize(&tree);
+	}
+	state.set_items_processed(state.iterations() * points.size());
+}
+HARNESS_BENCHMARK(point_3s_kd_tree_build)->argument(1048576);
+
+/// @brief Batched 8-NN queries of random points.
+static void point_3s_kd_tree_query_nearest(harness::state& state)
+{
+	const kd_tree_3s tree(random_points<single, 3>(state.argument()));
+	const auto queries = random_points<single, 3>(65536);
+	std::vector<idlib::kd_tree_neighbor<single>> result(queries.size() * 8);
+	while (state.keep_running())
+	{
+		tree.query_nearest(queries, 8, result);
+		harness::do_not_optimize(result.data());
+	}
+	state.set_items_processed(state.iterations() * queries.size());
+}
+HARNESS_BENCHMARK(point_3s_kd_tree_query_nearest)->argument(1048576);
+
+/// @brief Batched radius queries of random points finding about 30 points each.
+static void point_3s_kd_tree_query_radius(harness::state& state)
+{
+	const kd_tree_3s tree(random_points<single, 3>(state.argument()));
+	const auto queries = random_points<single, 3>(65536);
+	std::vector<std::vector<idlib::kd_tree_neighbor<single>>> result;
+	while (state.keep_running())
+	{
+		tree.query_radius(queries, 50.0f * 50.0f, result);
+		harness::do_not_optimize(result.data());
+	}
+	state.set_items_processed(state.iterations() * queries.size());
+}
+HARNESS_BENCHMARK(point_3s_kd_tree_query_radius)->argument(1048576);
+
+} } } // namespace idlib::benchmarks::geometry
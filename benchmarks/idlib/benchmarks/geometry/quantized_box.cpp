@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace geometry {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using batch_3s = idlib::vector_batch<single, 3>;
+
+static const box_3s parent(point_3s(-1000.0f, -1000.0f, -1000.0f), point_3s(1005.0f, 1005.0f, 1005.0f));
+
+static std::vector<box_3s> random_boxes(size_t n)
+{
+	std::vector<box_3s> boxes;
+	for (const auto& p : random_points<single, 3>(n))
+	{ boxes.push_back(box_3s(p, p + vector_3s(5.0f, 5.0f, 5.0f))); }
+	return boxes;
+}
+
+template <typename I>
+static void decode(harness::state& state)
+{
+	const idlib::box_quantizer<point_3s, I> quantizer(parent);
+	idlib::quantized_box_batch<point_3s, I> quantized;
+	quantizer.encode(random_boxes(state.argument()), quantized);
+	batch_3s min, max;
+	while (state.keep_running())
+	{
+		quantizer.decode(quantized, min, max);
+		harness::do_not_optimize(min.data(0));
+	}
+	state.set_items_processed(state.iterations() * quantized.size());
+}
+
+static void box_3s_decode_uint16(harness::state& state)
+{ decode<std::uint16_t>(state); }
+HARNESS_BENCHMARK(box_3s_decode_uint16)->argument(4194304);
+
+static void box_3s_decode_uint8(harness::state& state)
+{ decode<std::uint8_t>(state); }
+HARNESS_BENCHMARK(box_3s_decode_uint8)->argument(4194304);
+
+/// @brief Test quantized boxes against a query box.
+template <typename I>
+static void is_intersecting(harness::state& state)
+{
+	const idlib::box_quantizer<point_3s, I> quantizer(parent);
+	idlib::quantized_box_batch<point_3s, I> quantized;
+	quantizer.encode(random_boxes(state.argument()), quantized);
+	idlib::quantized_box<point_3s, I> query;
+	quantizer.encode_intersection(box_3s(point_3s(-500.0f, -500.0f, -500.0f), point_3s(500.0f, 500.0f, 500.0f)), query);
+	std::vector<uint32_t> bits((quantized.size() + 31) / 32);
+	while (state.keep_running())
+	{
+		idlib::is_intersecting(quantized, query, bits);
+		harness::do_not_optimize(bits.data());
+	}
+	state.set_items_processed(state.iterations() * quantized.size());
+}
+
+static void box_3s_is_intersecting_uint16(harness::state& state)
+{ is_intersecting<std::uint16_t>(state); }
+HARNESS_BENCHMARK(box_3s_is_intersecting_uint16)->argument(4194304);
+
+static void box_3s_is_intersecting_uint8(harness::state& state)
+{ is_intersecting<std::uint8_t>(state); }
+HARNESS_BENCHMARK(box_3s_is_intersecting_uint8)->argument(4194304);
+
+/// @brief Test boxes against a query box, the baseline of the quantized tests.
+static void box_3s_is_intersecting(harness::state& state)
+{
+	const auto boxes = random_boxes(state.argument());
+	const box_3s query(point_3s(-500.0f, -500.0f, -500.0f), point_3s(500.0f, 500.0f, 500.0f));
+	std::vector<uint32_t> bits((boxes.size() + 31) / 32);
+	while (state.keep_running())
+	{
+		std::fill(bits.begin(), bits.end(), 0);
+		for (size_t i = 0; i < boxes.size(); ++i)
+		{
+			if (idlib::is_intersecting(boxes[i], query)) bits[i / 32] |= uint32_t(1) << (i % 32);
+		}
+		harness::do_not_optimize(bits.data());
+	}
+	state.set_items_processed(state.iterations() * boxes.size());
+}
+HARNESS_BENCHMARK(box_3s_is_intersecting)->argument(4194304);
+
+} } } // namespace idlib::benchmarks::geometry
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace geometry {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using ray_3s = idlib::ray<point_3s>;
+using axis_aligned_box_3s = idlib::axis_aligned_box<point_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+using axis_aligned_cube_3s = idlib::axis_aligned_cube<point_3s>;
+using plane_3s = idlib::plane<point_3s>;
+
+static std::vector<ray_3s> random_rays(size_t n)
+{
+	const auto origins = random_points<single, 3>(n);
+	const auto directions = random_vectors<single, 3>(n);
+	std::vector<ray_3s> rays;
+	for (size_t i = 0; i < n; ++i)
+	{ rays.push_back(ray_3s(origins[i], directions[i])); }
+	return rays;
+}
+
+/// @brief Intersect each ray with a geometry.
+template <typename G>
+static void rays(harness::state& state, const G& g)
+{
+	const auto r = random_rays(state.argument());
+	while (state.keep_running())
+	{
+		single s = 0.0f;
+		for (const auto& x : r)
+		{ s += idlib::intersect(x, g).is_hit() ? 1.0f : 0.0f; }
+		harness::do_not_optimize(s);
+	}
+	state.set_items_processed(state.iterations() * r.size());
+}
+
+/// @brief Intersect each packet of rays with a geometry.
+template <std::size_t Width, typename G>
+static void packets(harness::state& state, const G& g)
+{
+	const auto r = random_rays(state.argument());
+	std::vector<idlib::ray_packet<point_3s, Width>> p;
+	for (size_t i = 0; i + Width <= r.size(); i += Width)
+	{ p.emplace_back(idlib::span<const ray_3s>(r.data() + i, Width)); }
+	while (state.keep_running())
+	{
+		std::uint64_t s = 0;
+		for (const auto& x : p)
+		{ s += idlib::intersect(x, g).get_mask(); }
+		harness::do_not_optimize(s);
+	}
+	state.set_items_processed(state.iterations() * p.size() * Width);
+}
+
+static const axis_aligned_box_3s box(point_3s(-250.0f, -250.0f, -250.0f), point_3s(+250.0f, +250.0f, +250.0f));
+static const sphere_3s sphere(point_3s(0.0f, 0.0f, 0.0f), 250.0f);
+static const axis_aligned_cube_3s cube(point_3s(0.0f, 0.0f, 0.0f), 250.0f);
+static const plane_3s plane(point_3s(0.0f, 0.0f, 0.0f), vector_3s(0.0f, 0.0f, 1.0f));
+
+static void ray_3s_intersect_axis_aligned_box_3s(harness::state& state)
+{ rays(state, box); }
+HARNESS_BENCHMARK(ray_3s_intersect_axis_aligned_box_3s)->argument(4096);
+
+static void ray_packet_4_3s_intersect_axis_aligned_box_3s(harness::state& state)
+{ packets<4>(state, box); }
+HARNESS_BENCHMARK(ray_packet_4_3s_intersect_axis_aligned_box_3s)->argument(4096);
+
+static void ray_packet_8_3s_intersect_axis_aligned_box_3s(harness::state& state)
+{ packets<8>(state, box); }
+HARNESS_BENCHMARK(ray_packet_8_3s_intersect_axis_aligned_box_3s)->argument(4096);
+
+static void ray_3s_intersect_sphere_3s(harness::state& state)
+{ rays(state, sphere); }
+HARNESS_BENCHMARK(ray_3s_intersect_sphere_3s)->argument(4096);
+
+static void ray_packet_4_3s_intersect_sphere_3s(harness::state& state)
+{ packets<4>(state, sphere); }
+HARNESS_BENCHMARK(ray_packet_4_3s_intersect_sphere_3s)->argument(4096);
+
+static void ray_packet_8_3s_intersect_sphere_3s(harness::state& state)
+{ packets<8>(state, sphere); }
+HARNESS_BENCHMARK(ray_packet_8_3s_intersect_sphere_3s)->argument(4096);
+
+static void ray_3s_intersect_axis_aligned_cube_3s(harness::state& state)
+{ rays(state, cube); }
+HARNESS_BENCHMARK(ray_3s_intersect_axis_aligned_cube_3s)->argument(4096);
+
+static void ray_packet_8_3s_intersect_axis_aligned_cube_3s(harness::state& state)
+{ packets<8>(state, cube); }
+HARNESS_BENCHMARK(ray_packet_8_3s_intersect_axis_aligned_cube_3s)->argument(4096);
+
+static void ray_3s_intersect_plane_3s(harness::state& state)
+{ rays(state, plane); }
+HARNESS_BENCHMARK(ray_3s_intersect_plane_3s)->argument(4096);
+
+static void ray_packet_8_3s_intersect_plane_3s(harness::state& state)
+{ packets<8>(state, plane); }
+HARNESS_BENCHMARK(ray_packet_8_3s_intersect_plane_3s)->argument(4096);
+
+} } } // namespace idlib::benchmarks::geometry
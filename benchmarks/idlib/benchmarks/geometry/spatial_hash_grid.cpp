@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+#include <cmath>
+
+namespace idlib { namespace benchmarks { namespace geometry {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+using sphere_grid_3s = idlib::spatial_hash_grid<sphere_3s>;
+
+/// @brief Generate spheres of radius at most 1 such that there are 8 units of volume per sphere.
+static std::vector<sphere_3s> scattered_spheres(size_t n)
+{
+	const single scale = std::cbrt(single(n)) / 1000.0f;
+	const auto c = random_points<single, 3>(n);
+	const auto r = random_scalars<single>(n, idlib::interval<single>(0.1f, 1.0f));
+	std::vector<sphere_3s> spheres;
+	for (size_t i = 0; i < n; ++i)
+	{ spheres.push_back(sphere_3s(point_3s(c[i][0] * scale, c[i][1] * scale, c[i][2] * scale), r[i])); }
+	return spheres;
+}
+
+static void sphere_grid_3s_insert(harness::state& state)
+{
+	const auto spheres = scattered_spheres(state.argument());
+	std::vector<uint32_t> handles(spheres.size());
+	while (state.keep_running())
+	{
+		sphere_grid_3s grid(2.25f);
+		grid.insert(spheres, handles);
+		harness::do_not_optimize(handles.data());
+	}
+	state.set_items_processed(state.iterations() * spheres.size());
+}
+HARNESS_BENCHMARK(sphere_grid_3s_insert)->argument(65536)->argument(524288);
+
+/// @brief Move all spheres back and forth by a displacement of at most 0.05 along each axis.
+static void sphere_grid_3s_move(harness::state& state)
+{
+	const auto spheres = scattered_spheres(state.argument());
+	const auto displacements = random_vectors<single, 3>(spheres.size());
+	std::vector<sphere_3s> moved;
+	for (size_t i = 0; i < spheres.size(); ++i)
+	{ moved.push_back(sphere_3s(spheres[i].get_center() + displacements[i] * 0.00005f, spheres[i].get_radius())); }
+	sphere_grid_3s grid(2.25f);
+	std::vector<uint32_t> handles(spheres.size());
+	grid.insert(spheres, handles);
+	size_t step = 0;
+	while (state.keep_running())
+	{
+		grid.move(handles, (step++ % 2) ? spheres : moved);
+		harness::do_not_optimize(grid.get_cell_count());
+	}
+	state.set_items_processed(state.iterations() * spheres.size());
+}
+HARNESS_BENCHMARK(sphere_grid_3s_move)->argument(65536)->argument(524288);
+
+static void find_pairs(harness::state& state, size_t thread_count)
+{
+	const auto spheres = scattered_spheres(state.argument());
+	sphere_grid_3s grid(2.25f);
+	std::vector<uint32_t> handles(spheres.size());
+	grid.insert(spheres, handles);
+	std::vector<sphere_grid_3s::pair_type> pairs(grid.find_pairs(idlib::span<sphere_grid_3s::pair_type>()));
+	while (state.keep_running())
+	{
+		harness::do_not_optimize(grid.find_pairs(pairs, thread_count));
+	}
+	state.set_items_processed(state.iterations() * spheres.size());
+}
+
+static void sphere_grid_3s_find_pairs_single_thread(harness::state& state)
+{ find_pairs(state, 1); }
+HARNESS_BENCHMARK(sphere_grid_3s_find_pairs_single_thread)->argument(4096)->argument(65536)->argument(524288);
+
+static void sphere_grid_3s_find_pairs_all_threads(harness::state& state)
+{ find_pairs(state, 0); }
+HARNESS_BENCHMARK(sphere_grid_3s_find_pairs_all_threads)->argument(65536)->argument(524288);
+
+/// @brief The same pairs as sphere_grid_3s_find_pairs by testing all pairs.
+static void sphere_3s_find_pairs_brute_force(harness::state& state)
+{
+	const auto spheres = scattered_spheres(state.argument());
+	while (state.keep_running())
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < spheres.size(); ++i)
+		{
+			for (size_t j = i + 1; j < spheres.size(); ++j)
+			{ count += idlib::is_intersecting(spheres[i], spheres[j]) ? 1 : 0; }
+		}
+		harness::do_not_optimize(count);
+	}
+	state.set_items_processed(state.iterations() * spheres.size());
+}
+HARNESS_BENCHMARK(sphere_3s_find_pairs_brute_force)->argument(4096);
+
+} } } // namespace idlib::benchmarks::geometry
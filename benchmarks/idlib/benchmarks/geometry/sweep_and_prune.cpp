@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+#include <cmath>
+
+namespace idlib { namespace benchmarks { namespace geometry {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using sap_3s = idlib::sweep_and_prune<point_3s>;
+
+/// @brief Generate boxes of extent at most 2 such that there are 8 units of volume per box.
+static std::vector<box_3s> scattered_boxes(size_t n)
+{
+	const single scale = std::cbrt(single(n)) / 1000.0f;
+	const auto c = random_points<single, 3>(n);
+	const auto r = random_scalars<single>(n, idlib::interval<single>(0.1f, 1.0f));
+	std::vector<box_3s> boxes;
+	for (size_t i = 0; i < n; ++i)
+	{
+		const point_3s p(c[i][0] * scale, c[i][1] * scale, c[i][2] * scale);
+		const vector_3s s(r[i], r[i], r[i]);
+		boxes.push_back(box_3s(p - s, p + s));
+	}
+	return boxes;
+}
+
+/// @brief Insert all boxes and sort the endpoints from scratch.
+static void box_sap_3s_build(harness::state& state)
+{
+	const auto boxes = scattered_boxes(state.argument());
+	std::vector<sap_3s::pair_type> added, removed;
+	while (state.keep_running())
+	{
+		sap_3s sap;
+		for (const auto& box : boxes) sap.insert(box);
+		harness::do_not_optimize(sap.update(added, removed).pair_count);
+	}
+	state.set_items_processed(state.iterations() * boxes.size());
+}
+HARNESS_BENCHMARK(box_sap_3s_build)->argument(4096)->argument(16384);
+
+/// @brief Move all boxes back and forth by a displacement of at most 0.05 along each axis and update.
+static void box_sap_3s_update_coherent(harness::state& state)
+{
+	const auto boxes = scattered_boxes(state.argument());
+	const auto displacements = random_vectors<single, 3>(boxes.size());
+	std::vector<box_3s> moved;
+	for (size_t i = 0; i < boxes.size(); ++i)
+	{
+		const auto d = displacements[i] * 0.00005f;
+		moved.push_back(box_3s(boxes[i].get_min() + d, boxes[i].get_max() + d));
+	}
+	sap_3s sap;
+	std::vector<uint32_t> handles;
+	for (const auto& box : boxes) handles.push_back(sap.insert(box));
+	std::vector<sap_3s::pair_type> added, removed;
+	sap.update(added, removed);
+	size_t step = 0;
+	while (state.keep_running())
+	{
+		const auto& source = (step++ % 2) ? boxes : moved;
+		for (size_t i = 0; i < handles.size(); ++i) sap.move(handles[i], source[i]);
+		harness::do_not_optimize(sap.update(added, removed).swap_count);
+	}
+	state.set_items_processed(state.iterations() * boxes.size());
+}
+HARNESS_BENCHMARK(box_sap_3s_update_coherent)->argument(16384)->argument(65536);
+
+} } } // namespace idlib::benchmarks::geometry
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace math {
+
+template <typename E, std::size_t S>
+static std::vector<idlib::arithmetic_tuple<E, S, idlib::zero_functor<E>>> random_tuples(size_t n)
+{
+	using tuple_type = idlib::arithmetic_tuple<E, S, idlib::zero_functor<E>>;
+	idlib::rng rng(seed);
+	const idlib::interval<E> interval(E(-1000), E(+1000));
+	std::vector<tuple_type> tuples;
+	for (size_t i = 0; i < n; ++i)
+	{ tuples.push_back(tuple_type::generate([&rng, &interval](size_t) { return rng.next(interval); })); }
+	return tuples;
+}
+
+/// @brief \f$z_i = x_i + y_i \cdot s\f$ over sequences of tuples.
+template <typename E, std::size_t S>
+static void multiply_add(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_tuples<E, S>(n), y = random_tuples<E, S>(n);
+	auto z = x;
+	const E s = E(0.5);
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = x[i] + y[i] * s;
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+
+/// @brief The inner products of sequences of tuples.
+template <typename E, std::size_t S>
+static void inner_product(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_tuples<E, S>(n), y = random_tuples<E, S>(n);
+	std::vector<E> z(n);
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = x[i].inner_product(y[i]);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+
+static void arithmetic_tuple_4s_multiply_add(harness::state& state)
+{ multiply_add<single, 4>(state); }
+HARNESS_BENCHMARK(arithmetic_tuple_4s_multiply_add)->argument(1024);
+
+static void arithmetic_tuple_4d_multiply_add(harness::state& state)
+{ multiply_add<double, 4>(state); }
+HARNESS_BENCHMARK(arithmetic_tuple_4d_multiply_add)->argument(1024);
+
+static void arithmetic_tuple_4s_inner_product(harness::state& state)
+{ inner_product<single, 4>(state); }
+HARNESS_BENCHMARK(arithmetic_tuple_4s_inner_product)->argument(1024);
+
+static void arithmetic_tuple_4d_inner_product(harness::state& state)
+{ inner_product<double, 4>(state); }
+HARNESS_BENCHMARK(arithmetic_tuple_4d_inner_product)->argument(1024);
+
+} } } // namespace idlib::benchmarks::math
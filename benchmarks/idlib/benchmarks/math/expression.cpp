@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace math {
+
+using vector_3s = idlib::vector<single, 3>;
+
+/// @brief Evaluate \f$a + b \cdot s - c\f$ eagerly, creating a temporary vector per operator.
+static void vector_3s_expression_eager(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto a = random_vectors<single, 3>(n), b = random_vectors<single, 3>(n + 1), c = random_vectors<single, 3>(n + 2);
+	std::vector<vector_3s> z(n);
+	const single s = 0.5f;
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = a[i] + b[i + 1] * s - c[i + 2];
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(vector_3s_expression_eager)->argument(1024);
+
+/// @brief Evaluate \f$a + b \cdot s - c\f$ lazily, in a single pass over the components.
+static void vector_3s_expression_lazy(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto a = random_vectors<single, 3>(n), b = random_vectors<single, 3>(n + 1), c = random_vectors<single, 3>(n + 2);
+	std::vector<vector_3s> z(n);
+	const single s = 0.5f;
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = idlib::evaluate(idlib::lazy(a[i]) + b[i + 1] * s - c[i + 2]);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(vector_3s_expression_lazy)->argument(1024);
+
+} } } // namespace idlib::benchmarks::math
@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace math {
+
+using vector_3s = idlib::vector<single, 3>;
+
+static void single_lineary_interpolate(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_scalars<single>(n, idlib::interval<single>(-1000.0f, +1000.0f)),
+	           y = random_scalars<single>(n + 1, idlib::interval<single>(-1000.0f, +1000.0f)),
+	           t = random_scalars<single>(n + 2, idlib::interval<single>(0.0f, 1.0f));
+	std::vector<single> z(n);
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = idlib::lineary_interpolate(x[i], y[i + 1], t[i + 2]);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(single_lineary_interpolate)->argument(1024);
+
+static void vector_3s_lineary_interpolate(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_vectors<single, 3>(n), y = random_vectors<single, 3>(n + 1);
+	const auto t = random_scalars<single>(n, idlib::interval<single>(0.0f, 1.0f));
+	std::vector<vector_3s> z(n);
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = idlib::lineary_interpolate(x[i], y[i + 1], t[i]);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(vector_3s_lineary_interpolate)->argument(1024);
+
+} } } // namespace idlib::benchmarks::math
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace math {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using matrix_4s = idlib::matrix<single, 4, 4>;
+
+static matrix_4s affine_transform()
+{
+	auto axis = idlib::normalize(vector_3s(1.0f, 2.0f, 3.0f), idlib::euclidean_norm_functor<vector_3s>()).get_vector();
+	return idlib::translation(vector_3s(1.0f, -2.0f, 3.0f)) * idlib::rotation(axis, idlib::angle<single, idlib::radians>(0.5f));
+}
+
+static void matrix_4s_multiply(harness::state& state)
+{
+	const size_t n = state.argument();
+	std::vector<matrix_4s> x(n, affine_transform()), z(n);
+	const auto y = affine_transform();
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = x[i] * y;
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(matrix_4s_multiply)->argument(256);
+
+static void matrix_4s_transform_points(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto m = affine_transform();
+	const auto p = random_points<single, 3>(n);
+	std::vector<point_3s> q(n);
+	while (state.keep_running())
+	{
+		idlib::transform_points(m, idlib::span<const point_3s>(p), idlib::span<point_3s>(q));
+		harness::do_not_optimize(q.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(matrix_4s_transform_points)->argument(1024)->argument(1 << 20);
+
+} } } // namespace idlib::benchmarks::math
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace math {
+
+using quaternion_s = idlib::quaternion<single>;
+using quaternion_batch_s = idlib::quaternion_batch<single>;
+
+static std::vector<quaternion_s> random_unit_quaternions(size_t n, std::uint64_t stream)
+{
+	idlib::rng rng(idlib::rng_engine::philox4x32, seed, stream);
+	const idlib::interval<single> interval(-1.0f, +1.0f);
+	std::vector<quaternion_s> quaternions;
+	for (size_t i = 0; i < n; ++i)
+	{
+		quaternion_s q(rng.next(interval), rng.next(interval), rng.next(interval), rng.next(interval));
+		quaternions.push_back(q / idlib::euclidean_norm(q));
+	}
+	return quaternions;
+}
+
+static void quaternion_s_slerp(harness::state& state)
+{
+	const size_t n = state.argument();
+	const auto x = random_unit_quaternions(n, 0), y = random_unit_quaternions(n, 1);
+	std::vector<quaternion_s> z(n);
+	const idlib::mu<single> t(0.25f);
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = idlib::slerp(x[i], y[i], t);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(quaternion_s_slerp)->argument(1024);
+
+static void quaternion_batch_s_slerp(harness::state& state)
+{
+	const size_t n = state.argument();
+	quaternion_batch_s x(random_unit_quaternions(n, 0)), y(random_unit_quaternions(n, 1)), z(n);
+	const idlib::mu<single> t(0.25f);
+	while (state.keep_running())
+	{
+		idlib::slerp(x, y, t, z);
+		harness::do_not_optimize(z.data(0));
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(quaternion_batch_s_slerp)->argument(1024);
+
+static void quaternion_batch_s_nlerp(harness::state& state)
+{
+	const size_t n = state.argument();
+	quaternion_batch_s x(random_unit_quaternions(n, 0)), y(random_unit_quaternions(n, 1)), z(n);
+	const idlib::mu<single> t(0.25f);
+	while (state.keep_running())
+	{
+		idlib::nlerp(x, y, t, z);
+		harness::do_not_optimize(z.data(0));
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(quaternion_batch_s_nlerp)->argument(1024);
+
+} } } // namespace idlib::benchmarks::math
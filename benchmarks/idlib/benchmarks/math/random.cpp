@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace math {
+
+/// @brief Generate single values by individual calls of idlib::rng::next.
+template <idlib::rng_engine Engine>
+static void next(harness::state& state)
+{
+	const size_t n = state.argument();
+	idlib::rng rng(Engine, seed);
+	const idlib::interval<single> interval(-1.0f, +1.0f);
+	std::vector<single> z(n);
+	while (state.keep_running())
+	{
+		for (auto& x : z) x = rng.next(interval);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+
+/// @brief Generate single values by idlib::rng::fill.
+template <idlib::rng_engine Engine, typename T>
+static void fill(harness::state& state, const idlib::interval<T>& interval)
+{
+	const size_t n = state.argument();
+	idlib::rng rng(Engine, seed);
+	std::vector<T> z(n);
+	while (state.keep_running())
+	{
+		rng.fill(idlib::span<T>(z), interval);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+
+static void rng_next_single_mersenne_twister(harness::state& state)
+{ next<idlib::rng_engine::mersenne_twister>(state); }
+HARNESS_BENCHMARK(rng_next_single_mersenne_twister)->argument(4096);
+
+static void rng_next_single_xoshiro256_star_star(harness::state& state)
+{ next<idlib::rng_engine::xoshiro256_star_star>(state); }
+HARNESS_BENCHMARK(rng_next_single_xoshiro256_star_star)->argument(4096);
+
+static void rng_next_single_pcg64(harness::state& state)
+{ next<idlib::rng_engine::pcg64>(state); }
+HARNESS_BENCHMARK(rng_next_single_pcg64)->argument(4096);
+
+static void rng_next_single_philox4x32(harness::state& state)
+{ next<idlib::rng_engine::philox4x32>(state); }
+HARNESS_BENCHMARK(rng_next_single_philox4x32)->argument(4096);
+
+static void rng_fill_single_mersenne_twister(harness::state& state)
+{ fill<idlib::rng_engine::mersenne_twister>(state, idlib::interval<single>(-1.0f, +1.0f)); }
+HARNESS_BENCHMARK(rng_fill_single_mersenne_twister)->argument(4096);
+
+static void rng_fill_single_xoshiro256_star_star(harness::state& state)
+{ fill<idlib::rng_engine::xoshiro256_star_star>(state, idlib::interval<single>(-1.0f, +1.0f)); }
+HARNESS_BENCHMARK(rng_fill_single_xoshiro256_star_star)->argument(4096);
+
+static void rng_fill_single_pcg64(harness::state& state)
+{ fill<idlib::rng_engine::pcg64>(state, idlib::interval<single>(-1.0f, +1.0f)); }
+HARNESS_BENCHMARK(rng_fill_single_pcg64)->argument(4096);
+
+static void rng_fill_single_philox4x32(harness::state& state)
+{ fill<idlib::rng_engine::philox4x32>(state, idlib::interval<single>(-1.0f, +1.0f)); }
+HARNESS_BENCHMARK(rng_fill_single_philox4x32)->argument(4096);
+
+static void rng_fill_double_xoshiro256_star_star(harness::state& state)
+{ fill<idlib::rng_engine::xoshiro256_star_star>(state, idlib::interval<double>(-1.0, +1.0)); }
+HARNESS_BENCHMARK(rng_fill_double_xoshiro256_star_star)->argument(4096);
+
+static void rng_fill_int_xoshiro256_star_star(harness::state& state)
+{ fill<idlib::rng_engine::xoshiro256_star_star>(state, idlib::interval<int>(-1000, +1000)); }
+HARNESS_BENCHMARK(rng_fill_int_xoshiro256_star_star)->argument(4096);
+
+} } } // namespace idlib::benchmarks::math
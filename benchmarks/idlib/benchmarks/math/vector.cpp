@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "idlib/benchmarks/data.hpp"
+
+namespace idlib { namespace benchmarks { namespace math {
+
+using vector_3s = idlib::vector<single, 3>;
+using vector_batch_3s = idlib::vector_batch<single, 3>;
+
+/// @brief Apply a binary operation to sequences of vectors.
+template <typename R, typename O>
+static void binary(harness::state& state, O operation)
+{
+	const size_t n = state.argument();
+	const auto x = random_vectors<single, 3>(n), y = random_vectors<single, 3>(n + 1);
+	std::vector<R> z(n);
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = operation(x[i], y[i + 1]);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+
+/// @brief Apply a unary operation to a sequence of vectors.
+template <typename R, typename O>
+static void unary(harness::state& state, O operation)
+{
+	const size_t n = state.argument();
+	auto x = random_vectors<single, 3>(n);
+	x[0] = idlib::zero<vector_3s>();
+	std::vector<R> z(n);
+	while (state.keep_running())
+	{
+		for (size_t i = 0; i < n; ++i) z[i] = operation(x[i]);
+		harness::do_not_optimize(z.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+
+static void vector_3s_add(harness::state& state)
+{ binary<vector_3s>(state, [](const vector_3s& x, const vector_3s& y) { return x + y; }); }
+HARNESS_BENCHMARK(vector_3s_add)->argument(1024);
+
+static void vector_3s_scale(harness::state& state)
+{ unary<vector_3s>(state, [](const vector_3s& x) { return x * 0.5f; }); }
+HARNESS_BENCHMARK(vector_3s_scale)->argument(1024);
+
+static void vector_3s_dot_product(harness::state& state)
+{ binary<single>(state, [](const vector_3s& x, const vector_3s& y) { return idlib::dot_product(x, y); }); }
+HARNESS_BENCHMARK(vector_3s_dot_product)->argument(1024);
+
+static void vector_3s_cross_product(harness::state& state)
+{ binary<vector_3s>(state, [](const vector_3s& x, const vector_3s& y) { return idlib::cross_product(x, y); }); }
+HARNESS_BENCHMARK(vector_3s_cross_product)->argument(1024);
+
+static void vector_3s_squared_euclidean_norm(harness::state& state)
+{ unary<single>(state, [](const vector_3s& x) { return idlib::squared_euclidean_norm(x); }); }
+HARNESS_BENCHMARK(vector_3s_squared_euclidean_norm)->argument(1024);
+
+static void vector_3s_euclidean_norm(harness::state& state)
+{ unary<single>(state, [](const vector_3s& x) { return idlib::euclidean_norm(x); }); }
+HARNESS_BENCHMARK(vector_3s_euclidean_norm)->argument(1024);
+
+static void vector_3s_fast_euclidean_norm(harness::state& state)
+{ unary<single>(state, [](const vector_3s& x) { return idlib::fast_euclidean_norm(x); }); }
+HARNESS_BENCHMARK(vector_3s_fast_euclidean_norm)->argument(1024);
+
+static void vector_3s_manhattan_norm(harness::state& state)
+{ unary<single>(state, [](const vector_3s& x) { return idlib::manhattan_norm(x); }); }
+HARNESS_BENCHMARK(vector_3s_manhattan_norm)->argument(1024);
+
+static void vector_3s_maximum_norm(harness::state& state)
+{ unary<single>(state, [](const vector_3s& x) { return idlib::maximum_norm(x); }); }
+HARNESS_BENCHMARK(vector_3s_maximum_norm)->argument(1024);
+
+static void vector_3s_normalize(harness::state& state)
+{
+	unary<vector_3s>(state, [](const vector_3s& x)
+	{ return idlib::normalize(x, idlib::euclidean_norm_functor<vector_3s>{}).get_vector_or_default(); });
+}
+HARNESS_BENCHMARK(vector_3s_normalize)->argument(1024);
+
+static void vector_3s_fast_normalize(harness::state& state)
+{
+	unary<vector_3s>(state, [](const vector_3s& x)
+	{ return idlib::normalize(x, idlib::fast_euclidean_norm_functor<vector_3s>{}).get_vector_or_default(); });
+}
+HARNESS_BENCHMARK(vector_3s_fast_normalize)->argument(1024);
+
+static void vector_batch_3s_add(harness::state& state)
+{
+	const size_t n = state.argument();
+	vector_batch_3s a(random_vectors<single, 3>(n)), b(random_vectors<single, 3>(n)), r(n);
+	while (state.keep_running())
+	{
+		idlib::add(a, b, r);
+		harness::do_not_optimize(r.data(0));
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(vector_batch_3s_add)->argument(1024)->argument(1 << 20);
+
+static void vector_batch_3s_euclidean_norm(harness::state& state)
+{
+	const size_t n = state.argument();
+	vector_batch_3s a(random_vectors<single, 3>(n));
+	std::vector<single> r(n);
+	while (state.keep_running())
+	{
+		idlib::euclidean_norm(a, r);
+		harness::do_not_optimize(r.data());
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(vector_batch_3s_euclidean_norm)->argument(1024)->argument(1 << 20);
+
+static void vector_batch_3s_normalize(harness::state& state)
+{
+	const size_t n = state.argument();
+	vector_batch_3s a(random_vectors<single, 3>(n)), r(n);
+	while (state.keep_running())
+	{
+		idlib::normalize(a, r);
+		harness::do_not_optimize(r.data(0));
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(vector_batch_3s_normalize)->argument(1024)->argument(1 << 20);
+
+static void vector_batch_3s_fast_normalize(harness::state& state)
+{
+	const size_t n = state.argument();
+	vector_batch_3s a(random_vectors<single, 3>(n)), r(n);
+	while (state.keep_running())
+	{
+		idlib::normalize(a, r, idlib::fast_euclidean_norm_functor<vector_3s>{});
+		harness::do_not_optimize(r.data(0));
+		harness::clobber_memory();
+	}
+	state.set_items_processed(state.iterations() * n);
+}
+HARNESS_BENCHMARK(vector_batch_3s_fast_normalize)->argument(1024)->argument(1 << 20);
+
+} } } // namespace idlib::benchmarks::math
@@ -33,7 +33,10 @@ macro(set_project_default_properties)
 	  # TODO: IdLib can have these warnings enabled.
 	  add_definitions("-Wno-reorder -Wno-sign-compare -Wno-missing-braces -Wno-unused-parameter")
 	  # Enable optimizations that do not interfere with debug experience.
-	  add_definitions("-Og")
+	  # Release build types keep their optimization level.
+	  if (NOT CMAKE_BUILD_TYPE MATCHES "^(Release|RelWithDebInfo|MinSizeRel)$")
+	    add_definitions("-Og")
+	  endif()
 	  # Enable extra debug information.
 	  add_definitions("-ggdb3")
 	endif()
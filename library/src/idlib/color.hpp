@@ -37,3 +37,9 @@
 #include "idlib/color/a.hpp"
 #include "idlib/color/l.hpp"
 #include "idlib/color/la.hpp"
+#include "idlib/color/expression.hpp"
+#include "idlib/color/srgb.hpp"
+#include "idlib/color/convert.hpp"
+#include "idlib/color/image.hpp"
+#include "idlib/color/lerp.hpp"
+#include "idlib/color/composite.hpp"
@@ -129,6 +129,10 @@ public:
     {}
 
 public:
+    /// @brief Copy construct this color from another color.
+    /// @param other the other color
+    color(const color& other) = default;
+
     /// @brief Assign this color from another color.
     /// @param other the other color
     /// @return this color
@@ -0,0 +1,503 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/color/composite.hpp
+/// @brief Alpha compositing of spans of colors with premultiplied alpha.
+/// @author Michael Heilmann
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/idlib.hpp` instead)
+#endif
+
+#include "idlib/color/color.hpp"
+#include "idlib/color/convert.hpp"
+#include "idlib/math/simd.hpp"
+#include "idlib/range/span.hpp"
+#include "idlib/utility/is_any_of.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace idlib {
+
+/// @brief The compositing operators of idlib::composite.
+/// @detail
+/// The operators are given for a source color \f$s\f$ with alpha \f$\alpha_s\f$ and a destination color \f$d\f$ with alpha \f$\alpha_d\f$,
+/// both with premultiplied alpha. Each formula applies to the RGB components and the A component alike.
+enum class composite_operator
+{
+    /// @brief \f$s + d (1 - \alpha_s)\f$.
+    over,
+    /// @brief \f$s \alpha_d\f$.
+    in,
+    /// @brief \f$s (1 - \alpha_d)\f$.
+    out,
+    /// @brief \f$s \alpha_d + d (1 - \alpha_s)\f$.
+    atop,
+    /// @brief Porter-Duff "xor", \f$s (1 - \alpha_d) + d (1 - \alpha_s)\f$.
+    exclusive_or,
+    /// @brief \f$s d + s (1 - \alpha_d) + d (1 - \alpha_s)\f$.
+    multiply,
+    /// @brief \f$s + d - s d\f$.
+    screen,
+    /// @brief \f$\min(1, s + d)\f$.
+    add,
+}; // enum class composite_operator
+
+} // namespace idlib
+
+namespace idlib { namespace internal {
+
+/// @brief The minimal number of colors per thread of the compositing algorithms.
+constexpr std::size_t composite_grain = 65536;
+
+/// @brief Multiply two uint8 values as values within the range from 0 (inclusive) to 1 (inclusive).
+/// @return \f$\lfloor x y / 255 + \frac{1}{2} \rfloor\f$
+/// @remark The quotient is computed without division as \f$\lfloor (t + \lfloor t / 256 \rfloor) / 256 \rfloor\f$, \f$t = x y + 128\f$.
+/// All intermediate values are within the range of uint16.
+inline int mul_uint8(int x, int y)
+{
+    const int t = x * y + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+/// @brief The arithmetic of the compositing operators on uint8 values.
+struct composite_uint8_arithmetic
+{
+    static int add(int x, int y) { return x + y; }
+    static int sub(int x, int y) { return x - y; }
+    static int mul(int x, int y) { return mul_uint8(x, y); }
+    static int inv(int x) { return 255 - x; }
+    static int min1(int x) { return std::min(x, 255); }
+};
+
+/// @brief The arithmetic of the compositing operators on clamped single values.
+struct composite_single_arithmetic
+{
+    static float add(float x, float y) { return x + y; }
+    static float sub(float x, float y) { return x - y; }
+    static float mul(float x, float y) { return x * y; }
+    static float inv(float x) { return 1.0f - x; }
+    static float min1(float x) { return std::min(x, 1.0f); }
+};
+
+#if defined(IDLIB_WITH_SSE2)
+/// @brief internal::composite_uint8_arithmetic for eight uint8 values zero-extended to uint16 values.
+struct composite_epu16_arithmetic
+{
+    static __m128i add(__m128i x, __m128i y) { return _mm_add_epi16(x, y); }
+    static __m128i sub(__m128i x, __m128i y) { return _mm_sub_epi16(x, y); }
+    static __m128i mul(__m128i x, __m128i y)
+    {
+        const __m128i t = _mm_add_epi16(_mm_mullo_epi16(x, y), _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    }
+    static __m128i inv(__m128i x) { return _mm_sub_epi16(_mm_set1_epi16(255), x); }
+    static __m128i min1(__m128i x) { return _mm_min_epi16(x, _mm_set1_epi16(255)); }
+};
+
+/// @brief internal::composite_single_arithmetic for four clamped single values.
+struct composite_ps_arithmetic
+{
+    static __m128 add(__m128 x, __m128 y) { return _mm_add_ps(x, y); }
+    static __m128 sub(__m128 x, __m128 y) { return _mm_sub_ps(x, y); }
+    static __m128 mul(__m128 x, __m128 y) { return _mm_mul_ps(x, y); }
+    static __m128 inv(__m128 x) { return _mm_sub_ps(_mm_set1_ps(1.0f), x); }
+    static __m128 min1(__m128 x) { return _mm_min_ps(x, _mm_set1_ps(1.0f)); }
+};
+
+/// @brief Broadcast the A components of two RGBA colors of uint16 values to all components of the respective color.
+inline __m128i broadcast_a_epi16(__m128i x)
+{ return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)); }
+
+/// @brief Broadcast the A component of an RGBA color of single values to all components.
+inline __m128 broadcast_a_ps(__m128 x)
+{ return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+#endif
+
+/// @brief Compositing functor.
+/// @tparam Operator the compositing operator
+/// @remark The static member function template @a apply computes the value of a component
+/// from the values @a s and @a d of the source and destination components and the alphas @a as and @a ad
+/// in terms of the arithmetic @a A. The result is not yet clamped to the range of the component values.
+template <composite_operator Operator>
+struct composite_functor;
+
+template <>
+struct composite_functor<composite_operator::over>
+{
+    template <typename A, typename T>
+    static T apply(T s, T d, T as, T) { return A::add(s, A::mul(d, A::inv(as))); }
+};
+
+template <>
+struct composite_functor<composite_operator::in>
+{
+    template <typename A, typename T>
+    static T apply(T s, T, T, T ad) { return A::mul(s, ad); }
+};
+
+template <>
+struct composite_functor<composite_operator::out>
+{
+    template <typename A, typename T>
+    static T apply(T s, T, T, T ad) { return A::mul(s, A::inv(ad)); }
+};
+
+template <>
+struct composite_functor<composite_operator::atop>
+{
+    template <typename A, typename T>
+    static T apply(T s, T d, T as, T ad) { return A::add(A::mul(s, ad), A::mul(d, A::inv(as))); }
+};
+
+template <>
+struct composite_functor<composite_operator::exclusive_or>
+{
+    template <typename A, typename T>
+    static T apply(T s, T d, T as, T ad) { return A::add(A::mul(s, A::inv(ad)), A::mul(d, A::inv(as))); }
+};
+
+template <>
+struct composite_functor<composite_operator::multiply>
+{
+    template <typename A, typename T>
+    static T apply(T s, T d, T as, T ad)
+    { return A::add(A::mul(s, d), A::add(A::mul(s, A::inv(ad)), A::mul(d, A::inv(as)))); }
+};
+
+template <>
+struct composite_functor<composite_operator::screen>
+{
+    template <typename A, typename T>
+    static T apply(T s, T d, T, T) { return A::sub(A::add(s, d), A::mul(s, d)); }
+};
+
+template <>
+struct composite_functor<composite_operator::add>
+{
+    template <typename A, typename T>
+    static T apply(T s, T d, T, T) { return A::min1(A::add(s, d)); }
+};
+
+/// @brief Composite @a n RGBA uint8 colors.
+/// @param x, y pointers to the first component of the first source and destination color
+/// @param z a pointer to the first component of the first composited color. May be @a x or @a y.
+/// @remark The results are clamped to the range from 0 (inclusive) to 255 (inclusive).
+/// The SIMD kernel saturates when packing, the scalar kernel clamps.
+template <composite_operator Operator>
+void composite_uint8(const std::uint8_t *x, const std::uint8_t *y, std::uint8_t *z, std::size_t n)
+{
+    using functor = composite_functor<Operator>;
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + 4 * i)),
+                      b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + 4 * i));
+        const __m128i s0 = _mm_unpacklo_epi8(a, zero), d0 = _mm_unpacklo_epi8(b, zero),
+                      s1 = _mm_unpackhi_epi8(a, zero), d1 = _mm_unpackhi_epi8(b, zero);
+        const __m128i p = functor::template apply<composite_epu16_arithmetic>(s0, d0, broadcast_a_epi16(s0), broadcast_a_epi16(d0)),
+                      q = functor::template apply<composite_epu16_arithmetic>(s1, d1, broadcast_a_epi16(s1), broadcast_a_epi16(d1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(z + 4 * i), _mm_packus_epi16(p, q));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        const std::uint8_t *s = x + 4 * i, *d = y + 4 * i;
+        const int as = s[3], ad = d[3];
+        std::array<std::uint8_t, 4> t;
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            const int v = functor::template apply<composite_uint8_arithmetic>(int(s[k]), int(d[k]), as, ad);
+            t[k] = static_cast<std::uint8_t>(std::min(std::max(v, 0), 255));
+        }
+        std::copy(t.begin(), t.end(), z + 4 * i);
+    }
+}
+
+/// @brief Composite @a n RGBA clamped single colors.
+/// @param x, y pointers to the first component of the first source and destination color
+/// @param z a pointer to the first component of the first composited color. May be @a x or @a y.
+/// @remark The results are clamped to the range from 0 (inclusive) to 1 (inclusive) like internal::lerp_single clamps.
+template <composite_operator Operator>
+void composite_single(const float *x, const float *y, float *z, std::size_t n)
+{
+    using functor = composite_functor<Operator>;
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    for (; i < n; ++i)
+    {
+        const __m128 s = _mm_loadu_ps(x + 4 * i), d = _mm_loadu_ps(y + 4 * i);
+        const __m128 v = functor::template apply<composite_ps_arithmetic>(s, d, broadcast_a_ps(s), broadcast_a_ps(d));
+        _mm_storeu_ps(z + 4 * i, _mm_min_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_setzero_ps(), v)));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        const float *s = x + 4 * i, *d = y + 4 * i;
+        const float as = s[3], ad = d[3];
+        std::array<float, 4> t;
+        for (std::size_t k = 0; k < 4; ++k)
+        { t[k] = type::clamped_single_traits::range().clamp(functor::template apply<composite_single_arithmetic>(s[k], d[k], as, ad)); }
+        std::copy(t.begin(), t.end(), z + 4 * i);
+    }
+}
+
+/// @brief Composite @a n RGBA colors.
+/// @param op the compositing operator
+/// @throws invalid_argument_error @a op is not a compositing operator
+template <typename T>
+void composite(composite_operator op, const T *x, const T *y, T *z, std::size_t n)
+{
+    const auto f = [x, y, z, n](auto o)
+    {
+        if constexpr (std::is_same<T, std::uint8_t>::value)
+        { composite_uint8<decltype(o)::value>(x, y, z, n); }
+        else
+        { composite_single<decltype(o)::value>(x, y, z, n); }
+    };
+    switch (op)
+    {
+        case composite_operator::over: f(std::integral_constant<composite_operator, composite_operator::over>()); break;
+        case composite_operator::in: f(std::integral_constant<composite_operator, composite_operator::in>()); break;
+        case composite_operator::out: f(std::integral_constant<composite_operator, composite_operator::out>()); break;
+        case composite_operator::atop: f(std::integral_constant<composite_operator, composite_operator::atop>()); break;
+        case composite_operator::exclusive_or: f(std::integral_constant<composite_operator, composite_operator::exclusive_or>()); break;
+        case composite_operator::multiply: f(std::integral_constant<composite_operator, composite_operator::multiply>()); break;
+        case composite_operator::screen: f(std::integral_constant<composite_operator, composite_operator::screen>()); break;
+        case composite_operator::add: f(std::integral_constant<composite_operator, composite_operator::add>()); break;
+        default: throw invalid_argument_error(__FILE__, __LINE__, "unknown compositing operator");
+    }
+}
+
+/// @brief Premultiply the RGB components of @a n RGBA uint8 colors by their A component.
+/// @remark Each RGB component \f$c\f$ becomes internal::mul_uint8(c, a), that is, \f$c a / 255\f$ exactly rounded.
+inline void premultiply_uint8(const std::uint8_t *x, std::uint8_t *z, std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    const __m128i zero = _mm_setzero_si128(), a = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+    for (; i + 4 <= n; i += 4)
+    {
+        // The A component is multiplied by 255 which yields the A component.
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + 4 * i));
+        const __m128i s = _mm_unpacklo_epi8(c, zero), t = _mm_unpackhi_epi8(c, zero);
+        const __m128i p = composite_epu16_arithmetic::mul(s, _mm_max_epi16(broadcast_a_epi16(s), a)),
+                      q = composite_epu16_arithmetic::mul(t, _mm_max_epi16(broadcast_a_epi16(t), a));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(z + 4 * i), _mm_packus_epi16(p, q));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        const std::uint8_t a = x[4 * i + 3];
+        for (std::size_t k = 0; k < 3; ++k)
+        { z[4 * i + k] = static_cast<std::uint8_t>(mul_uint8(x[4 * i + k], a)); }
+        z[4 * i + 3] = a;
+    }
+}
+
+/// @brief Premultiply the RGB components of @a n RGBA clamped single colors by their A component.
+inline void premultiply_single(const float *x, float *z, std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    const __m128 rgb = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    for (; i < n; ++i)
+    {
+        const __m128 c = _mm_loadu_ps(x + 4 * i);
+        const __m128 v = _mm_mul_ps(c, broadcast_a_ps(c));
+        _mm_storeu_ps(z + 4 * i, _mm_or_ps(_mm_and_ps(rgb, v), _mm_andnot_ps(rgb, c)));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        const float a = x[4 * i + 3];
+        for (std::size_t k = 0; k < 3; ++k)
+        { z[4 * i + k] = x[4 * i + k] * a; }
+        z[4 * i + 3] = a;
+    }
+}
+
+/// @brief Get the unpremultiply table.
+/// @return the table of the 256 values \f$\lceil 255 \cdot 2^{16} / a \rceil\f$ for \f$a > 0\f$ and \f$0\f$ for \f$a = 0\f$
+/// @remark For \f$c \leq a\f$, \f$\lfloor (c r + 2^{15}) / 2^{16} \rfloor\f$ is \f$c \cdot 255 / a\f$ exactly rounded, as an exhaustive test confirms.
+inline const std::array<std::uint32_t, 256>& get_unpremultiply_table()
+{
+    static const std::array<std::uint32_t, 256> table = []()
+    {
+        std::array<std::uint32_t, 256> t;
+        t[0] = 0;
+        for (std::uint32_t a = 1; a < t.size(); ++a)
+        { t[a] = (255u * 65536u + a - 1) / a; }
+        return t;
+    }();
+    return table;
+}
+
+/// @brief Divide the RGB components of @a n RGBA uint8 colors by their A component.
+/// @remark Each RGB component \f$c\f$ becomes \f$\min(255, c \cdot 255 / a)\f$ exactly rounded and \f$0\f$ if \f$a = 0\f$.
+/// The quotient is computed by multiplication with internal::get_unpremultiply_table.
+inline void unpremultiply_uint8(const std::uint8_t *x, std::uint8_t *z, std::size_t n)
+{
+    const auto& table = get_unpremultiply_table();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::uint8_t a = x[4 * i + 3];
+        const std::uint32_t r = table[a];
+        for (std::size_t k = 0; k < 3; ++k)
+        { z[4 * i + k] = static_cast<std::uint8_t>(std::min<std::uint32_t>((x[4 * i + k] * r + 32768u) >> 16, 255u)); }
+        z[4 * i + 3] = a;
+    }
+}
+
+/// @brief Divide the RGB components of @a n RGBA clamped single colors by their A component.
+/// @remark Each RGB component \f$c\f$ becomes \f$c / a\f$ clamped like internal::lerp_single clamps and \f$0\f$ if \f$a = 0\f$.
+inline void unpremultiply_single(const float *x, float *z, std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    const __m128 rgb = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    for (; i < n; ++i)
+    {
+        const __m128 c = _mm_loadu_ps(x + 4 * i), a = broadcast_a_ps(c);
+        __m128 v = _mm_min_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_setzero_ps(), _mm_div_ps(c, a)));
+        v = _mm_and_ps(v, _mm_cmpgt_ps(a, _mm_setzero_ps()));
+        _mm_storeu_ps(z + 4 * i, _mm_or_ps(_mm_and_ps(rgb, v), _mm_andnot_ps(rgb, c)));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        const float a = x[4 * i + 3];
+        for (std::size_t k = 0; k < 3; ++k)
+        { z[4 * i + k] = a > 0.0f ? type::clamped_single_traits::range().clamp(x[4 * i + k] / a) : 0.0f; }
+        z[4 * i + 3] = a;
+    }
+}
+
+} } // namespace idlib::internal
+
+namespace idlib {
+
+/// @brief Composite the colors of two spans of colors with premultiplied alpha.
+/// @tparam ColorSpace the color space
+/// @param op the compositing operator
+/// @param x the span of source colors
+/// @param y the span of destination colors
+/// @param z the span of the composited colors. May be @a x or @a y.
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throws invalid_argument_error @a x, @a y, and @a z have different sizes
+/// @throws invalid_argument_error @a op is not a compositing operator
+/// @detail
+/// The color spaces are RGBAb and RGBAf. The RGB components of the colors are premultiplied by their A component,
+/// see idlib::premultiply. Color \f$i\f$ of @a z is color \f$i\f$ of @a x composited onto color \f$i\f$ of @a y
+/// by the formula of @a op, see idlib::composite_operator, clamped to the range of the component values.
+/// For clamped single color spaces, the formulas are evaluated in single precision in the order they are given.
+/// For uint8 color spaces, each product of two components is \f$c_0 c_1 / 255\f$ exactly rounded and computed without division.
+/// The results of @a over, @a in, @a out, @a screen, and @a add are hence exactly rounded,
+/// the results of @a atop and @a exclusive_or are within one and the results of @a multiply are within 1.5 of the exact value.
+/// @remark Compositing a fully opaque source color over any color yields the source color,
+/// compositing a fully transparent source color over any color yields the destination color.
+template <typename ColorSpace>
+void composite(composite_operator op, span<const color<ColorSpace>> x, span<const color<ColorSpace>> y, span<color<ColorSpace>> z, std::size_t thread_count = 0)
+{
+    static_assert(is_any_of<ColorSpace, RGBAb, RGBAf>::value, "unsupported color space");
+    if (x.size() != y.size() || x.size() != z.size())
+    { throw invalid_argument_error(__FILE__, __LINE__, "x, y, and z have different sizes"); }
+    // Raise invalid operators before any thread is started.
+    if (op < composite_operator::over || op > composite_operator::add)
+    { throw invalid_argument_error(__FILE__, __LINE__, "unknown compositing operator"); }
+    const auto *p = internal::get_components(x), *q = internal::get_components(y);
+    auto *r = internal::get_components(z);
+    if (thread_count == 0) thread_count = get_default_thread_count();
+    parallel_for(0, z.size(), internal::composite_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+    { internal::composite(op, p + b * 4, q + b * 4, r + b * 4, e - b); });
+}
+
+/// @brief Convert a span of colors with straight alpha to a span of colors with premultiplied alpha.
+/// @tparam ColorSpace the color space
+/// @param x the span of colors with straight alpha
+/// @param z the span of colors with premultiplied alpha. May be @a x.
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throws invalid_argument_error @a x and @a z have different sizes
+/// @detail
+/// The color spaces are RGBAb and RGBAf.
+/// The RGB components are multiplied by the A component, the A component is retained.
+/// For uint8 color spaces, the product \f$c a / 255\f$ is exactly rounded and computed without division.
+template <typename ColorSpace>
+void premultiply(span<const color<ColorSpace>> x, span<color<ColorSpace>> z, std::size_t thread_count = 0)
+{
+    static_assert(is_any_of<ColorSpace, RGBAb, RGBAf>::value, "unsupported color space");
+    if (x.size() != z.size())
+    { throw invalid_argument_error(__FILE__, __LINE__, "x and z have different sizes"); }
+    const auto *p = internal::get_components(x);
+    auto *r = internal::get_components(z);
+    if (thread_count == 0) thread_count = get_default_thread_count();
+    parallel_for(0, z.size(), internal::composite_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+    {
+        if constexpr (std::is_same<ColorSpace, RGBAb>::value)
+        { internal::premultiply_uint8(p + b * 4, r + b * 4, e - b); }
+        else
+        { internal::premultiply_single(p + b * 4, r + b * 4, e - b); }
+    });
+}
+
+/// @brief Convert a span of colors with premultiplied alpha to a span of colors with straight alpha.
+/// @tparam ColorSpace the color space
+/// @param x the span of colors with premultiplied alpha
+/// @param z the span of colors with straight alpha. May be @a x.
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throws invalid_argument_error @a x and @a z have different sizes
+/// @detail
+/// The color spaces are RGBAb and RGBAf.
+/// The RGB components are divided by the A component and clamped to the range of the component values, the A component is retained.
+/// The RGB components of fully transparent colors become @a 0.
+/// For uint8 color spaces, the quotient \f$c \cdot 255 / a\f$ is exactly rounded and computed by a table of reciprocals.
+template <typename ColorSpace>
+void unpremultiply(span<const color<ColorSpace>> x, span<color<ColorSpace>> z, std::size_t thread_count = 0)
+{
+    static_assert(is_any_of<ColorSpace, RGBAb, RGBAf>::value, "unsupported color space");
+    if (x.size() != z.size())
+    { throw invalid_argument_error(__FILE__, __LINE__, "x and z have different sizes"); }
+    const auto *p = internal::get_components(x);
+    auto *r = internal::get_components(z);
+    if (thread_count == 0) thread_count = get_default_thread_count();
+    parallel_for(0, z.size(), internal::composite_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+    {
+        if constexpr (std::is_same<ColorSpace, RGBAb>::value)
+        { internal::unpremultiply_uint8(p + b * 4, r + b * 4, e - b); }
+        else
+        { internal::unpremultiply_single(p + b * 4, r + b * 4, e - b); }
+    });
+}
+
+} // namespace idlib
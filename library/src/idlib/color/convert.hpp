@@ -0,0 +1,334 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/color/convert.hpp
+/// @brief Conversion of spans of colors between color spaces.
+/// @author Michael Heilmann
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/idlib.hpp` instead)
+#endif
+
+#include "idlib/color/color.hpp"
+#include "idlib/color/srgb.hpp"
+#include "idlib/math/simd.hpp"
+#include "idlib/range/span.hpp"
+#include "idlib/utility/is_any_of.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#include "idlib/type.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace idlib { namespace internal {
+
+/// @brief The minimal number of colors per thread of the color conversions.
+constexpr std::size_t convert_colors_grain = 65536;
+
+/// @brief The number of colors per block of color conversions which convert and reorder in separate passes.
+constexpr std::size_t convert_colors_block = 256;
+
+/// @brief Get the syntax of the components of a color space.
+/// @remark All components of the color spaces supported by the color conversions have the same syntax.
+template <typename ColorSpace>
+struct component_syntax;
+
+template <typename Semantics, typename Syntax, typename Transfer, typename ... Components>
+struct component_syntax<space<component<Semantics, Syntax, 0, Transfer>, Components ...>>
+{ using type = Syntax; };
+
+/// @brief Get the uint8 to clamped single table.
+/// @return the table of the 256 values type::convert<type::clamped_single_traits, type::uint8_traits> maps the uint8 values to
+/// @remark The table is filled by the scalar conversion and hence reproduces it bit by bit.
+inline const std::array<float, 256>& get_uint8_to_clamped_single_table()
+{
+    static const std::array<float, 256> table = []()
+    {
+        std::array<float, 256> t;
+        for (std::size_t i = 0; i < t.size(); ++i)
+        { t[i] = type::convert<type::clamped_single_traits, type::uint8_traits>()(static_cast<std::uint8_t>(i)); }
+        return t;
+    }();
+    return table;
+}
+
+#if defined(IDLIB_WITH_SSE2)
+/// @brief Convert four clamped single values to four int32 values within the range from 0 (inclusive) to 256 (inclusive).
+/// @remark Multiplication by 256 is exact and truncation is flooring for non-negative values.
+/// NaN values are mapped to 0 as @a _mm_max_ps returns its second operand if any operand is NaN.
+inline __m128i convert_clamped_single_to_int32(__m128 x)
+{
+    x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(256.0f)));
+}
+#endif
+
+/// @brief Convert @a n clamped single values to uint8 values.
+/// @param x a pointer to the clamped single values
+/// @param y a pointer to the uint8 values
+/// @param n the number of values
+/// @detail
+/// The result is identical to type::convert<type::uint8_traits, type::clamped_single_traits> for values within the range from 0 (inclusive) to 1 (inclusive):
+/// That conversion computes \f$\lfloor 256 x \rfloor\f$ for \f$x < 1\f$ and maps \f$1\f$ to \f$255\f$.
+/// The SIMD kernels compute \f$\lfloor 256 x \rfloor\f$ for all values and rely on unsigned saturation when packing to map \f$256\f$ to \f$255\f$.
+inline void convert_clamped_single_to_uint8(const float *x, std::uint8_t *y, std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_AVX)
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f), scale = _mm256_set1_ps(256.0f);
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(x + i + 0), zero), one),
+                     b = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(x + i + 8), zero), one);
+        const __m256i p = _mm256_cvttps_epi32(_mm256_mul_ps(a, scale)),
+                      q = _mm256_cvttps_epi32(_mm256_mul_ps(b, scale));
+        const __m128i s = _mm_packs_epi32(_mm256_castsi256_si128(p), _mm256_extractf128_si256(p, 1)),
+                      t = _mm_packs_epi32(_mm256_castsi256_si128(q), _mm256_extractf128_si256(q, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(y + i), _mm_packus_epi16(s, t));
+    }
+#elif defined(IDLIB_WITH_SSE2)
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i s = _mm_packs_epi32(convert_clamped_single_to_int32(_mm_loadu_ps(x + i + 0)),
+                                          convert_clamped_single_to_int32(_mm_loadu_ps(x + i + 4))),
+                      t = _mm_packs_epi32(convert_clamped_single_to_int32(_mm_loadu_ps(x + i + 8)),
+                                          convert_clamped_single_to_int32(_mm_loadu_ps(x + i + 12)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(y + i), _mm_packus_epi16(s, t));
+    }
+#endif
+    for (; i < n; ++i)
+    { y[i] = type::convert<type::uint8_traits, type::clamped_single_traits>()(x[i]); }
+}
+
+/// @brief Convert @a n uint8 values to clamped single values.
+/// @param x a pointer to the uint8 values
+/// @param y a pointer to the clamped single values
+/// @param n the number of values
+inline void convert_uint8_to_clamped_single(const std::uint8_t *x, float *y, std::size_t n)
+{
+    const auto& table = get_uint8_to_clamped_single_table();
+    for (std::size_t i = 0; i < n; ++i)
+    { y[i] = table[x[i]]; }
+}
+
+/// @brief Convert colors of a source color space to colors of a target color space.
+/// @tparam TargetColorSpace the target color space
+/// @tparam SourceColorSpace the source color space
+/// @detail
+/// The component values of a target color are determined as follows:
+/// - the RGB components are the RGB components of the source color or, if the source color space is an L color space, the L component,
+/// - the L component is the L component of the source color,
+/// - the A component is the A component of the source color or, if the source color space has no A component, maximal opacity.
+/// Component values are converted by the scalar conversions type::convert.
+/// RGB component values of sRGB color spaces are decoded by internal::get_srgb_decode_table and encoded by internal::srgb_encode_uint8.
+template <typename TargetColorSpace, typename SourceColorSpace>
+struct color_converter
+{
+    using target_syntax = typename component_syntax<TargetColorSpace>::type;
+    using source_syntax = typename component_syntax<SourceColorSpace>::type;
+    using target_component = typename target_syntax::underlying_type;
+    using source_component = typename source_syntax::underlying_type;
+
+    static constexpr std::size_t target_count = TargetColorSpace::count;
+    static constexpr std::size_t source_count = SourceColorSpace::count;
+
+    static_assert(!(TargetColorSpace::has_l && SourceColorSpace::has_rgb), "conversion from RGB color spaces to L color spaces is not supported");
+
+    static constexpr bool is_target_srgb = is_srgb<TargetColorSpace>::value;
+    static constexpr bool is_source_srgb = is_srgb<SourceColorSpace>::value;
+
+    static_assert(is_target_srgb == is_source_srgb || !std::is_same<target_syntax, source_syntax>::value,
+                  "conversion between sRGB and linear color spaces with the same component syntax is not supported");
+
+    /// @brief Get the index of the source component a target component is determined by.
+    /// @param k the index of the target component
+    /// @return the index of the source component or @a source_count if the target component is maximal opacity
+    static constexpr std::size_t get_source_index(std::size_t k)
+    {
+        if (TargetColorSpace::has_a && k + 1 == target_count)
+        { return SourceColorSpace::has_a ? source_count - 1 : source_count; }
+        return (TargetColorSpace::has_rgb && SourceColorSpace::has_l) ? 0 : k;
+    }
+
+    /// @brief If target colors and source colors have the same components.
+    static constexpr bool is_componentwise = target_count == source_count;
+
+    /// @brief Reorder the components of @a n colors.
+    /// @param x a pointer to the first component of the first source color
+    /// @param y a pointer to the first component of the first target color
+    /// @param n the number of colors
+    /// @param opaque the value of an A component of maximal opacity
+    /// @param f the conversion of a component value and the index of its source component
+    template <typename X, typename Y, typename F>
+    static void reorder(const X *x, Y *y, std::size_t n, Y opaque, F&& f)
+    {
+        for (std::size_t i = 0; i < n; ++i, x += source_count, y += target_count)
+        {
+            for (std::size_t k = 0; k < target_count; ++k)
+            {
+                const std::size_t j = get_source_index(k);
+                y[k] = j < source_count ? f(x[j], j) : opaque;
+            }
+        }
+    }
+
+    /// @brief Convert @a n colors.
+    /// @param x a pointer to the first component of the first source color
+    /// @param y a pointer to the first component of the first target color
+    /// @param n the number of colors
+    void operator()(const source_component *x, target_component *y, std::size_t n) const
+    {
+        if constexpr (std::is_same<target_syntax, source_syntax>::value)
+        {
+            if constexpr (is_componentwise)
+            { std::copy(x, x + n * source_count, y); }
+            else
+            { reorder(x, y, n, target_syntax::range().max(), [](source_component v, std::size_t) { return v; }); }
+        }
+        else if constexpr (std::is_same<target_syntax, type::clamped_single_traits>::value)
+        {
+            if constexpr (is_componentwise && !is_source_srgb)
+            { convert_uint8_to_clamped_single(x, y, n * source_count); }
+            else
+            {
+                const auto& table = get_uint8_to_clamped_single_table();
+                const auto& srgb_table = get_srgb_decode_table();
+                reorder(x, y, n, target_syntax::range().max(), [&table, &srgb_table](source_component v, std::size_t j)
+                {
+                    const bool is_a = SourceColorSpace::has_a && j + 1 == source_count;
+                    return (is_source_srgb && !is_a) ? srgb_table[v] : table[v];
+                });
+            }
+        }
+        else if constexpr (is_target_srgb)
+        {
+            if constexpr (is_componentwise)
+            { srgb_encode_uint8<target_count, TargetColorSpace::has_a>(x, y, n * target_count); }
+            else
+            {
+                // Reorder a block to a temporary of the target layout, then encode the block.
+                std::array<float, convert_colors_block * target_count> t;
+                for (std::size_t i = 0; i < n; i += convert_colors_block)
+                {
+                    const std::size_t m = std::min(convert_colors_block, n - i);
+                    reorder(x + i * source_count, t.data(), m, source_syntax::range().max(), [](float v, std::size_t) { return v; });
+                    srgb_encode_uint8<target_count, TargetColorSpace::has_a>(t.data(), y + i * target_count, m * target_count);
+                }
+            }
+        }
+        else
+        {
+            if constexpr (is_componentwise)
+            { convert_clamped_single_to_uint8(x, y, n * source_count); }
+            else
+            {
+                // Convert a block to a temporary of the source layout, then reorder the block.
+                std::array<std::uint8_t, convert_colors_block * source_count> t;
+                for (std::size_t i = 0; i < n; i += convert_colors_block)
+                {
+                    const std::size_t m = std::min(convert_colors_block, n - i);
+                    convert_clamped_single_to_uint8(x + i * source_count, t.data(), m * source_count);
+                    reorder(t.data(), y + i * target_count, m, target_syntax::range().max(), [](std::uint8_t v, std::size_t) { return v; });
+                }
+            }
+        }
+    }
+};
+
+/// @brief Get a pointer to the first component of the first color of a span of colors.
+template <typename ColorSpace>
+auto get_components(span<color<ColorSpace>> colors)
+{
+    using component_type = typename component_syntax<ColorSpace>::type::underlying_type;
+    static_assert(std::is_standard_layout<color<ColorSpace>>::value &&
+                  sizeof(color<ColorSpace>) == ColorSpace::count * sizeof(component_type), "unsupported color layout");
+    return reinterpret_cast<component_type *>(colors.data());
+}
+
+template <typename ColorSpace>
+auto get_components(span<const color<ColorSpace>> colors)
+{
+    using component_type = typename component_syntax<ColorSpace>::type::underlying_type;
+    static_assert(std::is_standard_layout<color<ColorSpace>>::value &&
+                  sizeof(color<ColorSpace>) == ColorSpace::count * sizeof(component_type), "unsupported color layout");
+    return reinterpret_cast<const component_type *>(colors.data());
+}
+
+/// @brief Get a pointer to the first component of a color.
+template <typename ColorSpace>
+auto get_components(const color<ColorSpace>& c)
+{ return get_components(span<const color<ColorSpace>>(&c, 1)); }
+
+template <typename ColorSpace>
+auto get_components(color<ColorSpace>& c)
+{ return get_components(span<color<ColorSpace>>(&c, 1)); }
+
+} } // namespace idlib::internal
+
+namespace idlib {
+
+/// @brief Convert a span of colors to a span of colors of another color space.
+/// @tparam TargetColorSpace the target color space
+/// @tparam SourceColorSpace the source color space
+/// @param source the source colors
+/// @param target the target colors
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throws invalid_argument_error @a source and @a target have different sizes
+/// @detail
+/// The color spaces are any of Lb, LAb, RGBb, RGBAb, Lf, LAf, RGBf, RGBAf, sRGBb, and sRGBAb.
+/// Component values are converted exactly like type::convert converts them, that is,
+/// the result is identical to converting colors one by one with the conversion constructors of the colors.
+/// Additionally, L colors are converted to RGB colors by replicating the L component
+/// and colors without an A component are converted to colors with an A component of maximal opacity.
+/// Conversions from colors with an A component to colors without an A component drop the A component.
+/// Conversions from RGB colors to L colors are not supported.
+/// sRGB colors are converted from and to clamped single colors only.
+/// Their RGB components are decoded exactly and encoded with rounding to the nearest uint8 value,
+/// unlike the linear uint8 conversion which floors.
+/// @remark uint8 values are converted to clamped single values by table lookup,
+/// clamped single values are converted to uint8 values by SIMD kernels if available.
+template <typename TargetColorSpace, typename SourceColorSpace>
+void convert_colors(span<const color<SourceColorSpace>> source, span<color<TargetColorSpace>> target, std::size_t thread_count = 0)
+{
+    static_assert(is_any_of<TargetColorSpace, Lb, LAb, RGBb, RGBAb, Lf, LAf, RGBf, RGBAf, sRGBb, sRGBAb>::value, "unsupported target color space");
+    static_assert(is_any_of<SourceColorSpace, Lb, LAb, RGBb, RGBAb, Lf, LAf, RGBf, RGBAf, sRGBb, sRGBAb>::value, "unsupported source color space");
+    if (source.size() != target.size())
+    { throw invalid_argument_error(__FILE__, __LINE__, "source and target have different sizes"); }
+    using converter_type = internal::color_converter<TargetColorSpace, SourceColorSpace>;
+    const auto *x = internal::get_components(source);
+    auto *y = internal::get_components(target);
+    if (thread_count == 0) thread_count = get_default_thread_count();
+    parallel_for(0, source.size(), internal::convert_colors_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+    {
+        converter_type()(x + b * converter_type::source_count, y + b * converter_type::target_count, e - b);
+    });
+}
+
+} // namespace idlib
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/color/expression.hpp
+/// @brief Adaption of RGB and RGBA colors to expression templates.
+/// @author Michael Heilmann
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/idlib.hpp` instead)
+#endif
+
+#include "idlib/color/rgb.hpp"
+#include "idlib/color/rgba.hpp"
+#include "idlib/math/expression.hpp"
+
+namespace idlib {
+
+namespace internal {
+
+/// @brief Implementation of idlib::expression_traits for RGB and RGBA colors.
+/// The component operations are the saturating component operations of the color space
+/// i.e. the results are identical to the results of the operators of idlib::color.
+template <typename ColorSpace, size_t Size>
+struct color_expression_traits
+{
+	using value_type = color<ColorSpace>;
+
+	static constexpr size_t size()
+	{ return Size; }
+
+	template <size_t I, typename = void>
+	struct component;
+
+	template <typename E>
+	struct component<0, E> { using type = typename ColorSpace::r; };
+
+	template <typename E>
+	struct component<1, E> { using type = typename ColorSpace::g; };
+
+	template <typename E>
+	struct component<2, E> { using type = typename ColorSpace::b; };
+
+	template <typename E>
+	struct component<3, E> { using type = typename ColorSpace::a; };
+
+	template <size_t I>
+	using syntax = typename component<I>::type::syntax;
+
+	template <size_t I>
+	using component_type = typename syntax<I>::underlying_type;
+
+	template <size_t I>
+	static component_type<I> get(const value_type& x)
+	{
+		if constexpr (I == 0) return x.get_r();
+		else if constexpr (I == 1) return x.get_g();
+		else if constexpr (I == 2) return x.get_b();
+		else return x.get_a();
+	}
+
+	template <typename ... Cs>
+	static value_type make(const Cs& ... cs)
+	{ return value_type(cs ...); }
+
+	template <size_t I>
+	static component_type<I> add(const component_type<I>& x, const component_type<I>& y)
+	{ return type::add<syntax<I>>()(x, y); }
+
+	template <size_t I>
+	static component_type<I> subtract(const component_type<I>& x, const component_type<I>& y)
+	{ return type::subtract<syntax<I>>()(x, y); }
+
+}; // struct color_expression_traits
+
+} // namespace internal
+
+template <typename ColorSpace>
+struct expression_traits<color<ColorSpace>, std::enable_if_t<internal::is_rgb<ColorSpace>::value>>
+	: internal::color_expression_traits<ColorSpace, 3>
+{};
+
+template <typename ColorSpace>
+struct expression_traits<color<ColorSpace>, std::enable_if_t<internal::is_rgba<ColorSpace>::value>>
+	: internal::color_expression_traits<ColorSpace, 4>
+{};
+
+} // namespace idlib
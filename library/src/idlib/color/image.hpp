@@ -0,0 +1,468 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/color/image.hpp
+/// @brief Images of colors.
+/// @author Michael Heilmann
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/idlib.hpp` instead)
+#endif
+
+#include "idlib/color/color.hpp"
+#include "idlib/color/convert.hpp"
+#include "idlib/file_system/mapped_file.hpp"
+#include "idlib/file_system/error.hpp"
+#include "idlib/range/span.hpp"
+#include "idlib/utility/aligned_allocator.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#include "idlib/utility/out_of_bounds_error.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace idlib {
+
+/// @brief The storage layouts of images.
+enum class image_layout
+{
+    /// @brief The pixels of a row are adjacent colors.
+    interleaved,
+    /// @brief The values of each component are stored in a plane of their own.
+    planar,
+};
+
+} // namespace idlib
+
+namespace idlib { namespace internal {
+
+/// @brief The alignment, in Bytes, of the rows of images.
+constexpr std::size_t image_row_alignment = 64;
+
+/// @brief The minimal number of pixels per thread of the image algorithms.
+constexpr std::size_t image_grain = 65536;
+
+/// @brief Get the type of the elements of the rows of an image.
+template <typename ColorSpace, image_layout Layout>
+struct image_element
+{ using type = color<ColorSpace>; };
+
+template <typename ColorSpace>
+struct image_element<ColorSpace, image_layout::planar>
+{ using type = typename component_syntax<ColorSpace>::type::underlying_type; };
+
+/// @brief Get the stride of the rows of an image.
+/// @param width the width of the image
+/// @return the smallest multiple of the number of elements which occupy a multiple of internal::image_row_alignment Bytes not smaller than @a width
+template <typename T>
+constexpr std::size_t get_image_stride(std::size_t width)
+{
+    constexpr std::size_t n = image_row_alignment / std::gcd(image_row_alignment, sizeof(T));
+    return (width + n - 1) / n * n;
+}
+
+} } // namespace idlib::internal
+
+namespace idlib {
+
+/// @brief A view on the pixels of an image.
+/// @tparam ColorSpace the color space of the pixels
+/// @tparam Layout the storage layout of the pixels
+/// @tparam IsConst if the pixels can only be read through the view
+/// @detail
+/// A view does not own the pixels. Like a span, it is cheap to copy and does not propagate constness to the pixels.
+/// Mutable views implicitly convert to constant views.
+/// </br>
+/// The pixels of the rows are stored at the indices \f$[0, w)\f$ of the rows.
+/// Row \f$y\f$ of a plane starts at index \f$y \cdot s\f$ where \f$s \geq w\f$ is the stride of the view.
+/// Plane \f$k\f$ of a planar view starts at index \f$k \cdot t\f$ where \f$t\f$ is the plane stride of the view.
+template <typename ColorSpace, image_layout Layout = image_layout::interleaved, bool IsConst = false>
+class image_view
+{
+public:
+    /// @brief The color type.
+    using color_type = color<ColorSpace>;
+
+    /// @brief The component type.
+    using component_type = typename internal::component_syntax<ColorSpace>::type::underlying_type;
+
+    /// @brief The element type i.e. the color type for interleaved images and the component type for planar images.
+    /// The element type is const-qualified for constant views.
+    using element_type = std::conditional_t<IsConst, const typename internal::image_element<ColorSpace, Layout>::type,
+                                                     typename internal::image_element<ColorSpace, Layout>::type>;
+
+    /// @brief The storage layout.
+    static constexpr image_layout layout = Layout;
+
+    /// @brief The number of planes.
+    static constexpr std::size_t plane_count = Layout == image_layout::interleaved ? 1 : ColorSpace::count;
+
+private:
+    element_type *m_data;
+    std::size_t m_width;
+    std::size_t m_height;
+    std::size_t m_stride;
+    std::size_t m_plane_stride;
+
+public:
+    /// @brief Construct this view as an empty view.
+    image_view() :
+        m_data(nullptr), m_width(0), m_height(0), m_stride(0), m_plane_stride(0)
+    {}
+
+    /// @brief Construct this view.
+    /// @param data a pointer to the first element of the first row of the first plane
+    /// @param width, height the width and the height
+    /// @param stride the number of elements from the start of a row to the start of the next row
+    /// @param plane_stride the number of elements from the start of a plane to the start of the next plane.
+    /// Ignored for interleaved views.
+    /// @throws invalid_argument_error @a stride is smaller than @a width or @a plane_stride is smaller than the number of elements of a plane
+    image_view(element_type *data, std::size_t width, std::size_t height, std::size_t stride, std::size_t plane_stride = 0) :
+        m_data(data), m_width(width), m_height(height), m_stride(stride),
+        m_plane_stride(Layout == image_layout::interleaved ? 0 : plane_stride)
+    {
+        if (stride < width)
+        { throw invalid_argument_error(__FILE__, __LINE__, "stride is smaller than width"); }
+        if (Layout == image_layout::planar && height > 0 && plane_stride < (height - 1) * stride + width)
+        { throw invalid_argument_error(__FILE__, __LINE__, "plane stride is smaller than a plane"); }
+    }
+
+    /// @brief Construct this constant view from a mutable view.
+    /// @param other the mutable view
+    template <bool OtherIsConst, typename = std::enable_if_t<IsConst && !OtherIsConst>>
+    image_view(const image_view<ColorSpace, Layout, OtherIsConst>& other) :
+        m_data(other.data()), m_width(other.width()), m_height(other.height()), m_stride(other.stride()),
+        m_plane_stride(other.plane_stride())
+    {}
+
+    /// @brief Get the width of this view.
+    /// @return the width of this view
+    std::size_t width() const
+    { return m_width; }
+
+    /// @brief Get the height of this view.
+    /// @return the height of this view
+    std::size_t height() const
+    { return m_height; }
+
+    /// @brief Get the stride of this view.
+    /// @return the number of elements from the start of a row to the start of the next row
+    std::size_t stride() const
+    { return m_stride; }
+
+    /// @brief Get the plane stride of this view.
+    /// @return the number of elements from the start of a plane to the start of the next plane, @a 0 for interleaved views
+    std::size_t plane_stride() const
+    { return m_plane_stride; }
+
+    /// @brief Get if this view is empty.
+    /// @return @a true if the width or the height of this view is @a 0, @a false otherwise
+    bool empty() const
+    { return 0 == m_width || 0 == m_height; }
+
+    /// @brief Get a pointer to the first element of the first row of the first plane of this view.
+    /// @return a pointer to the first element of the first row of the first plane of this view
+    element_type *data() const
+    { return m_data; }
+
+    /// @brief Get a row of this interleaved view.
+    /// @param y the index of the row
+    /// @return the colors of the row
+    span<element_type> row(std::size_t y) const
+    {
+        static_assert(Layout == image_layout::interleaved, "not an interleaved view");
+        assert(y < m_height);
+        return span<element_type>(m_data + y * m_stride, m_width);
+    }
+
+    /// @brief Get a row of a plane of this planar view.
+    /// @param k the index of the plane
+    /// @param y the index of the row
+    /// @return the component values of the row
+    span<element_type> row(std::size_t k, std::size_t y) const
+    {
+        static_assert(Layout == image_layout::planar, "not a planar view");
+        assert(k < plane_count && y < m_height);
+        return span<element_type>(m_data + k * m_plane_stride + y * m_stride, m_width);
+    }
+
+    /// @brief Get the color of a pixel of this interleaved view.
+    /// @param x, y the coordinates of the pixel
+    /// @return a reference to the color of the pixel
+    element_type& operator()(std::size_t x, std::size_t y) const
+    {
+        static_assert(Layout == image_layout::interleaved, "not an interleaved view");
+        assert(x < m_width && y < m_height);
+        return m_data[y * m_stride + x];
+    }
+
+    /// @brief Get the color of a pixel.
+    /// @param x, y the coordinates of the pixel
+    /// @return the color of the pixel
+    color_type get(std::size_t x, std::size_t y) const
+    {
+        assert(x < m_width && y < m_height);
+        if constexpr (Layout == image_layout::interleaved)
+        { return m_data[y * m_stride + x]; }
+        else
+        {
+            color_type c;
+            component_type *p = internal::get_components(c);
+            for (std::size_t k = 0; k < plane_count; ++k)
+            { p[k] = m_data[k * m_plane_stride + y * m_stride + x]; }
+            return c;
+        }
+    }
+
+    /// @brief Set the color of a pixel.
+    /// @param x, y the coordinates of the pixel
+    /// @param c the color
+    void set(std::size_t x, std::size_t y, const color_type& c) const
+    {
+        static_assert(!IsConst, "not a mutable view");
+        assert(x < m_width && y < m_height);
+        if constexpr (Layout == image_layout::interleaved)
+        { m_data[y * m_stride + x] = c; }
+        else
+        {
+            const component_type *p = internal::get_components(c);
+            for (std::size_t k = 0; k < plane_count; ++k)
+            { m_data[k * m_plane_stride + y * m_stride + x] = p[k]; }
+        }
+    }
+
+    /// @brief Get a view on a rectangle of the pixels of this view.
+    /// @param x, y the coordinates of the upper left pixel of the rectangle
+    /// @param width, height the width and the height of the rectangle
+    /// @return the view on the rectangle
+    /// @throws out_of_bounds_error the rectangle is not within the bounds of this view
+    /// @remark The pixels are not copied.
+    image_view view(std::size_t x, std::size_t y, std::size_t width, std::size_t height) const
+    {
+        if (x > m_width || width > m_width - x || y > m_height || height > m_height - y)
+        { throw out_of_bounds_error(__FILE__, __LINE__, "rectangle out of bounds"); }
+        return image_view(m_data + y * m_stride + x, width, height, m_stride, m_plane_stride);
+    }
+
+}; // class image_view
+
+/// @brief An image.
+/// @tparam ColorSpace the color space of the pixels
+/// @tparam Layout the storage layout of the pixels
+/// @detail
+/// The first element of every row is aligned to internal::image_row_alignment Bytes.
+/// The pixels are either stored in memory or in a memory mapped file.
+/// The pixels of an image stored in memory are initialized to the default color of the color space.
+/// The storage of an image stored in a memory mapped file is the storage of the view, including the padding of the rows.
+template <typename ColorSpace, image_layout Layout = image_layout::interleaved>
+class image
+{
+public:
+    /// @brief The view type.
+    using view_type = image_view<ColorSpace, Layout>;
+
+    /// @brief The constant view type.
+    using const_view_type = image_view<ColorSpace, Layout, true>;
+
+    /// @brief The color type.
+    using color_type = typename view_type::color_type;
+
+    /// @brief The element type.
+    using element_type = typename view_type::element_type;
+
+private:
+    std::vector<element_type, aligned_allocator<element_type, internal::image_row_alignment>> m_elements;
+    std::unique_ptr<file_system::mapped_file_descriptor> m_file;
+    view_type m_view;
+
+    static std::size_t get_plane_stride(std::size_t width, std::size_t height)
+    { return internal::get_image_stride<element_type>(width) * height; }
+
+public:
+    /// @brief Construct this image as an empty image.
+    image() :
+        m_elements(), m_file(), m_view()
+    {}
+
+    /// @brief Construct this image stored in memory.
+    /// @param width, height the width and the height
+    image(std::size_t width, std::size_t height) :
+        m_elements(view_type::plane_count * get_plane_stride(width, height)), m_file(), m_view()
+    {
+        const std::size_t plane_stride = get_plane_stride(width, height);
+        if constexpr (Layout == image_layout::planar)
+        {
+            const color_type c;
+            const auto *p = internal::get_components(c);
+            for (std::size_t k = 0; k < view_type::plane_count; ++k)
+            { std::fill(m_elements.begin() + k * plane_stride, m_elements.begin() + (k + 1) * plane_stride, p[k]); }
+        }
+        m_view = view_type(m_elements.data(), width, height, internal::get_image_stride<element_type>(width), plane_stride);
+    }
+
+    /// @brief Construct this image stored in a memory mapped file.
+    /// @param width, height the width and the height
+    /// @param pathname the pathname of the file
+    /// @throws file_system::error the file can not be created, resized or mapped
+    /// @remark If the file exists, it is resized to the size of the storage. Its contents are kept up to that size.
+    /// If the file does not exist, it is created. Its contents are zeroes.
+    image(std::size_t width, std::size_t height, const std::string& pathname) :
+        m_elements(), m_file(std::make_unique<file_system::mapped_file_descriptor>()), m_view()
+    {
+        const std::size_t plane_stride = get_plane_stride(width, height);
+        const std::size_t size = view_type::plane_count * plane_stride * sizeof(element_type);
+        if (0 == size)
+        { return; }
+        m_file->open_write(pathname, file_system::create_mode::create_not_existing, size);
+        if (!m_file->is_open())
+        { throw file_system::error(__FILE__, __LINE__, "unable to map file `" + pathname + "`"); }
+        m_view = view_type(reinterpret_cast<element_type *>(m_file->data()), width, height,
+                           internal::get_image_stride<element_type>(width), plane_stride);
+    }
+
+    image(image&&) = default;
+    image& operator=(image&&) = default;
+
+    // Delete copy constructor.
+    image(const image&) = delete;
+
+    // Delete copy assignment operator.
+    image& operator=(const image&) = delete;
+
+    /// @brief Get a view on all pixels of this image.
+    /// @return the view
+    const view_type& view()
+    { return m_view; }
+
+    /// @brief Get a constant view on all pixels of this image.
+    /// @return the constant view
+    const_view_type view() const
+    { return m_view; }
+
+    /// @brief Get the width of this image.
+    /// @return the width of this image
+    std::size_t width() const
+    { return m_view.width(); }
+
+    /// @brief Get the height of this image.
+    /// @return the height of this image
+    std::size_t height() const
+    { return m_view.height(); }
+
+    /// @brief Get the stride of this image.
+    /// @return the number of elements from the start of a row to the start of the next row
+    std::size_t stride() const
+    { return m_view.stride(); }
+
+    /// @brief Get if this image is stored in a memory mapped file.
+    /// @return @a true if this image is stored in a memory mapped file, @a false otherwise
+    bool is_mapped() const
+    { return nullptr != m_file; }
+
+    /// @brief Get the color of a pixel.
+    /// @param x, y the coordinates of the pixel
+    /// @return the color of the pixel
+    color_type get(std::size_t x, std::size_t y) const
+    { return m_view.get(x, y); }
+
+}; // class image
+
+/// @brief Replace the color of each pixel of a view by the result of a function applied to it.
+/// @param view the view
+/// @param f the function @code{color<ColorSpace> f(const color<ColorSpace>&)}
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @detail
+/// The rows are distributed over the threads.
+/// For example, @code{transform_pixels(v, [](const auto& c) { return idlib::brighten(c, 0.25f); })} brightens the pixels.
+template <typename ColorSpace, image_layout Layout, typename F>
+void transform_pixels(const image_view<ColorSpace, Layout>& view, F&& f, std::size_t thread_count = 0)
+{
+    if (view.empty())
+    { return; }
+    if (thread_count == 0) thread_count = get_default_thread_count();
+    const std::size_t grain = std::max<std::size_t>(1, internal::image_grain / view.width());
+    parallel_for(0, view.height(), grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+    {
+        for (std::size_t y = b; y < e; ++y)
+        {
+            if constexpr (Layout == image_layout::interleaved)
+            {
+                for (auto& c : view.row(y))
+                { c = f(c); }
+            }
+            else
+            {
+                for (std::size_t x = 0; x < view.width(); ++x)
+                { view.set(x, y, f(view.get(x, y))); }
+            }
+        }
+    });
+}
+
+/// @brief Copy the pixels of a view to another view.
+/// @param source the source view
+/// @param target the target view
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throws invalid_argument_error the views have different widths or heights
+/// @remark The views may have different layouts. They must not overlap. The source view may be a constant view.
+template <typename ColorSpace, image_layout SourceLayout, bool SourceIsConst, image_layout TargetLayout>
+void copy_pixels(const image_view<ColorSpace, SourceLayout, SourceIsConst>& source, const image_view<ColorSpace, TargetLayout>& target, std::size_t thread_count = 0)
+{
+    if (source.width() != target.width() || source.height() != target.height())
+    { throw invalid_argument_error(__FILE__, __LINE__, "source and target have different sizes"); }
+    if (source.empty())
+    { return; }
+    if (thread_count == 0) thread_count = get_default_thread_count();
+    const std::size_t grain = std::max<std::size_t>(1, internal::image_grain / source.width());
+    parallel_for(0, source.height(), grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+    {
+        for (std::size_t y = b; y < e; ++y)
+        {
+            if constexpr (SourceLayout == TargetLayout)
+            {
+                for (std::size_t k = 0; k < source.plane_count; ++k)
+                {
+                    const auto *p = source.data() + k * source.plane_stride() + y * source.stride();
+                    std::copy(p, p + source.width(), target.data() + k * target.plane_stride() + y * target.stride());
+                }
+            }
+            else
+            {
+                for (std::size_t x = 0; x < source.width(); ++x)
+                { target.set(x, y, source.get(x, y)); }
+            }
+        }
+    });
+}
+
+} // namespace idlib
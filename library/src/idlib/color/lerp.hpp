@@ -0,0 +1,290 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/color/lerp.hpp
+/// @brief Linear interpolation of spans of colors.
+/// @author Michael Heilmann
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/idlib.hpp` instead)
+#endif
+
+#include "idlib/color/color.hpp"
+#include "idlib/color/convert.hpp"
+#include "idlib/math/mu.hpp"
+#include "idlib/math/simd.hpp"
+#include "idlib/range/span.hpp"
+#include "idlib/utility/is_any_of.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace idlib { namespace internal {
+
+/// @brief The minimal number of colors per thread of the interpolation algorithms.
+constexpr std::size_t lerp_grain = 65536;
+
+/// @brief The number of colors per block of the gradient algorithms.
+constexpr std::size_t lerp_block = 256;
+
+/// @brief Get the fixed-point weight of uint8 interpolation.
+/// @param mu the interpolation parameter
+/// @return \f$w = \lfloor 256 \mu + \frac{1}{2} \rfloor\f$, within the range from 0 (inclusive) to 256 (inclusive)
+inline std::uint16_t get_lerp_weight(const mu<float>& mu)
+{ return static_cast<std::uint16_t>(std::floor(mu.get_mu() * 256.0f + 0.5f)); }
+
+/// @brief Lineary interpolate between two uint8 values.
+/// @param x, y the values
+/// @param w the fixed-point weight of @a y
+/// @return \f$\lfloor (x (256 - w) + y w + 128) / 256 \rfloor\f$
+/// @remark The result is @a x for \f$w = 0\f$ and @a y for \f$w = 256\f$.
+/// All intermediate values are within the range of uint16.
+inline std::uint8_t lerp_uint8(std::uint8_t x, std::uint8_t y, std::uint16_t w)
+{ return static_cast<std::uint8_t>((x * (256 - w) + y * w + 128) >> 8); }
+
+/// @brief Lineary interpolate between two clamped single values.
+/// @param x, y the values
+/// @param one_minus_mu, mu the weights of @a x and @a y
+/// @return the same value as type::clamped_single_traits::range().clamp(lineary_interpolate(x, y, mu))
+inline float lerp_single(float x, float y, float one_minus_mu, float mu)
+{ return type::clamped_single_traits::range().clamp(x * one_minus_mu + y * mu); }
+
+#if defined(IDLIB_WITH_SSE2)
+/// @brief internal::lerp_uint8 for eight uint8 values zero-extended to uint16 values.
+inline __m128i lerp_epu16(__m128i x, __m128i y, __m128i w)
+{
+    const __m128i v = _mm_sub_epi16(_mm_set1_epi16(256), w);
+    const __m128i s = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(x, v), _mm_mullo_epi16(y, w)), _mm_set1_epi16(128));
+    return _mm_srli_epi16(s, 8);
+}
+
+/// @brief internal::lerp_single for four clamped single values.
+/// @remark The operand order of @a _mm_max_ps and @a _mm_min_ps reproduces idlib::clamp for signed zeroes and NaN values.
+inline __m128 lerp_ps(__m128 x, __m128 y, __m128 one_minus_mu, __m128 mu)
+{
+    const __m128 v = _mm_add_ps(_mm_mul_ps(x, one_minus_mu), _mm_mul_ps(y, mu));
+    return _mm_min_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_setzero_ps(), v));
+}
+#endif
+
+/// @brief Lineary interpolate between @a n uint8 values with a single weight.
+inline void lerp_uint8(const std::uint8_t *x, const std::uint8_t *y, std::uint16_t w, std::uint8_t *z, std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    const __m128i zero = _mm_setzero_si128(), u = _mm_set1_epi16(static_cast<short>(w));
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i)),
+                      b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + i));
+        const __m128i p = lerp_epu16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero), u),
+                      q = lerp_epu16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero), u);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(z + i), _mm_packus_epi16(p, q));
+    }
+#endif
+    for (; i < n; ++i)
+    { z[i] = lerp_uint8(x[i], y[i], w); }
+}
+
+/// @brief Lineary interpolate between @a n uint8 values with one weight per value.
+inline void lerp_uint8(const std::uint8_t *x, const std::uint8_t *y, const std::uint16_t *w, std::uint8_t *z, std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i)),
+                      b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + i));
+        const __m128i p = lerp_epu16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i + 0))),
+                      q = lerp_epu16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + i + 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(z + i), _mm_packus_epi16(p, q));
+    }
+#endif
+    for (; i < n; ++i)
+    { z[i] = lerp_uint8(x[i], y[i], w[i]); }
+}
+
+/// @brief Lineary interpolate between @a n clamped single values with a single pair of weights.
+inline void lerp_single(const float *x, const float *y, float one_minus_mu, float mu, float *z, std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    const __m128 u = _mm_set1_ps(one_minus_mu), v = _mm_set1_ps(mu);
+    for (; i + 4 <= n; i += 4)
+    { _mm_storeu_ps(z + i, lerp_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i), u, v)); }
+#endif
+    for (; i < n; ++i)
+    { z[i] = lerp_single(x[i], y[i], one_minus_mu, mu); }
+}
+
+/// @brief Lineary interpolate between @a n clamped single values with one pair of weights per value.
+inline void lerp_single(const float *x, const float *y, const float *one_minus_mu, const float *mu, float *z, std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(z + i, lerp_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i),
+                                     _mm_loadu_ps(one_minus_mu + i), _mm_loadu_ps(mu + i)));
+    }
+#endif
+    for (; i < n; ++i)
+    { z[i] = lerp_single(x[i], y[i], one_minus_mu[i], mu[i]); }
+}
+
+/// @brief Fill colors \f$b\f$ (inclusive) to \f$e\f$ (exclusive) of a gradient of \f$n\f$ colors.
+/// @param x, y pointers to the components of the first and the last color of the gradient
+/// @param z a pointer to the first component of the first color of the gradient
+template <std::size_t Count, typename T>
+void gradient(const T *x, const T *y, T *z, std::size_t b, std::size_t e, std::size_t n)
+{
+    // The colors at the ends of the gradient are repeated for a block such that the per-component kernels can be used.
+    std::array<T, lerp_block * Count> u, v;
+    for (std::size_t i = 0; i < lerp_block; ++i)
+    {
+        std::copy(x, x + Count, u.data() + i * Count);
+        std::copy(y, y + Count, v.data() + i * Count);
+    }
+    // The weight \f$\lfloor 256 j / (n - 1) + 1/2 \rfloor = \lfloor (512 j + n - 1) / d \rfloor\f$, \f$d = 2 (n - 1)\f$, of color \f$j\f$
+    // is maintained as a quotient and a remainder which are incremented by the quotient and the remainder of \f$512 / d\f$.
+    const std::uint64_t d = 2 * (n - 1);
+    std::uint64_t quotient = (512 * std::uint64_t(b) + n - 1) / d, remainder = (512 * std::uint64_t(b) + n - 1) % d;
+    for (; b < e; b += lerp_block)
+    {
+        const std::size_t m = std::min(lerp_block, e - b);
+        if constexpr (std::is_same<T, std::uint8_t>::value)
+        {
+            std::array<std::uint16_t, lerp_block * Count> w;
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                std::fill(w.data() + i * Count, w.data() + (i + 1) * Count, static_cast<std::uint16_t>(quotient));
+                quotient += 512 / d;
+                remainder += 512 % d;
+                if (remainder >= d)
+                {
+                    quotient++;
+                    remainder -= d;
+                }
+            }
+            lerp_uint8(u.data(), v.data(), w.data(), z + b * Count, m * Count);
+        }
+        else
+        {
+            std::array<float, lerp_block * Count> s, t;
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                // The weights of mu<float>(j / (n - 1)) for the index \f$j\f$ of the color.
+                const float c = static_cast<float>(b + i) / static_cast<float>(n - 1);
+                std::fill(s.data() + i * Count, s.data() + (i + 1) * Count, 1.0f - c);
+                std::fill(t.data() + i * Count, t.data() + (i + 1) * Count, c);
+            }
+            lerp_single(u.data(), v.data(), s.data(), t.data(), z + b * Count, m * Count);
+        }
+    }
+}
+
+} } // namespace idlib::internal
+
+namespace idlib {
+
+/// @brief Lineary interpolate between the colors of two spans of colors.
+/// @tparam ColorSpace the color space
+/// @param x, y the spans of colors to interpolate between
+/// @param mu the interpolation parameter
+/// @param z the span of the interpolated colors. May be @a x or @a y.
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throws invalid_argument_error @a x, @a y, and @a z have different sizes
+/// @detail
+/// The color spaces are any of Lb, LAb, RGBb, RGBAb, Lf, LAf, RGBf, and RGBAf.
+/// For clamped single color spaces, the result is identical to idlib::lineary_interpolate of the colors.
+/// For uint8 color spaces, the components are interpolated in fixed-point:
+/// Given the weight \f$w = \lfloor 256 \mu + \frac{1}{2} \rfloor\f$,
+/// the interpolated component value is \f$\lfloor (x (256 - w) + y w + 128) / 256 \rfloor\f$.
+/// It differs from the exactly rounded value by at most one.
+template <typename ColorSpace>
+void lerp(span<const color<ColorSpace>> x, span<const color<ColorSpace>> y, const mu<float>& mu, span<color<ColorSpace>> z, std::size_t thread_count = 0)
+{
+    static_assert(is_any_of<ColorSpace, Lb, LAb, RGBb, RGBAb, Lf, LAf, RGBf, RGBAf>::value, "unsupported color space");
+    if (x.size() != y.size() || x.size() != z.size())
+    { throw invalid_argument_error(__FILE__, __LINE__, "x, y, and z have different sizes"); }
+    const auto *p = internal::get_components(x), *q = internal::get_components(y);
+    auto *r = internal::get_components(z);
+    constexpr std::size_t count = ColorSpace::count;
+    if (thread_count == 0) thread_count = get_default_thread_count();
+    if constexpr (std::is_same<typename internal::component_syntax<ColorSpace>::type, type::uint8_traits>::value)
+    {
+        const std::uint16_t w = internal::get_lerp_weight(mu);
+        parallel_for(0, z.size(), internal::lerp_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+        { internal::lerp_uint8(p + b * count, q + b * count, w, r + b * count, (e - b) * count); });
+    }
+    else
+    {
+        parallel_for(0, z.size(), internal::lerp_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+        { internal::lerp_single(p + b * count, q + b * count, mu.get_one_minus_mu(), mu.get_mu(), r + b * count, (e - b) * count); });
+    }
+}
+
+/// @brief Fill a span of colors with a gradient.
+/// @tparam ColorSpace the color space
+/// @param x, y the first and the last color of the gradient
+/// @param z the span of colors
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throws invalid_argument_error @a z has more than 2^24 colors
+/// @detail
+/// Color \f$j\f$ of \f$n > 1\f$ colors is interpolated between @a x and @a y with \f$\mu = j / (n - 1)\f$
+/// as idlib::lerp interpolates.
+/// If \f$n = 1\f$ then the color is @a x.
+/// For clamped single color spaces, \f$\mu\f$ is @code{float(j) / float(n - 1)}.
+/// For uint8 color spaces, the weight is computed exactly in integer arithmetic.
+template <typename ColorSpace>
+void gradient(const color<ColorSpace>& x, const color<ColorSpace>& y, span<color<ColorSpace>> z, std::size_t thread_count = 0)
+{
+    static_assert(is_any_of<ColorSpace, Lb, LAb, RGBb, RGBAb, Lf, LAf, RGBf, RGBAf>::value, "unsupported color space");
+    // Beyond 2^24, consecutive indices are not distinct single values.
+    if (z.size() > (std::size_t(1) << 24))
+    { throw invalid_argument_error(__FILE__, __LINE__, "too many colors"); }
+    if (z.size() < 2)
+    {
+        std::fill(z.begin(), z.end(), x);
+        return;
+    }
+    const auto *p = internal::get_components(x), *q = internal::get_components(y);
+    auto *r = internal::get_components(z);
+    if (thread_count == 0) thread_count = get_default_thread_count();
+    parallel_for(0, z.size(), internal::lerp_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+    { internal::gradient<ColorSpace::count>(p, q, r, b, e, z.size()); });
+}
+
+} // namespace idlib
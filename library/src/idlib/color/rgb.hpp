@@ -40,6 +40,7 @@
 #include "idlib/utility/is_any_of.hpp"
 #include "idlib/color/brighten.hpp"
 #include "idlib/color/darken.hpp"
+#include "idlib/color/srgb.hpp"
 #include "idlib/type.hpp"
 
 namespace idlib {
@@ -204,12 +205,37 @@ public:
     template<typename ThisColorSpace = ColorSpace, typename OtherColorSpace>
     explicit color(const color<OtherColorSpace>& other,
                    typename std::enable_if<!std::is_same<ThisColorSpace, OtherColorSpace>::value &&
+                                           !internal::is_srgb<ThisColorSpace>::value &&
                                            is_any_of<OtherColorSpace, RGBb, RGBf>::value, int *>::type = nullptr) :
         r(type::convert<typename color_space_type::r::syntax, typename OtherColorSpace::r::syntax>()(other.get_r())),
         g(type::convert<typename color_space_type::g::syntax, typename OtherColorSpace::g::syntax>()(other.get_g())),
         b(type::convert<typename color_space_type::b::syntax, typename OtherColorSpace::b::syntax>()(other.get_b()))
     {}
 
+    /// @brief Encode construct this sRGB byte color from an RGB clamped float color.
+    /// @param other the RGB clamped float color
+    /// @remark The RGB components are encoded like internal::srgb_encode_uint8, hence the result is identical to convert_colors.
+    template<typename ThisColorSpace = ColorSpace, typename OtherColorSpace>
+    explicit color(const color<OtherColorSpace>& other,
+                   typename std::enable_if<std::is_same<ThisColorSpace, sRGBb>::value &&
+                                           std::is_same<OtherColorSpace, RGBf>::value, int *>::type = nullptr) :
+        r(internal::srgb_encode_uint8(other.get_r())),
+        g(internal::srgb_encode_uint8(other.get_g())),
+        b(internal::srgb_encode_uint8(other.get_b()))
+    {}
+
+    /// @brief Decode construct this RGB clamped float color from an sRGB byte color.
+    /// @param other the sRGB byte color
+    /// @remark The RGB components are decoded by internal::get_srgb_decode_table, hence the result is identical to convert_colors.
+    template<typename ThisColorSpace = ColorSpace, typename OtherColorSpace>
+    explicit color(const color<OtherColorSpace>& other,
+                   typename std::enable_if<std::is_same<ThisColorSpace, RGBf>::value &&
+                                           std::is_same<OtherColorSpace, sRGBb>::value, int *>::type = nullptr) :
+        r(internal::get_srgb_decode_table()[other.get_r()]),
+        g(internal::get_srgb_decode_table()[other.get_g()]),
+        b(internal::get_srgb_decode_table()[other.get_b()])
+    {}
+
     /// @brief Convert construct this RGB byte color from an L byte color.
     /// @param other L byte color
     template<typename ThisColorSpace = ColorSpace, typename OtherColorSpace>
@@ -238,6 +264,10 @@ public:
     {}
 
 public:
+    /// @brief Copy construct this color from another color.
+    /// @param other the other color
+    color(const color& other) = default;
+
     /// @brief Assign this color from another color.
     /// @param other the other color
     /// @return this color
@@ -40,6 +40,7 @@
 #include "idlib/utility/is_any_of.hpp"
 #include "idlib/color/brighten.hpp"
 #include "idlib/color/darken.hpp"
+#include "idlib/color/srgb.hpp"
 #include "idlib/type.hpp"
 
 namespace idlib {
@@ -218,6 +219,7 @@ public:
     template<typename ThisColorSpace = ColorSpace, typename OtherColorSpace>
     explicit color(const color<OtherColorSpace>& other,
                    typename std::enable_if<!std::is_same<ThisColorSpace, OtherColorSpace>::value &&
+                                           !internal::is_srgb<ThisColorSpace>::value &&
                                            is_any_of<OtherColorSpace, RGBAb, RGBAf>::value, int *>::type = nullptr) :
         r(type::convert<typename color_space_type::r::syntax, typename OtherColorSpace::r::syntax>()(other.get_r())),
         g(type::convert<typename color_space_type::g::syntax, typename OtherColorSpace::g::syntax>()(other.get_g())),
@@ -225,6 +227,32 @@ public:
         a(type::convert<typename color_space_type::a::syntax, typename OtherColorSpace::a::syntax>()(other.get_a()))
     {}
 
+    /// @brief Encode construct this sRGBA byte color from an RGBA clamped float color.
+    /// @param other the RGBA clamped float color
+    /// @remark The RGB components are encoded like internal::srgb_encode_uint8 and the A component is converted like internal::linear_encode_uint8, hence the result is identical to convert_colors.
+    template<typename ThisColorSpace = ColorSpace, typename OtherColorSpace>
+    explicit color(const color<OtherColorSpace>& other,
+                   typename std::enable_if<std::is_same<ThisColorSpace, sRGBAb>::value &&
+                                           std::is_same<OtherColorSpace, RGBAf>::value, int *>::type = nullptr) :
+        r(internal::srgb_encode_uint8(other.get_r())),
+        g(internal::srgb_encode_uint8(other.get_g())),
+        b(internal::srgb_encode_uint8(other.get_b())),
+        a(internal::linear_encode_uint8(other.get_a()))
+    {}
+
+    /// @brief Decode construct this RGBA clamped float color from an sRGBA byte color.
+    /// @param other the sRGBA byte color
+    /// @remark The RGB components are decoded by internal::get_srgb_decode_table, hence the result is identical to convert_colors.
+    template<typename ThisColorSpace = ColorSpace, typename OtherColorSpace>
+    explicit color(const color<OtherColorSpace>& other,
+                   typename std::enable_if<std::is_same<ThisColorSpace, RGBAf>::value &&
+                                           std::is_same<OtherColorSpace, sRGBAb>::value, int *>::type = nullptr) :
+        r(internal::get_srgb_decode_table()[other.get_r()]),
+        g(internal::get_srgb_decode_table()[other.get_g()]),
+        b(internal::get_srgb_decode_table()[other.get_b()]),
+        a(type::convert<typename color_space_type::a::syntax, typename OtherColorSpace::a::syntax>()(other.get_a()))
+    {}
+
     /// @brief Construct this RGBA clamped float color from an LA clamped float color.
     /// @param other the LA clamped float color
     template<typename ThisColorSpace = ColorSpace, typename OtherColorSpace>
@@ -281,6 +309,10 @@ public:
     }
 
 public:
+    /// @brief Copy construct this color from another color.
+    /// @param other the other color
+    color(const color& other) = default;
+
     /// @brief Assign this color from another color.
     /// @param other the other color
     /// @return this color
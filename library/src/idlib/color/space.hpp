@@ -47,11 +47,21 @@ struct l {};
 
 }
 
-template <typename Semantics, typename Syntax, size_t Index>
+namespace transfer {
+
+/// @brief "linear": the component value is proportional to the intensity.
+struct linear {};
+/// @brief "sRGB": the component value is the intensity encoded by the sRGB transfer function (IEC 61966-2-1).
+struct srgb {};
+
+}
+
+template <typename Semantics, typename Syntax, size_t Index, typename Transfer = transfer::linear>
 struct component
 { 
     using semantics = Semantics;
     using syntax = Syntax;
+    using transfer_function = Transfer;
     static constexpr size_t index = Index;
 };
 
@@ -335,6 +345,88 @@ using RGBAb = space<component<semantics::r, type::uint8_traits, 0>,
                     component<semantics::b, type::uint8_traits, 2>,
                     component<semantics::a, type::uint8_traits, 3>>;
 
+/// @brief The type of an RGB color space with unsigned integer components each within the range from 0 (inclusive) to 255 (inclusive)
+/// encoding the intensities by the sRGB transfer function.
+/// A component value of 0 indicates minimal intensity of the component and 255 indicates maximal intensity of the component.
+template <>
+struct space<component<semantics::r, type::uint8_traits, 0, transfer::srgb>,
+             component<semantics::g, type::uint8_traits, 1, transfer::srgb>,
+             component<semantics::b, type::uint8_traits, 2, transfer::srgb>>
+{
+    /// @brief The R component.
+    using r = component<semantics::r, type::uint8_traits, 0, transfer::srgb>;
+
+    /// @brief The G component.
+    using g = component<semantics::g, type::uint8_traits, 1, transfer::srgb>;
+
+    /// @brief The B component.
+    using b = component<semantics::b, type::uint8_traits, 2, transfer::srgb>;
+
+    /// @brief If the color space has RGB components.
+    /// @return @a true if the color space has RGB components, @a false otherwise
+    static constexpr bool has_rgb = true;
+
+    /// @brief If the color space has an A component.
+    /// @return @a true if the color space has an A component, @a false otherwise
+    static constexpr bool has_a = false;
+
+    /// @brief If the color space has an L component.
+    /// @return @a true if the color space has an L component, @a false otherwise
+    static constexpr bool has_l = false;
+
+    /// @brief The number of components of a color in the color space.
+    /// @return the number of components of a color in the color space
+    static constexpr size_t count = 3;
+};
+
+using sRGBb = space<component<semantics::r, type::uint8_traits, 0, transfer::srgb>,
+                    component<semantics::g, type::uint8_traits, 1, transfer::srgb>,
+                    component<semantics::b, type::uint8_traits, 2, transfer::srgb>>;
+
+/// @brief The type of an RGBA color space with unsigned integer components each within the range from 0 (inclusive) to 255 (inclusive)
+/// encoding the intensities of the RGB components by the sRGB transfer function.
+/// A component value of 0 indicates minimal intensity of the component and 255 indicates maximal intensity of the component.
+/// The A component is linear.
+template <>
+struct space<component<semantics::r, type::uint8_traits, 0, transfer::srgb>,
+             component<semantics::g, type::uint8_traits, 1, transfer::srgb>,
+             component<semantics::b, type::uint8_traits, 2, transfer::srgb>,
+             component<semantics::a, type::uint8_traits, 3>>
+{
+    /// @brief The R component.
+    using r = component<semantics::r, type::uint8_traits, 0, transfer::srgb>;
+
+    /// @brief The G component.
+    using g = component<semantics::g, type::uint8_traits, 1, transfer::srgb>;
+
+    /// @brief The B component.
+    using b = component<semantics::b, type::uint8_traits, 2, transfer::srgb>;
+
+    /// @brief The A component.
+    using a = component<semantics::a, type::uint8_traits, 3>;
+
+    /// @brief If the color space has RGB components.
+    /// @return @a true if the color space has RGB components, @a false otherwise
+    static constexpr bool has_rgb = true;
+
+    /// @brief If the color space has an A component.
+    /// @return @a true if the color space has an A component, @a false otherwise
+    static constexpr bool has_a = true;
+
+    /// @brief If the color space has an L component.
+    /// @return @a true if the color space has an L component, @a false otherwise
+    static constexpr bool has_l = false;
+
+    /// @brief The number of components in the color space.
+    /// @return the number of components of a color in the color space
+    static constexpr size_t count = 4;
+};
+
+using sRGBAb = space<component<semantics::r, type::uint8_traits, 0, transfer::srgb>,
+                     component<semantics::g, type::uint8_traits, 1, transfer::srgb>,
+                     component<semantics::b, type::uint8_traits, 2, transfer::srgb>,
+                     component<semantics::a, type::uint8_traits, 3>>;
+
 /// @brief The type of an A color space with floating-point components each within the range from 0 (inclusive) to 1 (inclusive).
 /// A component value of 0 indicates minimal intensity of the component and 1 indicates maximal intensity of the component.
 template <>
@@ -410,6 +502,10 @@ template <>
 struct pure_opacity_space<LAf>
 { using type = Af; };
 
+template <>
+struct pure_opacity_space<sRGBAb>
+{ using type = Ab; };
+
 template <typename ColorSpace>
 using pure_opacity_space_t = typename pure_opacity_space<ColorSpace>::type;
 
@@ -450,6 +546,14 @@ template <>
 struct pure_color_space<LAf>
 { using type = Lf; };
 
+template <>
+struct pure_color_space<sRGBb>
+{ using type = sRGBb; };
+
+template <>
+struct pure_color_space<sRGBAb>
+{ using type = sRGBb; };
+
 template <typename ColorSpace>
 using pure_color_space_t = typename pure_color_space<ColorSpace>::type;
 
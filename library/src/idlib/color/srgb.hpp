@@ -0,0 +1,233 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/color/srgb.hpp
+/// @brief The sRGB transfer function.
+/// @author Michael Heilmann
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/idlib.hpp` instead)
+#endif
+
+#include "idlib/color/space.hpp"
+#include "idlib/math/simd.hpp"
+#include "idlib/type.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace idlib { namespace internal {
+
+/// @brief Get if the RGB components of a color space are encoded by the sRGB transfer function.
+/// @remark The A component of a color space is always linear.
+template <typename ColorSpace, typename Enabled = void>
+struct is_srgb
+{ static constexpr bool value = false; };
+
+template <typename ColorSpace>
+struct is_srgb<ColorSpace, std::enable_if_t<ColorSpace::has_rgb>>
+{ static constexpr bool value = std::is_same<typename ColorSpace::r::transfer_function, transfer::srgb>::value; };
+
+/// @brief Decode an sRGB encoded value.
+/// @param v the encoded value within the range from 0 (inclusive) to 1 (inclusive)
+/// @return the linear value
+inline double srgb_decode(double v)
+{ return v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4); }
+
+/// @brief Encode a linear value by the sRGB transfer function.
+/// @param x the linear value within the range from 0 (inclusive) to 1 (inclusive)
+/// @return the encoded value
+inline double srgb_encode(double x)
+{ return x <= 0.0031308 ? 12.92 * x : 1.055 * std::pow(x, 1.0 / 2.4) - 0.055; }
+
+/// @brief Get the sRGB decode table.
+/// @return the table of the linear values of the 256 sRGB encoded uint8 values \f$q\f$,
+/// that is, internal::srgb_decode(q / 255) correctly rounded to single
+inline const std::array<float, 256>& get_srgb_decode_table()
+{
+    static const std::array<float, 256> table = []()
+    {
+        std::array<float, 256> t;
+        for (std::size_t q = 0; q < t.size(); ++q)
+        { t[q] = static_cast<float>(srgb_decode(q / 255.0)); }
+        return t;
+    }();
+    return table;
+}
+
+/// @brief Get the sRGB encode thresholds.
+/// @return the table of the smallest linear single values \f$x\f$ which are encoded to the uint8 values \f$q > 0\f$,
+/// that is, \f$\lfloor 255 \cdot \mathrm{srgb\_encode}(x) + \frac{1}{2} \rfloor \geq q\f$. Element @a 0 is @a 0.
+inline const std::array<float, 256>& get_srgb_encode_thresholds()
+{
+    static const std::array<float, 256> table = []()
+    {
+        std::array<float, 256> t;
+        t[0] = 0.0f;
+        const float one = 1.0f;
+        std::uint32_t end;
+        std::memcpy(&end, &one, sizeof(float));
+        for (std::size_t q = 1; q < t.size(); ++q)
+        {
+            // Binary search over the bit patterns of the non-negative single values which are ordered like the values.
+            std::uint32_t lower = 0, upper = end;
+            while (lower < upper)
+            {
+                const std::uint32_t middle = lower + (upper - lower) / 2;
+                float x;
+                std::memcpy(&x, &middle, sizeof(float));
+                if (255.0 * srgb_encode(x) + 0.5 >= static_cast<double>(q)) upper = middle;
+                else lower = middle + 1;
+            }
+            std::memcpy(&t[q], &lower, sizeof(float));
+        }
+        return t;
+    }();
+    return table;
+}
+
+/// @brief Encode a linear clamped single value by the sRGB transfer function to an uint8 value.
+/// @param x the linear value
+/// @return \f$\lfloor 255 \cdot \mathrm{srgb\_encode}(x) + \frac{1}{2} \rfloor\f$
+/// @remark The value is clamped to the range from 0 (inclusive) to 1 (inclusive). NaN is clamped to 0.
+inline std::uint8_t srgb_encode_uint8(float x)
+{
+    if (!(x > 0.0f))
+    { return 0; }
+    const auto& t = get_srgb_encode_thresholds();
+    return static_cast<std::uint8_t>(std::upper_bound(t.begin() + 1, t.end(), x) - (t.begin() + 1));
+}
+
+/// @brief Convert a linear clamped single value to an uint8 value like type::convert<type::uint8_traits, type::clamped_single_traits>.
+/// @param x the linear value
+/// @return \f$\min(\lfloor 256 \cdot x \rfloor, 255)\f$
+/// @remark The value is clamped to the range from 0 (inclusive) to 1 (inclusive). NaN is clamped to 0.
+inline std::uint8_t linear_encode_uint8(float x)
+{ return type::convert<type::uint8_traits, type::clamped_single_traits>()(x > 0.0f ? std::min(x, 1.0f) : 0.0f); }
+
+#if defined(IDLIB_WITH_SSE2)
+/// @brief Approximate \f$255 \cdot \mathrm{srgb\_encode}(x)\f$ for four values within the range from 0 (inclusive) to 1 (inclusive).
+/// @detail
+/// \f$x^{1/2.4}\f$ is computed as \f$2^{\log_2(x) / 2.4}\f$ where
+/// \f$\log_2\f$ is computed from the exponent and an atanh series of the mantissa and
+/// \f$2^y\f$ is computed from the integer part of \f$y\f$ and a Taylor polynomial of the fractional part.
+/// An exhaustive test of all single values within the range from 0 (inclusive) to 1 (inclusive) yields an absolute error below \f$10^{-4}\f$.
+inline __m128 srgb_encode_ps(__m128 x)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    // \f$x = m 2^e\f$ with \f$m \in [\sqrt{2}/2, \sqrt{2}]\f$.
+    const __m128i bits = _mm_castps_si128(x);
+    const __m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+    const __m128 large = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356f));
+    m = _mm_sub_ps(m, _mm_and_ps(large, _mm_mul_ps(m, _mm_set1_ps(0.5f))));
+    const __m128 ef = _mm_add_ps(_mm_cvtepi32_ps(e), _mm_and_ps(large, one));
+    // \f$\log_2(m) = \frac{2}{\ln 2} \mathrm{atanh}(t)\f$ with \f$t = (m - 1) / (m + 1)\f$.
+    const __m128 t = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+    const __m128 t2 = _mm_mul_ps(t, t);
+    __m128 p = _mm_add_ps(_mm_set1_ps(1.0f / 5.0f), _mm_mul_ps(t2, _mm_set1_ps(1.0f / 7.0f)));
+    p = _mm_add_ps(_mm_set1_ps(1.0f / 3.0f), _mm_mul_ps(t2, p));
+    p = _mm_add_ps(one, _mm_mul_ps(t2, p));
+    const __m128 y = _mm_mul_ps(_mm_add_ps(ef, _mm_mul_ps(_mm_mul_ps(t, p), _mm_set1_ps(2.0f / 0.69314718f))), _mm_set1_ps(1.0f / 2.4f));
+    // \f$2^y = 2^n \sqrt{2} e^{g \ln 2}\f$ with \f$n = \lfloor y \rfloor\f$ and \f$g = y - n - 1/2\f$.
+    __m128 n = _mm_cvtepi32_ps(_mm_cvttps_epi32(y));
+    n = _mm_sub_ps(n, _mm_and_ps(_mm_cmpgt_ps(n, y), one));
+    const __m128 g = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(y, n), _mm_set1_ps(0.5f)), _mm_set1_ps(0.69314718f));
+    __m128 q = _mm_add_ps(_mm_set1_ps(1.0f / 120.0f), _mm_mul_ps(g, _mm_set1_ps(1.0f / 720.0f)));
+    q = _mm_add_ps(_mm_set1_ps(1.0f / 24.0f), _mm_mul_ps(g, q));
+    q = _mm_add_ps(_mm_set1_ps(1.0f / 6.0f), _mm_mul_ps(g, q));
+    q = _mm_add_ps(_mm_set1_ps(0.5f), _mm_mul_ps(g, q));
+    q = _mm_add_ps(one, _mm_mul_ps(g, q));
+    q = _mm_add_ps(one, _mm_mul_ps(g, q));
+    const __m128 s = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23));
+    const __m128 v = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(q, s), _mm_set1_ps(1.41421356f * 1.055f * 255.0f)), _mm_set1_ps(0.055f * 255.0f));
+    // The linear segment.
+    const __m128 small = _mm_cmple_ps(x, _mm_set1_ps(0.0031308f));
+    return _mm_or_ps(_mm_and_ps(small, _mm_mul_ps(x, _mm_set1_ps(12.92f * 255.0f))), _mm_andnot_ps(small, v));
+}
+#endif
+
+/// @brief Encode @a n linear clamped single values to uint8 values.
+/// @tparam Count the number of components of a color
+/// @tparam LinearA if the last component of a color is an A component which is not encoded
+/// @param x a pointer to the linear values
+/// @param y a pointer to the uint8 values
+/// @param n the number of values
+/// @detail
+/// RGB values are encoded like internal::srgb_encode_uint8, A values are converted like internal::linear_encode_uint8.
+/// The SIMD kernel rounds the approximation of internal::srgb_encode_ps.
+/// Four values at a time are encoded by internal::srgb_encode_uint8 instead if any of them is within \f$2^{-10}\f$ of a rounding boundary,
+/// which is more than ten times the error of the approximation. Hence the results are identical.
+template <std::size_t Count, bool LinearA>
+void srgb_encode_uint8(const float *x, std::uint8_t *y, std::size_t n)
+{
+    static_assert(!LinearA || Count == 4, "an A component which is not encoded is supported only for four components");
+    const auto encode = [](const float *x, std::size_t i)
+    {
+        return (LinearA && i % Count == Count - 1)
+             ? linear_encode_uint8(x[i])
+             : srgb_encode_uint8(x[i]);
+    };
+    std::size_t i = 0;
+#if defined(IDLIB_WITH_SSE2)
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f);
+    const __m128 band = _mm_set1_ps(1.0f / 1024.0f), band1 = _mm_set1_ps(1.0f - 1.0f / 1024.0f);
+    const __m128i linear = LinearA ? _mm_setr_epi32(0, 0, 0, -1) : _mm_setzero_si128();
+    const __m128 top = _mm_set1_ps(get_srgb_encode_thresholds()[255]);
+    const auto encode4 = [&](std::size_t j)
+    {
+        const __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(x + j), zero), one);
+        const __m128 r = _mm_add_ps(srgb_encode_ps(a), half);
+        __m128i q = _mm_cvttps_epi32(r);
+        const __m128 f = _mm_sub_ps(r, _mm_cvtepi32_ps(q));
+        const __m128i l = _mm_cvttps_epi32(_mm_mul_ps(a, _mm_set1_ps(256.0f)));
+        // Values encoded to 255, in particular 1, are at a rounding boundary of the approximation and are handled separately.
+        const __m128 saturated = _mm_cmpge_ps(a, top);
+        q = _mm_or_si128(_mm_and_si128(_mm_castps_si128(saturated), _mm_set1_epi32(255)), _mm_andnot_si128(_mm_castps_si128(saturated), q));
+        const __m128 ambiguous = _mm_andnot_ps(_mm_or_ps(saturated, _mm_castsi128_ps(linear)),
+                                               _mm_or_ps(_mm_cmplt_ps(f, band), _mm_cmpgt_ps(f, band1)));
+        if (_mm_movemask_ps(ambiguous))
+        { return _mm_setr_epi32(encode(x, j + 0), encode(x, j + 1), encode(x, j + 2), encode(x, j + 3)); }
+        // Values of 256 of the A component are saturated to 255 when packing.
+        return _mm_or_si128(_mm_and_si128(linear, l), _mm_andnot_si128(linear, q));
+    };
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m128i s = _mm_packs_epi32(encode4(i + 0), encode4(i + 4)),
+                      t = _mm_packs_epi32(encode4(i + 8), encode4(i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(y + i), _mm_packus_epi16(s, t));
+    }
+#endif
+    for (; i < n; ++i)
+    { y[i] = encode(x, i); }
+}
+
+} } // namespace idlib::internal
@@ -72,7 +72,8 @@ void file_descriptor_impl::open(const std::string& pathname, access_mode access_
     default:
         return;
     };
-    m_handle = ::open(pathname.c_str(), flags, 0);
+    // Created files are readable and writeable by everyone modulo the file mode creation mask.
+    m_handle = ::open(pathname.c_str(), flags, 0666);
 }
 
 bool file_descriptor_impl::is_open() const noexcept
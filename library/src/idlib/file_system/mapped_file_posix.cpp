@@ -27,6 +27,7 @@
 #if defined(ID_POSIX)
 
 #include <sys/mman.h>
+#include <unistd.h>
 
 #include "idlib/file_system/header.in"
 
@@ -51,13 +52,21 @@ void mapped_file_descriptor_impl::open_read(const std::string& pathname, create_
 void mapped_file_descriptor_impl::open_write(const std::string& pathname, create_mode create_mode, size_t size) noexcept
 {
     close();
-    m_file_descriptor.open(pathname, idlib::file_system::access_mode::write, create_mode);
+    // A shared writable mapping requires the file to be opened for reading and writing.
+    m_file_descriptor.open(pathname, idlib::file_system::access_mode::read_write, create_mode);
     if (!m_file_descriptor.is_open())
     {
         return;
     }
     m_size = size;
-    m_data = mmap(0, m_size, PROT_READ, MAP_SHARED, *((int *)m_file_descriptor.handle()), 0);
+    // Resize the file such that all pages of the mapping are backed by the file.
+    if (-1 == ftruncate(*((int *)m_file_descriptor.handle()), m_size))
+    {
+        errno = 0;
+        m_file_descriptor.close();
+        return;
+    }
+    m_data = mmap(0, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, *((int *)m_file_descriptor.handle()), 0);
     if (MAP_FAILED == m_data)
     {
         errno = 0;
@@ -79,7 +88,7 @@ void mapped_file_descriptor_impl::close() noexcept
         {
             perror("Error un-mmapping the file");
         }
-        m_data = NULL;
+        m_data = MAP_FAILED;
     }
     m_file_descriptor.close();
 }
@@ -37,6 +37,7 @@
 
 #include "idlib/math/sq.hpp"
 #include "idlib/math/sqrt.hpp"
+#include "idlib/math/abs.hpp"
 
 #include "idlib/math/semantic_cast.hpp"
 
@@ -57,6 +58,7 @@
 #include "idlib/math/one_zero.hpp"
 
 #include "idlib/math/random.hpp"
+#include "idlib/math/random_engine.hpp"
 
 #include "idlib/math/arithmetic_tuple.hpp"
 
@@ -67,7 +69,13 @@
 #include "idlib/math/enclose.hpp"
 #include "idlib/math/is_enclosing.hpp"
 #include "idlib/math/is_intersecting.hpp"
+#include "idlib/math/intersect.hpp"
 #include "idlib/math/translate.hpp"
 
 #include "idlib/math/point.hpp"
 #include "idlib/math/vector.hpp"
+#include "idlib/math/vector_batch.hpp"
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/quaternion.hpp"
+#include "idlib/math/quaternion_batch.hpp"
+#include "idlib/math/expression.hpp"
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/abs.hpp
+/// @brief "absolute value" functor and function
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/simd.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+
+namespace idlib {
+	
+/// @brief Functor computing the absolute value.
+/// @remark Specializations for signed integral types and floating-point types are provided.
+/// @tparam T the type
+/// @tparam E for SFINAE
+template <typename T, typename E = void>
+struct abs_functor;
+
+/// @brief The function corresponding to idlib::abs_functor.
+template <typename T>
+constexpr auto abs(const T& v)
+{ return abs_functor<T>()(v); }
+
+template <typename T>
+struct abs_functor<T, std::enable_if_t<std::is_floating_point<T>::value>>
+{
+	/// @remark In constant expressions, the sign of zero values is cleared explicitly.
+	/// The sign of NaN values is retained.
+	constexpr T operator()(T x) const
+	{
+		if (IDLIB_IS_CONSTANT_EVALUATED())
+		{ return x < T(0) ? -x : (x == T(0) ? T(0) : x); }
+		return std::abs(x);
+	}
+}; // struct abs_functor
+
+template <typename T>
+struct abs_functor<T, std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value>>
+{
+	constexpr T operator()(T x) const
+	{ return x < T(0) ? -x : x; }
+}; // struct abs_functor
+
+} // namespace idlib
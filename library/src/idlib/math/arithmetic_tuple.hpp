@@ -27,6 +27,7 @@
 #include "idlib/utility/fold_expressions.hpp"
 #include "idlib/math/operators.hpp"
 #include "idlib/math/one_zero.hpp"
+#include "idlib/math/arithmetic_tuple_kernel.hpp"
 #include <algorithm>
 
 namespace idlib {
@@ -57,6 +58,9 @@ using all_convertible = all_true<std::is_convertible<ArgumentTypes, TargetType>:
 /// @tparam S the size i.e. the number of element values
 /// A partial specialization for the size of @a 0 is provided.
 /// @tparam Z a functor type returning the zero element value
+/// @remark The storage layout and the element-wise operations are provided by idlib::internal::arithmetic_tuple_kernel.
+/// For @a single tuples of size @a 3 and @a 4 and @a double tuples of size @a 2 and @a 4 these are SIMD-backed if SIMD is available.
+/// Their results are bit-identical to the results of the scalar implementation.
 template <typename E, std::size_t S, typename Z>
 struct arithmetic_tuple
 {
@@ -69,14 +73,26 @@ public:
 	constexpr static std::size_t size() noexcept
 	{ return S; }
 
-private:	
+private:
+	/// @brief The kernel type.
+	using kernel_type = internal::arithmetic_tuple_kernel<E, S>;
+
+	/// @brief The kernel type used in constant expressions.
+	/// Selects the @a constexpr scalar implementation of the primary template.
+	using constant_kernel_type = internal::arithmetic_tuple_kernel<E, S, bool>;
+
 	/// @brief The elements.
-	E m_elements[S];
+	/// The elements from index S (inclusive) to index kernel_type::capacity (exclusive) are padding.
+	alignas(kernel_type::alignment) E m_elements[kernel_type::capacity];
 	
 public:
 	/// @brief Default construct with the zero element value.
-	arithmetic_tuple()
-	{ std::fill_n(&(m_elements[0]), S, Z()()); }
+	constexpr arithmetic_tuple() :
+		m_elements{}
+	{
+		for (std::size_t i = 0; i < S; ++i)
+		{ m_elements[i] = Z()(); }
+	}
 	
 	/// @brief Construct this tuple with the specified element values.
 	/// @param first, ... rest the element values
@@ -85,112 +101,112 @@ public:
 	template<typename A, typename ... As,
              typename =  std::enable_if_t<((1 + sizeof...(As)) == S) &&
 										  (all_convertible<E, typename std::decay<A>::type>::value && all_convertible<E, typename std::decay<As>::type...>::value)>>
-	arithmetic_tuple(A&& a, As&& ... as) :
-        m_elements{ static_cast<E>(a), static_cast<E>(as) ... }
-    { static_assert(S == 1 + sizeof ... (as), "wrong number of arguments"); }
-
-	arithmetic_tuple(const arithmetic_tuple& other) = default;
-	arithmetic_tuple(arithmetic_tuple&& other) = default;
-	arithmetic_tuple& operator=(const arithmetic_tuple& other) = default;
-	arithmetic_tuple& operator=(arithmetic_tuple&& other) = default;
-	
-private:
-	template <std::size_t ... Is>
-	static arithmetic_tuple<E, S, Z> unary_minus(const arithmetic_tuple& a, std::index_sequence<Is...>)
-	{ return arithmetic_tuple<E, S, Z>((-a.m_elements[Is])...); }
-	
-	template <std::size_t ... Is>
-	static arithmetic_tuple<E, S, Z> unary_plus(const arithmetic_tuple& a, std::index_sequence<Is...>)
-	{ return arithmetic_tuple<E, S, Z>((+a.m_elements[Is])...); }
+	constexpr arithmetic_tuple(A&& a, As&& ... as) :
+        m_elements{}
+    {
+		static_assert(S == 1 + sizeof ... (as), "wrong number of arguments");
+		// Write all elements at once such that a subsequent vector load of the elements is not stalled.
+		if (IDLIB_IS_CONSTANT_EVALUATED()) constant_kernel_type::set(m_elements, static_cast<E>(a), static_cast<E>(as) ...);
+		else kernel_type::set(m_elements, static_cast<E>(a), static_cast<E>(as) ...);
+	}
+
+	constexpr arithmetic_tuple(const arithmetic_tuple& other) = default;
+	constexpr arithmetic_tuple(arithmetic_tuple&& other) = default;
+	constexpr arithmetic_tuple& operator=(const arithmetic_tuple& other) = default;
+	constexpr arithmetic_tuple& operator=(arithmetic_tuple&& other) = default;
 	
 public:
-    arithmetic_tuple<E, S, Z> operator+() const
-    { return unary_plus(*this, std::make_index_sequence<S>{}); }
+    constexpr arithmetic_tuple<E, S, Z> operator+() const
+    { return *this; }
 
-    arithmetic_tuple<E, S, Z> operator-() const
-    { return unary_minus(*this, std::make_index_sequence<S>{}); }
+    constexpr arithmetic_tuple<E, S, Z> operator-() const
+    {
+		auto t = *this;
+		if (IDLIB_IS_CONSTANT_EVALUATED()) constant_kernel_type::negate(t.m_elements);
+		else kernel_type::negate(t.m_elements);
+		return t;
+	}
 	
-private:
-	template <std::size_t ... Is>
-	static arithmetic_tuple<E, S, Z> add(const arithmetic_tuple& a, const arithmetic_tuple& b, std::index_sequence<Is...>)
-	{ return arithmetic_tuple<E, S, Z>((a.m_elements[Is] + b.m_elements[Is])...); }
-
 public:
-	arithmetic_tuple<E, S, Z>& operator += (const arithmetic_tuple& other)
+	constexpr arithmetic_tuple<E, S, Z>& operator += (const arithmetic_tuple& other)
 	{
-		(*this) = add(*this, other, std::make_index_sequence<S>{});
+		if (IDLIB_IS_CONSTANT_EVALUATED()) constant_kernel_type::add(m_elements, other.m_elements);
+		else kernel_type::add(m_elements, other.m_elements);
 		return *this;
 	}
 	
-	arithmetic_tuple<E, S, Z> operator+(const arithmetic_tuple& other) const
-	{ return add(*this, other, std::make_index_sequence<S>{}); }
-	
-private:
-	template <std::size_t ... Is>
-	static arithmetic_tuple<E, S, Z> subtract(const arithmetic_tuple& a, const arithmetic_tuple& b, std::index_sequence<Is...>)
-	{ return arithmetic_tuple<E, S, Z>((a.m_elements[Is] - b.m_elements[Is])...); }
+	constexpr arithmetic_tuple<E, S, Z> operator+(const arithmetic_tuple& other) const
+	{
+		auto t = *this;
+		t += other;
+		return t;
+	}
 
 public:
-	arithmetic_tuple<E, S, Z>& operator -= (const arithmetic_tuple& other)
+	constexpr arithmetic_tuple<E, S, Z>& operator -= (const arithmetic_tuple& other)
 	{
-		(*this) = subtract(*this, other, std::make_index_sequence<S>{});
+		if (IDLIB_IS_CONSTANT_EVALUATED()) constant_kernel_type::subtract(m_elements, other.m_elements);
+		else kernel_type::subtract(m_elements, other.m_elements);
 		return *this;
 	}
 	
-	arithmetic_tuple<E, S, Z> operator-(const arithmetic_tuple& other) const
-	{ return subtract(*this, other, std::make_index_sequence<S>{}); }
-	
-private:
-	template <std::size_t...Is>
-	static arithmetic_tuple<E, S, Z> multiply(const arithmetic_tuple& a, const element_type& s, std::index_sequence<Is...>)
-	{ return arithmetic_tuple<E, S, Z>((a.m_elements[Is] * s)...); }
+	constexpr arithmetic_tuple<E, S, Z> operator-(const arithmetic_tuple& other) const
+	{
+		auto t = *this;
+		t -= other;
+		return t;
+	}
 
 public:
-	arithmetic_tuple<E, S, Z>& operator *= (const element_type& other)
+	constexpr arithmetic_tuple<E, S, Z>& operator *= (const element_type& other)
 	{
-		(*this) = multiply(*this, other, std::make_index_sequence<S>{});
+		if (IDLIB_IS_CONSTANT_EVALUATED()) constant_kernel_type::multiply(m_elements, other);
+		else kernel_type::multiply(m_elements, other);
 		return *this;
 	}
 	
-	arithmetic_tuple<E, S, Z> operator*(const element_type& other) const
-	{ return multiply(*this, other, std::make_index_sequence<S>{}); }
-	
-private:
-	template <std::size_t...Is>
-	static arithmetic_tuple<E, S, Z> divide(const arithmetic_tuple& a, const element_type& s, std::index_sequence<Is...>)
-	{ return arithmetic_tuple<E, S, Z>((a.m_elements[Is] / s)...); }
+	constexpr arithmetic_tuple<E, S, Z> operator*(const element_type& other) const
+	{
+		auto t = *this;
+		t *= other;
+		return t;
+	}
 
 public:
-	arithmetic_tuple<E, S, Z>& operator /= (const element_type& other)
+	constexpr arithmetic_tuple<E, S, Z>& operator /= (const element_type& other)
 	{
-		(*this) = divide(*this, other, std::make_index_sequence<S>{});
+		if (IDLIB_IS_CONSTANT_EVALUATED()) constant_kernel_type::divide(m_elements, other);
+		else kernel_type::divide(m_elements, other);
 		return *this;
 	}
 
-	arithmetic_tuple<E, S, Z> operator/(const element_type& other) const
-	{ return divide(*this, other, std::make_index_sequence<S>{}); }
-	
-private:
-	template <std::size_t...Is>
-	static bool equal_to(const arithmetic_tuple& a, const arithmetic_tuple& b, std::index_sequence<Is...>)
-	{ 
-		return idlib::and_fold_expr()((a.m_elements[Is] == b.m_elements[Is])...);
-	}		
-	
-public:
-	bool operator==(const arithmetic_tuple& other) const
-	{ return equal_to(*this, other, std::make_index_sequence<S>{}); }
+	constexpr arithmetic_tuple<E, S, Z> operator/(const element_type& other) const
+	{
+		auto t = *this;
+		t /= other;
+		return t;
+	}
 
-private:
-	template <std::size_t...Is>
-	static bool not_equal_to(const arithmetic_tuple& a, const arithmetic_tuple& b, std::index_sequence<Is...>)
+public:
+	constexpr bool operator==(const arithmetic_tuple& other) const
 	{
-		return idlib::or_fold_expr()((a.m_elements[Is] != b.m_elements[Is])...);
+		return IDLIB_IS_CONSTANT_EVALUATED() ? constant_kernel_type::equal_to(m_elements, other.m_elements)
+		                                     : kernel_type::equal_to(m_elements, other.m_elements);
 	}
-	
+
+	constexpr bool operator!=(const arithmetic_tuple& other) const
+	{ return !(*this == other); }
+
 public:
-	bool operator!=(const arithmetic_tuple& other) const
-	{ return not_equal_to(*this, other, std::make_index_sequence<S>{}); }
+	/// @brief Compute the sum of the products of the elements of this tuple and another tuple.
+	/// @param other the other tuple
+	/// @return the sum \f$\sum_{i=0}^{S-1} a_i b_i\f$ where \f$a\f$ is this tuple and \f$b\f$ is the other tuple
+	/// @remark The products are summed right-to-left like idlib::plus_fold_expr does.
+	constexpr element_type inner_product(const arithmetic_tuple& other) const
+	{
+		return IDLIB_IS_CONSTANT_EVALUATED() ? constant_kernel_type::inner_product(m_elements, other.m_elements)
+		                                     : kernel_type::inner_product(m_elements, other.m_elements);
+	}
 	
 public:
 	/// @{
@@ -198,28 +214,28 @@ public:
 	/// @param index the index
 	/// @return the tuple element at the specified index
 	/// @pre The index is within bounds.
-	element_type& at(size_t const& index)
+	constexpr element_type& at(size_t const& index)
 	{ return m_elements[index]; }
 
-	element_type& operator[](size_t const& index)
+	constexpr element_type& operator[](size_t const& index)
 	{ return m_elements[index]; }
 
-	const element_type& at(size_t const& index) const
+	constexpr const element_type& at(size_t const& index) const
 	{ return m_elements[index]; }
 
-	const element_type& operator[](size_t const& index) const
+	constexpr const element_type& operator[](size_t const& index) const
 	{ return m_elements[index]; }
 	
 	/// @}
 	
 private:
 	template <typename G, std::size_t...Is>
-	static arithmetic_tuple<E, S, Z> generate(const G& g, std::index_sequence<Is...>)
+	static constexpr arithmetic_tuple<E, S, Z> generate(const G& g, std::index_sequence<Is...>)
 	{ return arithmetic_tuple<E, S, Z>((g(Is))...); }
 
 public:
 	template <typename G>
-	static arithmetic_tuple<E, S, Z> generate(const G& g)
+	static constexpr arithmetic_tuple<E, S, Z> generate(const G& g)
 	{ return generate(g, std::make_index_sequence<S>{}); }
 	
 }; // struct arithmetic_tuple
@@ -241,52 +257,52 @@ public:
 
 public:
 	/// @brief Default construct this arithmetic tuple.
-	arithmetic_tuple()
+	constexpr arithmetic_tuple()
 	{}
 
-	arithmetic_tuple(const arithmetic_tuple& other) = default;
-	arithmetic_tuple(arithmetic_tuple&& other) = default;
-	arithmetic_tuple& operator=(const arithmetic_tuple& other) = default;
-	arithmetic_tuple& operator=(arithmetic_tuple&& other) = default;
+	constexpr arithmetic_tuple(const arithmetic_tuple& other) = default;
+	constexpr arithmetic_tuple(arithmetic_tuple&& other) = default;
+	constexpr arithmetic_tuple& operator=(const arithmetic_tuple& other) = default;
+	constexpr arithmetic_tuple& operator=(arithmetic_tuple&& other) = default;
 	
-    arithmetic_tuple<E, 0, Z> operator+() const
+    constexpr arithmetic_tuple<E, 0, Z> operator+() const
     { return *this; }
 
-    arithmetic_tuple<E, 0, Z> operator-() const
+    constexpr arithmetic_tuple<E, 0, Z> operator-() const
     { return *this; }
 
-	arithmetic_tuple<E, 0, Z>& operator += (const arithmetic_tuple& other)
+	constexpr arithmetic_tuple<E, 0, Z>& operator += (const arithmetic_tuple& other)
 	{ return *this; }
 	
-	arithmetic_tuple<E, 0, Z> operator+(const arithmetic_tuple& other) const
+	constexpr arithmetic_tuple<E, 0, Z> operator+(const arithmetic_tuple& other) const
 	{ return *this; }
 
-	arithmetic_tuple<E, 0, Z>& operator -= (const arithmetic_tuple& other)
+	constexpr arithmetic_tuple<E, 0, Z>& operator -= (const arithmetic_tuple& other)
 	{ return *this; }
 	
-	arithmetic_tuple<E, 0, Z> operator-(const arithmetic_tuple& other) const
+	constexpr arithmetic_tuple<E, 0, Z> operator-(const arithmetic_tuple& other) const
 	{ return *this; }
 
-	arithmetic_tuple<E, 0, Z>& operator *= (const element_type& other)
+	constexpr arithmetic_tuple<E, 0, Z>& operator *= (const element_type& other)
 	{ return *this; }
 	
-	arithmetic_tuple<E, 0, Z> operator*(const element_type& other) const
+	constexpr arithmetic_tuple<E, 0, Z> operator*(const element_type& other) const
 	{ return *this; }
 
-	arithmetic_tuple<E, 0, Z>& operator /= (const element_type& other)
+	constexpr arithmetic_tuple<E, 0, Z>& operator /= (const element_type& other)
 	{ return *this; }
 
-	arithmetic_tuple<E, 0, Z> operator/(const element_type& other) const
+	constexpr arithmetic_tuple<E, 0, Z> operator/(const element_type& other) const
 	{ return *this; }
 
-	bool operator==(const arithmetic_tuple& other) const
+	constexpr bool operator==(const arithmetic_tuple& other) const
 	{ return true; }
 
-	bool operator!=(const arithmetic_tuple& other) const
+	constexpr bool operator!=(const arithmetic_tuple& other) const
 	{ return false; }
 
 	template <typename G>
-	static arithmetic_tuple<E, 0, Z> generate(const G& g)
+	static constexpr arithmetic_tuple<E, 0, Z> generate(const G& g)
 	{ return arithmetic_tuple<E, 0, Z>(); }
 	
 }; // struct arithmetic_tuple
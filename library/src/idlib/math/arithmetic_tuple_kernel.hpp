@@ -0,0 +1,354 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/arithmetic_tuple_kernel.hpp
+/// @brief Storage layout and element-wise kernels of idlib::arithmetic_tuple.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/simd.hpp"
+#include <cstddef>
+#include <type_traits>
+
+namespace idlib { namespace internal {
+
+/// @brief The storage layout of an idlib::arithmetic_tuple.
+/// @tparam E the element type
+/// @tparam S the size i.e. the number of element values
+/// @remark
+/// Provides the member constants
+/// - @a capacity, the number of stored elements which is greater than or equal to @a S, and
+/// - @a alignment, the alignment of the element array.
+/// @remark The layout does not depend on the available SIMD instruction set extensions or on #IDLIB_NO_SIMD.
+/// Hence code compiled with different extensions agrees on the size and the alignment of arithmetic tuples.
+template <typename E, std::size_t S>
+struct arithmetic_tuple_layout
+{
+	static constexpr std::size_t capacity = S;
+	static constexpr std::size_t alignment = alignof(E);
+};
+
+/// @brief 4 @a single elements are stored in 16 bytes aligned to 16 bytes, the size of an SSE register.
+/// @remark 3 @a single elements use the primary template, i.e. they are stored unpadded in 12 bytes.
+template <>
+struct arithmetic_tuple_layout<float, 4>
+{
+	static constexpr std::size_t capacity = 4;
+	static constexpr std::size_t alignment = 16;
+};
+
+/// @brief 2 @a double elements are stored in 16 bytes aligned to 16 bytes, the size of an SSE2 register.
+template <>
+struct arithmetic_tuple_layout<double, 2>
+{
+	static constexpr std::size_t capacity = 2;
+	static constexpr std::size_t alignment = 16;
+};
+
+/// @brief 4 @a double elements are stored in 32 bytes aligned to 32 bytes, the size of an AVX register.
+template <>
+struct arithmetic_tuple_layout<double, 4>
+{
+	static constexpr std::size_t capacity = 4;
+	static constexpr std::size_t alignment = 32;
+};
+
+/// @brief The storage layout and the element-wise operations of an idlib::arithmetic_tuple.
+/// @tparam E the element type
+/// @tparam S the size i.e. the number of element values
+/// @tparam Enabled for SFINAE
+/// @remark
+/// Provides the member constants @a capacity and @a alignment of idlib::internal::arithmetic_tuple_layout.
+/// Elements at the indices from @a S (inclusive) to @a capacity (exclusive) are padding.
+/// Their values are unspecified and are never observed by the operations.
+/// @remark
+/// Provides static functions operating in-place on element arrays of @a capacity elements.
+/// Each function computes exactly the same values as the scalar implementation of the primary template.
+/// In particular, idlib::internal::arithmetic_tuple_kernel::inner_product sums right-to-left like idlib::plus_fold_expr.
+/// The SIMD specializations of idlib::internal::arithmetic_tuple_kernel::set write all elements at once.
+/// @remark Specializations for the element types @a single and @a double and the common sizes are provided if SIMD is available.
+/// @remark The functions of the primary template are @a constexpr.
+/// A non-void @a Enabled argument selects the primary template for any element type and size.
+template <typename E, std::size_t S, typename Enabled = void>
+struct arithmetic_tuple_kernel
+{
+	static constexpr std::size_t capacity = arithmetic_tuple_layout<E, S>::capacity;
+	static constexpr std::size_t alignment = arithmetic_tuple_layout<E, S>::alignment;
+
+	template <typename ... Es>
+	static constexpr void set(E *a, const Es& ... es)
+	{
+		const E v[] = { es ... };
+		for (std::size_t i = 0; i < S; ++i)
+		{ a[i] = v[i]; }
+	}
+
+	static constexpr void negate(E *a)
+	{
+		for (std::size_t i = 0; i < S; ++i)
+		{ a[i] = -a[i]; }
+	}
+
+	static constexpr void add(E *a, const E *b)
+	{
+		for (std::size_t i = 0; i < S; ++i)
+		{ a[i] = a[i] + b[i]; }
+	}
+
+	static constexpr void subtract(E *a, const E *b)
+	{
+		for (std::size_t i = 0; i < S; ++i)
+		{ a[i] = a[i] - b[i]; }
+	}
+
+	static constexpr void multiply(E *a, const E& s)
+	{
+		for (std::size_t i = 0; i < S; ++i)
+		{ a[i] = a[i] * s; }
+	}
+
+	static constexpr void divide(E *a, const E& s)
+	{
+		for (std::size_t i = 0; i < S; ++i)
+		{ a[i] = a[i] / s; }
+	}
+
+	static constexpr bool equal_to(const E *a, const E *b)
+	{
+		for (std::size_t i = 0; i < S; ++i)
+		{
+			if (!(a[i] == b[i])) return false;
+		}
+		return true;
+	}
+
+	static constexpr E inner_product(const E *a, const E *b)
+	{
+		E r = a[S - 1] * b[S - 1];
+		for (std::size_t i = S - 1; i > 0; --i)
+		{ r = a[i - 1] * b[i - 1] + r; }
+		return r;
+	}
+
+}; // struct arithmetic_tuple_kernel
+
+#if defined(IDLIB_WITH_SSE2)
+
+/// @brief Specialization of idlib::internal::arithmetic_tuple_kernel for 3 and 4 @a single elements.
+/// The elements are processed in a single SSE register.
+/// 4 elements are loaded and stored with 16-byte aligned accesses.
+/// 3 elements are loaded and stored with an 8-byte and a 4-byte access and the fourth lane of the register is @a 0.
+template <std::size_t S>
+struct arithmetic_tuple_kernel<float, S, std::enable_if_t<S == 3 || S == 4>>
+{
+	static constexpr std::size_t capacity = arithmetic_tuple_layout<float, S>::capacity;
+	static constexpr std::size_t alignment = arithmetic_tuple_layout<float, S>::alignment;
+
+	static __m128 load(const float *a)
+	{
+		return S == 3 ? _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(a)), _mm_load_ss(a + 2))
+		              : _mm_load_ps(a);
+	}
+
+	static void store(float *a, __m128 x)
+	{
+		if (S == 3)
+		{
+			_mm_storel_pi(reinterpret_cast<__m64 *>(a), x);
+			_mm_store_ss(a + 2, _mm_movehl_ps(x, x));
+		}
+		else
+		{ _mm_store_ps(a, x); }
+	}
+
+	static void set(float *a, float x, float y, float z)
+	{ store(a, _mm_setr_ps(x, y, z, 0.0f)); }
+
+	static void set(float *a, float x, float y, float z, float w)
+	{ store(a, _mm_setr_ps(x, y, z, w)); }
+
+	static void negate(float *a)
+	{ store(a, _mm_xor_ps(load(a), _mm_set1_ps(-0.0f))); }
+
+	static void add(float *a, const float *b)
+	{ store(a, _mm_add_ps(load(a), load(b))); }
+
+	static void subtract(float *a, const float *b)
+	{ store(a, _mm_sub_ps(load(a), load(b))); }
+
+	static void multiply(float *a, const float& s)
+	{ store(a, _mm_mul_ps(load(a), _mm_set1_ps(s))); }
+
+	// The fourth lane of 3 elements is divided by 1 such that 0 / 0 is not computed.
+	static void divide(float *a, const float& s)
+	{ store(a, _mm_div_ps(load(a), S == 3 ? _mm_setr_ps(s, s, s, 1.0f) : _mm_set1_ps(s))); }
+
+	static bool equal_to(const float *a, const float *b)
+	{
+		static constexpr int mask = (1 << S) - 1;
+		return (_mm_movemask_ps(_mm_cmpeq_ps(load(a), load(b))) & mask) == mask;
+	}
+
+	static float inner_product(const float *a, const float *b)
+	{
+		alignas(16) float p[4];
+		_mm_store_ps(p, _mm_mul_ps(load(a), load(b)));
+		return S == 3 ? p[0] + (p[1] + p[2])
+			          : p[0] + (p[1] + (p[2] + p[3]));
+	}
+
+}; // struct arithmetic_tuple_kernel
+
+/// @brief Specialization of idlib::internal::arithmetic_tuple_kernel for 2 @a double elements.
+/// The elements are stored in a single 16-byte aligned SSE2 register.
+template <>
+struct arithmetic_tuple_kernel<double, 2, void>
+{
+	static constexpr std::size_t capacity = arithmetic_tuple_layout<double, 2>::capacity;
+	static constexpr std::size_t alignment = arithmetic_tuple_layout<double, 2>::alignment;
+
+	static void set(double *a, double x, double y)
+	{ _mm_store_pd(a, _mm_setr_pd(x, y)); }
+
+	static void negate(double *a)
+	{ _mm_store_pd(a, _mm_xor_pd(_mm_load_pd(a), _mm_set1_pd(-0.0))); }
+
+	static void add(double *a, const double *b)
+	{ _mm_store_pd(a, _mm_add_pd(_mm_load_pd(a), _mm_load_pd(b))); }
+
+	static void subtract(double *a, const double *b)
+	{ _mm_store_pd(a, _mm_sub_pd(_mm_load_pd(a), _mm_load_pd(b))); }
+
+	static void multiply(double *a, const double& s)
+	{ _mm_store_pd(a, _mm_mul_pd(_mm_load_pd(a), _mm_set1_pd(s))); }
+
+	static void divide(double *a, const double& s)
+	{ _mm_store_pd(a, _mm_div_pd(_mm_load_pd(a), _mm_set1_pd(s))); }
+
+	static bool equal_to(const double *a, const double *b)
+	{ return _mm_movemask_pd(_mm_cmpeq_pd(_mm_load_pd(a), _mm_load_pd(b))) == 0x3; }
+
+	static double inner_product(const double *a, const double *b)
+	{
+		alignas(16) double p[2];
+		_mm_store_pd(p, _mm_mul_pd(_mm_load_pd(a), _mm_load_pd(b)));
+		return p[0] + p[1];
+	}
+
+}; // struct arithmetic_tuple_kernel
+
+/// @brief Specialization of idlib::internal::arithmetic_tuple_kernel for 4 @a double elements.
+/// The elements are stored in a single 32-byte aligned AVX register if AVX is available and in two SSE2 registers otherwise.
+template <>
+struct arithmetic_tuple_kernel<double, 4, void>
+{
+	static constexpr std::size_t capacity = arithmetic_tuple_layout<double, 4>::capacity;
+	static constexpr std::size_t alignment = arithmetic_tuple_layout<double, 4>::alignment;
+
+#if defined(IDLIB_WITH_AVX)
+	static void set(double *a, double x, double y, double z, double w)
+	{ _mm256_store_pd(a, _mm256_setr_pd(x, y, z, w)); }
+
+	static void negate(double *a)
+	{ _mm256_store_pd(a, _mm256_xor_pd(_mm256_load_pd(a), _mm256_set1_pd(-0.0))); }
+
+	static void add(double *a, const double *b)
+	{ _mm256_store_pd(a, _mm256_add_pd(_mm256_load_pd(a), _mm256_load_pd(b))); }
+
+	static void subtract(double *a, const double *b)
+	{ _mm256_store_pd(a, _mm256_sub_pd(_mm256_load_pd(a), _mm256_load_pd(b))); }
+
+	static void multiply(double *a, const double& s)
+	{ _mm256_store_pd(a, _mm256_mul_pd(_mm256_load_pd(a), _mm256_set1_pd(s))); }
+
+	static void divide(double *a, const double& s)
+	{ _mm256_store_pd(a, _mm256_div_pd(_mm256_load_pd(a), _mm256_set1_pd(s))); }
+
+	static bool equal_to(const double *a, const double *b)
+	{ return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_load_pd(a), _mm256_load_pd(b), _CMP_EQ_OQ)) == 0xf; }
+
+	static double inner_product(const double *a, const double *b)
+	{
+		alignas(32) double p[4];
+		_mm256_store_pd(p, _mm256_mul_pd(_mm256_load_pd(a), _mm256_load_pd(b)));
+		return p[0] + (p[1] + (p[2] + p[3]));
+	}
+#else
+	static void set(double *a, double x, double y, double z, double w)
+	{
+		arithmetic_tuple_kernel<double, 2>::set(a + 0, x, y);
+		arithmetic_tuple_kernel<double, 2>::set(a + 2, z, w);
+	}
+
+	static void negate(double *a)
+	{
+		arithmetic_tuple_kernel<double, 2>::negate(a + 0);
+		arithmetic_tuple_kernel<double, 2>::negate(a + 2);
+	}
+
+	static void add(double *a, const double *b)
+	{
+		arithmetic_tuple_kernel<double, 2>::add(a + 0, b + 0);
+		arithmetic_tuple_kernel<double, 2>::add(a + 2, b + 2);
+	}
+
+	static void subtract(double *a, const double *b)
+	{
+		arithmetic_tuple_kernel<double, 2>::subtract(a + 0, b + 0);
+		arithmetic_tuple_kernel<double, 2>::subtract(a + 2, b + 2);
+	}
+
+	static void multiply(double *a, const double& s)
+	{
+		arithmetic_tuple_kernel<double, 2>::multiply(a + 0, s);
+		arithmetic_tuple_kernel<double, 2>::multiply(a + 2, s);
+	}
+
+	static void divide(double *a, const double& s)
+	{
+		arithmetic_tuple_kernel<double, 2>::divide(a + 0, s);
+		arithmetic_tuple_kernel<double, 2>::divide(a + 2, s);
+	}
+
+	static bool equal_to(const double *a, const double *b)
+	{
+		return arithmetic_tuple_kernel<double, 2>::equal_to(a + 0, b + 0)
+			&& arithmetic_tuple_kernel<double, 2>::equal_to(a + 2, b + 2);
+	}
+
+	static double inner_product(const double *a, const double *b)
+	{
+		alignas(16) double p[4];
+		_mm_store_pd(p + 0, _mm_mul_pd(_mm_load_pd(a + 0), _mm_load_pd(b + 0)));
+		_mm_store_pd(p + 2, _mm_mul_pd(_mm_load_pd(a + 2), _mm_load_pd(b + 2)));
+		return p[0] + (p[1] + (p[2] + p[3]));
+	}
+#endif
+
+}; // struct arithmetic_tuple_kernel
+
+#endif
+
+} } // namespace idlib::internal
@@ -0,0 +1,497 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/batch_kernel.hpp
+/// @brief Element-wise kernels over arrays of scalars.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/simd.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace idlib { namespace internal {
+
+/// @brief SIMD register abstraction for a scalar type.
+/// @tparam Scalar the scalar type
+/// @remark Specializations for @a float and @a double are provided if SIMD is available.
+/// Specializations provide the member type @a type, the member constant @a width (the number of lanes), and
+/// static functions load, store, set1, add, subtract, multiply, divide, sqrt, rsqrt_estimate, min, max, equal, less, select, and bits.
+/// Each lane-wise operation computes exactly the same value as the corresponding scalar operation.
+/// In particular, rsqrt_estimate computes the same value as idlib::internal::rsqrt_estimate.
+template <typename Scalar>
+struct simd_traits;
+
+#if defined(IDLIB_WITH_SSE2)
+
+template <>
+struct simd_traits<float>
+{
+	using type = __m128;
+	static constexpr std::size_t width = 4;
+	static type load(const float *p) { return _mm_loadu_ps(p); }
+	static void store(float *p, type x) { _mm_storeu_ps(p, x); }
+	static type set1(float x) { return _mm_set1_ps(x); }
+	static type add(type x, type y) { return _mm_add_ps(x, y); }
+	static type subtract(type x, type y) { return _mm_sub_ps(x, y); }
+	static type multiply(type x, type y) { return _mm_mul_ps(x, y); }
+	static type divide(type x, type y) { return _mm_div_ps(x, y); }
+	static type sqrt(type x) { return _mm_sqrt_ps(x); }
+	static type rsqrt_estimate(type x) { return _mm_rsqrt_ps(x); }
+	/// @brief Lane-wise <c>y < x ? y : x</c>.
+	static type min(type x, type y) { return _mm_min_ps(y, x); }
+	/// @brief Lane-wise <c>x < y ? y : x</c>.
+	static type max(type x, type y) { return _mm_max_ps(y, x); }
+	/// @brief Lane-wise <c>x == y</c>.
+	static type equal(type x, type y) { return _mm_cmpeq_ps(x, y); }
+	/// @brief Lane-wise <c>x < y</c>.
+	static type less(type x, type y) { return _mm_cmplt_ps(x, y); }
+	/// @brief Lane-wise <c>m ? x : y</c>.
+	static type select(type m, type x, type y) { return _mm_or_ps(_mm_and_ps(m, x), _mm_andnot_ps(m, y)); }
+	/// @brief The bits of the lanes of a mask, lane @a i at bit @a i.
+	static std::uint32_t bits(type m) { return std::uint32_t(_mm_movemask_ps(m)); }
+};
+
+template <>
+struct simd_traits<double>
+{
+	using type = __m128d;
+	static constexpr std::size_t width = 2;
+	static type load(const double *p) { return _mm_loadu_pd(p); }
+	static void store(double *p, type x) { _mm_storeu_pd(p, x); }
+	static type set1(double x) { return _mm_set1_pd(x); }
+	static type add(type x, type y) { return _mm_add_pd(x, y); }
+	static type subtract(type x, type y) { return _mm_sub_pd(x, y); }
+	static type multiply(type x, type y) { return _mm_mul_pd(x, y); }
+	static type divide(type x, type y) { return _mm_div_pd(x, y); }
+	static type sqrt(type x) { return _mm_sqrt_pd(x); }
+	static type rsqrt_estimate(type x)
+	{
+		auto y = _mm_castsi128_pd(_mm_sub_epi64(_mm_set1_epi64x(0x5fe6eb50c7b537a9), _mm_srli_epi64(_mm_castpd_si128(x), 1)));
+		return _mm_mul_pd(y, _mm_sub_pd(_mm_set1_pd(1.5), _mm_mul_pd(_mm_mul_pd(_mm_mul_pd(_mm_set1_pd(0.5), x), y), y)));
+	}
+	/// @brief Lane-wise <c>y < x ? y : x</c>.
+	static type min(type x, type y) { return _mm_min_pd(y, x); }
+	/// @brief Lane-wise <c>x < y ? y : x</c>.
+	static type max(type x, type y) { return _mm_max_pd(y, x); }
+	/// @brief Lane-wise <c>x == y</c>.
+	static type equal(type x, type y) { return _mm_cmpeq_pd(x, y); }
+	/// @brief Lane-wise <c>x < y</c>.
+	static type less(type x, type y) { return _mm_cmplt_pd(x, y); }
+	/// @brief Lane-wise <c>m ? x : y</c>.
+	static type select(type m, type x, type y) { return _mm_or_pd(_mm_and_pd(m, x), _mm_andnot_pd(m, y)); }
+	/// @brief The bits of the lanes of a mask, lane @a i at bit @a i.
+	static std::uint32_t bits(type m) { return std::uint32_t(_mm_movemask_pd(m)); }
+};
+
+#endif
+
+/// @brief 256-bit SIMD register abstraction for a scalar type.
+/// @tparam Scalar the scalar type
+/// @remark A specialization for @a float is provided if AVX is available.
+/// It provides the same members as idlib::internal::simd_traits except for rsqrt_estimate.
+/// The bulk kernels keep using idlib::internal::simd_traits, this is used where the data layout has a width of 8 lanes.
+template <typename Scalar>
+struct wide_simd_traits;
+
+#if defined(IDLIB_WITH_AVX)
+
+template <>
+struct wide_simd_traits<float>
+{
+	using type = __m256;
+	static constexpr std::size_t width = 8;
+	static type load(const float *p) { return _mm256_loadu_ps(p); }
+	static void store(float *p, type x) { _mm256_storeu_ps(p, x); }
+	static type set1(float x) { return _mm256_set1_ps(x); }
+	static type add(type x, type y) { return _mm256_add_ps(x, y); }
+	static type subtract(type x, type y) { return _mm256_sub_ps(x, y); }
+	static type multiply(type x, type y) { return _mm256_mul_ps(x, y); }
+	static type divide(type x, type y) { return _mm256_div_ps(x, y); }
+	static type sqrt(type x) { return _mm256_sqrt_ps(x); }
+	static type min(type x, type y) { return _mm256_min_ps(y, x); }
+	static type max(type x, type y) { return _mm256_max_ps(y, x); }
+	static type equal(type x, type y) { return _mm256_cmp_ps(x, y, _CMP_EQ_OQ); }
+	static type less(type x, type y) { return _mm256_cmp_ps(x, y, _CMP_LT_OQ); }
+	static type select(type m, type x, type y) { return _mm256_blendv_ps(y, x, m); }
+	static std::uint32_t bits(type m) { return std::uint32_t(_mm256_movemask_ps(m)); }
+};
+
+#endif
+
+/// @brief The maximal relative error of idlib::internal::rsqrt_estimate.
+constexpr double rsqrt_estimate_error = 1.76e-3;
+
+/// @{
+/// @brief Estimate the reciprocal square root \f$\frac{1}{\sqrt{x}}\f$ of a positive normal value \f$x\f$.
+/// @param x the value
+/// @return the estimate. Its relative error is at most idlib::internal::rsqrt_estimate_error.
+/// @remark If SSE is available, the @a single estimate is the estimate of the <c>rsqrtss</c> instruction
+/// (relative error at most \f$1.5 \cdot 2^{-12}\f$). Its values depend on the processor.
+/// Otherwise the estimate is obtained by halving the exponent with integer arithmetic followed by one Newton-Raphson step
+/// (relative error at most \f$1.753 \cdot 10^{-3}\f$, see Lomont, "Fast Inverse Square Root", 2003).
+inline float rsqrt_estimate(float x)
+{
+#if defined(IDLIB_WITH_SSE2)
+	return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+	std::uint32_t i;
+	std::memcpy(&i, &x, sizeof(x));
+	i = UINT32_C(0x5f375a86) - (i >> 1);
+	float y;
+	std::memcpy(&y, &i, sizeof(y));
+	return y * (1.5f - 0.5f * x * y * y);
+#endif
+}
+
+inline double rsqrt_estimate(double x)
+{
+	std::uint64_t i;
+	std::memcpy(&i, &x, sizeof(x));
+	i = UINT64_C(0x5fe6eb50c7b537a9) - (i >> 1);
+	double y;
+	std::memcpy(&y, &i, sizeof(y));
+	return y * (1.5 - 0.5 * x * y * y);
+}
+/// @}
+
+/// @brief Compute the reciprocal square root of a value by refining idlib::internal::rsqrt_estimate.
+/// @tparam Refinements the number of Newton-Raphson steps \f$y' = y \left(\frac{3}{2} - \frac{x}{2} y^2\right)\f$
+/// @param x the value. Must be @a 0 or a positive normal value.
+/// @return @a 1 if \f$x = 0\f$, an approximation of \f$\frac{1}{\sqrt{x}}\f$ otherwise
+/// @remark A step maps a relative error \f$e\f$ to a relative error of \f$\frac{3}{2}e^2 + \frac{1}{2}|e|^3\f$ plus rounding errors.
+template <std::size_t Refinements, typename Scalar>
+Scalar rsqrt_or_one(Scalar x)
+{
+	if (x == Scalar(0)) return Scalar(1);
+	Scalar y = rsqrt_estimate(x), h = Scalar(0.5) * x;
+	for (std::size_t i = 0; i < Refinements; ++i)
+	{ y = y * (Scalar(1.5) - h * y * y); }
+	return y;
+}
+
+/// @brief Get if SIMD is available for a scalar type.
+template <typename Scalar, typename Enabled = void>
+struct has_simd_traits : std::false_type
+{};
+
+template <typename Scalar>
+struct has_simd_traits<Scalar, std::void_t<decltype(simd_traits<Scalar>::width)>> : std::true_type
+{};
+
+/// @brief Get if 256-bit SIMD is available for a scalar type.
+template <typename Scalar, typename Enabled = void>
+struct has_wide_simd_traits : std::false_type
+{};
+
+template <typename Scalar>
+struct has_wide_simd_traits<Scalar, std::void_t<decltype(wide_simd_traits<Scalar>::width)>> : std::true_type
+{};
+
+/// @brief A single scalar with the interface of idlib::internal::simd_value.
+/// @detail Kernels written in terms of this interface compute bit-identical results for both types.
+/// @tparam Scalar the scalar type
+template <typename Scalar>
+struct scalar_value
+{
+	using scalar_type = Scalar;
+	static constexpr std::size_t width = 1;
+	Scalar v;
+	static scalar_value load(const Scalar *p) { return { *p }; }
+	static scalar_value broadcast(Scalar x) { return { x }; }
+	void store(Scalar *p) const { *p = v; }
+	friend scalar_value operator+(scalar_value x, scalar_value y) { return { x.v + y.v }; }
+	friend scalar_value operator-(scalar_value x, scalar_value y) { return { x.v - y.v }; }
+	friend scalar_value operator*(scalar_value x, scalar_value y) { return { x.v * y.v }; }
+	friend scalar_value operator/(scalar_value x, scalar_value y) { return { x.v / y.v }; }
+	friend scalar_value sqrt(scalar_value x) { return { std::sqrt(x.v) }; }
+	/// @brief <c>std::min(x, y)</c>.
+	friend scalar_value min(scalar_value x, scalar_value y) { return y.v < x.v ? y : x; }
+	/// @brief <c>std::max(x, y)</c>.
+	friend scalar_value max(scalar_value x, scalar_value y) { return x.v < y.v ? y : x; }
+	/// @brief <c>a < b ? x : y</c>.
+	friend scalar_value select_less(scalar_value a, scalar_value b, scalar_value x, scalar_value y) { return a.v < b.v ? x : y; }
+	/// @brief <c>a == b ? x : y</c>.
+	friend scalar_value select_equal(scalar_value a, scalar_value b, scalar_value x, scalar_value y) { return a.v == b.v ? x : y; }
+	/// @brief <c>a < b ? 1 : 0</c>.
+	friend std::uint32_t bits_less(scalar_value a, scalar_value b) { return a.v < b.v ? 1 : 0; }
+};
+
+#if defined(IDLIB_WITH_SSE2)
+
+/// @brief A SIMD register of scalars with arithmetic operators.
+/// @tparam Scalar the scalar type. Must have SIMD traits.
+/// @tparam Traits the SIMD traits, idlib::internal::simd_traits or idlib::internal::wide_simd_traits
+template <typename Scalar, typename Traits = simd_traits<Scalar>>
+struct simd_value
+{
+	using traits = Traits;
+	using scalar_type = Scalar;
+	static constexpr std::size_t width = traits::width;
+	typename traits::type v;
+	static simd_value load(const Scalar *p) { return { traits::load(p) }; }
+	static simd_value broadcast(Scalar x) { return { traits::set1(x) }; }
+	void store(Scalar *p) const { traits::store(p, v); }
+	friend simd_value operator+(simd_value x, simd_value y) { return { traits::add(x.v, y.v) }; }
+	friend simd_value operator-(simd_value x, simd_value y) { return { traits::subtract(x.v, y.v) }; }
+	friend simd_value operator*(simd_value x, simd_value y) { return { traits::multiply(x.v, y.v) }; }
+	friend simd_value operator/(simd_value x, simd_value y) { return { traits::divide(x.v, y.v) }; }
+	friend simd_value sqrt(simd_value x) { return { traits::sqrt(x.v) }; }
+	/// @brief Lane-wise <c>std::min(x, y)</c>.
+	friend simd_value min(simd_value x, simd_value y) { return { traits::min(x.v, y.v) }; }
+	/// @brief Lane-wise <c>std::max(x, y)</c>.
+	friend simd_value max(simd_value x, simd_value y) { return { traits::max(x.v, y.v) }; }
+	/// @brief Lane-wise <c>a < b ? x : y</c>.
+	friend simd_value select_less(simd_value a, simd_value b, simd_value x, simd_value y) { return { traits::select(traits::less(a.v, b.v), x.v, y.v) }; }
+	/// @brief Lane-wise <c>a == b ? x : y</c>.
+	friend simd_value select_equal(simd_value a, simd_value b, simd_value x, simd_value y) { return { traits::select(traits::equal(a.v, b.v), x.v, y.v) }; }
+	/// @brief The bits of the lanes with <c>a < b</c>, lane @a i at bit @a i.
+	friend std::uint32_t bits_less(simd_value a, simd_value b) { return traits::bits(traits::less(a.v, b.v)); }
+};
+
+#endif
+
+/// @brief Select the widest value type available for a scalar type.
+/// @detail The widest SIMD register available for the scalar type is selected, scalars if there is none.
+/// @tparam Scalar the scalar type
+template <typename Scalar, typename Enabled = void>
+struct widest_value
+{
+	using type = scalar_value<Scalar>;
+};
+
+#if defined(IDLIB_WITH_SSE2)
+
+template <typename Scalar>
+struct widest_value<Scalar, std::enable_if_t<has_simd_traits<Scalar>::value && !has_wide_simd_traits<Scalar>::value>>
+{
+	using type = simd_value<Scalar>;
+};
+
+template <typename Scalar>
+struct widest_value<Scalar, std::enable_if_t<has_wide_simd_traits<Scalar>::value>>
+{
+	using type = simd_value<Scalar, wide_simd_traits<Scalar>>;
+};
+
+#endif
+
+/// @brief Element-wise kernels over arrays of @a n scalars.
+/// @tparam Scalar the scalar type
+/// @tparam Enabled for SFINAE
+/// @remark The output array may be one of the input arrays but must not partially overlap with them.
+/// @remark A specialization using idlib::internal::simd_traits is provided for scalar types for which SIMD is available.
+/// Its results are bit-identical to the results of the scalar implementation.
+template <typename Scalar, typename Enabled = void>
+struct batch_kernel
+{
+	/// @brief \f$z_i = x_i + y_i\f$.
+	static void add(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = x[i] + y[i]; }
+
+	/// @brief \f$z_i = x_i - y_i\f$.
+	static void subtract(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = x[i] - y[i]; }
+
+	/// @brief \f$z_i = x_i \cdot s\f$.
+	static void multiply(const Scalar *x, Scalar s, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = x[i] * s; }
+
+	/// @brief \f$z_i = x_i \cdot y_i\f$.
+	static void multiply(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = x[i] * y[i]; }
+
+	/// @brief \f$z_i = x_i \cdot y_i + z_i\f$ (not fused).
+	static void multiply_add(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = x[i] * y[i] + z[i]; }
+
+	/// @brief \f$z_i = a_i \cdot b_i - c_i \cdot d_i\f$ (not fused).
+	static void multiply_subtract(const Scalar *a, const Scalar *b, const Scalar *c, const Scalar *d, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = a[i] * b[i] - c[i] * d[i]; }
+
+	/// @brief \f$z_i = \sqrt{x_i}\f$.
+	static void sqrt(const Scalar *x, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = std::sqrt(x[i]); }
+
+	/// @brief \f$z_i = x_i\f$ if \f$w_i = 0\f$ and \f$z_i = \frac{x_i}{w_i}\f$ otherwise.
+	static void divide_or_retain(const Scalar *x, const Scalar *w, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = w[i] == Scalar(0) ? x[i] : x[i] / w[i]; }
+
+	/// @brief \f$z_i = \f$ idlib::internal::rsqrt_or_one<Refinements>(\f$x_i\f$).
+	template <std::size_t Refinements>
+	static void rsqrt_or_one(const Scalar *x, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = internal::rsqrt_or_one<Refinements>(x[i]); }
+
+	/// @brief \f$z_i = \min(x_i, y_i)\f$ with the semantics of std::min.
+	static void min(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = y[i] < x[i] ? y[i] : x[i]; }
+
+	/// @brief \f$z_i = \max(x_i, y_i)\f$ with the semantics of std::max.
+	static void max(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{ for (std::size_t i = 0; i < n; ++i) z[i] = x[i] < y[i] ? y[i] : x[i]; }
+
+	/// @brief \f$z_i = \min(x_i \cdot s + t, m)\f$ (not fused) with the semantics of std::min.
+	static void multiply_add_min(const Scalar *x, Scalar s, Scalar t, Scalar m, Scalar *z, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const Scalar v = x[i] * s + t;
+			z[i] = m < v ? m : v;
+		}
+	}
+
+}; // struct batch_kernel
+
+template <typename Scalar>
+struct batch_kernel<Scalar, std::enable_if_t<has_simd_traits<Scalar>::value>>
+{
+private:
+	using traits = simd_traits<Scalar>;
+	// The primary template (selected by any Enabled type other than void) processes the remaining elements.
+	using scalar_kernel = batch_kernel<Scalar, bool>;
+	static constexpr std::size_t W = traits::width;
+
+public:
+	static void add(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+		{ traits::store(z + i, traits::add(traits::load(x + i), traits::load(y + i))); }
+		scalar_kernel::add(x + i, y + i, z + i, n - i);
+	}
+
+	static void subtract(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+		{ traits::store(z + i, traits::subtract(traits::load(x + i), traits::load(y + i))); }
+		scalar_kernel::subtract(x + i, y + i, z + i, n - i);
+	}
+
+	static void multiply(const Scalar *x, Scalar s, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		auto t = traits::set1(s);
+		for (; i + W <= n; i += W)
+		{ traits::store(z + i, traits::multiply(traits::load(x + i), t)); }
+		scalar_kernel::multiply(x + i, s, z + i, n - i);
+	}
+
+	static void multiply(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+		{ traits::store(z + i, traits::multiply(traits::load(x + i), traits::load(y + i))); }
+		scalar_kernel::multiply(x + i, y + i, z + i, n - i);
+	}
+
+	static void multiply_add(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+		{ traits::store(z + i, traits::add(traits::multiply(traits::load(x + i), traits::load(y + i)), traits::load(z + i))); }
+		scalar_kernel::multiply_add(x + i, y + i, z + i, n - i);
+	}
+
+	static void multiply_subtract(const Scalar *a, const Scalar *b, const Scalar *c, const Scalar *d, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+		{
+			auto p = traits::multiply(traits::load(a + i), traits::load(b + i));
+			auto q = traits::multiply(traits::load(c + i), traits::load(d + i));
+			traits::store(z + i, traits::subtract(p, q));
+		}
+		scalar_kernel::multiply_subtract(a + i, b + i, c + i, d + i, z + i, n - i);
+	}
+
+	static void sqrt(const Scalar *x, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+		{ traits::store(z + i, traits::sqrt(traits::load(x + i))); }
+		scalar_kernel::sqrt(x + i, z + i, n - i);
+	}
+
+	static void divide_or_retain(const Scalar *x, const Scalar *w, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		auto zero = traits::set1(Scalar(0));
+		for (; i + W <= n; i += W)
+		{
+			auto a = traits::load(x + i), b = traits::load(w + i);
+			traits::store(z + i, traits::select(traits::equal(b, zero), a, traits::divide(a, b)));
+		}
+		scalar_kernel::divide_or_retain(x + i, w + i, z + i, n - i);
+	}
+
+	template <std::size_t Refinements>
+	static void rsqrt_or_one(const Scalar *x, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		auto zero = traits::set1(Scalar(0)), one = traits::set1(Scalar(1)),
+		     half = traits::set1(Scalar(0.5)), three_halves = traits::set1(Scalar(1.5));
+		for (; i + W <= n; i += W)
+		{
+			auto a = traits::load(x + i);
+			auto y = traits::rsqrt_estimate(a), h = traits::multiply(half, a);
+			for (std::size_t j = 0; j < Refinements; ++j)
+			{ y = traits::multiply(y, traits::subtract(three_halves, traits::multiply(traits::multiply(h, y), y))); }
+			traits::store(z + i, traits::select(traits::equal(a, zero), one, y));
+		}
+		scalar_kernel::template rsqrt_or_one<Refinements>(x + i, z + i, n - i);
+	}
+
+	static void min(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+		{ traits::store(z + i, traits::min(traits::load(x + i), traits::load(y + i))); }
+		scalar_kernel::min(x + i, y + i, z + i, n - i);
+	}
+
+	static void max(const Scalar *x, const Scalar *y, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + W <= n; i += W)
+		{ traits::store(z + i, traits::max(traits::load(x + i), traits::load(y + i))); }
+		scalar_kernel::max(x + i, y + i, z + i, n - i);
+	}
+
+	static void multiply_add_min(const Scalar *x, Scalar s, Scalar t, Scalar m, Scalar *z, std::size_t n)
+	{
+		std::size_t i = 0;
+		auto a = traits::set1(s), b = traits::set1(t), c = traits::set1(m);
+		for (; i + W <= n; i += W)
+		{ traits::store(z + i, traits::min(traits::add(traits::multiply(traits::load(x + i), a), b), c)); }
+		scalar_kernel::multiply_add_min(x + i, s, t, m, z + i, n - i);
+	}
+
+}; // struct batch_kernel
+
+} } // namespace idlib::internal
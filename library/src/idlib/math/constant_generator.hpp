@@ -35,7 +35,7 @@ struct constant_generator : generator
 {
     using result_type = R;
 
-    constant_generator(const result_type& c = result_type())
+    constexpr constant_generator(const result_type& c = result_type())
         : m_c(c)
 	{}
 
@@ -44,7 +44,7 @@ struct constant_generator : generator
     #pragma warning(disable: 4100)
 #endif
 
-    result_type operator()(size_t index) const
+    constexpr result_type operator()(size_t index) const
 	{ return m_c; }
 
 #if defined(_MSC_VER)
@@ -36,7 +36,7 @@ template <typename Vector>
 struct cross_product_functor;
 
 template <typename Vector>
-auto cross_product(const Vector& v, const Vector& w) -> decltype(cross_product_functor<Vector>()(v, w))
+constexpr auto cross_product(const Vector& v, const Vector& w) -> decltype(cross_product_functor<Vector>()(v, w))
 { return cross_product_functor<Vector>()(v, w); }
 
 } // namespace idlib
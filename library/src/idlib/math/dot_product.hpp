@@ -36,7 +36,7 @@ template <typename Vector>
 struct dot_product_functor;
 
 template <typename Vector>
-auto dot_product(const Vector& v, const Vector& w) -> decltype(dot_product_functor<Vector>()(v, w))
+constexpr auto dot_product(const Vector& v, const Vector& w) -> decltype(dot_product_functor<Vector>()(v, w))
 { return dot_product_functor<Vector>()(v, w); }
 
 } // namespace idlib
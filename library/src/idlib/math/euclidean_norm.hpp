@@ -41,7 +41,7 @@ template <typename Vector>
 struct euclidean_norm_functor;
 
 template <typename Vector>
-auto euclidean_norm(const Vector& v) -> decltype(euclidean_norm_functor<Vector>()(v))
+constexpr auto euclidean_norm(const Vector& v) -> decltype(euclidean_norm_functor<Vector>()(v))
 { return euclidean_norm_functor<Vector>()(v); }
 
 } // namespace idlib
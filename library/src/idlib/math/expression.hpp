@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/expression.hpp
+/// @brief Opt-in expression templates for the arithmetic of vectors, points, and colors.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/point.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief Traits adapting a type to expression templates.
+/// @detail
+/// Specializations provide
+/// - the member type @a value_type,
+/// - a static constexpr function @a size() returning the number of components,
+/// - a static function template @a get<I>(x) returning the component value of index @a I of a value @a x,
+/// - a static function template @a make(c...) constructing a value from its component values, and
+/// - static function templates @a add<I>(x, y), @a subtract<I>(x, y), @a scale<I>(x, s), and @a negate<I>(x)
+///   computing the component value of index @a I of a sum, difference, scaled value, and negated value
+///   (only the ones the type supports).
+/// Each function template must compute exactly what the corresponding operator of the type computes for the component.
+/// @tparam T the type
+/// @tparam E for SFINAE
+/// @remark Specializations for idlib::vector and idlib::point values are provided.
+/// Specializations for RGB and RGBA idlib::color values are provided by the color library.
+template <typename T, typename E = void>
+struct expression_traits;
+
+/// @brief The base of expression templates.
+/// @detail
+/// An expression template represents an arithmetic expression without evaluating it.
+/// Evaluating an expression template computes each component value of the result by a single pass through the expression tree.
+/// In particular, no intermediate values are created.
+/// The results are identical to the results of evaluating the expression with the operators of the type.
+/// @detail Expression templates are opt-in: Wrap the operands by idlib::lazy.
+/// @code
+/// vector_3s x = lazy(a) + lazy(b) * s - lazy(c);
+/// @endcode
+/// @remark Expression templates store references to the wrapped operands.
+/// The operands must outlive the expression templates.
+/// @tparam Derived the derived type. Provides the member type @a value_type and a member function template @a get<I>()
+/// returning the component value of index @a I of the result.
+template <typename Derived>
+struct expression
+{
+	/// @brief Get the derived expression.
+	/// @return the derived expression
+	const Derived& derived() const
+	{ return static_cast<const Derived&>(*this); }
+
+	/// @brief Evaluate this expression.
+	/// @return the result
+	template <typename T, typename D = Derived, typename = std::enable_if_t<std::is_same<T, typename D::value_type>::value>>
+	operator T() const
+	{ return evaluate(std::make_index_sequence<expression_traits<T>::size()>{}); }
+
+private:
+	template <size_t...Is>
+	auto evaluate(std::index_sequence<Is...>) const
+	{ return expression_traits<typename Derived::value_type>::make(derived().template get<Is>()...); }
+
+}; // struct expression
+
+/// @brief Get if a type is an expression template.
+template <typename T>
+struct is_expression : std::is_base_of<expression<T>, T>
+{};
+
+namespace internal {
+
+/// @brief Get if a type is adapted to expression templates.
+template <typename T, typename E = void>
+struct has_expression_traits : std::false_type
+{};
+
+template <typename T>
+struct has_expression_traits<T, std::void_t<decltype(expression_traits<T>::size())>> : std::true_type
+{};
+
+} // namespace internal
+
+/// @brief An expression template wrapping a value.
+/// @tparam T the type of the value
+template <typename T>
+struct terminal_expression : expression<terminal_expression<T>>
+{
+	using value_type = T;
+	const value_type *m_value;
+
+	explicit terminal_expression(const value_type& value) :
+		m_value(&value)
+	{}
+
+	template <size_t I>
+	decltype(auto) get() const
+	{ return expression_traits<value_type>::template get<I>(*m_value); }
+
+}; // struct terminal_expression
+
+/// @brief An expression template representing the sum of two expressions.
+template <typename L, typename R>
+struct plus_expression : expression<plus_expression<L, R>>
+{
+	using value_type = std::decay_t<decltype(std::declval<const typename L::value_type&>() + std::declval<const typename R::value_type&>())>;
+	L m_left;
+	R m_right;
+
+	plus_expression(const L& left, const R& right) :
+		m_left(left), m_right(right)
+	{}
+
+	template <size_t I>
+	auto get() const
+	{ return expression_traits<value_type>::template add<I>(m_left.template get<I>(), m_right.template get<I>()); }
+
+}; // struct plus_expression
+
+/// @brief An expression template representing the difference of two expressions.
+template <typename L, typename R>
+struct minus_expression : expression<minus_expression<L, R>>
+{
+	using value_type = std::decay_t<decltype(std::declval<const typename L::value_type&>() - std::declval<const typename R::value_type&>())>;
+	L m_left;
+	R m_right;
+
+	minus_expression(const L& left, const R& right) :
+		m_left(left), m_right(right)
+	{}
+
+	template <size_t I>
+	auto get() const
+	{ return expression_traits<value_type>::template subtract<I>(m_left.template get<I>(), m_right.template get<I>()); }
+
+}; // struct minus_expression
+
+/// @brief An expression template representing the product of an expression and a scalar.
+template <typename E, typename S>
+struct scale_expression : expression<scale_expression<E, S>>
+{
+	using value_type = std::decay_t<decltype(std::declval<const typename E::value_type&>() * std::declval<const S&>())>;
+	E m_expression;
+	S m_scalar;
+
+	scale_expression(const E& expression, const S& scalar) :
+		m_expression(expression), m_scalar(scalar)
+	{}
+
+	template <size_t I>
+	auto get() const
+	{ return expression_traits<value_type>::template scale<I>(m_expression.template get<I>(), m_scalar); }
+
+}; // struct scale_expression
+
+/// @brief An expression template representing the negation of an expression.
+template <typename E>
+struct negate_expression : expression<negate_expression<E>>
+{
+	using value_type = std::decay_t<decltype(-std::declval<const typename E::value_type&>())>;
+	E m_expression;
+
+	explicit negate_expression(const E& expression) :
+		m_expression(expression)
+	{}
+
+	template <size_t I>
+	auto get() const
+	{ return expression_traits<value_type>::template negate<I>(m_expression.template get<I>()); }
+
+}; // struct negate_expression
+
+/// @brief Wrap a value into an expression template.
+/// @param x the value
+/// @return the expression template
+template <typename T, typename = std::enable_if_t<internal::has_expression_traits<T>::value>>
+terminal_expression<T> lazy(const T& x)
+{ return terminal_expression<T>(x); }
+
+/// @brief Evaluate an expression template.
+/// @param e the expression template
+/// @return the result
+template <typename E>
+typename E::value_type evaluate(const expression<E>& e)
+{ return e; }
+
+namespace internal {
+
+template <typename T>
+const T& as_expression(const expression<T>& e)
+{ return e.derived(); }
+
+template <typename T, typename = std::enable_if_t<has_expression_traits<T>::value>>
+terminal_expression<T> as_expression(const T& x)
+{ return terminal_expression<T>(x); }
+
+template <typename T>
+using expression_t = std::decay_t<decltype(as_expression(std::declval<const T&>()))>;
+
+/// @brief Enabled if at least one operand is an expression template and the other one is an expression template or a value adapted to expression templates.
+template <typename L, typename R>
+using enable_if_expression_operands_t = std::enable_if_t<(is_expression<L>::value || is_expression<R>::value) &&
+                                                         (is_expression<L>::value || has_expression_traits<L>::value) &&
+                                                         (is_expression<R>::value || has_expression_traits<R>::value)>;
+
+} // namespace internal
+
+template <typename L, typename R, typename = internal::enable_if_expression_operands_t<L, R>>
+auto operator+(const L& l, const R& r)
+{ return plus_expression<internal::expression_t<L>, internal::expression_t<R>>(internal::as_expression(l), internal::as_expression(r)); }
+
+template <typename L, typename R, typename = internal::enable_if_expression_operands_t<L, R>>
+auto operator-(const L& l, const R& r)
+{ return minus_expression<internal::expression_t<L>, internal::expression_t<R>>(internal::as_expression(l), internal::as_expression(r)); }
+
+template <typename E>
+auto operator-(const expression<E>& e)
+{ return negate_expression<E>(e.derived()); }
+
+template <typename E, typename S, typename = std::enable_if_t<std::is_arithmetic<S>::value>>
+auto operator*(const expression<E>& e, const S& s)
+{ return scale_expression<E, S>(e.derived(), s); }
+
+namespace internal {
+
+/// @brief Implementation of idlib::expression_traits for types with a subscript operator and scalar arithmetic.
+template <typename T, typename Scalar, size_t Size>
+struct arithmetic_expression_traits
+{
+	using value_type = T;
+	using scalar_type = Scalar;
+
+	static constexpr size_t size()
+	{ return Size; }
+
+	template <size_t I>
+	static const scalar_type& get(const value_type& x)
+	{ return x[I]; }
+
+	template <typename ... Cs>
+	static value_type make(const Cs& ... cs)
+	{ return value_type(cs ...); }
+
+	template <size_t I>
+	static scalar_type add(const scalar_type& x, const scalar_type& y)
+	{ return x + y; }
+
+	template <size_t I>
+	static scalar_type subtract(const scalar_type& x, const scalar_type& y)
+	{ return x - y; }
+
+	template <size_t I>
+	static scalar_type scale(const scalar_type& x, const scalar_type& s)
+	{ return x * s; }
+
+	template <size_t I>
+	static scalar_type negate(const scalar_type& x)
+	{ return -x; }
+
+}; // struct arithmetic_expression_traits
+
+} // namespace internal
+
+template <typename Scalar, size_t Dimensionality>
+struct expression_traits<vector<Scalar, Dimensionality>>
+	: internal::arithmetic_expression_traits<vector<Scalar, Dimensionality>, Scalar, Dimensionality>
+{};
+
+template <typename Vector>
+struct expression_traits<point<Vector>>
+	: internal::arithmetic_expression_traits<point<Vector>, typename Vector::scalar_type, Vector::dimensionality()>
+{};
+
+} // namespace idlib
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/fast_euclidean_norm.hpp
+/// @brief "fast Euclidean norm" functor and function
+/// @author Michael Heilmann
+
+#pragma once
+
+#include <cstddef>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief Functor computing an approximation of the Euclidean norm of a vector.
+/// @detail
+/// The norm \f$|v| = s \cdot \frac{1}{\sqrt{s}}\f$ with \f$s = v \cdot v\f$ is computed from an estimate of the reciprocal square root
+/// refined by @a Refinements Newton-Raphson steps (see idlib::internal::rsqrt_or_one) instead of a square root.
+/// This functor is a norm policy for idlib::normalize:
+/// Normalization multiplies by the reciprocal square root instead of dividing by the norm.
+/// @remark Specializations provide the static member function @a error_bound() returning the maximal relative error
+/// of the norm and of the components of normalized vectors. These bounds are
+/// <table>
+/// <tr><th>Refinements</th><th>@a single</th><th>@a double</th></tr>
+/// <tr><td>0</td><td>\f$2 \cdot 10^{-3}\f$</td><td>\f$2 \cdot 10^{-3}\f$</td></tr>
+/// <tr><td>1</td><td>\f$10^{-5}\f$</td><td>\f$10^{-5}\f$</td></tr>
+/// <tr><td>2 or more</td><td>\f$10^{-6}\f$</td><td>\f$10^{-10}\f$</td></tr>
+/// </table>
+/// The results depend on the processor (but not on the bounds).
+/// @remark The squared norm must be @a 0 or a normal value.
+/// @tparam Vector the vector type
+/// @tparam Refinements the number of Newton-Raphson steps
+template <typename Vector, std::size_t Refinements = 1>
+struct fast_euclidean_norm_functor;
+
+template <std::size_t Refinements = 1, typename Vector>
+auto fast_euclidean_norm(const Vector& v) -> decltype(fast_euclidean_norm_functor<Vector, Refinements>()(v))
+{ return fast_euclidean_norm_functor<Vector, Refinements>()(v); }
+
+namespace internal {
+
+/// @brief The maximal relative error of the reciprocal square roots computed by idlib::internal::rsqrt_or_one.
+/// @remark See idlib::fast_euclidean_norm_functor.
+template <typename Scalar>
+constexpr Scalar rsqrt_error_bound(std::size_t refinements)
+{
+	return refinements == 0 ? Scalar(2e-3)
+		 : refinements == 1 ? Scalar(1e-5)
+		 : sizeof(Scalar) <= sizeof(float) ? Scalar(1e-6) : Scalar(1e-10);
+}
+
+} // namespace internal
+
+} // namespace idlib
@@ -102,7 +102,7 @@ public:
     /// @return the center
     point_type get_center() const
 	{ 
-		static const auto TWO = idlib::one<scalar_type>() + idlib::one<scalar_type>();
+		static constexpr auto TWO = idlib::one<scalar_type>() + idlib::one<scalar_type>();
 		return get_min() + get_size() / TWO;
     }
 
@@ -93,7 +93,7 @@ public:
     /// @return the minimum of this axis aligned cube
     point_type get_min() const
 	{
-		static const auto TWO = one<scalar_type>() + one<scalar_type>();
+		static constexpr auto TWO = one<scalar_type>() + one<scalar_type>();
         return get_center() - one<vector_type>() * (get_size() / TWO);
     }
 
@@ -101,7 +101,7 @@ public:
     /// @return the maximum of this axis aligned cube
     point_type get_max() const
 	{
-		static const auto TWO = one<scalar_type>() + one<scalar_type>();
+		static constexpr auto TWO = one<scalar_type>() + one<scalar_type>();
 		return get_center() + one<vector_type>() * (get_size() / TWO);
     }
 
@@ -0,0 +1,721 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/geometry/bvh.hpp
+/// @brief Bounding volume hierarchies over axis aligned boxes.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/geometry/axis_aligned_box.hpp"
+#include "idlib/math/geometry/ray_intersection.hpp"
+#include "idlib/math/is_enclosing.hpp"
+#include "idlib/math/is_intersecting.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/range/span.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief The options of building an idlib::bvh.
+struct bvh_options
+{
+	/// @brief The maximal number of primitives in a leaf. Must be positive.
+	std::size_t max_leaf_size = 4;
+
+	/// @brief The number of bins per axis of the surface area heuristic. Must be in [2, 64].
+	std::size_t bin_count = 16;
+
+	/// @brief The maximal number of threads, @a 0 selects idlib::get_default_thread_count().
+	std::size_t thread_count = 0;
+
+}; // struct bvh_options
+
+/// @ingroup math
+/// @brief A bounding volume hierarchy (BVH) over axis aligned boxes with a payload each.
+/// @details
+/// The hierarchy is a binary tree built top-down with the binned surface area heuristic (SAH).
+/// Large nodes are binned and split by multiple threads.
+/// The resulting tree only depends on the input and not on the number of threads.
+/// @details
+/// The nodes are stored in a single array in depth-first order:
+/// the left child of an inner node immediately follows that node, the index of the right child is stored in the node.
+/// The boxes and payloads of the primitives are reordered such that the primitives of a leaf are contiguous.
+/// @details
+/// The queries invoke a visitor for each primitive whose box intersects the query geometry.
+/// The tests of the primitive boxes are performed by idlib::is_intersecting, idlib::is_enclosing and idlib::intersect.
+/// @tparam P the point type of the axis aligned boxes. Its scalar type must be a floating point type.
+/// @tparam Payload the payload type
+template <typename P, typename Payload>
+struct bvh
+{
+public:
+	/// @brief The point type of this BVH type.
+	using point_type = P;
+
+	/// @brief The vector type of this BVH type.
+	using vector_type = typename P::vector_type;
+
+	/// @brief The scalar type of this BVH type.
+	using scalar_type = typename P::scalar_type;
+
+	/// @brief The box type of this BVH type.
+	using box_type = axis_aligned_box<P>;
+
+	/// @brief The ray type of this BVH type.
+	using ray_type = ray<P>;
+
+	/// @brief The payload type of this BVH type.
+	using payload_type = Payload;
+
+	static_assert(std::is_floating_point<scalar_type>::value, "scalar type must be a floating point type");
+
+	/// @brief The dimensionality of this BVH type.
+	/// @return the dimensionality
+	static constexpr std::size_t dimensionality()
+	{ return vector_type::dimensionality(); }
+
+	/// @brief A node of a BVH.
+	/// @remark For single precision and three dimensions a node occupies 32 Bytes.
+	struct node
+	{
+		/// @brief The minimum of the bounds of this node along each axis.
+		scalar_type min[dimensionality()];
+		/// @brief The maximum of the bounds of this node along each axis.
+		scalar_type max[dimensionality()];
+		/// @brief If this node is a leaf, the index of its first primitive. Otherwise the index of its right child.
+		std::uint32_t index;
+		/// @brief If this node is a leaf, the number of its primitives (positive). Otherwise @a 0.
+		std::uint32_t count;
+
+		/// @brief Get if this node is a leaf.
+		/// @return @a true if this node is a leaf, @a false otherwise
+		bool is_leaf() const
+		{ return count != 0; }
+	};
+
+	/// @brief The maximal depth of a BVH.
+	/// @remark The surface area heuristic is used up to half of this depth, median splits are used below.
+	static constexpr std::size_t max_depth = 64;
+
+	/// @brief Construct this BVH with no primitives.
+	bvh()
+	{}
+
+	/// @brief Construct this BVH from boxes and their payloads.
+	/// @param boxes the boxes
+	/// @param payloads the payloads
+	/// @param options the build options
+	/// @throw idlib::invalid_argument_error the number of boxes and payloads differ
+	/// @throw idlib::invalid_argument_error the options are invalid
+	/// @throw idlib::invalid_argument_error there are more than 2<sup>31</sup> boxes
+	bvh(span<const box_type> boxes, span<const payload_type> payloads, const bvh_options& options = bvh_options())
+	{
+		if (boxes.size() != payloads.size())
+		{ throw invalid_argument_error(__FILE__, __LINE__, "number of boxes and payloads differ"); }
+		if (options.max_leaf_size == 0)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "maximal leaf size is zero"); }
+		if (options.bin_count < 2 || options.bin_count > max_bin_count)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "bin count is not within [2, 64]"); }
+		if (boxes.size() > (std::size_t(1) << 31))
+		{ throw invalid_argument_error(__FILE__, __LINE__, "too many boxes"); }
+		if (boxes.size() == 0)
+		{ return; }
+		builder b(boxes, options);
+		b.build();
+		b.flatten(m_nodes);
+		m_boxes.reserve(boxes.size());
+		m_payloads.reserve(boxes.size());
+		for (const auto& x : b.references)
+		{
+			m_boxes.push_back(boxes[x.index]);
+			m_payloads.push_back(payloads[x.index]);
+		}
+	}
+
+	bvh(const bvh&) = default;
+	bvh(bvh&&) = default;
+	bvh& operator=(const bvh&) = default;
+	bvh& operator=(bvh&&) = default;
+
+	/// @brief Get the number of primitives of this BVH.
+	/// @return the number of primitives
+	std::size_t size() const
+	{ return m_boxes.size(); }
+
+	/// @brief Get if this BVH has no primitives.
+	/// @return @a true if this BVH has no primitives, @a false otherwise
+	bool empty() const
+	{ return m_boxes.empty(); }
+
+	/// @brief Get the nodes of this BVH.
+	/// @return the nodes in depth-first order, the root is the first node
+	const std::vector<node>& get_nodes() const
+	{ return m_nodes; }
+
+	/// @brief Get the boxes of the primitives of this BVH.
+	/// @return the boxes in the order of the leaves
+	const std::vector<box_type>& get_boxes() const
+	{ return m_boxes; }
+
+	/// @brief Get the payloads of the primitives of this BVH.
+	/// @return the payloads in the order of the leaves
+	const std::vector<payload_type>& get_payloads() const
+	{ return m_payloads; }
+
+	/// @brief Get the bounds of all primitives of this BVH.
+	/// @return the bounds
+	/// @throw idlib::invalid_argument_error this BVH is empty
+	box_type get_bounds() const
+	{
+		if (empty())
+		{ throw invalid_argument_error(__FILE__, __LINE__, "BVH is empty"); }
+		point_type min, max;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			min[i] = m_nodes[0].min[i];
+			max[i] = m_nodes[0].max[i];
+		}
+		return box_type(min, max);
+	}
+
+	/// @brief Visit the primitives whose boxes intersect a box.
+	/// @param box the box
+	/// @param visitor a function invoked as <c>visitor(b, p)</c> for the box @a b and the payload @a p of each primitive
+	template <typename Visitor>
+	void query(const box_type& box, Visitor&& visitor) const
+	{
+		traverse([&box](const node& n) { return overlaps(n.min, n.max, box.get_min(), box.get_max()); },
+		         [&box, &visitor](const box_type& b, const payload_type& p)
+		         { if (is_intersecting(b, box)) visitor(b, p); });
+	}
+
+	/// @brief Visit the primitives whose boxes enclose a point.
+	/// @param point the point
+	/// @param visitor a function invoked as <c>visitor(b, p)</c> for the box @a b and the payload @a p of each primitive
+	template <typename Visitor>
+	void query(const point_type& point, Visitor&& visitor) const
+	{
+		traverse([&point](const node& n) { return overlaps(n.min, n.max, point, point); },
+		         [&point, &visitor](const box_type& b, const payload_type& p)
+		         { if (is_enclosing(b, point)) visitor(b, p); });
+	}
+
+	/// @brief Visit the primitives whose boxes are hit by a ray.
+	/// @param ray the ray
+	/// @param visitor a function invoked as <c>visitor(b, p, t)</c> for the box @a b and the payload @a p of each primitive
+	/// where @a t is the distance from the ray origin at which the ray enters the box (@a 0 if the origin is inside the box)
+	/// @param max_distance primitives entered beyond this distance are not visited
+	/// @remark Children are visited nearest first, hence primitives tend to be visited in ascending order of @a t.
+	template <typename Visitor>
+	void query(const ray_type& ray, Visitor&& visitor,
+	           scalar_type max_distance = std::numeric_limits<scalar_type>::infinity()) const
+	{
+		if (m_nodes.empty()) return;
+		const auto& o = ray.get_origin();
+		const auto& d = ray.get_direction();
+		scalar_type inverse[dimensionality()];
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{ inverse[i] = one<scalar_type>() / d[i]; }
+		std::uint32_t stack[max_depth + 1];
+		std::size_t top = 0;
+		std::uint32_t current = 0;
+		scalar_type t;
+		if (!slab(m_nodes[0].min, m_nodes[0].max, o, d, inverse, max_distance, t)) return;
+		while (true)
+		{
+			const node& n = m_nodes[current];
+			if (n.is_leaf())
+			{
+				for (std::uint32_t i = n.index, e = n.index + n.count; i < e; ++i)
+				{
+					const box_type& b = m_boxes[i];
+					const auto h = intersect(ray, b);
+					if (h.is_hit() && h.get_distance() <= max_distance)
+					{ visitor(b, m_payloads[i], h.get_distance()); }
+				}
+			}
+			else
+			{
+				std::uint32_t l = current + 1, r = n.index;
+				scalar_type tl, tr;
+				bool hl = slab(m_nodes[l].min, m_nodes[l].max, o, d, inverse, max_distance, tl),
+				     hr = slab(m_nodes[r].min, m_nodes[r].max, o, d, inverse, max_distance, tr);
+				if (hl && hr)
+				{
+					if (tr < tl) std::swap(l, r);
+					stack[top++] = r;
+					current = l;
+					continue;
+				}
+				else if (hl)
+				{
+					current = l;
+					continue;
+				}
+				else if (hr)
+				{
+					current = r;
+					continue;
+				}
+			}
+			if (top == 0) break;
+			current = stack[--top];
+		}
+	}
+
+private:
+	static constexpr std::size_t max_bin_count = 64;
+
+	/// @brief Test if the box given by @a amin, @a amax overlaps the box given by @a bmin, @a bmax.
+	template <typename A, typename B>
+	static bool overlaps(const A& amin, const A& amax, const B& bmin, const B& bmax)
+	{
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			if (amin[i] > bmax[i] || amax[i] < bmin[i]) return false;
+		}
+		return true;
+	}
+
+	/// @brief Slab test of a ray against the box given by @a min, @a max.
+	/// @param[out] t the entry distance if the ray hits the box within the maximal distance
+	template <typename A>
+	static bool slab(const A& min, const A& max, const point_type& o, const vector_type& d,
+	                 const scalar_type *inverse, scalar_type max_distance, scalar_type& t)
+	{
+		scalar_type t0 = zero<scalar_type>(), t1 = max_distance;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			if (d[i] == zero<scalar_type>())
+			{
+				if (o[i] < min[i] || o[i] > max[i]) return false;
+				continue;
+			}
+			scalar_type a = (min[i] - o[i]) * inverse[i],
+			            b = (max[i] - o[i]) * inverse[i];
+			if (a > b) std::swap(a, b);
+			t0 = std::max(t0, a);
+			t1 = std::min(t1, b);
+			if (t0 > t1) return false;
+		}
+		t = t0;
+		return true;
+	}
+
+	/// @brief Depth-first traversal invoking a primitive visitor for the primitives of all leaves accepted by a node test.
+	template <typename NodeTest, typename PrimitiveVisitor>
+	void traverse(NodeTest&& test, PrimitiveVisitor&& visitor) const
+	{
+		if (m_nodes.empty() || !test(m_nodes[0])) return;
+		std::uint32_t stack[max_depth + 1];
+		std::size_t top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const node& n = m_nodes[stack[--top]];
+			if (n.is_leaf())
+			{
+				for (std::uint32_t i = n.index, e = n.index + n.count; i < e; ++i)
+				{ visitor(m_boxes[i], m_payloads[i]); }
+				continue;
+			}
+			const std::uint32_t l = std::uint32_t(&n - m_nodes.data()) + 1, r = n.index;
+			if (test(m_nodes[r])) stack[top++] = r;
+			if (test(m_nodes[l])) stack[top++] = l;
+		}
+	}
+
+	/// @brief The bounds of a set of boxes or points.
+	/// @remark Default construction leaves the bounds uninitialized, idlib::bvh::bounds::clear makes them empty.
+	struct bounds
+	{
+		std::array<scalar_type, dimensionality()> min, max;
+
+		void clear()
+		{
+			min.fill(+std::numeric_limits<scalar_type>::infinity());
+			max.fill(-std::numeric_limits<scalar_type>::infinity());
+		}
+
+		template <typename A>
+		void grow(const A& a, const A& b)
+		{
+			for (std::size_t i = 0; i < dimensionality(); ++i)
+			{
+				min[i] = std::min(min[i], a[i]);
+				max[i] = std::max(max[i], b[i]);
+			}
+		}
+
+		void grow(const bounds& other)
+		{ grow(other.min, other.max); }
+
+		/// @brief The surface measure i.e. the sum of the measures of the axis-orthogonal faces.
+		scalar_type area() const
+		{
+			if (min[0] > max[0]) return zero<scalar_type>();
+			if (dimensionality() == 1) return max[0] - min[0];
+			scalar_type a = zero<scalar_type>();
+			for (std::size_t i = 0; i < dimensionality(); ++i)
+			{
+				scalar_type p = one<scalar_type>();
+				for (std::size_t j = 0; j < dimensionality(); ++j)
+				{
+					if (j != i) p *= max[j] - min[j];
+				}
+				a += p;
+			}
+			return a;
+		}
+	};
+
+	/// @brief A bin of the surface area heuristic.
+	struct bin
+	{
+		bounds box;
+		std::uint32_t count;
+	};
+
+	/// @brief The bins along all axes of a range of primitives.
+	/// @remark Only the first idlib::bvh_options::bin_count bins along each axis are used.
+	struct binning
+	{
+		std::array<std::array<bin, max_bin_count>, dimensionality()> bins;
+
+		explicit binning(std::size_t bin_count)
+		{
+			for (std::size_t i = 0; i < dimensionality(); ++i)
+			{
+				for (std::size_t j = 0; j < bin_count; ++j)
+				{
+					bins[i][j].box.clear();
+					bins[i][j].count = 0;
+				}
+			}
+		}
+
+		void merge(const binning& other, std::size_t bin_count)
+		{
+			for (std::size_t i = 0; i < dimensionality(); ++i)
+			{
+				for (std::size_t j = 0; j < bin_count; ++j)
+				{
+					bins[i][j].box.grow(other.bins[i][j].box);
+					bins[i][j].count += other.bins[i][j].count;
+				}
+			}
+		}
+	};
+
+	/// @brief A primitive of the tree under construction.
+	/// @remark The builder partitions these compact copies instead of indices to keep its memory accesses sequential.
+	struct reference
+	{
+		std::array<scalar_type, dimensionality()> min, max, centroid;
+		std::uint32_t index;
+	};
+
+	/// @brief A node of the tree under construction.
+	/// @remark The children of the inner node at index @a i are at indices @a index and <c>index + 1</c>.
+	struct build_node
+	{
+		bounds box;
+		std::uint32_t index;
+		std::uint32_t count;
+	};
+
+	/// @brief Builds the tree into an array of build_node objects and flattens it into depth-first order.
+	struct builder
+	{
+		span<const box_type> boxes;
+		const bvh_options& options;
+		std::size_t thread_count;
+		std::vector<reference> references;
+		std::vector<build_node> nodes;
+		std::atomic<std::uint32_t> node_count;
+
+		/// @brief Ranges of primitives of at least this size are processed by multiple threads.
+		static constexpr std::size_t parallel_grain = 16384;
+
+		builder(span<const box_type> boxes, const bvh_options& options)
+			: boxes(boxes), options(options),
+			  thread_count(options.thread_count ? options.thread_count : get_default_thread_count()),
+			  references(boxes.size()), nodes(2 * boxes.size() - 1), node_count(1)
+		{}
+
+		void build()
+		{
+			parallel_for(0, boxes.size(), parallel_grain, thread_count, [this](std::size_t b, std::size_t e, std::size_t)
+			{
+				static constexpr auto TWO = one<scalar_type>() + one<scalar_type>();
+				for (std::size_t i = b; i < e; ++i)
+				{
+					auto& x = references[i];
+					x.index = std::uint32_t(i);
+					for (std::size_t j = 0; j < dimensionality(); ++j)
+					{
+						x.min[j] = boxes[i].get_min()[j];
+						x.max[j] = boxes[i].get_max()[j];
+						x.centroid[j] = (x.min[j] + x.max[j]) / TWO;
+					}
+				}
+			});
+			build(0, 0, std::uint32_t(boxes.size()), 0, thread_count);
+			nodes.resize(node_count.load());
+		}
+
+		/// @brief Compute the bounds of the boxes and the bounds of the centroids of a range of primitives.
+		void compute_bounds(std::uint32_t begin, std::uint32_t end, std::size_t threads, bounds& box, bounds& centroid_box) const
+		{
+			auto f = [this](std::size_t b, std::size_t e, bounds& box, bounds& centroid_box)
+			{
+				for (std::size_t i = b; i < e; ++i)
+				{
+					const auto& x = references[i];
+					box.grow(x.min, x.max);
+					centroid_box.grow(x.centroid, x.centroid);
+				}
+			};
+			if (threads == 1 || end - begin < 2 * parallel_grain)
+			{
+				f(begin, end, box, centroid_box);
+				return;
+			}
+			std::vector<std::pair<bounds, bounds>> partial(threads);
+			for (auto& x : partial)
+			{
+				x.first.clear();
+				x.second.clear();
+			}
+			std::size_t k = parallel_for(begin, end, parallel_grain, threads, [&](std::size_t b, std::size_t e, std::size_t t)
+			{ f(b, e, partial[t].first, partial[t].second); });
+			for (std::size_t t = 0; t < k; ++t)
+			{
+				box.grow(partial[t].first);
+				centroid_box.grow(partial[t].second);
+			}
+		}
+
+		/// @brief Compute the bin of a centroid along an axis.
+		/// @remark The scaled centroid is clamped before it is converted to an integer.
+		/// Negative values and NaN map to the first bin, values beyond the last bin to the last bin.
+		std::size_t get_bin(const std::array<scalar_type, dimensionality()>& c, std::size_t axis,
+		                    const bounds& centroid_box, scalar_type scale) const
+		{
+			const scalar_type b = (c[axis] - centroid_box.min[axis]) * scale;
+			if (!(b > zero<scalar_type>()))
+			{ return 0; }
+			if (!(b < scalar_type(options.bin_count - 1)))
+			{ return options.bin_count - 1; }
+			return static_cast<std::size_t>(b);
+		}
+
+		/// @brief Compute the bins along all axes of a range of primitives.
+		void compute_bins(std::uint32_t begin, std::uint32_t end, std::size_t threads,
+		                  const bounds& centroid_box, const std::array<scalar_type, dimensionality()>& scale,
+		                  binning& result) const
+		{
+			auto f = [&, this](std::size_t b, std::size_t e, binning& result)
+			{
+				for (std::size_t i = b; i < e; ++i)
+				{
+					const auto& x = references[i];
+					for (std::size_t j = 0; j < dimensionality(); ++j)
+					{
+						if (scale[j] == zero<scalar_type>()) continue;
+						auto& y = result.bins[j][get_bin(x.centroid, j, centroid_box, scale[j])];
+						y.box.grow(x.min, x.max);
+						y.count++;
+					}
+				}
+			};
+			if (threads == 1 || end - begin < 2 * parallel_grain)
+			{
+				f(begin, end, result);
+				return;
+			}
+			std::vector<binning> partial(threads, binning(options.bin_count));
+			std::size_t k = parallel_for(begin, end, parallel_grain, threads, [&](std::size_t b, std::size_t e, std::size_t t)
+			{ f(b, e, partial[t]); });
+			for (std::size_t t = 0; t < k; ++t)
+			{ result.merge(partial[t], options.bin_count); }
+		}
+
+		void build(std::uint32_t index, std::uint32_t begin, std::uint32_t end, std::size_t depth, std::size_t threads)
+		{
+			build_node& n = nodes[index];
+			bounds centroid_box;
+			n.box.clear();
+			centroid_box.clear();
+			compute_bounds(begin, end, threads, n.box, centroid_box);
+			const std::uint32_t count = end - begin;
+			if (count <= options.max_leaf_size)
+			{
+				n.index = begin;
+				n.count = count;
+				return;
+			}
+			std::uint32_t middle = begin;
+			std::array<scalar_type, dimensionality()> scale;
+			bool degenerated = true;
+			for (std::size_t j = 0; j < dimensionality(); ++j)
+			{
+				const scalar_type extent = centroid_box.max[j] - centroid_box.min[j];
+				scale[j] = extent > zero<scalar_type>() ? scalar_type(options.bin_count) / extent : zero<scalar_type>();
+				degenerated = degenerated && extent == zero<scalar_type>();
+			}
+			if (!degenerated && depth < max_depth / 2)
+			{
+				// Binned surface area heuristic.
+				binning binned(options.bin_count);
+				compute_bins(begin, end, threads, centroid_box, scale, binned);
+				std::size_t best_axis = 0, best_bin = 0;
+				scalar_type best_cost = std::numeric_limits<scalar_type>::infinity();
+				for (std::size_t j = 0; j < dimensionality(); ++j)
+				{
+					if (scale[j] == zero<scalar_type>()) continue;
+					const auto& bins = binned.bins[j];
+					// right[i] is the cost of the bins [i, bin_count)
+					std::array<scalar_type, max_bin_count> right;
+					bounds r;
+					r.clear();
+					std::uint32_t rc = 0;
+					for (std::size_t i = options.bin_count - 1; i > 0; --i)
+					{
+						r.grow(bins[i].box);
+						rc += bins[i].count;
+						right[i] = r.area() * scalar_type(rc);
+					}
+					bounds l;
+					l.clear();
+					std::uint32_t lc = 0;
+					for (std::size_t i = 1; i < options.bin_count; ++i)
+					{
+						l.grow(bins[i - 1].box);
+						lc += bins[i - 1].count;
+						if (lc == 0 || lc == count) continue;
+						const scalar_type cost = l.area() * scalar_type(lc) + right[i];
+						if (cost < best_cost)
+						{
+							best_cost = cost;
+							best_axis = j;
+							best_bin = i;
+						}
+					}
+				}
+				if (best_cost < std::numeric_limits<scalar_type>::infinity())
+				{
+					middle = std::uint32_t(std::partition(references.begin() + begin, references.begin() + end,
+					                                      [&](const reference& x)
+					{ return get_bin(x.centroid, best_axis, centroid_box, scale[best_axis]) < best_bin; }) - references.begin());
+				}
+			}
+			if (middle == begin)
+			{
+				// Median split along the axis of largest centroid extent.
+				std::size_t axis = 0;
+				for (std::size_t j = 1; j < dimensionality(); ++j)
+				{
+					if (centroid_box.max[j] - centroid_box.min[j] > centroid_box.max[axis] - centroid_box.min[axis]) axis = j;
+				}
+				middle = begin + count / 2;
+				std::nth_element(references.begin() + begin, references.begin() + middle, references.begin() + end,
+				                 [axis](const reference& x, const reference& y)
+				{ return x.centroid[axis] < y.centroid[axis] || (x.centroid[axis] == y.centroid[axis] && x.index < y.index); });
+			}
+			const std::uint32_t left = node_count.fetch_add(2);
+			n.index = left;
+			n.count = 0;
+			if (threads > 1 && count >= parallel_grain)
+			{
+				const std::size_t l = threads / 2, r = threads - l;
+				parallel_invoke([&]() { build(left + 0, begin, middle, depth + 1, l); },
+				                [&]() { build(left + 1, middle, end, depth + 1, r); });
+			}
+			else
+			{
+				build(left + 0, begin, middle, depth + 1, 1);
+				build(left + 1, middle, end, depth + 1, 1);
+			}
+		}
+
+		/// @brief Flatten the tree into depth-first order.
+		void flatten(std::vector<node>& target) const
+		{
+			target.clear();
+			target.reserve(nodes.size());
+			flatten(0, target);
+		}
+
+		std::uint32_t flatten(std::uint32_t index, std::vector<node>& target) const
+		{
+			const build_node& x = nodes[index];
+			const std::uint32_t i = std::uint32_t(target.size());
+			target.emplace_back();
+			for (std::size_t j = 0; j < dimensionality(); ++j)
+			{
+				target[i].min[j] = x.box.min[j];
+				target[i].max[j] = x.box.max[j];
+			}
+			target[i].count = x.count;
+			if (x.count != 0)
+			{
+				target[i].index = x.index;
+			}
+			else
+			{
+				flatten(x.index + 0, target);
+				const std::uint32_t r = flatten(x.index + 1, target);
+				target[i].index = r;
+			}
+			return i;
+		}
+	};
+
+	/// @brief The nodes in depth-first order.
+	std::vector<node> m_nodes;
+
+	/// @brief The boxes of the primitives in the order of the leaves.
+	std::vector<box_type> m_boxes;
+
+	/// @brief The payloads of the primitives in the order of the leaves.
+	std::vector<payload_type> m_payloads;
+
+}; // struct bvh
+
+} // namespace idlib
@@ -0,0 +1,414 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/geometry/enclose_points.hpp
+/// @brief Bounding volumes of sets of points.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/geometry/axis_aligned_box.hpp"
+#include "idlib/math/geometry/sphere.hpp"
+#include "idlib/math/batch_kernel.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/range/span.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace idlib { namespace internal {
+
+/// @brief The minimal number of points per thread of the bounding volume algorithms.
+constexpr std::size_t enclose_points_grain = 65536;
+
+/// @brief Get the number of scalars of a point.
+/// @remark This may exceed the dimensionality as the storage of points may be padded for SIMD.
+template <typename P>
+constexpr std::size_t get_point_stride()
+{
+	using S = typename P::scalar_type;
+	static_assert(sizeof(P) % sizeof(S) == 0, "unsupported point layout");
+	return sizeof(P) / sizeof(S);
+}
+
+/// @brief Compute the minima and the maxima of the components of points.
+/// @param p a pointer to the first component of the first point
+/// @param n the number of points
+/// @param lower, upper the minima and the maxima to update
+/// @detail
+/// The points are a contiguous array of scalars with a period of @a Stride scalars per point.
+/// A register holds @a W scalars, hence @a Stride registers hold the components of @a W points
+/// and lane @a l of register @a r holds component <c>(r W + l) % Stride</c>.
+/// Hence the points are reduced by lane-wise minima and maxima of @a Stride registers
+/// and the lanes are reduced to the components at the end.
+template <typename S, std::size_t D, std::size_t Stride>
+void min_max(const S *p, std::size_t n, S *lower, S *upper)
+{
+	using V = typename widest_value<S>::type;
+	static constexpr std::size_t W = V::width;
+	std::size_t i = 0;
+	if (W > 1 && n >= W)
+	{
+		V l[Stride], h[Stride];
+		for (std::size_t r = 0; r < Stride; ++r)
+		{ l[r] = h[r] = V::load(p + r * W); }
+		for (i = W; i + W <= n; i += W)
+		{
+			const S *q = p + i * Stride;
+			for (std::size_t r = 0; r < Stride; ++r)
+			{
+				const V x = V::load(q + r * W);
+				l[r] = min(l[r], x);
+				h[r] = max(h[r], x);
+			}
+		}
+		S a[Stride * W], b[Stride * W];
+		for (std::size_t r = 0; r < Stride; ++r)
+		{
+			l[r].store(a + r * W);
+			h[r].store(b + r * W);
+		}
+		for (std::size_t k = 0; k < Stride * W; ++k)
+		{
+			const std::size_t c = k % Stride;
+			if (c >= D) continue;
+			lower[c] = std::min(lower[c], a[k]);
+			upper[c] = std::max(upper[c], b[k]);
+		}
+	}
+	for (; i < n; ++i)
+	{
+		for (std::size_t c = 0; c < D; ++c)
+		{
+			lower[c] = std::min(lower[c], p[i * Stride + c]);
+			upper[c] = std::max(upper[c], p[i * Stride + c]);
+		}
+	}
+}
+
+/// @brief Find the point farthest from a point.
+/// @return the index of the farthest point and its squared distance
+template <typename P>
+std::pair<std::size_t, typename P::scalar_type> find_farthest(span<const P> points, const P& q, std::size_t thread_count)
+{
+	using S = typename P::scalar_type;
+	using result_type = std::pair<std::size_t, S>;
+	if (thread_count == 0) thread_count = get_default_thread_count();
+	std::vector<result_type> results(thread_count, result_type(0, -one<S>()));
+	const std::size_t k = parallel_for(0, points.size(), enclose_points_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t t)
+	{
+		result_type r(b, -one<S>());
+		for (std::size_t i = b; i < e; ++i)
+		{
+			const S d = squared_euclidean_norm(points[i] - q);
+			if (d > r.second) r = result_type(i, d);
+		}
+		results[t] = r;
+	});
+	result_type r = results[0];
+	for (std::size_t t = 1; t < k; ++t)
+	{
+		if (results[t].second > r.second) r = results[t];
+	}
+	return r;
+}
+
+/// @brief Get the smallest radius not smaller than a radius such that a sphere with a center encloses points.
+template <typename P>
+typename P::scalar_type get_enclosing_radius(span<const P> points, const P& center, typename P::scalar_type radius, std::size_t thread_count)
+{
+	using S = typename P::scalar_type;
+	const S d = find_farthest(points, center, thread_count).second;
+	S r = std::max(radius, std::sqrt(d));
+	while (r * r < d) r = std::nextafter(r, std::numeric_limits<S>::infinity());
+	return r;
+}
+
+/// @brief Grow a sphere to enclose a point as by Ritter's algorithm.
+template <typename P>
+void grow(P& center, typename P::scalar_type& radius, const P& p)
+{
+	using S = typename P::scalar_type;
+	const auto v = p - center;
+	const S d2 = squared_euclidean_norm(v);
+	if (d2 <= radius * radius) return;
+	const S d = std::sqrt(d2);
+	const S r = (radius + d) / S(2);
+	center = center + v * ((r - radius) / d);
+	radius = r;
+}
+
+/// @brief Grow a sphere to enclose a sphere.
+template <typename P>
+void grow(P& center, typename P::scalar_type& radius, const P& other_center, typename P::scalar_type other_radius)
+{
+	using S = typename P::scalar_type;
+	const auto v = other_center - center;
+	const S d = std::sqrt(squared_euclidean_norm(v));
+	if (d + other_radius <= radius) return;
+	if (d + radius <= other_radius)
+	{
+		center = other_center;
+		radius = other_radius;
+		return;
+	}
+	const S r = (d + radius + other_radius) / S(2);
+	center = center + v * ((r - radius) / d);
+	radius = r;
+}
+
+/// @brief The minimal enclosing sphere of a small set of points by Welzl's algorithm with the move-to-front heuristic.
+/// @remark See Gärtner, "Fast and Robust Smallest Enclosing Balls", 1999.
+template <typename P>
+struct miniball
+{
+	using scalar_type = typename P::scalar_type;
+	using vector_type = typename P::vector_type;
+	static constexpr std::size_t D = P::dimensionality();
+
+	/// @brief The relative tolerance of the containment test.
+	static constexpr scalar_type tolerance = std::numeric_limits<scalar_type>::epsilon() * scalar_type(64);
+
+	/// @brief The points in move-to-front order.
+	std::vector<P> points;
+
+	P center;
+
+	/// @brief The squared radius or a negative value if the sphere is empty.
+	scalar_type radius_squared;
+
+	/// @brief The points which are on the boundary of the sphere.
+	std::array<P, D + 1> boundary;
+
+	void compute()
+	{ compute(points.size(), 0); }
+
+	bool contains(const P& p) const
+	{ return squared_euclidean_norm(p - center) <= radius_squared * (one<scalar_type>() + tolerance); }
+
+	void compute(std::size_t end, std::size_t k)
+	{
+		set_circumsphere(k);
+		if (k == D + 1) return;
+		for (std::size_t i = 0; i < end; ++i)
+		{
+			if (contains(points[i])) continue;
+			boundary[k] = points[i];
+			compute(i, k + 1);
+			std::rotate(points.begin(), points.begin() + i, points.begin() + i + 1);
+		}
+	}
+
+	/// @brief Set the sphere to the smallest sphere with the first @a k boundary points on its boundary.
+	/// @remark The center is \f$b_0 + \sum_j \lambda_j v_j\f$ with \f$v_j = b_j - b_0\f$
+	/// where \f$2 v_i \cdot \sum_j \lambda_j v_j = v_i \cdot v_i\f$ for all \f$i\f$.
+	/// If the points are (nearly) affinely dependent, the sphere of the first @a k - 1 points is grown to the last point.
+	void set_circumsphere(std::size_t k)
+	{
+		if (k == 0)
+		{
+			radius_squared = -one<scalar_type>();
+			return;
+		}
+		center = boundary[0];
+		radius_squared = zero<scalar_type>();
+		if (k == 1) return;
+		const std::size_t m = k - 1;
+		vector_type v[D];
+		scalar_type a[D][D + 1];
+		scalar_type scale = zero<scalar_type>();
+		for (std::size_t i = 0; i < m; ++i)
+		{ v[i] = boundary[i + 1] - boundary[0]; }
+		for (std::size_t i = 0; i < m; ++i)
+		{
+			for (std::size_t j = 0; j < m; ++j)
+			{ a[i][j] = scalar_type(2) * dot_product(v[i], v[j]); }
+			a[i][m] = dot_product(v[i], v[i]);
+			scale = std::max(scale, a[i][i]);
+		}
+		// Gaussian elimination with partial pivoting.
+		for (std::size_t c = 0; c < m; ++c)
+		{
+			std::size_t pivot = c;
+			for (std::size_t r = c + 1; r < m; ++r)
+			{
+				if (std::abs(a[r][c]) > std::abs(a[pivot][c])) pivot = r;
+			}
+			if (!(std::abs(a[pivot][c]) > scale * tolerance))
+			{
+				set_circumsphere(k - 1);
+				scalar_type radius = std::sqrt(std::max(radius_squared, zero<scalar_type>()));
+				grow(center, radius, boundary[k - 1]);
+				radius_squared = radius * radius;
+				return;
+			}
+			for (std::size_t j = 0; j <= m; ++j) std::swap(a[c][j], a[pivot][j]);
+			for (std::size_t r = c + 1; r < m; ++r)
+			{
+				const scalar_type f = a[r][c] / a[c][c];
+				for (std::size_t j = c; j <= m; ++j) a[r][j] -= f * a[c][j];
+			}
+		}
+		scalar_type lambda[D];
+		for (std::size_t c = m; c-- > 0;)
+		{
+			scalar_type s = a[c][m];
+			for (std::size_t j = c + 1; j < m; ++j) s -= a[c][j] * lambda[j];
+			lambda[c] = s / a[c][c];
+		}
+		auto offset = zero<vector_type>();
+		for (std::size_t i = 0; i < m; ++i) offset += v[i] * lambda[i];
+		center = boundary[0] + offset;
+		radius_squared = squared_euclidean_norm(offset);
+	}
+};
+
+} } // namespace idlib::internal
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief Compute the smallest axis aligned box enclosing points.
+/// @param points the points
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @return the box
+/// @throw idlib::invalid_argument_error there are no points
+/// @remark The minima and the maxima are reduced by SIMD instructions if available and the points are split across threads.
+/// @pre No coordinate is NaN.
+template <typename P>
+axis_aligned_box<P> enclose_points(span<const P> points, std::size_t thread_count = 0)
+{
+	using S = typename P::scalar_type;
+	static constexpr std::size_t D = P::dimensionality();
+	using bounds_type = std::array<S, 2 * D>;
+	if (points.empty())
+	{ throw invalid_argument_error(__FILE__, __LINE__, "no points"); }
+	if (thread_count == 0) thread_count = get_default_thread_count();
+	std::vector<bounds_type> results(thread_count);
+	const std::size_t k = parallel_for(0, points.size(), internal::enclose_points_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t t)
+	{
+		bounds_type& r = results[t];
+		for (std::size_t c = 0; c < D; ++c) r[c] = r[D + c] = points[b][c];
+		internal::min_max<S, D, internal::get_point_stride<P>()>(&points[b][0], e - b, r.data(), r.data() + D);
+	});
+	P lower, upper;
+	for (std::size_t c = 0; c < D; ++c)
+	{
+		lower[c] = results[0][c];
+		upper[c] = results[0][D + c];
+		for (std::size_t t = 1; t < k; ++t)
+		{
+			lower[c] = std::min(lower[c], results[t][c]);
+			upper[c] = std::max(upper[c], results[t][D + c]);
+		}
+	}
+	return axis_aligned_box<P>(lower, upper);
+}
+
+/// @ingroup math
+/// @brief Compute a sphere enclosing points by Ritter's algorithm.
+/// @param points the points
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @return the sphere. Its radius is typically within 5% to 20% of the radius of the minimal enclosing sphere.
+/// @throw idlib::invalid_argument_error there are no points
+/// @remark The initial sphere has the diameter between the point farthest from the first point
+/// and the point farthest from that point. Each thread grows the initial sphere to the points of its range,
+/// the spheres of the threads are then grown to each other. With one thread, this is Ritter's algorithm
+/// (Ritter, "An Efficient Bounding Sphere", Graphics Gems, 1990).
+/// Finally the radius is increased if rounding errors left a point outside of the sphere.
+/// @pre No coordinate is NaN.
+template <typename P>
+sphere<P> enclose_points_ritter(span<const P> points, std::size_t thread_count = 0)
+{
+	using S = typename P::scalar_type;
+	if (points.empty())
+	{ throw invalid_argument_error(__FILE__, __LINE__, "no points"); }
+	if (thread_count == 0) thread_count = get_default_thread_count();
+	const P& y = points[internal::find_farthest(points, points[0], thread_count).first];
+	const P& z = points[internal::find_farthest(points, y, thread_count).first];
+	const P initial_center = y + (z - y) * (one<S>() / S(2));
+	const S initial_radius = std::sqrt(squared_euclidean_norm(z - y)) / S(2);
+	std::vector<std::pair<P, S>> results(thread_count);
+	const std::size_t k = parallel_for(0, points.size(), internal::enclose_points_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t t)
+	{
+		P center = initial_center;
+		S radius = initial_radius;
+		for (std::size_t i = b; i < e; ++i) internal::grow(center, radius, points[i]);
+		results[t] = std::make_pair(center, radius);
+	});
+	P center = results[0].first;
+	S radius = results[0].second;
+	for (std::size_t t = 1; t < k; ++t) internal::grow(center, radius, results[t].first, results[t].second);
+	return sphere<P>(center, internal::get_enclosing_radius(points, center, radius, thread_count));
+}
+
+/// @ingroup math
+/// @brief Compute the minimal sphere enclosing points by Welzl's algorithm.
+/// @param points the points
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @return the sphere. Up to rounding errors, it is the minimal enclosing sphere.
+/// @throw idlib::invalid_argument_error there are no points
+/// @remark The minimal enclosing sphere of a small support set is computed by Welzl's algorithm
+/// with the move-to-front heuristic. The point farthest from its center is searched for by multiple threads.
+/// If that point is outside of the sphere, it is added to the support set and the sphere is recomputed.
+/// As the minimal enclosing sphere of a subset encloses all points only if it is the minimal enclosing sphere of all points,
+/// this terminates with the minimal enclosing sphere, typically after few passes over the points.
+/// (Welzl, "Smallest enclosing disks (balls and ellipsoids)", 1991 and Gärtner, "Fast and Robust Smallest Enclosing Balls", 1999).
+/// Finally the radius is increased if rounding errors left a point outside of the sphere.
+/// @pre No coordinate is NaN.
+template <typename P>
+sphere<P> enclose_points_welzl(span<const P> points, std::size_t thread_count = 0)
+{
+	using S = typename P::scalar_type;
+	/// The maximal number of passes over the points.
+	static constexpr std::size_t max_passes = 256;
+	if (points.empty())
+	{ throw invalid_argument_error(__FILE__, __LINE__, "no points"); }
+	if (thread_count == 0) thread_count = get_default_thread_count();
+	internal::miniball<P> ball;
+	const P& y = points[internal::find_farthest(points, points[0], thread_count).first];
+	ball.points.push_back(y);
+	for (std::size_t pass = 0; pass < max_passes; ++pass)
+	{
+		ball.compute();
+		const auto farthest = internal::find_farthest(points, ball.center, thread_count);
+		if (ball.contains(points[farthest.first])) break;
+		ball.points.insert(ball.points.begin(), points[farthest.first]);
+	}
+	const S radius = std::sqrt(std::max(ball.radius_squared, zero<S>()));
+	return sphere<P>(ball.center, internal::get_enclosing_radius(points, ball.center, radius, thread_count));
+}
+
+} // namespace idlib
@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/geometry/frustum.hpp
+/// @brief Frusta and the bulk culling of spheres and axis aligned boxes.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/geometry/axis_aligned_box.hpp"
+#include "idlib/math/geometry/frustum_kernel.hpp"
+#include "idlib/math/geometry/plane.hpp"
+#include "idlib/math/geometry/sphere.hpp"
+#include "idlib/math/is_intersecting.hpp"
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/vector_batch.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/range/span.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <array>
+#include <cstdint>
+
+namespace idlib {
+
+template <typename P>
+struct frustum;
+
+/// @ingroup math
+/// @brief A frustum.
+/// @detail A frustum is the intersection of the insides of six planes, the left, right, bottom, top, near and far plane.
+/// The inside of a plane \f$\hat{n} \cdot X + d = 0\f$ are the points \f$X\f$ with \f$\hat{n} \cdot X + d \geq 0\f$
+/// i.e. the normals point inwards.
+/// @remark The tests of geometries against a frustum are conservative:
+/// A geometry is considered as intersecting the frustum unless it is outside of at least one plane.
+/// Hence a geometry near a corner of the frustum may be considered as intersecting although it is outside of the frustum.
+/// @tparam S the scalar type
+template <typename S>
+struct frustum<point<vector<S,3>>> : public equal_to_expr<frustum<point<vector<S,3>>>>
+{
+public:
+	/// @brief The point type of this frustum type.
+	using point_type = point<vector<S,3>>;
+
+	/// @brief The scalar type of this frustum type.
+	using scalar_type = S;
+
+	/// @brief The plane type of this frustum type.
+	using plane_type = plane<point_type>;
+
+	/// @brief The matrix type of this frustum type.
+	using matrix_type = matrix<S, 4, 4>;
+
+	/// @brief The number of planes of a frustum.
+	/// @return the number of planes
+	static constexpr std::size_t plane_count()
+	{ return 6; }
+
+	/// @brief Construct this frustum with the default values of a frustum.
+	/// @remark The default frustum is the frustum of the identity matrix i.e. the cube \f$[-1,+1]^3\f$.
+	frustum()
+		: frustum(one<matrix_type>())
+	{}
+
+	/// @brief Construct this frustum from planes.
+	/// @param planes the left, right, bottom, top, near and far plane
+	explicit frustum(const std::array<plane_type, 6>& planes)
+		: m_planes(planes)
+	{}
+
+	/// @brief Construct this frustum from a view projection matrix.
+	/// @param m the matrix mapping points to clip space. The inside of the frustum is mapped to the points
+	/// \f$(x, y, z, w)\f$ with \f$-w \leq x, y, z \leq w\f$.
+	/// @throw std::domain_error the normal of a plane is the zero vector
+	/// @remark The planes are the sums and the differences of the last row and the other rows of the matrix
+	/// (Gribb and Hartmann, "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix", 2001).
+	explicit frustum(const matrix_type& m)
+		: m_planes
+		  {
+			  get_plane(m, 0, one<S>()), get_plane(m, 0, -one<S>()),
+			  get_plane(m, 1, one<S>()), get_plane(m, 1, -one<S>()),
+			  get_plane(m, 2, one<S>()), get_plane(m, 2, -one<S>()),
+		  }
+	{}
+
+	frustum(const frustum&) = default;
+	frustum& operator=(const frustum&) = default;
+
+	/// @brief Get the planes of this frustum.
+	/// @return the left, right, bottom, top, near and far plane
+	const std::array<plane_type, 6>& get_planes() const
+	{ return m_planes; }
+
+	// CRTP
+	bool equal_to(const frustum& other) const
+	{ return m_planes == other.m_planes; }
+
+private:
+	/// @brief Get the plane \f$r_3 + s r_i\f$ of rows of a matrix.
+	static plane_type get_plane(const matrix_type& m, std::size_t i, S s)
+	{ return plane_type(m(3, 0) + s * m(i, 0), m(3, 1) + s * m(i, 1), m(3, 2) + s * m(i, 2), m(3, 3) + s * m(i, 3)); }
+
+	/// @brief The left, right, bottom, top, near and far plane.
+	std::array<plane_type, 6> m_planes;
+
+}; // struct frustum
+
+namespace internal {
+
+/// @brief Get the coefficients \f$(a, b, c, d)\f$ of the planes of a frustum for idlib::internal::frustum_kernel.
+template <typename S>
+std::array<S, 24> get_plane_coefficients(const frustum<point<vector<S, 3>>>& f)
+{
+	std::array<S, 24> coefficients;
+	for (std::size_t i = 0; i < 6; ++i)
+	{
+		const auto& p = f.get_planes()[i];
+		coefficients[4 * i + 0] = p.get_normal()[0];
+		coefficients[4 * i + 1] = p.get_normal()[1];
+		coefficients[4 * i + 2] = p.get_normal()[2];
+		coefficients[4 * i + 3] = p.get_distance();
+	}
+	return coefficients;
+}
+
+/// @brief The minimal number of words of a visibility bitmask per thread.
+constexpr std::size_t cull_grain = 2048;
+
+/// @brief Compute a visibility bitmask by invoking a kernel for each register.
+/// @param n the number of geometries
+/// @param visible the visibility bitmask of at least <c>(n + 31) / 32</c> words
+/// @param f a function invoked as <c>f(v, i)</c> returning the bits of the geometries starting at index @a i,
+/// where the type of @a v is the value type of the kernel
+/// @remark The words are split across threads. A word is written by one thread only.
+template <typename S, typename F>
+void cull(std::size_t n, std::uint32_t *visible, std::size_t thread_count, F&& f)
+{
+	using V = typename widest_value<S>::type;
+	static_assert(32 % V::width == 0, "width must divide 32");
+	parallel_for(0, (n + 31) / 32, cull_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+	{
+		for (std::size_t w = b; w < e; ++w)
+		{
+			const std::size_t i = 32 * w;
+			std::uint32_t word = 0;
+			if (i + 32 <= n)
+			{
+				for (std::size_t k = 0; k < 32; k += V::width)
+				{ word |= f(V(), i + k) << k; }
+			}
+			else
+			{
+				for (std::size_t k = 0; i + k < n; ++k)
+				{ word |= f(scalar_value<S>(), i + k) << k; }
+			}
+			visible[w] = word;
+		}
+	});
+}
+
+} // namespace internal
+
+/// @ingroup math
+/// @brief Cull spheres against a frustum.
+/// @param f the frustum
+/// @param centers the centers of the spheres
+/// @param radii the radii of the spheres
+/// @param visible receives the visibility bitmask. Bit <c>i % 32</c> of word <c>i / 32</c> is set if sphere @a i intersects the frustum.
+/// The bits of the last word beyond the number of spheres are cleared.
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throw idlib::invalid_argument_error the number of radii is not the number of centers
+/// @throw idlib::invalid_argument_error the bitmask has less than <c>(n + 31) / 32</c> words for @a n spheres
+/// @remark The results are identical to the results of idlib::is_intersecting for idlib::frustum and idlib::sphere values.
+template <typename S>
+void cull_spheres(const frustum<point<vector<S, 3>>>& f, const vector_batch<S, 3>& centers,
+                  span<const typename vector_batch<S, 3>::scalar_type> radii, span<std::uint32_t> visible, std::size_t thread_count = 0)
+{
+	if (radii.size() != centers.size())
+	{ throw invalid_argument_error(__FILE__, __LINE__, "number of radii is not the number of centers"); }
+	if (visible.size() < (centers.size() + 31) / 32)
+	{ throw invalid_argument_error(__FILE__, __LINE__, "bitmask is too small"); }
+	const auto planes = internal::get_plane_coefficients(f);
+	const S *x = centers.data(0), *y = centers.data(1), *z = centers.data(2), *r = radii.data();
+	internal::cull<S>(centers.size(), visible.data(), thread_count, [&](auto v, std::size_t i)
+	{ return internal::frustum_kernel<decltype(v)>::spheres(planes.data(), x + i, y + i, z + i, r + i); });
+}
+
+/// @ingroup math
+/// @brief Cull axis aligned boxes against a frustum.
+/// @param f the frustum
+/// @param min, max the minima and the maxima of the boxes
+/// @param visible receives the visibility bitmask. Bit <c>i % 32</c> of word <c>i / 32</c> is set if box @a i intersects the frustum.
+/// The bits of the last word beyond the number of boxes are cleared.
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throw idlib::invalid_argument_error the number of maxima is not the number of minima
+/// @throw idlib::invalid_argument_error the bitmask has less than <c>(n + 31) / 32</c> words for @a n boxes
+/// @remark The results are identical to the results of idlib::is_intersecting for idlib::frustum and idlib::axis_aligned_box values.
+template <typename S>
+void cull_boxes(const frustum<point<vector<S, 3>>>& f, const vector_batch<S, 3>& min, const vector_batch<S, 3>& max,
+                span<std::uint32_t> visible, std::size_t thread_count = 0)
+{
+	if (min.size() != max.size())
+	{ throw invalid_argument_error(__FILE__, __LINE__, "number of maxima is not the number of minima"); }
+	if (visible.size() < (min.size() + 31) / 32)
+	{ throw invalid_argument_error(__FILE__, __LINE__, "bitmask is too small"); }
+	const auto planes = internal::get_plane_coefficients(f);
+	internal::cull<S>(min.size(), visible.data(), thread_count, [&](auto v, std::size_t i)
+	{
+		const S *lower[3] = { min.data(0) + i, min.data(1) + i, min.data(2) + i };
+		const S *upper[3] = { max.data(0) + i, max.data(1) + i, max.data(2) + i };
+		return internal::frustum_kernel<decltype(v)>::boxes(planes.data(), lower, upper);
+	});
+}
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a frustum and a sphere intersect.
+/// @remark The test is conservative, see idlib::frustum.
+/// A sphere is outside of a plane if the signed distance of its center from the plane is smaller than the negated radius.
+template <typename P>
+struct is_intersecting_functor<frustum<P>, sphere<P>>
+{
+	bool operator()(const frustum<P>& a, const sphere<P>& b) const
+	{
+		using V = internal::scalar_value<typename P::scalar_type>;
+		const auto planes = internal::get_plane_coefficients(a);
+		const auto& c = b.get_center();
+		return internal::frustum_kernel<V>::spheres(planes.data(), &c[0], &c[1], &c[2], &b.get_radius()) != 0;
+	}
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a sphere and a frustum intersect.
+/// @remark The method for determinating if a frustum and a sphere intersect is
+/// commutative. By swapping the arguments that method can be reused to determine if a
+/// sphere and a frustum intersect.
+template <typename P>
+struct is_intersecting_functor<sphere<P>, frustum<P>>
+{
+	bool operator()(const sphere<P>& a, const frustum<P>& b) const
+	{ return is_intersecting(b, a); }
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a frustum and an axis aligned box intersect.
+/// @remark The test is conservative, see idlib::frustum.
+/// A box is outside of a plane if its corner farthest along the normal of the plane is outside of the plane.
+template <typename P>
+struct is_intersecting_functor<frustum<P>, axis_aligned_box<P>>
+{
+	bool operator()(const frustum<P>& a, const axis_aligned_box<P>& b) const
+	{
+		using V = internal::scalar_value<typename P::scalar_type>;
+		const auto planes = internal::get_plane_coefficients(a);
+		const typename P::scalar_type *lower[3] = { &b.get_min()[0], &b.get_min()[1], &b.get_min()[2] };
+		const typename P::scalar_type *upper[3] = { &b.get_max()[0], &b.get_max()[1], &b.get_max()[2] };
+		return internal::frustum_kernel<V>::boxes(planes.data(), lower, upper) != 0;
+	}
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if an axis aligned box and a frustum intersect.
+/// @remark The method for determinating if a frustum and an axis aligned box intersect is
+/// commutative. By swapping the arguments that method can be reused to determine if an
+/// axis aligned box and a frustum intersect.
+template <typename P>
+struct is_intersecting_functor<axis_aligned_box<P>, frustum<P>>
+{
+	bool operator()(const axis_aligned_box<P>& a, const frustum<P>& b) const
+	{ return is_intersecting(b, a); }
+}; // struct is_intersecting_functor
+
+} // namespace idlib
@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/geometry/frustum_kernel.hpp
+/// @brief Kernels of the culling of spheres and axis aligned boxes against frusta.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/batch_kernel.hpp"
+#include <cstdint>
+
+namespace idlib { namespace internal {
+
+/// @brief Kernels testing geometries in structure-of-arrays layout against the six planes of a frustum.
+/// @detail
+/// The planes are passed as an array of six times four scalars \f$(a, b, c, d)\f$,
+/// the inside of a plane are the points \f$X\f$ with \f$a X_0 + b X_1 + c X_2 + d \geq 0\f$.
+/// A geometry is culled if it is outside of at least one plane.
+/// The geometries are passed as pointers to the arrays of their components. A value holds one geometry
+/// (idlib::internal::scalar_value) or several geometries (idlib::internal::simd_value).
+/// Each kernel returns the bits of the visible geometries, geometry @a i at bit @a i.
+/// @tparam V the value type
+/// @remark Each algorithm is written once in terms of the value type.
+/// Hence the test of a single geometry and the test of several geometries compute identical results.
+template <typename V>
+struct frustum_kernel
+{
+	using scalar_type = typename V::scalar_type;
+
+	/// @brief The number of planes of a frustum.
+	static constexpr std::size_t plane_count = 6;
+
+	/// @brief The bits of all geometries.
+	static constexpr std::uint32_t all = (std::uint32_t(1) << V::width) - 1;
+
+	/// @brief Test spheres.
+	/// @param x, y, z the components of the centers
+	/// @param r the radii
+	/// @remark A sphere is outside of a plane if the signed distance of its center is smaller than the negated radius.
+	static std::uint32_t spheres(const scalar_type *planes, const scalar_type *x, const scalar_type *y, const scalar_type *z,
+	                             const scalar_type *r)
+	{
+		const V cx = V::load(x), cy = V::load(y), cz = V::load(z), cr = V::load(r), zero = V::broadcast(scalar_type(0));
+		std::uint32_t outside = 0;
+		for (std::size_t i = 0; i < plane_count; ++i, planes += 4)
+		{
+			const V distance = V::broadcast(planes[0]) * cx + V::broadcast(planes[1]) * cy + V::broadcast(planes[2]) * cz
+			                 + V::broadcast(planes[3]);
+			outside |= bits_less(distance + cr, zero);
+		}
+		return ~outside & all;
+	}
+
+	/// @brief Test axis aligned boxes.
+	/// @param min, max the pointers to the arrays of the components of the minima and the maxima
+	/// @remark A box is outside of a plane if its corner farthest along the normal of the plane is outside of the plane.
+	static std::uint32_t boxes(const scalar_type *planes, const scalar_type *const *min, const scalar_type *const *max)
+	{
+		const V lower[3] = { V::load(min[0]), V::load(min[1]), V::load(min[2]) };
+		const V upper[3] = { V::load(max[0]), V::load(max[1]), V::load(max[2]) };
+		const V zero = V::broadcast(scalar_type(0));
+		std::uint32_t outside = 0;
+		for (std::size_t i = 0; i < plane_count; ++i, planes += 4)
+		{
+			const V& px = planes[0] < scalar_type(0) ? lower[0] : upper[0];
+			const V& py = planes[1] < scalar_type(0) ? lower[1] : upper[1];
+			const V& pz = planes[2] < scalar_type(0) ? lower[2] : upper[2];
+			const V distance = V::broadcast(planes[0]) * px + V::broadcast(planes[1]) * py + V::broadcast(planes[2]) * pz
+			                 + V::broadcast(planes[3]);
+			outside |= bits_less(distance, zero);
+		}
+		return ~outside & all;
+	}
+
+}; // struct frustum_kernel
+
+} } // namespace idlib::internal
@@ -30,3 +30,12 @@
 #include "idlib/math/geometry/plane.hpp"
 #include "idlib/math/geometry/ray.hpp"
 #include "idlib/math/geometry/sphere.hpp"
+#include "idlib/math/geometry/ray_intersection.hpp"
+#include "idlib/math/geometry/bvh.hpp"
+#include "idlib/math/geometry/spatial_hash_grid.hpp"
+#include "idlib/math/geometry/sweep_and_prune.hpp"
+#include "idlib/math/geometry/loose_octree.hpp"
+#include "idlib/math/geometry/frustum.hpp"
+#include "idlib/math/geometry/enclose_points.hpp"
+#include "idlib/math/geometry/kd_tree.hpp"
+#include "idlib/math/geometry/quantized_box.hpp"
@@ -55,5 +55,6 @@ INSTANTIATE(sphere)
 	template struct idlib::A<idlib::point<idlib::vector<quadruple, 3>>>;
 
 INSTANTIATE(plane)
+INSTANTIATE(frustum)
 
 #undef INSTANTIATION
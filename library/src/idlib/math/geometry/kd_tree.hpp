@@ -0,0 +1,390 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/geometry/kd_tree.hpp
+/// @brief Static k-d trees over points.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/point.hpp"
+#include "idlib/math/vector.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/range/span.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A neighbor found by a query of an idlib::kd_tree.
+/// @tparam S the scalar type
+template <typename S>
+struct kd_tree_neighbor
+{
+	/// @brief The index of the point in the points the k-d tree was built from.
+	std::uint32_t index;
+
+	/// @brief The distance of the point from the query point as measured by the norm of the k-d tree.
+	S distance;
+
+}; // struct kd_tree_neighbor
+
+/// @ingroup math
+/// @brief A static k-d tree over points.
+/// @details
+/// The tree is a complete binary tree stored in flat arrays in breadth-first order such that
+/// the children of inner node @a i are the nodes <c>2 i + 1</c> and <c>2 i + 2</c>.
+/// An inner node splits its points at the median along the axis of the greatest extent of their bounding box,
+/// the lower half goes to its left child and the upper half goes to its right child.
+/// Hence the range of points of a node follows from its index and the points are stored contiguously in leaf order.
+/// The depth is the least depth such that no leaf has more than the leaf size points.
+/// @details
+/// The distance between points is measured by a norm of their difference vector,
+/// by default idlib::squared_euclidean_norm. idlib::manhattan_norm_functor and idlib::maximum_norm_functor can be used as well.
+/// The distance of a query point to the cell of a node is bounded from below by the norm of its offsets from the splitting planes,
+/// hence any norm which is monotone in the absolute values of the components can be used.
+/// @details
+/// The tree is built by multiple threads, one level at a time. Single queries are performed by the calling thread,
+/// batched queries are split across threads.
+/// @tparam P the point type. Its scalar type must be a floating point type.
+/// @tparam Norm the type of the norm functor
+template <typename P, typename Norm = squared_euclidean_norm_functor<typename P::vector_type>>
+struct kd_tree
+{
+public:
+	/// @brief The point type of this k-d tree type.
+	using point_type = P;
+
+	/// @brief The scalar type of this k-d tree type.
+	using scalar_type = typename P::scalar_type;
+
+	/// @brief The vector type of this k-d tree type.
+	using vector_type = typename P::vector_type;
+
+	/// @brief The norm functor type of this k-d tree type.
+	using norm_type = Norm;
+
+	/// @brief The neighbor type of this k-d tree type.
+	using neighbor_type = kd_tree_neighbor<scalar_type>;
+
+	/// @brief The index type of this k-d tree type.
+	using index_type = std::uint32_t;
+
+	/// @brief The index of a neighbor which was not found.
+	static constexpr index_type invalid_index = std::numeric_limits<index_type>::max();
+
+	static_assert(std::is_floating_point<scalar_type>::value, "scalar type must be a floating point type");
+
+	/// @brief The dimensionality of this k-d tree type.
+	/// @return the dimensionality
+	static constexpr std::size_t dimensionality()
+	{ return P::dimensionality(); }
+
+	/// @brief The greatest depth of a k-d tree.
+	static constexpr std::size_t max_depth = 32;
+
+	/// @brief Construct this k-d tree without points.
+	/// @param norm the norm functor
+	explicit kd_tree(const norm_type& norm = norm_type()) :
+		m_norm(norm), m_depth(0)
+	{}
+
+	/// @brief Construct this k-d tree over points.
+	/// @param points the points
+	/// @param leaf_size the maximal number of points of a leaf
+	/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+	/// @param norm the norm functor
+	/// @throw idlib::invalid_argument_error @a leaf_size is @a 0, a coordinate is not finite or there are too many points
+	explicit kd_tree(span<const P> points, std::size_t leaf_size = 8, std::size_t thread_count = 0, const norm_type& norm = norm_type()) :
+		m_norm(norm), m_depth(0)
+	{
+		if (leaf_size == 0)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "leaf size is 0"); }
+		if (points.size() >= invalid_index)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "too many points"); }
+		for (const auto& p : points)
+		{
+			for (std::size_t i = 0; i < dimensionality(); ++i)
+			{
+				if (!std::isfinite(p[i]))
+				{ throw invalid_argument_error(__FILE__, __LINE__, "coordinate is not finite"); }
+			}
+		}
+		const std::size_t n = points.size();
+		while (((n + (std::size_t(1) << m_depth) - 1) >> m_depth) > leaf_size) ++m_depth;
+		m_indices.resize(n);
+		for (std::size_t i = 0; i < n; ++i) m_indices[i] = index_type(i);
+		m_splits.resize(get_inner_node_count());
+		m_axes.resize(get_inner_node_count());
+		for (std::size_t level = 0; level < m_depth; ++level)
+		{
+			const std::size_t first = (std::size_t(1) << level) - 1;
+			parallel_for(first, 2 * first + 1, 1, thread_count, [this, &points](std::size_t b, std::size_t e, std::size_t)
+			{
+				for (std::size_t node = b; node < e; ++node) split(points, node);
+			});
+		}
+		m_points.resize(n);
+		parallel_for(0, n, 4096, thread_count, [this, &points](std::size_t b, std::size_t e, std::size_t)
+		{
+			for (std::size_t i = b; i < e; ++i) m_points[i] = points[m_indices[i]];
+		});
+	}
+
+	/// @brief Get the number of points of this k-d tree.
+	/// @return the number of points
+	std::size_t size() const
+	{ return m_points.size(); }
+
+	/// @brief Get if this k-d tree has no points.
+	/// @return @a true if this k-d tree has no points, @a false otherwise
+	bool empty() const
+	{ return m_points.empty(); }
+
+	/// @brief Get the depth of this k-d tree.
+	/// @return the number of levels of inner nodes
+	std::size_t get_depth() const
+	{ return m_depth; }
+
+	/// @brief Get the norm functor of this k-d tree.
+	/// @return the norm functor
+	const norm_type& get_norm() const
+	{ return m_norm; }
+
+	/// @brief Find the nearest points of a point.
+	/// @param q the query point
+	/// @param k the number of points to find
+	/// @param [out] result receives the <c>min(k, size())</c> nearest points ordered by ascending distance.
+	/// Points with equal distances are ordered arbitrarily.
+	void query_nearest(const P& q, std::size_t k, std::vector<neighbor_type>& result) const
+	{
+		result.clear();
+		k = std::min(k, size());
+		if (k == 0) return;
+		const auto less = [](const neighbor_type& x, const neighbor_type& y) { return x.distance < y.distance; };
+		visit(q, [&result, k](scalar_type bound) { return result.size() == k && !(bound < result.front().distance); },
+		      [&result, &less, k](index_type index, scalar_type distance)
+		{
+			if (result.size() < k)
+			{
+				result.push_back(neighbor_type{ index, distance });
+				std::push_heap(result.begin(), result.end(), less);
+			}
+			else if (distance < result.front().distance)
+			{
+				std::pop_heap(result.begin(), result.end(), less);
+				result.back() = neighbor_type{ index, distance };
+				std::push_heap(result.begin(), result.end(), less);
+			}
+		});
+		std::sort_heap(result.begin(), result.end(), less);
+	}
+
+	/// @brief Find the points within a distance of a point.
+	/// @param q the query point
+	/// @param radius the distance as measured by the norm, for the default norm this is the squared radius
+	/// @param [out] result receives the points whose distance is not greater than @a radius in arbitrary order
+	void query_radius(const P& q, scalar_type radius, std::vector<neighbor_type>& result) const
+	{
+		result.clear();
+		if (empty() || !(radius >= zero<scalar_type>())) return;
+		visit(q, [radius](scalar_type bound) { return bound > radius; },
+		      [&result, radius](index_type index, scalar_type distance)
+		{
+			if (!(distance > radius)) result.push_back(neighbor_type{ index, distance });
+		});
+	}
+
+	/// @brief Find the nearest points of multiple points.
+	/// @param queries the query points
+	/// @param k the number of points to find per query point
+	/// @param [out] result receives @a k neighbors per query point in the order of the query points,
+	/// the neighbors of a query point are ordered by ascending distance.
+	/// If there are less than @a k points, the remaining neighbors have the index @a invalid_index and an infinite distance.
+	/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+	/// @throw idlib::invalid_argument_error the size of @a result is not <c>k * queries.size()</c>
+	void query_nearest(span<const P> queries, std::size_t k, span<neighbor_type> result, std::size_t thread_count = 0) const
+	{
+		if (result.size() != k * queries.size())
+		{ throw invalid_argument_error(__FILE__, __LINE__, "size of result is not k times the number of queries"); }
+		parallel_for(0, queries.size(), query_grain, thread_count, [this, &queries, &result, k](std::size_t b, std::size_t e, std::size_t)
+		{
+			std::vector<neighbor_type> neighbors;
+			for (std::size_t i = b; i < e; ++i)
+			{
+				query_nearest(queries[i], k, neighbors);
+				neighbor_type *target = result.data() + i * k;
+				std::copy(neighbors.cbegin(), neighbors.cend(), target);
+				std::fill(target + neighbors.size(), target + k, neighbor_type{ invalid_index, std::numeric_limits<scalar_type>::infinity() });
+			}
+		});
+	}
+
+	/// @brief Find the points within a distance of multiple points.
+	/// @param queries the query points
+	/// @param radius the distance as measured by the norm, for the default norm this is the squared radius
+	/// @param [out] result receives one vector of neighbors per query point in the order of the query points
+	/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+	void query_radius(span<const P> queries, scalar_type radius, std::vector<std::vector<neighbor_type>>& result, std::size_t thread_count = 0) const
+	{
+		result.resize(queries.size());
+		parallel_for(0, queries.size(), query_grain, thread_count, [this, &queries, &result, radius](std::size_t b, std::size_t e, std::size_t)
+		{
+			for (std::size_t i = b; i < e; ++i) query_radius(queries[i], radius, result[i]);
+		});
+	}
+
+private:
+	/// @brief The minimal number of query points per thread of batched queries.
+	static constexpr std::size_t query_grain = 64;
+
+	/// @brief A subtree to visit.
+	struct pending
+	{
+		std::size_t node;
+		std::size_t begin, end;
+		/// @brief A lower bound of the distance of the query point from the points of the subtree.
+		scalar_type bound;
+	};
+
+	std::size_t get_inner_node_count() const
+	{ return (std::size_t(1) << m_depth) - 1; }
+
+	static std::size_t get_middle(std::size_t begin, std::size_t end)
+	{ return begin + (end - begin) / 2; }
+
+	/// @brief Get the range of points of a node.
+	std::pair<std::size_t, std::size_t> get_range(std::size_t node) const
+	{
+		std::size_t begin = 0, end = m_indices.size();
+		const std::size_t path = node + 1;
+		std::size_t level = 0;
+		while ((path >> (level + 1)) != 0) ++level;
+		while (level-- > 0)
+		{
+			const std::size_t middle = get_middle(begin, end);
+			if ((path >> level) & 1) begin = middle;
+			else end = middle;
+		}
+		return std::make_pair(begin, end);
+	}
+
+	/// @brief Split the range of points of an inner node at the median along the axis of the greatest extent.
+	void split(span<const P> points, std::size_t node)
+	{
+		const auto range = get_range(node);
+		index_type *begin = m_indices.data() + range.first, *end = m_indices.data() + range.second;
+		P lower = points[*begin], upper = points[*begin];
+		for (const index_type *i = begin + 1; i < end; ++i)
+		{
+			for (std::size_t j = 0; j < dimensionality(); ++j)
+			{
+				lower[j] = std::min(lower[j], points[*i][j]);
+				upper[j] = std::max(upper[j], points[*i][j]);
+			}
+		}
+		std::size_t axis = 0;
+		for (std::size_t j = 1; j < dimensionality(); ++j)
+		{
+			if (upper[j] - lower[j] > upper[axis] - lower[axis]) axis = j;
+		}
+		index_type *middle = m_indices.data() + get_middle(range.first, range.second);
+		std::nth_element(begin, middle, end, [&points, axis](index_type x, index_type y) { return points[x][axis] < points[y][axis]; });
+		m_axes[node] = std::uint8_t(axis);
+		m_splits[node] = points[*middle][axis];
+	}
+
+	/// @brief Visit the leaves nearest to a query point first.
+	/// @param q the query point
+	/// @param prune receives a lower bound of the distance of a subtree and returns if the subtree is skipped
+	/// @param f receives the index and the distance of each point of a visited leaf
+	template <typename Prune, typename F>
+	void visit(const P& q, Prune prune, F f) const
+	{
+		std::array<pending, max_depth + 1> stack;
+		std::size_t top = 0;
+		stack[top++] = pending{ 0, 0, size(), zero<scalar_type>() };
+		const std::size_t inner_node_count = get_inner_node_count();
+		while (top > 0)
+		{
+			pending x = stack[--top];
+			if (prune(x.bound)) continue;
+			while (x.node < inner_node_count)
+			{
+				const std::size_t axis = m_axes[x.node];
+				const std::size_t middle = get_middle(x.begin, x.end);
+				vector_type offset = zero<vector_type>();
+				offset[axis] = q[axis] - m_splits[x.node];
+				const scalar_type bound = std::max(x.bound, m_norm(offset));
+				const std::size_t left = 2 * x.node + 1, right = 2 * x.node + 2;
+				if (offset[axis] < zero<scalar_type>())
+				{
+					stack[top++] = pending{ right, middle, x.end, bound };
+					x = pending{ left, x.begin, middle, x.bound };
+				}
+				else
+				{
+					stack[top++] = pending{ left, x.begin, middle, bound };
+					x = pending{ right, middle, x.end, x.bound };
+				}
+			}
+			for (std::size_t i = x.begin; i < x.end; ++i)
+			{ f(m_indices[i], m_norm(m_points[i] - q)); }
+		}
+	}
+
+	norm_type m_norm;
+
+	/// @brief The number of levels of inner nodes.
+	std::size_t m_depth;
+
+	/// @brief The points in leaf order.
+	std::vector<P> m_points;
+
+	/// @brief The indices of the points in leaf order in the points the tree was built from.
+	std::vector<index_type> m_indices;
+
+	/// @brief The splitting coordinates of the inner nodes.
+	std::vector<scalar_type> m_splits;
+
+	/// @brief The splitting axes of the inner nodes.
+	std::vector<std::uint8_t> m_axes;
+
+}; // struct kd_tree
+
+} // namespace idlib
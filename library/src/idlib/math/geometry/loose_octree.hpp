@@ -0,0 +1,699 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/geometry/loose_octree.hpp
+/// @brief Loose octrees over axis aligned boxes.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/geometry/axis_aligned_box.hpp"
+#include "idlib/math/geometry/axis_aligned_cube.hpp"
+#include "idlib/math/geometry/plane.hpp"
+#include "idlib/math/geometry/sphere.hpp"
+#include "idlib/math/is_enclosing.hpp"
+#include "idlib/math/is_intersecting.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/range/span.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief The memory usage of an idlib::loose_octree.
+struct loose_octree_memory_usage
+{
+	/// @brief The number of objects.
+	std::size_t object_count = 0;
+
+	/// @brief The number of nodes.
+	std::size_t node_count = 0;
+
+	/// @brief The number of Bytes allocated for objects and handles.
+	std::size_t object_bytes = 0;
+
+	/// @brief The number of Bytes allocated for nodes.
+	std::size_t node_bytes = 0;
+
+	/// @brief Get the number of Bytes allocated.
+	/// @return the number of Bytes
+	std::size_t get_bytes() const
+	{ return object_bytes + node_bytes; }
+
+	/// @brief Get the number of Bytes allocated per object.
+	/// @return the number of Bytes per object, @a 0 if there are no objects
+	std::size_t get_bytes_per_object() const
+	{ return object_count == 0 ? 0 : get_bytes() / object_count; }
+
+}; // struct loose_octree_memory_usage
+
+/// @ingroup math
+/// @brief A loose octree over axis aligned boxes.
+/// @details
+/// The nodes of the octree partition an axis aligned cube, the bounds, into cubic cells.
+/// The loose cube of a node has the center of its cell and twice its size.
+/// A box is stored in the deepest node whose cell contains the center of the box and whose cell size is not smaller
+/// than the extent of the box along any axis. Hence the box is enclosed by the loose cube of its node.
+/// Boxes whose center is not within the bounds are stored in the root and are tested by every query.
+/// @details
+/// Boxes are identified by handles which are returned by insert and remain valid until remove.
+/// The boxes of a node are kept in an intrusive list such that moving a box only relinks the box.
+/// If a box moves within the cell of its node, only the box is replaced.
+/// Otherwise the path to its new node starts from the closest common ancestor rather than from the root,
+/// which is a constant number of steps for coherent motion.
+/// @details
+/// Nodes are allocated from a pool and are released once they have neither boxes nor children.
+/// As each box keeps at most its node and the ancestors of its node alive, the number of nodes is at most
+/// <c>1 + n * max_depth</c> for @a n boxes.
+/// @details
+/// Queries visit the nodes whose loose cubes intersect the query geometry.
+/// The exact tests are performed by idlib::is_intersecting.
+/// @tparam P the point type of the axis aligned boxes. Its scalar type must be a floating point type.
+template <typename P>
+struct loose_octree
+{
+public:
+	/// @brief The point type of this loose octree type.
+	using point_type = P;
+
+	/// @brief The scalar type of this loose octree type.
+	using scalar_type = typename P::scalar_type;
+
+	/// @brief The box type of this loose octree type.
+	using box_type = axis_aligned_box<P>;
+
+	/// @brief The cube type of this loose octree type.
+	using cube_type = axis_aligned_cube<P>;
+
+	/// @brief The plane type of this loose octree type.
+	using plane_type = plane<P>;
+
+	/// @brief The handle type of this loose octree type.
+	using handle_type = std::uint32_t;
+
+	static_assert(std::is_floating_point<scalar_type>::value, "scalar type must be a floating point type");
+
+	/// @brief The dimensionality of this loose octree type.
+	/// @return the dimensionality
+	static constexpr std::size_t dimensionality()
+	{ return P::dimensionality(); }
+
+	static_assert(dimensionality() >= 1 && dimensionality() <= 3, "dimensionality must be within [1, 3]");
+
+	/// @brief The number of children of a node of this loose octree type.
+	/// @return the number of children
+	static constexpr std::size_t child_count()
+	{ return std::size_t(1) << dimensionality(); }
+
+	/// @brief The greatest maximal depth of a loose octree.
+	static constexpr std::size_t max_max_depth = 24;
+
+	/// @brief Construct this loose octree with no boxes.
+	/// @param bounds the bounds
+	/// @param max_depth the maximal depth of a node, the root has depth @a 0
+	/// @throw idlib::invalid_argument_error the size of the bounds is not positive or a coordinate is not finite
+	/// @throw idlib::invalid_argument_error the maximal depth is greater than idlib::loose_octree::max_max_depth
+	explicit loose_octree(const cube_type& bounds, std::size_t max_depth = 8)
+		: m_bounds(bounds), m_min(bounds.get_min()), m_max_depth(max_depth)
+	{
+		if (!(bounds.get_size() > zero<scalar_type>()) || !std::isfinite(bounds.get_size()))
+		{ throw invalid_argument_error(__FILE__, __LINE__, "size is not positive or not finite"); }
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			if (!std::isfinite(m_min[i]) || !std::isfinite(bounds.get_max()[i]))
+			{ throw invalid_argument_error(__FILE__, __LINE__, "coordinate is not finite"); }
+		}
+		if (max_depth > max_max_depth)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "maximal depth is too great"); }
+		scalar_type size = bounds.get_size();
+		for (std::size_t level = 0; level <= max_depth; ++level)
+		{
+			m_sizes.push_back(size);
+			m_inverse_sizes.push_back(one<scalar_type>() / size);
+			size /= scalar_type(2);
+		}
+		create_root();
+	}
+
+	loose_octree(const loose_octree&) = default;
+	loose_octree(loose_octree&&) = default;
+	loose_octree& operator=(const loose_octree&) = default;
+	loose_octree& operator=(loose_octree&&) = default;
+
+	/// @brief Get the bounds of this loose octree.
+	/// @return the bounds
+	const cube_type& get_bounds() const
+	{ return m_bounds; }
+
+	/// @brief Get the maximal depth of this loose octree.
+	/// @return the maximal depth
+	std::size_t get_max_depth() const
+	{ return m_max_depth; }
+
+	/// @brief Get the number of boxes of this loose octree.
+	/// @return the number of boxes
+	std::size_t size() const
+	{ return m_size; }
+
+	/// @brief Get if this loose octree has no boxes.
+	/// @return @a true if this loose octree has no boxes, @a false otherwise
+	bool empty() const
+	{ return m_size == 0; }
+
+	/// @brief Get the number of nodes of this loose octree including the root.
+	/// @return the number of nodes
+	std::size_t get_node_count() const
+	{ return m_nodes.size() - m_free_nodes.size(); }
+
+	/// @brief Get the memory usage of this loose octree.
+	/// @return the memory usage
+	/// @remark Besides the capacity of its storage, the memory per box is bounded by
+	/// <c>sizeof(object) + sizeof(handle_type) + max_depth * (sizeof(node) + sizeof(std::uint32_t))</c>.
+	/// The storage retained after removals is released by compact.
+	loose_octree_memory_usage get_memory_usage() const
+	{
+		loose_octree_memory_usage usage;
+		usage.object_count = m_size;
+		usage.node_count = get_node_count();
+		usage.object_bytes = m_objects.capacity() * sizeof(object) + m_free.capacity() * sizeof(handle_type);
+		usage.node_bytes = m_nodes.capacity() * sizeof(node) + m_free_nodes.capacity() * sizeof(std::uint32_t);
+		return usage;
+	}
+
+	/// @brief Get if a handle refers to a box of this loose octree.
+	/// @param handle the handle
+	/// @return @a true if the handle refers to a box, @a false otherwise
+	bool contains(handle_type handle) const
+	{ return handle < m_objects.size() && m_objects[handle].node != invalid_index; }
+
+	/// @brief Get the box of a handle.
+	/// @param handle the handle
+	/// @return the box
+	/// @throw idlib::invalid_argument_error the handle does not refer to a box of this loose octree
+	const box_type& get(handle_type handle) const
+	{
+		ensure_contains(handle);
+		return m_objects[handle].box;
+	}
+
+	/// @brief Get the loose cube of the node of a box.
+	/// @param handle the handle
+	/// @return the loose cube
+	/// @throw idlib::invalid_argument_error the handle does not refer to a box of this loose octree
+	cube_type get_loose_cube(handle_type handle) const
+	{
+		ensure_contains(handle);
+		const auto box = get_loose_box(m_nodes[m_objects[handle].node].where);
+		point_type center;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{ center[i] = (box.get_min()[i] + box.get_max()[i]) / scalar_type(2); }
+		return cube_type(center, box.get_max()[0] - box.get_min()[0]);
+	}
+
+	/// @brief Insert a box.
+	/// @param box the box
+	/// @return the handle of the box
+	/// @throw idlib::invalid_argument_error a coordinate of the box is not finite
+	/// @throw idlib::invalid_argument_error there are 2<sup>32</sup> - 1 boxes
+	handle_type insert(const box_type& box)
+	{
+		ensure_finite(box);
+		const handle_type handle = allocate_handle();
+		m_objects[handle].box = box;
+		link(handle, find_or_create(root_index, get_location(box)));
+		++m_size;
+		return handle;
+	}
+
+	/// @brief Move a box i.e. replace the box of a handle.
+	/// @param handle the handle
+	/// @param box the box
+	/// @throw idlib::invalid_argument_error the handle does not refer to a box of this loose octree
+	/// @throw idlib::invalid_argument_error a coordinate of the box is not finite
+	void move(handle_type handle, const box_type& box)
+	{
+		ensure_contains(handle);
+		ensure_finite(box);
+		object& o = m_objects[handle];
+		o.box = box;
+		const location l = get_location(box);
+		const std::uint32_t source = o.node;
+		if (is_at(m_nodes[source], l))
+		{ return; }
+		std::uint32_t ancestor = source;
+		while (!is_ancestor(m_nodes[ancestor], l))
+		{ ancestor = m_nodes[ancestor].parent; }
+		const std::uint32_t target = find_or_create(ancestor, l);
+		unlink(handle);
+		link(handle, target);
+		prune(source);
+	}
+
+	/// @brief Remove a box.
+	/// @param handle the handle of the box
+	/// @throw idlib::invalid_argument_error the handle does not refer to a box of this loose octree
+	/// @post The handle is invalid and may be returned by subsequent insertions.
+	void remove(handle_type handle)
+	{
+		ensure_contains(handle);
+		const std::uint32_t source = m_objects[handle].node;
+		unlink(handle);
+		prune(source);
+		m_objects[handle].node = invalid_index;
+		m_free.push_back(handle);
+		--m_size;
+	}
+
+	/// @brief Remove all boxes.
+	/// @post All handles are invalid.
+	void clear()
+	{
+		m_objects.clear();
+		m_free.clear();
+		m_size = 0;
+		create_root();
+	}
+
+	/// @brief Rebuild the nodes and release the storage which is not used.
+	/// @remark The handles remain valid.
+	void compact()
+	{
+		while (!m_objects.empty() && m_objects.back().node == invalid_index)
+		{ m_objects.pop_back(); }
+		m_free.erase(std::remove_if(m_free.begin(), m_free.end(), [this](handle_type h)
+		{ return h >= m_objects.size(); }), m_free.end());
+		create_root();
+		for (handle_type h = 0; h < m_objects.size(); ++h)
+		{
+			if (m_objects[h].node == invalid_index) continue;
+			link(h, find_or_create(root_index, get_location(m_objects[h].box)));
+		}
+		m_objects.shrink_to_fit();
+		m_free.shrink_to_fit();
+		m_nodes.shrink_to_fit();
+		m_free_nodes.shrink_to_fit();
+	}
+
+	/// @brief Visit the boxes intersecting a query geometry.
+	/// @param query the query geometry e.g. an idlib::sphere, an idlib::axis_aligned_box or a point.
+	/// idlib::is_intersecting_functor must be specialized for Q and idlib::axis_aligned_box.
+	/// @param visitor a function invoked as <c>visitor(h, b)</c> for the handle @a h and the box @a b of each box
+	/// @remark Each box is visited at most once. The visitor must not modify this loose octree.
+	template <typename Q, typename Visitor>
+	void query(const Q& query, Visitor&& visitor) const
+	{ query_node(root_index, query, visitor); }
+
+	/// @brief Visit the boxes which are not outside of any of a set of planes e.g. of a frustum.
+	/// @param planes the planes. The inside of a plane are the points \f$X\f$ with \f$\hat{n} \cdot X + d \geq 0\f$.
+	/// @param visitor a function invoked as <c>visitor(h, b)</c> for the handle @a h and the box @a b of each box
+	/// @throw idlib::invalid_argument_error there are more than 32 planes
+	/// @remark Each box is visited at most once. The visitor must not modify this loose octree.
+	/// @remark A box outside of the intersection of the insides of the planes may be visited
+	/// if it is not outside of any single plane. This is the common conservative test for frustum culling.
+	/// The planes a loose cube is inside of are not tested for the boxes and nodes below that node.
+	template <typename Visitor>
+	void query_planes(span<const plane_type> planes, Visitor&& visitor) const
+	{
+		if (planes.size() > 32)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "too many planes"); }
+		const std::uint32_t mask = planes.size() == 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << planes.size()) - 1;
+		query_planes_node(root_index, planes, mask, visitor);
+	}
+
+private:
+	/// @brief The invalid index.
+	static constexpr std::uint32_t invalid_index = std::numeric_limits<std::uint32_t>::max();
+
+	/// @brief The index of the root.
+	static constexpr std::uint32_t root_index = 0;
+
+	/// @brief The level and the cell coordinates of a node.
+	struct location
+	{
+		std::uint32_t level;
+		std::array<std::uint32_t, dimensionality()> coordinates;
+	};
+
+	/// @brief A node. The root has the level and the cell coordinates @a 0.
+	struct node
+	{
+		/// @brief The indices of the children or idlib::loose_octree::invalid_index.
+		std::array<std::uint32_t, child_count()> children;
+		/// @brief The index of the parent or idlib::loose_octree::invalid_index for the root.
+		std::uint32_t parent;
+		/// @brief The handle of the first box of this node or idlib::loose_octree::invalid_index.
+		std::uint32_t first;
+		/// @brief The level and the cell coordinates of this node.
+		location where;
+	};
+
+	/// @brief A box and its links in the list of boxes of its node.
+	struct object
+	{
+		box_type box;
+		/// @brief The index of the node or idlib::loose_octree::invalid_index if the handle is free.
+		std::uint32_t node;
+		std::uint32_t previous;
+		std::uint32_t next;
+	};
+
+	/// @brief The states of a box with respect to a plane.
+	enum plane_side
+	{
+		side_outside,
+		side_intersecting,
+		side_inside,
+	};
+
+	void ensure_contains(handle_type handle) const
+	{
+		if (!contains(handle))
+		{ throw invalid_argument_error(__FILE__, __LINE__, "invalid handle"); }
+	}
+
+	static void ensure_finite(const box_type& box)
+	{
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			if (!std::isfinite(box.get_min()[i]) || !std::isfinite(box.get_max()[i]))
+			{ throw invalid_argument_error(__FILE__, __LINE__, "coordinate is not finite"); }
+		}
+	}
+
+	/// @brief Get the loose cube of a node as a box.
+	/// @remark Boxes are placed and nodes are culled by this function such that both agree exactly.
+	box_type get_loose_box(const location& l) const
+	{
+		const scalar_type size = m_sizes[l.level];
+		point_type min, max;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			min[i] = m_min[i] + scalar_type(l.coordinates[i]) * size - size / scalar_type(2);
+			max[i] = min[i] + size * scalar_type(2);
+		}
+		return box_type(min, max);
+	}
+
+	/// @brief Get the location of the node of a box.
+	location get_location(const box_type& box) const
+	{
+		location l{ 0, {} };
+		scalar_type extent = zero<scalar_type>();
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{ extent = std::max(extent, box.get_max()[i] - box.get_min()[i]); }
+		while (l.level < m_max_depth && extent <= m_sizes[l.level + 1])
+		{ l.level++; }
+		const scalar_type cells = scalar_type(std::uint32_t(1) << l.level);
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			const scalar_type center = (box.get_min()[i] + box.get_max()[i]) / scalar_type(2);
+			const scalar_type x = (center - m_min[i]) * m_inverse_sizes[l.level];
+			if (!(x >= zero<scalar_type>() && x < cells))
+			{ return location{ 0, {} }; }
+			l.coordinates[i] = std::min(std::uint32_t(x), (std::uint32_t(1) << l.level) - 1);
+		}
+		// Guard against rounding: ascend until the loose cube encloses the box.
+		while (l.level > 0)
+		{
+			if (is_enclosing(get_loose_box(l), box)) break;
+			l.level--;
+			for (auto& c : l.coordinates) c >>= 1;
+		}
+		return l;
+	}
+
+	/// @brief Get if a node is at a location.
+	static bool is_at(const node& n, const location& l)
+	{ return n.where.level == l.level && n.where.coordinates == l.coordinates; }
+
+	/// @brief Get if a node is at a location or an ancestor of a location.
+	static bool is_ancestor(const node& n, const location& l)
+	{
+		if (n.where.level > l.level) return false;
+		const std::uint32_t shift = l.level - n.where.level;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			if ((l.coordinates[i] >> shift) != n.where.coordinates[i]) return false;
+		}
+		return true;
+	}
+
+	/// @brief Get the index of a child of a node by the cell coordinates of the child.
+	static std::size_t get_child_slot(const location& l)
+	{
+		std::size_t slot = 0;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{ slot |= std::size_t(l.coordinates[i] & 1) << i; }
+		return slot;
+	}
+
+	/// @brief Reset the nodes to a root without boxes.
+	void create_root()
+	{
+		m_nodes.clear();
+		m_free_nodes.clear();
+		node root;
+		root.children.fill(invalid_index);
+		root.parent = invalid_index;
+		root.first = invalid_index;
+		root.where = location{ 0, {} };
+		m_nodes.push_back(root);
+	}
+
+	/// @brief Get the node at a location, creating the missing nodes below an ancestor.
+	std::uint32_t find_or_create(std::uint32_t ancestor, const location& l)
+	{
+		std::uint32_t index = ancestor;
+		for (std::uint32_t level = m_nodes[ancestor].where.level + 1; level <= l.level; ++level)
+		{
+			location c;
+			c.level = level;
+			for (std::size_t i = 0; i < dimensionality(); ++i)
+			{ c.coordinates[i] = l.coordinates[i] >> (l.level - level); }
+			const std::size_t slot = get_child_slot(c);
+			std::uint32_t child = m_nodes[index].children[slot];
+			if (child == invalid_index)
+			{
+				child = allocate_node();
+				node& n = m_nodes[child];
+				n.children.fill(invalid_index);
+				n.parent = index;
+				n.first = invalid_index;
+				n.where = c;
+				m_nodes[index].children[slot] = child;
+			}
+			index = child;
+		}
+		return index;
+	}
+
+	std::uint32_t allocate_node()
+	{
+		if (!m_free_nodes.empty())
+		{
+			const std::uint32_t index = m_free_nodes.back();
+			m_free_nodes.pop_back();
+			return index;
+		}
+		m_nodes.emplace_back();
+		return std::uint32_t(m_nodes.size() - 1);
+	}
+
+	/// @brief Release a node and its ancestors as long as they have neither boxes nor children.
+	void prune(std::uint32_t index)
+	{
+		while (index != root_index)
+		{
+			const node& n = m_nodes[index];
+			if (n.first != invalid_index) return;
+			for (auto child : n.children)
+			{
+				if (child != invalid_index) return;
+			}
+			const std::uint32_t parent = n.parent;
+			m_nodes[parent].children[get_child_slot(n.where)] = invalid_index;
+			m_free_nodes.push_back(index);
+			index = parent;
+		}
+	}
+
+	handle_type allocate_handle()
+	{
+		if (!m_free.empty())
+		{
+			const handle_type handle = m_free.back();
+			m_free.pop_back();
+			return handle;
+		}
+		if (m_objects.size() >= std::size_t(invalid_index))
+		{ throw invalid_argument_error(__FILE__, __LINE__, "too many boxes"); }
+		m_objects.emplace_back();
+		return handle_type(m_objects.size() - 1);
+	}
+
+	/// @brief Add a box to the front of the list of a node.
+	void link(handle_type handle, std::uint32_t index)
+	{
+		object& o = m_objects[handle];
+		node& n = m_nodes[index];
+		o.node = index;
+		o.previous = invalid_index;
+		o.next = n.first;
+		if (n.first != invalid_index) m_objects[n.first].previous = handle;
+		n.first = handle;
+	}
+
+	/// @brief Remove a box from the list of its node.
+	void unlink(handle_type handle)
+	{
+		const object& o = m_objects[handle];
+		if (o.previous != invalid_index) m_objects[o.previous].next = o.next;
+		else m_nodes[o.node].first = o.next;
+		if (o.next != invalid_index) m_objects[o.next].previous = o.previous;
+	}
+
+	template <typename Q, typename Visitor>
+	void query_node(std::uint32_t index, const Q& query, Visitor& visitor) const
+	{
+		const node& n = m_nodes[index];
+		for (std::uint32_t h = n.first; h != invalid_index; h = m_objects[h].next)
+		{
+			if (is_intersecting(query, m_objects[h].box)) visitor(handle_type(h), m_objects[h].box);
+		}
+		for (auto child : n.children)
+		{
+			if (child != invalid_index && is_intersecting(query, get_loose_box(m_nodes[child].where)))
+			{ query_node(child, query, visitor); }
+		}
+	}
+
+	/// @brief Classify a box with respect to a plane.
+	static plane_side get_side(const plane_type& plane, const box_type& box)
+	{
+		// The signed distances of the corners nearest to and farthest from the inside.
+		scalar_type nearest = plane.get_distance(), farthest = plane.get_distance();
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			const scalar_type n = plane.get_normal()[i];
+			if (n >= zero<scalar_type>())
+			{
+				farthest += n * box.get_max()[i];
+				nearest += n * box.get_min()[i];
+			}
+			else
+			{
+				farthest += n * box.get_min()[i];
+				nearest += n * box.get_max()[i];
+			}
+		}
+		if (farthest < zero<scalar_type>()) return side_outside;
+		if (nearest >= zero<scalar_type>()) return side_inside;
+		return side_intersecting;
+	}
+
+	/// @brief Test a box against the planes of a mask.
+	/// @return @a false if the box is outside of a plane, @a true otherwise
+	/// @post The planes the box is inside of were removed from the mask.
+	static bool test_planes(span<const plane_type> planes, std::uint32_t& mask, const box_type& box)
+	{
+		for (std::uint32_t m = mask; m != 0; m &= m - 1)
+		{
+			std::uint32_t i = 0;
+			while (((m >> i) & 1) == 0) ++i;
+			switch (get_side(planes[i], box))
+			{
+				case side_outside:
+					return false;
+				case side_inside:
+					mask &= ~(std::uint32_t(1) << i);
+					break;
+				case side_intersecting:
+					break;
+			}
+		}
+		return true;
+	}
+
+	template <typename Visitor>
+	void query_planes_node(std::uint32_t index, span<const plane_type> planes, std::uint32_t mask, Visitor& visitor) const
+	{
+		const node& n = m_nodes[index];
+		for (std::uint32_t h = n.first; h != invalid_index; h = m_objects[h].next)
+		{
+			std::uint32_t m = mask;
+			if (test_planes(planes, m, m_objects[h].box)) visitor(handle_type(h), m_objects[h].box);
+		}
+		for (auto child : n.children)
+		{
+			if (child == invalid_index) continue;
+			std::uint32_t m = mask;
+			if (test_planes(planes, m, get_loose_box(m_nodes[child].where)))
+			{ query_planes_node(child, planes, m, visitor); }
+		}
+	}
+
+	/// @brief The bounds.
+	cube_type m_bounds;
+
+	/// @brief The minimum of the bounds.
+	point_type m_min;
+
+	/// @brief The maximal depth of a node.
+	std::size_t m_max_depth;
+
+	/// @brief The sizes of the cells of the nodes indexed by their levels.
+	std::vector<scalar_type> m_sizes;
+
+	/// @brief The inverses of the sizes of the cells of the nodes indexed by their levels.
+	std::vector<scalar_type> m_inverse_sizes;
+
+	/// @brief The number of boxes.
+	std::size_t m_size = 0;
+
+	/// @brief The boxes indexed by their handles.
+	std::vector<object> m_objects;
+
+	/// @brief The free handles.
+	std::vector<handle_type> m_free;
+
+	/// @brief The pool of nodes. The root is at index @a 0.
+	std::vector<node> m_nodes;
+
+	/// @brief The indices of the free nodes of the pool.
+	std::vector<std::uint32_t> m_free_nodes;
+
+}; // struct loose_octree
+
+} // namespace idlib
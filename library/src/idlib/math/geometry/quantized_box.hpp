@@ -0,0 +1,524 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/geometry/quantized_box.hpp
+/// @brief Axis aligned boxes quantized relative to a parent box.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/geometry/axis_aligned_box.hpp"
+#include "idlib/math/geometry/quantized_box_kernel.hpp"
+#include "idlib/math/is_intersecting.hpp"
+#include "idlib/math/vector_batch.hpp"
+#include "idlib/crtp.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/range/span.hpp"
+#include "idlib/utility/aligned_allocator.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief An axis aligned box whose coordinates are quantized relative to a parent box.
+/// @details
+/// The quantized coordinates are unsigned integers. The coordinate @a q along an axis stands for
+/// \f$o + q s\f$ where the origin \f$o\f$ and the step \f$s\f$ along that axis are defined by an idlib::box_quantizer.
+/// With @a std::uint16_t coordinates, a quantized box of three dimensions has 12 Bytes,
+/// with @a std::uint8_t coordinates it has 6 Bytes. An idlib::axis_aligned_box of single precision points has 32 Bytes.
+/// @tparam P the point type of the axis aligned boxes
+/// @tparam I the unsigned integer type of the quantized coordinates
+template <typename P, typename I>
+struct quantized_box : public equal_to_expr<quantized_box<P, I>>
+{
+public:
+	/// @brief The point type of this quantized box type.
+	using point_type = P;
+
+	/// @brief The integer type of this quantized box type.
+	using integer_type = I;
+
+	static_assert(std::is_integral<I>::value && std::is_unsigned<I>::value, "integer type must be an unsigned integer type");
+
+	/// @brief The dimensionality of this quantized box type.
+	/// @return the dimensionality
+	static constexpr std::size_t dimensionality()
+	{ return P::dimensionality(); }
+
+	/// @brief The type of the quantized coordinates of a point.
+	using array_type = std::array<I, P::dimensionality()>;
+
+	/// @brief Construct this quantized box with the default values of a quantized box.
+	/// @remark The default values of a quantized box are the minimum and the maximum of @a 0.
+	quantized_box()
+		: m_min{}, m_max{}
+	{}
+
+	/// @brief Construct this quantized box with the specified minimum and maximum.
+	/// @param min the minimum
+	/// @param max the maximum
+	/// @throw std::domain_error the minimum is greater than the maximum along an axis
+	quantized_box(const array_type& min, const array_type& max)
+		: m_min(min), m_max(max)
+	{
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			if (m_min[i] > m_max[i])
+			{ throw std::domain_error("minimum is greater than maximum"); }
+		}
+	}
+
+	quantized_box(const quantized_box&) = default;
+	quantized_box& operator=(const quantized_box&) = default;
+
+	/// @brief Get the minimum.
+	/// @return the minimum
+	const array_type& get_min() const
+	{ return m_min; }
+
+	/// @brief Get the maximum.
+	/// @return the maximum
+	const array_type& get_max() const
+	{ return m_max; }
+
+	// CRTP
+	bool equal_to(const quantized_box& other) const
+	{ return m_min == other.m_min && m_max == other.m_max; }
+
+private:
+	array_type m_min;
+	array_type m_max;
+
+}; // struct quantized_box
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if two quantized boxes intersect.
+/// @remark The boxes must be quantized by the same idlib::box_quantizer.
+/// As the quantized boxes enclose the boxes they were quantized from, the test is conservative for these boxes.
+template <typename P, typename I>
+struct is_intersecting_functor<quantized_box<P, I>, quantized_box<P, I>>
+{
+	bool operator()(const quantized_box<P, I>& a, const quantized_box<P, I>& b) const
+	{
+		for (std::size_t i = 0; i < P::dimensionality(); ++i)
+		{
+			if (a.get_min()[i] > b.get_max()[i]) return false;
+			if (a.get_max()[i] < b.get_min()[i]) return false;
+		}
+		return true;
+	}
+}; // struct is_intersecting_functor
+
+/// @ingroup math
+/// @brief A batch of quantized boxes.
+/// @detail
+/// The quantized boxes are stored in structure-of-arrays layout:
+/// The minima and the maxima along each axis are stored contiguously in arrays aligned to a 64 Byte boundary.
+/// @tparam P the point type of the axis aligned boxes
+/// @tparam I the unsigned integer type of the quantized coordinates
+template <typename P, typename I>
+struct quantized_box_batch
+{
+public:
+	/// @brief The quantized box type.
+	using quantized_box_type = quantized_box<P, I>;
+
+	/// @brief The alignment in Bytes of the arrays.
+	static constexpr std::size_t alignment = 64;
+
+	/// @brief The type of an array.
+	using array_type = std::vector<I, aligned_allocator<I, alignment>>;
+
+	/// @brief Get the dimensionality.
+	/// @return the dimensionality
+	static constexpr std::size_t dimensionality()
+	{ return P::dimensionality(); }
+
+	/// @brief Get the number of quantized boxes in this batch.
+	/// @return the number of quantized boxes
+	std::size_t size() const
+	{ return m_min[0].size(); }
+
+	/// @brief Get if this batch is empty.
+	/// @return @a true if this batch is empty, @a false otherwise
+	bool empty() const
+	{ return m_min[0].empty(); }
+
+	/// @brief Reserve storage for the specified number of quantized boxes.
+	/// @param capacity the number of quantized boxes
+	void reserve(std::size_t capacity)
+	{
+		for (std::size_t j = 0; j < dimensionality(); ++j)
+		{
+			m_min[j].reserve(capacity);
+			m_max[j].reserve(capacity);
+		}
+	}
+
+	/// @brief Resize this batch to the specified number of quantized boxes.
+	/// @param size the number of quantized boxes
+	/// @post If the batch grows, the new quantized boxes are default quantized boxes.
+	void resize(std::size_t size)
+	{
+		for (std::size_t j = 0; j < dimensionality(); ++j)
+		{
+			m_min[j].resize(size, 0);
+			m_max[j].resize(size, 0);
+		}
+	}
+
+	/// @brief Remove all quantized boxes from this batch.
+	void clear()
+	{
+		for (std::size_t j = 0; j < dimensionality(); ++j)
+		{
+			m_min[j].clear();
+			m_max[j].clear();
+		}
+	}
+
+	/// @brief Append a quantized box to this batch.
+	/// @param box the quantized box
+	void push_back(const quantized_box_type& box)
+	{
+		for (std::size_t j = 0; j < dimensionality(); ++j)
+		{
+			m_min[j].push_back(box.get_min()[j]);
+			m_max[j].push_back(box.get_max()[j]);
+		}
+	}
+
+	/// @brief Get the quantized box at the specified index.
+	/// @param index the index
+	/// @return the quantized box
+	/// @pre The index is within bounds.
+	quantized_box_type get(std::size_t index) const
+	{
+		typename quantized_box_type::array_type min, max;
+		for (std::size_t j = 0; j < dimensionality(); ++j)
+		{
+			min[j] = m_min[j][index];
+			max[j] = m_max[j][index];
+		}
+		return quantized_box_type(min, max);
+	}
+
+	/// @brief Set the quantized box at the specified index.
+	/// @param index the index
+	/// @param box the quantized box
+	/// @pre The index is within bounds.
+	void set(std::size_t index, const quantized_box_type& box)
+	{
+		for (std::size_t j = 0; j < dimensionality(); ++j)
+		{
+			m_min[j][index] = box.get_min()[j];
+			m_max[j][index] = box.get_max()[j];
+		}
+	}
+
+	/// @{
+	/// @brief Get a pointer to the array of the minima along an axis.
+	/// @param axis the axis
+	/// @return a pointer to the array of size() minima
+	/// @pre The axis is smaller than the dimensionality.
+	I *min_data(std::size_t axis)
+	{ return m_min[axis].data(); }
+
+	const I *min_data(std::size_t axis) const
+	{ return m_min[axis].data(); }
+	/// @}
+
+	/// @{
+	/// @brief Get a pointer to the array of the maxima along an axis.
+	/// @param axis the axis
+	/// @return a pointer to the array of size() maxima
+	/// @pre The axis is smaller than the dimensionality.
+	I *max_data(std::size_t axis)
+	{ return m_max[axis].data(); }
+
+	const I *max_data(std::size_t axis) const
+	{ return m_max[axis].data(); }
+	/// @}
+
+private:
+	array_type m_min[P::dimensionality()];
+	array_type m_max[P::dimensionality()];
+
+}; // struct quantized_box_batch
+
+/// @ingroup math
+/// @brief Quantizes axis aligned boxes relative to a parent box.
+/// @details
+/// Along each axis, the parent box is divided into @a L steps where @a L is the greatest value of the integer type.
+/// The quantized coordinate @a q stands for \f$o + q s\f$ where the origin \f$o\f$ is the minimum of the parent box
+/// and the step \f$s\f$ is the extent of the parent box divided by @a L, rounded up such that \f$o + L s\f$ is not
+/// smaller than the maximum of the parent box.
+/// @details
+/// The quantization is conservative: The minimum is rounded down and the maximum is rounded up such that the decoded box,
+/// as computed by idlib::box_quantizer::decode, encloses the box.
+/// @tparam P the point type of the axis aligned boxes. Its scalar type must be a floating point type.
+/// @tparam I the unsigned integer type of the quantized coordinates
+template <typename P, typename I>
+struct box_quantizer
+{
+public:
+	/// @brief The point type of this box quantizer type.
+	using point_type = P;
+
+	/// @brief The scalar type of this box quantizer type.
+	using scalar_type = typename P::scalar_type;
+
+	/// @brief The box type of this box quantizer type.
+	using box_type = axis_aligned_box<P>;
+
+	/// @brief The quantized box type of this box quantizer type.
+	using quantized_box_type = quantized_box<P, I>;
+
+	/// @brief The quantized box batch type of this box quantizer type.
+	using quantized_box_batch_type = quantized_box_batch<P, I>;
+
+	/// @brief The vector batch type of this box quantizer type.
+	using vector_batch_type = vector_batch<scalar_type, P::dimensionality()>;
+
+	static_assert(std::is_floating_point<scalar_type>::value, "scalar type must be a floating point type");
+
+	/// @brief Get the dimensionality.
+	/// @return the dimensionality
+	static constexpr std::size_t dimensionality()
+	{ return P::dimensionality(); }
+
+	/// @brief The greatest quantized coordinate.
+	static constexpr I levels = std::numeric_limits<I>::max();
+
+	/// @brief Construct this box quantizer.
+	/// @param parent the parent box
+	/// @throw idlib::invalid_argument_error a coordinate of the parent box is not finite
+	explicit box_quantizer(const box_type& parent)
+		: m_parent(parent)
+	{
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			const scalar_type origin = parent.get_min()[i], extent = parent.get_max()[i] - origin;
+			if (!std::isfinite(origin) || !std::isfinite(parent.get_max()[i]) || !std::isfinite(extent))
+			{ throw invalid_argument_error(__FILE__, __LINE__, "coordinate is not finite"); }
+			scalar_type step = extent / scalar_type(levels);
+			while (origin + scalar_type(levels) * step < parent.get_max()[i])
+			{ step = std::nextafter(step, std::numeric_limits<scalar_type>::infinity()); }
+			m_steps[i] = step;
+			m_inverse_steps[i] = extent > scalar_type(0) ? scalar_type(levels) / extent : scalar_type(0);
+		}
+	}
+
+	box_quantizer(const box_quantizer&) = default;
+	box_quantizer& operator=(const box_quantizer&) = default;
+
+	/// @brief Get the parent box.
+	/// @return the parent box
+	const box_type& get_parent() const
+	{ return m_parent; }
+
+	/// @brief Decode a quantized coordinate.
+	/// @param axis the axis
+	/// @param q the quantized coordinate
+	/// @return \f$o + q s\f$
+	scalar_type decode(std::size_t axis, I q) const
+	{ return m_parent.get_min()[axis] + static_cast<scalar_type>(q) * m_steps[axis]; }
+
+	/// @brief Decode a quantized box.
+	/// @param box the quantized box
+	/// @return the decoded box
+	box_type decode(const quantized_box_type& box) const
+	{
+		P min, max;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			min[i] = decode(i, box.get_min()[i]);
+			max[i] = decode(i, box.get_max()[i]);
+		}
+		return box_type(min, max);
+	}
+
+	/// @brief Quantize a box.
+	/// @param box the box
+	/// @return the quantized box. Its decoded box encloses @a box.
+	/// @throw idlib::invalid_argument_error the parent box does not enclose @a box
+	quantized_box_type encode(const box_type& box) const
+	{
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			if (!(box.get_min()[i] >= m_parent.get_min()[i]) || !(box.get_max()[i] <= m_parent.get_max()[i]))
+			{ throw invalid_argument_error(__FILE__, __LINE__, "box is not enclosed by the parent box"); }
+		}
+		return encode_unchecked(box);
+	}
+
+	/// @brief Quantize the intersection of a box and the parent box.
+	/// @param box the box
+	/// @param [out] result receives the quantized intersection if the box intersects the parent box
+	/// @return @a true if the box intersects the parent box, @a false otherwise
+	/// @remark This quantizes query boxes which may extend beyond the parent box.
+	/// A box enclosed by the parent box intersects @a box only if their quantized boxes intersect.
+	bool encode_intersection(const box_type& box, quantized_box_type& result) const
+	{
+		if (!is_intersecting(box, m_parent)) return false;
+		P min, max;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			min[i] = std::max(box.get_min()[i], m_parent.get_min()[i]);
+			max[i] = std::min(box.get_max()[i], m_parent.get_max()[i]);
+		}
+		result = encode_unchecked(box_type(min, max));
+		return true;
+	}
+
+	/// @brief Quantize boxes.
+	/// @param boxes the boxes
+	/// @param [out] result receives the quantized boxes
+	/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+	/// @throw idlib::invalid_argument_error the parent box does not enclose a box
+	void encode(span<const box_type> boxes, quantized_box_batch_type& result, std::size_t thread_count = 0) const
+	{
+		result.resize(boxes.size());
+		parallel_for(0, boxes.size(), grain, thread_count, [this, &boxes, &result](std::size_t b, std::size_t e, std::size_t)
+		{
+			for (std::size_t i = b; i < e; ++i) result.set(i, encode(boxes[i]));
+		});
+	}
+
+	/// @brief Decode quantized boxes.
+	/// @param boxes the quantized boxes
+	/// @param [out] min, max receive the minima and the maxima of the decoded boxes
+	/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+	/// @remark The coordinates are decoded by SIMD instructions if available and the boxes are split across threads.
+	/// The results are identical to the results of decode for single quantized boxes.
+	void decode(const quantized_box_batch_type& boxes, vector_batch_type& min, vector_batch_type& max, std::size_t thread_count = 0) const
+	{
+		min.resize(boxes.size());
+		max.resize(boxes.size());
+		parallel_for(0, boxes.size(), grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+		{
+			for (std::size_t j = 0; j < dimensionality(); ++j)
+			{
+				const scalar_type origin = m_parent.get_min()[j];
+				internal::quantized_box_kernel<I>::decode(boxes.min_data(j) + b, origin, m_steps[j], min.data(j) + b, e - b);
+				internal::quantized_box_kernel<I>::decode(boxes.max_data(j) + b, origin, m_steps[j], max.data(j) + b, e - b);
+			}
+		});
+	}
+
+private:
+	/// @brief The minimal number of boxes per thread.
+	static constexpr std::size_t grain = 16384;
+
+	quantized_box_type encode_unchecked(const box_type& box) const
+	{
+		typename quantized_box_type::array_type min, max;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			min[i] = encode_lower(i, box.get_min()[i]);
+			max[i] = encode_upper(i, box.get_max()[i]);
+		}
+		return quantized_box_type(min, max);
+	}
+
+	/// @brief Get the greatest quantized coordinate which does not decode to a value greater than a coordinate.
+	I encode_lower(std::size_t axis, scalar_type x) const
+	{
+		const scalar_type t = std::floor((x - m_parent.get_min()[axis]) * m_inverse_steps[axis]);
+		I q = !(t > scalar_type(0)) ? I(0) : t >= scalar_type(levels) ? levels : static_cast<I>(t);
+		while (q > 0 && decode(axis, q) > x) --q;
+		return q;
+	}
+
+	/// @brief Get the smallest quantized coordinate which does not decode to a value smaller than a coordinate.
+	I encode_upper(std::size_t axis, scalar_type x) const
+	{
+		const scalar_type t = std::ceil((x - m_parent.get_min()[axis]) * m_inverse_steps[axis]);
+		I q = !(t > scalar_type(0)) ? I(0) : t >= scalar_type(levels) ? levels : static_cast<I>(t);
+		while (q < levels && decode(axis, q) < x) ++q;
+		return q;
+	}
+
+	box_type m_parent;
+
+	/// @brief The steps along the axes.
+	std::array<scalar_type, P::dimensionality()> m_steps;
+
+	/// @brief The inverses of the steps along the axes used for encoding.
+	std::array<scalar_type, P::dimensionality()> m_inverse_steps;
+
+}; // struct box_quantizer
+
+/// @ingroup math
+/// @brief Test quantized boxes against a query box.
+/// @param boxes the quantized boxes
+/// @param query the quantized query box, see idlib::box_quantizer::encode_intersection
+/// @param result receives the intersection bitmask. Bit <c>i % 32</c> of word <c>i / 32</c> is set if box @a i intersects the query box.
+/// The bits of the last word beyond the number of boxes are cleared.
+/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+/// @throw idlib::invalid_argument_error the bitmask has less than <c>(n + 31) / 32</c> words for @a n boxes
+/// @remark The quantized coordinates are compared by SIMD instructions if available and the words are split across threads.
+/// The results are identical to the results of idlib::is_intersecting for single quantized boxes.
+template <typename P, typename I>
+void is_intersecting(const quantized_box_batch<P, I>& boxes, const quantized_box<P, I>& query, span<std::uint32_t> result, std::size_t thread_count = 0)
+{
+	static constexpr std::size_t D = P::dimensionality();
+	/// The minimal number of words per thread.
+	static constexpr std::size_t grain = 2048;
+	const std::size_t n = boxes.size();
+	if (result.size() < (n + 31) / 32)
+	{ throw invalid_argument_error(__FILE__, __LINE__, "bitmask is too small"); }
+	parallel_for(0, (n + 31) / 32, grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+	{
+		for (std::size_t w = b; w < e; ++w)
+		{
+			const std::size_t i = 32 * w;
+			const I *lower[D], *upper[D];
+			for (std::size_t j = 0; j < D; ++j)
+			{
+				lower[j] = boxes.min_data(j) + i;
+				upper[j] = boxes.max_data(j) + i;
+			}
+			if (i + 32 <= n)
+			{ result[w] = internal::quantized_box_kernel<I>::template test<D>(lower, upper, query.get_min().data(), query.get_max().data()); }
+			else
+			{ result[w] = internal::test_quantized_scalar<D>(lower, upper, query.get_min().data(), query.get_max().data(), n - i); }
+		}
+	});
+}
+
+} // namespace idlib
@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/// @file idlib/math/geometry/quantized_box_kernel.hpp
+/// @brief Kernels of the decoding and the intersection of quantized axis aligned boxes.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/simd.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace idlib { namespace internal {
+
+/// @brief \f$x_i = o + q_i s\f$ for @a n quantized coordinates \f$q_i\f$.
+template <typename I, typename S>
+void decode_quantized_scalar(const I *q, S origin, S step, S *x, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; ++i)
+	{ x[i] = origin + static_cast<S>(q[i]) * step; }
+}
+
+/// @brief Test @a n boxes against a query box, all in quantized coordinates.
+/// @return the bits of the boxes intersecting the query box, box @a i at bit @a i
+template <std::size_t D, typename I>
+std::uint32_t test_quantized_scalar(const I *const *lower, const I *const *upper, const I *query_lower, const I *query_upper, std::size_t n)
+{
+	std::uint32_t word = 0;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		bool intersecting = true;
+		for (std::size_t j = 0; j < D; ++j)
+		{ intersecting = intersecting && lower[j][i] <= query_upper[j] && upper[j][i] >= query_lower[j]; }
+		word |= std::uint32_t(intersecting) << i;
+	}
+	return word;
+}
+
+/// @brief Kernels over quantized coordinates in structure-of-arrays layout.
+/// @tparam I the unsigned integer type of the quantized coordinates
+/// @tparam Enabled for SFINAE
+/// @remark A specialization using SSE2 is provided for @a std::uint8_t and @a std::uint16_t.
+/// Its results are bit-identical to the results of the scalar implementation.
+template <typename I, typename Enabled = void>
+struct quantized_box_kernel
+{
+	/// @brief \f$x_i = o + q_i s\f$ for @a n quantized coordinates \f$q_i\f$.
+	template <typename S>
+	static void decode(const I *q, S origin, S step, S *x, std::size_t n)
+	{ decode_quantized_scalar(q, origin, step, x, n); }
+
+	/// @brief Test 32 boxes against a query box.
+	/// @param lower, upper the pointers to the minima and the maxima of the first box along each axis
+	/// @param query_lower, query_upper the minima and the maxima of the query box
+	/// @return the bits of the boxes intersecting the query box, box @a i at bit @a i
+	template <std::size_t D>
+	static std::uint32_t test(const I *const *lower, const I *const *upper, const I *query_lower, const I *query_upper)
+	{ return test_quantized_scalar<D>(lower, upper, query_lower, query_upper, 32); }
+};
+
+#if defined(IDLIB_WITH_SSE2)
+
+/// @brief SSE2 operations on registers of quantized coordinates.
+template <typename I>
+struct quantized_simd_traits;
+
+template <>
+struct quantized_simd_traits<std::uint16_t>
+{
+	static constexpr std::size_t width = 8;
+	static __m128i set1(std::uint16_t x) { return _mm_set1_epi16(static_cast<short>(x)); }
+	/// @brief \f$\max(a - b, 0)\f$, which is zero if and only if \f$a \leq b\f$.
+	static __m128i subtract_saturated(__m128i a, __m128i b) { return _mm_subs_epu16(a, b); }
+	/// @brief Get the bits of the zero lanes.
+	static std::uint32_t zero_bits(__m128i x)
+	{
+		const __m128i z = _mm_cmpeq_epi16(x, _mm_setzero_si128());
+		return std::uint32_t(_mm_movemask_epi8(_mm_packs_epi16(z, _mm_setzero_si128())));
+	}
+	/// @brief Convert the lanes to four registers of single precision values.
+	static void convert(__m128i x, __m128 *y)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		y[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(x, zero));
+		y[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(x, zero));
+	}
+};
+
+template <>
+struct quantized_simd_traits<std::uint8_t>
+{
+	static constexpr std::size_t width = 16;
+	static __m128i set1(std::uint8_t x) { return _mm_set1_epi8(static_cast<char>(x)); }
+	static __m128i subtract_saturated(__m128i a, __m128i b) { return _mm_subs_epu8(a, b); }
+	static std::uint32_t zero_bits(__m128i x)
+	{ return std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128()))); }
+	static void convert(__m128i x, __m128 *y)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i lower = _mm_unpacklo_epi8(x, zero), upper = _mm_unpackhi_epi8(x, zero);
+		y[0] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lower, zero));
+		y[1] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lower, zero));
+		y[2] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(upper, zero));
+		y[3] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(upper, zero));
+	}
+};
+
+template <typename I>
+struct quantized_box_kernel<I, std::void_t<decltype(quantized_simd_traits<I>::width)>>
+{
+	using traits = quantized_simd_traits<I>;
+	static constexpr std::size_t width = traits::width;
+
+	template <typename S>
+	static void decode(const I *q, S origin, S step, S *x, std::size_t n)
+	{
+		std::size_t i = 0;
+		if constexpr (std::is_same<S, float>::value)
+		{
+			const __m128 o = _mm_set1_ps(origin), s = _mm_set1_ps(step);
+			for (; i + width <= n; i += width)
+			{
+				__m128 y[width / 4];
+				traits::convert(_mm_loadu_si128(reinterpret_cast<const __m128i *>(q + i)), y);
+				for (std::size_t j = 0; j < width / 4; ++j)
+				{ _mm_storeu_ps(x + i + 4 * j, _mm_add_ps(o, _mm_mul_ps(y[j], s))); }
+			}
+		}
+		decode_quantized_scalar(q + i, origin, step, x + i, n - i);
+	}
+
+	template <std::size_t D>
+	static std::uint32_t test(const I *const *lower, const I *const *upper, const I *query_lower, const I *query_upper)
+	{
+		__m128i ql[D], qu[D];
+		for (std::size_t j = 0; j < D; ++j)
+		{
+			ql[j] = traits::set1(query_lower[j]);
+			qu[j] = traits::set1(query_upper[j]);
+		}
+		std::uint32_t word = 0;
+		for (std::size_t k = 0; k < 32; k += width)
+		{
+			// The box is separated from the query box along an axis if its minimum is greater than the maximum of the query box
+			// or its maximum is smaller than the minimum of the query box, i.e. if a saturated difference is not zero.
+			__m128i separated = _mm_setzero_si128();
+			for (std::size_t j = 0; j < D; ++j)
+			{
+				const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lower[j] + k));
+				const __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i *>(upper[j] + k));
+				separated = _mm_or_si128(separated, traits::subtract_saturated(l, qu[j]));
+				separated = _mm_or_si128(separated, traits::subtract_saturated(ql[j], u));
+			}
+			word |= traits::zero_bits(separated) << k;
+		}
+		return word;
+	}
+};
+
+#endif
+
+} } // namespace idlib::internal
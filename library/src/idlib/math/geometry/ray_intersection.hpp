@@ -0,0 +1,424 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/geometry/ray_intersection.hpp
+/// @brief Intersection of rays and packets of rays with axis aligned boxes, axis aligned cubes, spheres and planes.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/geometry/axis_aligned_box.hpp"
+#include "idlib/math/geometry/axis_aligned_cube.hpp"
+#include "idlib/math/geometry/plane.hpp"
+#include "idlib/math/geometry/ray.hpp"
+#include "idlib/math/geometry/ray_kernel.hpp"
+#include "idlib/math/geometry/sphere.hpp"
+#include "idlib/math/intersect.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/range/span.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <cstdint>
+#include <limits>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief The result of the intersection of a ray with a geometry.
+/// @tparam Scalar the scalar type
+template <typename Scalar>
+struct ray_intersection_result
+{
+public:
+	/// @brief The scalar type.
+	using scalar_type = Scalar;
+
+	/// @brief Construct this result.
+	/// @param distance the distance along the ray at which the ray enters the geometry, positive infinity if the ray misses the geometry
+	explicit ray_intersection_result(scalar_type distance)
+		: m_distance(distance)
+	{}
+
+	/// @brief Get if the ray hits the geometry.
+	/// @return @a true if the ray hits the geometry, @a false otherwise
+	bool is_hit() const
+	{ return m_distance != std::numeric_limits<scalar_type>::infinity(); }
+
+	/// @brief Get the distance along the ray at which the ray enters the geometry.
+	/// @return the distance, @a 0 if the origin of the ray is inside the geometry, positive infinity if the ray misses the geometry
+	scalar_type get_distance() const
+	{ return m_distance; }
+
+private:
+	scalar_type m_distance;
+
+}; // struct ray_intersection_result
+
+/// @ingroup math
+/// @brief A packet of rays in structure-of-arrays layout.
+/// @details Intersecting a packet with a geometry tests all rays of the packet at once using SIMD instructions if available.
+/// @tparam P the point type of the rays
+/// @tparam Width the number of rays
+template <typename P, std::size_t Width>
+struct ray_packet
+{
+public:
+	/// @brief The point type of this ray packet type.
+	using point_type = P;
+
+	/// @brief The vector type of this ray packet type.
+	using vector_type = typename point_type::vector_type;
+
+	/// @brief The scalar type of this ray packet type.
+	using scalar_type = typename point_type::scalar_type;
+
+	/// @brief The ray type of this ray packet type.
+	using ray_type = ray<P>;
+
+	static_assert(Width > 0, "width must be positive");
+
+	/// @brief The dimensionality of this ray packet type.
+	/// @return the dimensionality
+	static constexpr std::size_t dimensionality()
+	{ return vector_type::dimensionality(); }
+
+	/// @brief The number of rays of this ray packet type.
+	/// @return the number of rays
+	static constexpr std::size_t width()
+	{ return Width; }
+
+	/// @brief Construct this ray packet with rays with the origin \f$\vec{0}\f$ and the direction of the first axis.
+	ray_packet()
+	{
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			for (std::size_t j = 0; j < Width; ++j)
+			{
+				m_origin[i][j] = zero<scalar_type>();
+				m_direction[i][j] = i == 0 ? one<scalar_type>() : zero<scalar_type>();
+				m_reciprocal_direction[i][j] = one<scalar_type>() / m_direction[i][j];
+			}
+		}
+	}
+
+	/// @brief Construct this ray packet from rays.
+	/// @param rays the rays
+	/// @throw idlib::invalid_argument_error the number of rays is not the width of this ray packet type
+	explicit ray_packet(span<const ray_type> rays)
+		: ray_packet()
+	{
+		if (rays.size() != Width)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "number of rays is not the width of the ray packet"); }
+		for (std::size_t j = 0; j < Width; ++j)
+		{ set(j, rays[j]); }
+	}
+
+	/// @brief Get a ray of this ray packet.
+	/// @param index the index of the ray
+	/// @return the ray
+	/// @pre <c>index < width()</c>
+	ray_type get(std::size_t index) const
+	{
+		point_type o;
+		vector_type d;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			o[i] = m_origin[i][index];
+			d[i] = m_direction[i][index];
+		}
+		return ray_type(o, d);
+	}
+
+	/// @brief Set a ray of this ray packet.
+	/// @param index the index of the ray
+	/// @param ray the ray
+	/// @pre <c>index < width()</c>
+	void set(std::size_t index, const ray_type& ray)
+	{
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			m_origin[i][index] = ray.get_origin()[i];
+			m_direction[i][index] = ray.get_direction()[i];
+			m_reciprocal_direction[i][index] = one<scalar_type>() / ray.get_direction()[i];
+		}
+	}
+
+	/// @brief Get the origin components of the rays along an axis.
+	/// @param axis the axis
+	/// @return a pointer to the array of width() components
+	const scalar_type *get_origins(std::size_t axis) const
+	{ return m_origin[axis]; }
+
+	/// @brief Get the direction components of the rays along an axis.
+	/// @param axis the axis
+	/// @return a pointer to the array of width() components
+	const scalar_type *get_directions(std::size_t axis) const
+	{ return m_direction[axis]; }
+
+	/// @brief Get the reciprocals of the direction components of the rays along an axis.
+	/// @param axis the axis
+	/// @return a pointer to the array of width() reciprocals
+	const scalar_type *get_reciprocal_directions(std::size_t axis) const
+	{ return m_reciprocal_direction[axis]; }
+
+private:
+	alignas(32) scalar_type m_origin[dimensionality()][Width];
+	alignas(32) scalar_type m_direction[dimensionality()][Width];
+	alignas(32) scalar_type m_reciprocal_direction[dimensionality()][Width];
+
+}; // struct ray_packet
+
+/// @ingroup math
+/// @brief The result of the intersection of a packet of rays with a geometry.
+/// @tparam Scalar the scalar type
+/// @tparam Width the number of rays
+template <typename Scalar, std::size_t Width>
+struct ray_packet_intersection_result
+{
+public:
+	/// @brief The scalar type.
+	using scalar_type = Scalar;
+
+	/// @brief Get if a ray hits the geometry.
+	/// @param index the index of the ray
+	/// @return @a true if the ray hits the geometry, @a false otherwise
+	bool is_hit(std::size_t index) const
+	{ return m_distances[index] != std::numeric_limits<scalar_type>::infinity(); }
+
+	/// @brief Get the distance along a ray at which the ray enters the geometry.
+	/// @param index the index of the ray
+	/// @return the distance, @a 0 if the origin of the ray is inside the geometry, positive infinity if the ray misses the geometry
+	scalar_type get_distance(std::size_t index) const
+	{ return m_distances[index]; }
+
+	/// @brief Get the distances of all rays.
+	/// @return a pointer to the array of @a Width distances
+	const scalar_type *get_distances() const
+	{ return m_distances; }
+
+	/// @brief Get the hit mask.
+	/// @return a bitmask with the bit @a i set if the ray @a i hits the geometry
+	std::uint64_t get_mask() const
+	{
+		static_assert(Width <= 64, "mask can not represent the result");
+		std::uint64_t mask = 0;
+		for (std::size_t i = 0; i < Width; ++i)
+		{ mask |= std::uint64_t(is_hit(i) ? 1 : 0) << i; }
+		return mask;
+	}
+
+	/// @brief The distances.
+	alignas(32) scalar_type m_distances[Width];
+
+}; // struct ray_packet_intersection_result
+
+namespace internal {
+
+/// @brief Invoke a kernel of idlib::internal::ray_kernel for each register of a ray packet.
+/// @param f a function invoked as <c>f(o, d, r)</c> returning the distances
+template <typename P, std::size_t Width, typename F>
+ray_packet_intersection_result<typename P::scalar_type, Width> for_each_register(const ray_packet<P, Width>& x, F&& f)
+{
+	using V = typename ray_packet_value<typename P::scalar_type, Width>::type;
+	static constexpr std::size_t D = ray_packet<P, Width>::dimensionality();
+	ray_packet_intersection_result<typename P::scalar_type, Width> result;
+	for (std::size_t j = 0; j < Width; j += V::width)
+	{
+		V o[D], d[D], r[D];
+		for (std::size_t i = 0; i < D; ++i)
+		{
+			o[i] = V::load(x.get_origins(i) + j);
+			d[i] = V::load(x.get_directions(i) + j);
+			r[i] = V::load(x.get_reciprocal_directions(i) + j);
+		}
+		f(o, d, r).store(result.m_distances + j);
+	}
+	return result;
+}
+
+/// @brief Convert a single ray into the arguments of idlib::internal::ray_kernel.
+template <typename P>
+struct scalar_ray
+{
+	using V = scalar_value<typename P::scalar_type>;
+	static constexpr std::size_t D = P::dimensionality();
+	V o[D], d[D], r[D];
+
+	explicit scalar_ray(const ray<P>& x)
+	{
+		for (std::size_t i = 0; i < D; ++i)
+		{
+			o[i] = V::broadcast(x.get_origin()[i]);
+			d[i] = V::broadcast(x.get_direction()[i]);
+			r[i] = V::broadcast(one<typename P::scalar_type>() / x.get_direction()[i]);
+		}
+	}
+};
+
+/// @brief Get the components of a point as an array.
+template <typename P>
+struct point_components
+{
+	typename P::scalar_type v[P::dimensionality()];
+
+	explicit point_components(const P& p)
+	{
+		for (std::size_t i = 0; i < P::dimensionality(); ++i)
+		{ v[i] = p[i]; }
+	}
+};
+
+} // namespace internal
+
+/// @brief Specialization of idlib::intersect_functor.
+/// Intersects a ray with an axis aligned box.
+/// @tparam P the point type of the geometries
+template <typename P>
+struct intersect_functor<ray<P>, axis_aligned_box<P>>
+{
+	auto operator()(const ray<P>& a, const axis_aligned_box<P>& b) const
+	{
+		internal::scalar_ray<P> x(a);
+		internal::point_components<P> min(b.get_min()), max(b.get_max());
+		return ray_intersection_result<typename P::scalar_type>
+			(internal::ray_kernel<typename internal::scalar_ray<P>::V, P::dimensionality()>::axis_aligned_box(x.o, x.d, x.r, min.v, max.v).v);
+	}
+}; // struct intersect_functor
+
+/// @brief Specialization of idlib::intersect_functor.
+/// Intersects a ray with an axis aligned cube.
+/// @tparam P the point type of the geometries
+template <typename P>
+struct intersect_functor<ray<P>, axis_aligned_cube<P>>
+{
+	auto operator()(const ray<P>& a, const axis_aligned_cube<P>& b) const
+	{
+		internal::scalar_ray<P> x(a);
+		internal::point_components<P> min(b.get_min()), max(b.get_max());
+		return ray_intersection_result<typename P::scalar_type>
+			(internal::ray_kernel<typename internal::scalar_ray<P>::V, P::dimensionality()>::axis_aligned_box(x.o, x.d, x.r, min.v, max.v).v);
+	}
+}; // struct intersect_functor
+
+/// @brief Specialization of idlib::intersect_functor.
+/// Intersects a ray with a sphere.
+/// @tparam P the point type of the geometries
+template <typename P>
+struct intersect_functor<ray<P>, sphere<P>>
+{
+	auto operator()(const ray<P>& a, const sphere<P>& b) const
+	{
+		internal::scalar_ray<P> x(a);
+		internal::point_components<P> center(b.get_center());
+		return ray_intersection_result<typename P::scalar_type>
+			(internal::ray_kernel<typename internal::scalar_ray<P>::V, P::dimensionality()>::sphere(x.o, x.d, center.v, b.get_radius_squared()).v);
+	}
+}; // struct intersect_functor
+
+/// @brief Specialization of idlib::intersect_functor.
+/// Intersects a ray with a plane.
+/// @remark A ray parallel to the plane does not intersect the plane even if it lies in the plane.
+/// @tparam P the point type of the geometries
+template <typename P>
+struct intersect_functor<ray<P>, plane<P>>
+{
+	auto operator()(const ray<P>& a, const plane<P>& b) const
+	{
+		internal::scalar_ray<P> x(a);
+		internal::point_components<typename P::vector_type> normal(b.get_normal());
+		return ray_intersection_result<typename P::scalar_type>
+			(internal::ray_kernel<typename internal::scalar_ray<P>::V, P::dimensionality()>::plane(x.o, x.d, normal.v, b.get_distance()).v);
+	}
+}; // struct intersect_functor
+
+/// @brief Specialization of idlib::intersect_functor.
+/// Intersects a packet of rays with an axis aligned box.
+/// @remark The distances are bit-identical to the distances computed for the single rays.
+/// @tparam P the point type of the geometries
+/// @tparam Width the number of rays
+template <typename P, std::size_t Width>
+struct intersect_functor<ray_packet<P, Width>, axis_aligned_box<P>>
+{
+	auto operator()(const ray_packet<P, Width>& a, const axis_aligned_box<P>& b) const
+	{
+		internal::point_components<P> min(b.get_min()), max(b.get_max());
+		return internal::for_each_register(a, [&](const auto *o, const auto *d, const auto *r)
+		{ return internal::ray_kernel<std::decay_t<decltype(*o)>, P::dimensionality()>::axis_aligned_box(o, d, r, min.v, max.v); });
+	}
+}; // struct intersect_functor
+
+/// @brief Specialization of idlib::intersect_functor.
+/// Intersects a packet of rays with an axis aligned cube.
+/// @remark The distances are bit-identical to the distances computed for the single rays.
+/// @tparam P the point type of the geometries
+/// @tparam Width the number of rays
+template <typename P, std::size_t Width>
+struct intersect_functor<ray_packet<P, Width>, axis_aligned_cube<P>>
+{
+	auto operator()(const ray_packet<P, Width>& a, const axis_aligned_cube<P>& b) const
+	{
+		internal::point_components<P> min(b.get_min()), max(b.get_max());
+		return internal::for_each_register(a, [&](const auto *o, const auto *d, const auto *r)
+		{ return internal::ray_kernel<std::decay_t<decltype(*o)>, P::dimensionality()>::axis_aligned_box(o, d, r, min.v, max.v); });
+	}
+}; // struct intersect_functor
+
+/// @brief Specialization of idlib::intersect_functor.
+/// Intersects a packet of rays with a sphere.
+/// @remark The distances are bit-identical to the distances computed for the single rays.
+/// @tparam P the point type of the geometries
+/// @tparam Width the number of rays
+template <typename P, std::size_t Width>
+struct intersect_functor<ray_packet<P, Width>, sphere<P>>
+{
+	auto operator()(const ray_packet<P, Width>& a, const sphere<P>& b) const
+	{
+		internal::point_components<P> center(b.get_center());
+		const auto radius_squared = b.get_radius_squared();
+		return internal::for_each_register(a, [&](const auto *o, const auto *d, const auto *)
+		{ return internal::ray_kernel<std::decay_t<decltype(*o)>, P::dimensionality()>::sphere(o, d, center.v, radius_squared); });
+	}
+}; // struct intersect_functor
+
+/// @brief Specialization of idlib::intersect_functor.
+/// Intersects a packet of rays with a plane.
+/// @remark The distances are bit-identical to the distances computed for the single rays.
+/// @tparam P the point type of the geometries
+/// @tparam Width the number of rays
+template <typename P, std::size_t Width>
+struct intersect_functor<ray_packet<P, Width>, plane<P>>
+{
+	auto operator()(const ray_packet<P, Width>& a, const plane<P>& b) const
+	{
+		internal::point_components<typename P::vector_type> normal(b.get_normal());
+		return internal::for_each_register(a, [&](const auto *o, const auto *d, const auto *)
+		{ return internal::ray_kernel<std::decay_t<decltype(*o)>, P::dimensionality()>::plane(o, d, normal.v, b.get_distance()); });
+	}
+}; // struct intersect_functor
+
+} // namespace idlib
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/geometry/ray_kernel.hpp
+/// @brief Kernels of the intersection of rays with geometries.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/batch_kernel.hpp"
+#include <limits>
+
+namespace idlib { namespace internal {
+
+/// @brief Kernels computing the distances along rays at which the rays enter geometries.
+/// @detail
+/// A ray is passed as its origin @a o, its unit direction @a d and the reciprocals @a r of the components of its direction,
+/// each an array of @a Dimensionality values.
+/// A value holds the components of one ray (idlib::internal::scalar_value) or of several rays (idlib::internal::simd_value).
+/// The geometry is passed as scalars and is the same for all rays.
+/// Each kernel returns the distance at which the ray enters the geometry, @a 0 if the origin is inside the geometry,
+/// and positive infinity if the ray misses the geometry.
+/// @tparam V the value type
+/// @tparam Dimensionality the dimensionality
+/// @remark Each algorithm is written once in terms of the value type.
+/// Hence the intersection of a single ray and the intersection of a ray packet compute bit-identical distances.
+template <typename V, std::size_t Dimensionality>
+struct ray_kernel
+{
+	using scalar_type = typename V::scalar_type;
+
+	static V infinity()
+	{ return V::broadcast(std::numeric_limits<scalar_type>::infinity()); }
+
+	/// @brief Intersect rays with an axis aligned box by the slab method.
+	/// @param lower, upper the minimum and the maximum of the box
+	/// @remark If a direction component is zero, the ray misses the box if its origin is outside of the slab along that axis.
+	static V axis_aligned_box(const V *o, const V *d, const V *r, const scalar_type *lower, const scalar_type *upper)
+	{
+		const V zero = V::broadcast(scalar_type(0)), inf = infinity(), ninf = V::broadcast(-std::numeric_limits<scalar_type>::infinity());
+		V t0 = zero, t1 = inf;
+		for (std::size_t i = 0; i < Dimensionality; ++i)
+		{
+			const V a = V::broadcast(lower[i]), b = V::broadcast(upper[i]);
+			const V u = (a - o[i]) * r[i], v = (b - o[i]) * r[i];
+			V lo = min(u, v), hi = max(u, v);
+			// Parallel to the slab: the slab is either missed or does not constrain the distance.
+			lo = select_equal(d[i], zero, select_less(o[i], a, inf, select_less(b, o[i], inf, ninf)), lo);
+			hi = select_equal(d[i], zero, inf, hi);
+			t0 = max(t0, lo);
+			t1 = min(t1, hi);
+		}
+		return select_less(t1, t0, inf, t0);
+	}
+
+	/// @brief Intersect rays with a sphere.
+	/// @param center the center of the sphere
+	/// @param radius_squared the squared radius of the sphere
+	static V sphere(const V *o, const V *d, const scalar_type *center, scalar_type radius_squared)
+	{
+		const V zero = V::broadcast(scalar_type(0)), inf = infinity();
+		V b = zero, c = zero;
+		for (std::size_t i = 0; i < Dimensionality; ++i)
+		{
+			const V x = o[i] - V::broadcast(center[i]);
+			b = b + x * d[i];
+			c = c + x * x;
+		}
+		c = c - V::broadcast(radius_squared);
+		// The distances are the roots of t^2 + 2bt + c = 0.
+		const V e = b * b - c;
+		const V t = (zero - b) - sqrt(select_less(e, zero, zero, e));
+		V result = select_less(t, zero, inf, t);
+		result = select_less(e, zero, inf, result);
+		// c <= 0 if the origin is inside of the sphere.
+		return select_less(zero, c, result, zero);
+	}
+
+	/// @brief Intersect rays with a plane.
+	/// @param normal the unit normal of the plane
+	/// @param distance the distance of the plane from the origin
+	/// @remark A ray parallel to the plane misses the plane even if it lies in the plane.
+	static V plane(const V *o, const V *d, const scalar_type *normal, scalar_type distance)
+	{
+		const V zero = V::broadcast(scalar_type(0)), inf = infinity();
+		V p = zero, q = V::broadcast(distance);
+		for (std::size_t i = 0; i < Dimensionality; ++i)
+		{
+			const V n = V::broadcast(normal[i]);
+			p = p + n * d[i];
+			q = q + n * o[i];
+		}
+		const V t = (zero - q) / select_equal(p, zero, V::broadcast(scalar_type(1)), p);
+		return select_equal(p, zero, inf, select_less(t, zero, inf, t));
+	}
+
+}; // struct ray_kernel
+
+/// @brief Select the value type processing packets of rays of the specified width.
+/// @detail The widest SIMD register whose width divides the packet width is selected, scalars if there is none.
+/// @tparam Scalar the scalar type
+/// @tparam Width the number of rays of a packet
+template <typename Scalar, std::size_t Width, typename Enabled = void>
+struct ray_packet_value
+{
+	using type = scalar_value<Scalar>;
+};
+
+#if defined(IDLIB_WITH_SSE2)
+
+template <typename Scalar, std::size_t Width>
+struct ray_packet_value<Scalar, Width, std::enable_if_t<has_simd_traits<Scalar>::value && !has_wide_simd_traits<Scalar>::value>>
+{
+	using type = std::conditional_t<Width % simd_traits<Scalar>::width == 0, simd_value<Scalar>, scalar_value<Scalar>>;
+};
+
+template <typename Scalar, std::size_t Width>
+struct ray_packet_value<Scalar, Width, std::enable_if_t<has_wide_simd_traits<Scalar>::value>>
+{
+	using type = std::conditional_t<Width % wide_simd_traits<Scalar>::width == 0, simd_value<Scalar, wide_simd_traits<Scalar>>,
+	             std::conditional_t<Width % simd_traits<Scalar>::width == 0, simd_value<Scalar>, scalar_value<Scalar>>>;
+};
+
+#endif
+
+} } // namespace idlib::internal
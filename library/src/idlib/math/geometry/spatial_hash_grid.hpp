@@ -0,0 +1,990 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/geometry/spatial_hash_grid.hpp
+/// @brief Spatial hash grids for broad-phase overlap queries.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/geometry/axis_aligned_box.hpp"
+#include "idlib/math/geometry/sphere.hpp"
+#include "idlib/math/enclose.hpp"
+#include "idlib/math/is_intersecting.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/range/span.hpp"
+#include "idlib/utility/parallel_for.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A spatial hash grid over geometries.
+/// @details
+/// Space is partitioned into cubic cells of a fixed size.
+/// A geometry whose enclosing axis aligned box is smaller than a cell along each axis is small and is stored in the cell
+/// containing the center of that box. Two small geometries can only intersect if their cells are identical or adjacent.
+/// The occupied cells are looked up by their integer coordinates in an open addressing hash table.
+/// Geometries which are not small are large, they are kept in a separate list and are tested against the cells they may overlap.
+/// The cell size should be slightly larger than the typical geometry.
+/// @details
+/// Geometries are identified by handles which are returned by insert and remain valid until remove.
+/// Moving a geometry within its cell only replaces the geometry.
+/// @details
+/// To find all pairs of intersecting geometries, the occupied cells are swept in lexicographic order of their coordinates
+/// such that adjacent cells are found by advancing cursors rather than by hash table lookups.
+/// The exact tests are performed by idlib::is_intersecting.
+/// @tparam G the geometry type e.g. idlib::sphere or idlib::axis_aligned_box.
+/// idlib::enclose_functor must be specialized for enclosing G into idlib::axis_aligned_box
+/// and idlib::is_intersecting_functor must be specialized for pairs of G.
+template <typename G>
+struct spatial_hash_grid
+{
+public:
+	/// @brief The geometry type of this spatial hash grid type.
+	using geometry_type = G;
+
+	/// @brief The point type of this spatial hash grid type.
+	using point_type = typename G::point_type;
+
+	/// @brief The scalar type of this spatial hash grid type.
+	using scalar_type = typename point_type::scalar_type;
+
+	/// @brief The box type of this spatial hash grid type.
+	using box_type = axis_aligned_box<point_type>;
+
+	/// @brief The handle type of this spatial hash grid type.
+	using handle_type = std::uint32_t;
+
+	/// @brief The pair type of this spatial hash grid type.
+	/// The first handle is smaller than the second handle.
+	using pair_type = std::pair<handle_type, handle_type>;
+
+	static_assert(std::is_floating_point<scalar_type>::value, "scalar type must be a floating point type");
+
+	/// @brief The dimensionality of this spatial hash grid type.
+	/// @return the dimensionality
+	static constexpr std::size_t dimensionality()
+	{ return point_type::dimensionality(); }
+
+	static_assert(dimensionality() >= 1 && dimensionality() <= 8, "dimensionality must be within [1, 8]");
+
+	/// @brief Construct this spatial hash grid with no geometries.
+	/// @param cell_size the size of the cells
+	/// @throw idlib::invalid_argument_error the cell size is not positive or not finite
+	explicit spatial_hash_grid(scalar_type cell_size)
+		: m_cell_size(cell_size), m_inverse_cell_size(one<scalar_type>() / cell_size),
+		  m_small_extent(cell_size * scalar_type(0.99))
+	{
+		if (!(cell_size > zero<scalar_type>()) || !std::isfinite(cell_size) || !std::isfinite(m_inverse_cell_size))
+		{ throw invalid_argument_error(__FILE__, __LINE__, "cell size is not positive or not finite"); }
+	}
+
+	spatial_hash_grid(const spatial_hash_grid&) = default;
+	spatial_hash_grid(spatial_hash_grid&&) = default;
+	spatial_hash_grid& operator=(const spatial_hash_grid&) = default;
+	spatial_hash_grid& operator=(spatial_hash_grid&&) = default;
+
+	/// @brief Get the size of the cells of this spatial hash grid.
+	/// @return the size of the cells
+	scalar_type get_cell_size() const
+	{ return m_cell_size; }
+
+	/// @brief Get the number of geometries of this spatial hash grid.
+	/// @return the number of geometries
+	std::size_t size() const
+	{ return m_size; }
+
+	/// @brief Get if this spatial hash grid has no geometries.
+	/// @return @a true if this spatial hash grid has no geometries, @a false otherwise
+	bool empty() const
+	{ return m_size == 0; }
+
+	/// @brief Get the number of occupied cells of this spatial hash grid.
+	/// @return the number of occupied cells
+	std::size_t get_cell_count() const
+	{ return m_cell_count; }
+
+	/// @brief Get the number of large geometries of this spatial hash grid.
+	/// @return the number of large geometries
+	std::size_t get_large_count() const
+	{ return m_large.size(); }
+
+	/// @brief Get if a handle refers to a geometry of this spatial hash grid.
+	/// @param handle the handle
+	/// @return @a true if the handle refers to a geometry, @a false otherwise
+	bool contains(handle_type handle) const
+	{ return handle < m_objects.size() && m_objects[handle].state != state_removed; }
+
+	/// @brief Get the geometry of a handle.
+	/// @param handle the handle
+	/// @return the geometry
+	/// @throw idlib::invalid_argument_error the handle does not refer to a geometry of this spatial hash grid
+	const geometry_type& get(handle_type handle) const
+	{
+		ensure_contains(handle);
+		const object& o = m_objects[handle];
+		return o.state == state_large ? m_large_geometries[o.position] : m_cells[o.index].geometries[o.position];
+	}
+
+	/// @brief Insert a geometry.
+	/// @param geometry the geometry
+	/// @return the handle of the geometry
+	/// @throw idlib::invalid_argument_error a coordinate of the geometry is NaN
+	/// @throw idlib::invalid_argument_error there are 2<sup>32</sup> - 1 geometries
+	handle_type insert(const geometry_type& geometry)
+	{
+		const entry e = make_entry(geometry);
+		const handle_type handle = allocate_handle();
+		link(handle, e);
+		return handle;
+	}
+
+	/// @brief Insert geometries.
+	/// @param geometries the geometries
+	/// @param[out] handles receives the handles of the geometries
+	/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+	/// @throw idlib::invalid_argument_error the number of geometries and handles differ
+	/// @throw idlib::invalid_argument_error a coordinate of a geometry is NaN
+	/// @throw idlib::invalid_argument_error there would be 2<sup>32</sup> - 1 geometries
+	/// @remark If an exception is raised, this spatial hash grid was not modified.
+	void insert(span<const geometry_type> geometries, span<handle_type> handles, std::size_t thread_count = 0)
+	{
+		if (geometries.size() != handles.size())
+		{ throw invalid_argument_error(__FILE__, __LINE__, "number of geometries and handles differ"); }
+		if (geometries.size() >= std::size_t(invalid_index) - m_size)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "too many geometries"); }
+		std::vector<entry> entries(geometries.size());
+		parallel_for(0, geometries.size(), grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+		{
+			for (std::size_t i = b; i < e; ++i)
+			{ entries[i] = make_entry(geometries[i]); }
+		});
+		m_objects.reserve(m_objects.size() + geometries.size());
+		for (std::size_t i = 0; i < geometries.size(); ++i)
+		{
+			handles[i] = allocate_handle();
+			link(handles[i], entries[i]);
+		}
+	}
+
+	/// @brief Move a geometry i.e. replace the geometry of a handle.
+	/// @param handle the handle
+	/// @param geometry the geometry
+	/// @throw idlib::invalid_argument_error the handle does not refer to a geometry of this spatial hash grid
+	/// @throw idlib::invalid_argument_error a coordinate of the geometry is NaN
+	void move(handle_type handle, const geometry_type& geometry)
+	{
+		ensure_contains(handle);
+		const entry e = make_entry(geometry);
+		if (!replace(handle, e))
+		{
+			unlink(handle);
+			link(handle, e);
+		}
+	}
+
+	/// @brief Move geometries i.e. replace the geometries of handles.
+	/// @param handles the handles. Must be distinct.
+	/// @param geometries the geometries
+	/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+	/// @throw idlib::invalid_argument_error the number of handles and geometries differ
+	/// @throw idlib::invalid_argument_error a handle does not refer to a geometry of this spatial hash grid
+	/// @throw idlib::invalid_argument_error a coordinate of a geometry is NaN
+	/// @remark Geometries which remain within their cells are replaced by multiple threads,
+	/// the other geometries are relocated by the calling thread.
+	/// If an exception is raised, this spatial hash grid was not modified.
+	void move(span<const handle_type> handles, span<const geometry_type> geometries, std::size_t thread_count = 0)
+	{
+		if (geometries.size() != handles.size())
+		{ throw invalid_argument_error(__FILE__, __LINE__, "number of handles and geometries differ"); }
+		for (auto handle : handles)
+		{ ensure_contains(handle); }
+		std::vector<entry> entries(geometries.size());
+		std::vector<std::uint8_t> replaced(geometries.size());
+		parallel_for(0, geometries.size(), grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+		{
+			for (std::size_t i = b; i < e; ++i)
+			{ entries[i] = make_entry(geometries[i]); }
+		});
+		// As the handles are distinct, the threads replace distinct geometries.
+		parallel_for(0, geometries.size(), grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+		{
+			for (std::size_t i = b; i < e; ++i)
+			{ replaced[i] = replace(handles[i], entries[i]); }
+		});
+		for (std::size_t i = 0; i < geometries.size(); ++i)
+		{
+			if (replaced[i]) continue;
+			unlink(handles[i]);
+			link(handles[i], entries[i]);
+		}
+	}
+
+	/// @brief Remove a geometry.
+	/// @param handle the handle of the geometry
+	/// @throw idlib::invalid_argument_error the handle does not refer to a geometry of this spatial hash grid
+	/// @post The handle is invalid and may be returned by subsequent insertions.
+	void remove(handle_type handle)
+	{
+		ensure_contains(handle);
+		unlink(handle);
+		m_objects[handle].state = state_removed;
+		m_free.push_back(handle);
+		--m_size;
+	}
+
+	/// @brief Remove all geometries.
+	/// @post All handles are invalid.
+	void clear()
+	{
+		m_size = 0;
+		m_objects.clear();
+		m_free.clear();
+		m_large.clear();
+		m_large_geometries.clear();
+		m_cells.clear();
+		m_free_cells.clear();
+		m_cell_count = 0;
+		m_table.clear();
+		m_table_shift = 64;
+		m_order.clear();
+		m_created.clear();
+		m_stale_count = 0;
+	}
+
+	/// @brief Find all pairs of intersecting geometries.
+	/// @param[out] pairs receives the pairs. If there are more pairs than the buffer can hold, the excess pairs are dropped.
+	/// @param thread_count the maximal number of threads, @a 0 selects idlib::get_default_thread_count()
+	/// @return the number of pairs of intersecting geometries, which may exceed the size of the buffer
+	/// @remark Each pair is reported exactly once, the first handle of a pair is smaller than the second handle.
+	/// The order of the pairs is unspecified if more than one thread is used.
+	/// @remark The order of the occupied cells is updated by merging the cells occupied since the previous invocation.
+	/// The small geometries are then copied in that order into contiguous storage which is swept by the threads.
+	/// Besides the bookkeeping of the threads, memory is only allocated if the number of geometries has grown.
+	std::size_t find_pairs(span<pair_type> pairs, std::size_t thread_count = 0)
+	{
+		update_order();
+		update_snapshot(thread_count);
+		std::atomic<std::size_t> count(0);
+		const std::size_t m = m_snapshot.size() - 1, n = m + m_large.size();
+		parallel_for(0, n, cell_grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t)
+		{
+			pair_buffer buffer(pairs, count);
+			if (b < m)
+			{ find_pairs_of_cells(b, std::min(e, m), buffer); }
+			for (std::size_t i = std::max(b, m); i < e; ++i)
+			{ find_pairs_of_large(i - m, buffer); }
+			buffer.flush();
+		});
+		return count.load();
+	}
+
+	/// @brief Visit the geometries intersecting a query geometry.
+	/// @param query the query geometry.
+	/// idlib::enclose_functor must be specialized for enclosing Q into idlib::axis_aligned_box
+	/// and idlib::is_intersecting_functor must be specialized for Q and G.
+	/// @param visitor a function invoked as <c>visitor(h, g)</c> for the handle @a h and the geometry @a g of each geometry
+	/// @throw idlib::invalid_argument_error a coordinate of the query geometry is NaN
+	/// @remark Each geometry is visited at most once.
+	template <typename Q, typename Visitor>
+	void query(const Q& query, Visitor&& visitor) const
+	{
+		const auto box = enclose<box_type>(query);
+		for_each_cell_near(box, [&](const cell& c)
+		{
+			for (std::size_t i = 0; i < c.handles.size(); ++i)
+			{
+				if (is_intersecting(query, c.geometries[i])) visitor(c.handles[i], c.geometries[i]);
+			}
+		});
+		for (std::size_t i = 0; i < m_large.size(); ++i)
+		{
+			if (is_intersecting(query, m_large_geometries[i])) visitor(m_large[i], m_large_geometries[i]);
+		}
+	}
+
+private:
+	/// @brief The invalid index.
+	static constexpr std::uint32_t invalid_index = std::numeric_limits<std::uint32_t>::max();
+
+	/// @brief The minimal number of geometries per thread.
+	static constexpr std::size_t grain = 4096;
+
+	/// @brief The minimal number of cells per thread.
+	static constexpr std::size_t cell_grain = 1024;
+
+	/// @brief The number of pairs a thread buffers before writing them.
+	static constexpr std::size_t buffer_size = 256;
+
+	/// @{
+	/// @brief The cell coordinates are packed into a key of 64 bits.
+	/// Each coordinate occupies a field of key_bits bits, the last coordinate occupies the most significant field.
+	/// The coordinates are clamped to [-key_bound, +key_bound] and are biased by key_bound + 1 such that
+	/// the field of a coordinate can be incremented or decremented by one without affecting other fields.
+	/// Hence the lexicographic order of the coordinates is the order of the keys and adjacent cells differ by constants.
+	using key_type = std::uint64_t;
+	using cell_coordinates = std::array<std::int64_t, dimensionality()>;
+	static constexpr std::size_t key_bits = 63 / dimensionality();
+	static constexpr std::int64_t key_bound = (std::int64_t(1) << (key_bits - 1)) - 2;
+	/// @}
+
+	/// @brief The states of an object.
+	enum object_state : std::uint8_t
+	{
+		/// @brief The geometry is small.
+		state_small,
+		/// @brief The geometry is large.
+		state_large,
+		/// @brief The geometry was removed.
+		state_removed,
+	};
+
+	/// @brief The location of a geometry.
+	struct object
+	{
+		/// @brief If the geometry is small, the index of its cell.
+		std::uint32_t index;
+		/// @brief The index of the geometry in its cell or in the list of large geometries.
+		std::uint32_t position;
+		object_state state;
+	};
+
+	/// @brief A geometry and the location it belongs to.
+	struct entry
+	{
+		geometry_type geometry;
+		/// @brief If the geometry is small, the key of its cell.
+		key_type key;
+		bool large;
+	};
+
+	/// @brief A cell. A cell is occupied if it has geometries and free otherwise.
+	/// @remark The geometries are stored in the cells such that they are copied from contiguous memory.
+	struct cell
+	{
+		key_type key;
+		/// @brief Incremented whenever the cell is occupied to detect outdated entries of the order.
+		std::uint32_t generation = 0;
+		/// @brief If the cell has an entry in the order.
+		bool ordered = false;
+		std::vector<handle_type> handles;
+		std::vector<geometry_type> geometries;
+	};
+
+	/// @brief A slot of the open addressing hash table of the cells.
+	struct slot
+	{
+		key_type key;
+		/// @brief The index of the cell or idlib::spatial_hash_grid::invalid_index if the slot is empty.
+		std::uint32_t index;
+	};
+
+	/// @brief An entry of the order of the cells.
+	/// The entry is outdated if the cell is free or was occupied again since the entry was created.
+	struct order_entry
+	{
+		key_type key;
+		std::uint32_t index;
+		std::uint32_t generation;
+	};
+
+	/// @brief An entry of the snapshot of the occupied cells.
+	/// The geometries of the cell are in the range [begin, end) where end is the begin of the next entry.
+	struct snapshot_entry
+	{
+		key_type key;
+		std::uint32_t begin;
+	};
+
+	/// @brief A buffer of pairs of a thread.
+	/// The handles of the buffered pairs are not initialized until they are pushed.
+	struct pair_buffer
+	{
+		span<pair_type> pairs;
+		std::atomic<std::size_t>& count;
+		handle_type firsts[buffer_size];
+		handle_type seconds[buffer_size];
+		std::size_t size;
+
+		pair_buffer(span<pair_type> pairs, std::atomic<std::size_t>& count) :
+			pairs(pairs), count(count), size(0)
+		{}
+
+		void push_back(handle_type a, handle_type b)
+		{
+			firsts[size] = std::min(a, b);
+			seconds[size] = std::max(a, b);
+			if (++size == buffer_size) flush();
+		}
+
+		void flush()
+		{
+			const std::size_t at = count.fetch_add(size, std::memory_order_relaxed);
+			for (std::size_t i = 0; i < size && at + i < pairs.size(); ++i)
+			{ pairs[at + i] = pair_type(firsts[i], seconds[i]); }
+			size = 0;
+		}
+	};
+
+	void ensure_contains(handle_type handle) const
+	{
+		if (!contains(handle))
+		{ throw invalid_argument_error(__FILE__, __LINE__, "invalid handle"); }
+	}
+
+	/// @brief Get the clamped cell coordinate of a coordinate.
+	std::int64_t get_cell(scalar_type x) const
+	{
+		static constexpr scalar_type bound = scalar_type(key_bound);
+		x = std::floor(x * m_inverse_cell_size);
+		if (x != x)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "coordinate is NaN"); }
+		return static_cast<std::int64_t>(std::min(std::max(x, -bound), bound));
+	}
+
+	/// @brief Get the key of cell coordinates within [-key_bound - 1, key_bound + 1].
+	static key_type get_key(const cell_coordinates& x)
+	{
+		key_type key = 0;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{ key |= key_type(x[i] + key_bound + 1) << (key_bits * i); }
+		return key;
+	}
+
+	/// @brief Get the difference of the keys of cells whose coordinates differ by an offset.
+	static key_type get_key_offset(const cell_coordinates& offset)
+	{
+		key_type key = 0;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{ key += key_type(offset[i]) << (key_bits * i); }
+		return key;
+	}
+
+	/// @brief Create an entry for a geometry.
+	/// @remark The extents of small geometries are smaller than 99% of the cell size such that rounding errors can not
+	/// separate the cells of intersecting small geometries by more than one cell.
+	entry make_entry(const geometry_type& geometry) const
+	{
+		static constexpr scalar_type half = one<scalar_type>() / (one<scalar_type>() + one<scalar_type>());
+		const auto box = enclose<box_type>(geometry);
+		cell_coordinates x;
+		bool large = false;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			const scalar_type min = box.get_min()[i], max = box.get_max()[i];
+			x[i] = get_cell((min + max) * half);
+			if (!(max - min <= m_small_extent)) large = true;
+		}
+		return entry{ geometry, get_key(x), large };
+	}
+
+	/// @brief Replace the geometry of an object if the object remains at its location.
+	/// @return @a true if the geometry was replaced, @a false if the locations differ
+	bool replace(handle_type handle, const entry& e)
+	{
+		const object& o = m_objects[handle];
+		if (o.state != state_small || e.large) return false;
+		cell& c = m_cells[o.index];
+		if (c.key != e.key) return false;
+		c.geometries[o.position] = e.geometry;
+		return true;
+	}
+
+	handle_type allocate_handle()
+	{
+		handle_type handle;
+		if (!m_free.empty())
+		{
+			handle = m_free.back();
+			m_free.pop_back();
+		}
+		else
+		{
+			if (m_objects.size() >= std::size_t(invalid_index))
+			{ throw invalid_argument_error(__FILE__, __LINE__, "too many geometries"); }
+			handle = handle_type(m_objects.size());
+			m_objects.emplace_back();
+		}
+		++m_size;
+		return handle;
+	}
+
+	/// @brief Add a geometry to its cell or the list of large geometries.
+	void link(handle_type handle, const entry& e)
+	{
+		object& o = m_objects[handle];
+		if (e.large)
+		{
+			o = object{ invalid_index, std::uint32_t(m_large.size()), state_large };
+			m_large.push_back(handle);
+			m_large_geometries.push_back(e.geometry);
+		}
+		else
+		{
+			std::uint32_t index = find_cell(e.key);
+			if (index == invalid_index)
+			{ index = create_cell(e.key); }
+			cell& c = m_cells[index];
+			o = object{ index, std::uint32_t(c.handles.size()), state_small };
+			c.handles.push_back(handle);
+			c.geometries.push_back(e.geometry);
+		}
+	}
+
+	/// @brief Remove a geometry from its cell or the list of large geometries.
+	void unlink(handle_type handle)
+	{
+		const object o = m_objects[handle];
+		if (o.state == state_large)
+		{
+			m_objects[m_large.back()].position = o.position;
+			m_large[o.position] = m_large.back();
+			m_large_geometries[o.position] = m_large_geometries.back();
+			m_large.pop_back();
+			m_large_geometries.pop_back();
+		}
+		else
+		{
+			cell& c = m_cells[o.index];
+			m_objects[c.handles.back()].position = o.position;
+			c.handles[o.position] = c.handles.back();
+			c.geometries[o.position] = c.geometries.back();
+			c.handles.pop_back();
+			c.geometries.pop_back();
+			if (c.handles.empty()) destroy_cell(o.index);
+		}
+	}
+
+	/// @{
+	/// @brief Operations of the open addressing hash table of the cells.
+	/// @remark The table uses linear probing with backward shift deletion and a load factor of at most 1/2.
+
+	std::size_t get_home(key_type key) const
+	{ return std::size_t((key * UINT64_C(0x9E3779B97F4A7C15)) >> m_table_shift); }
+
+	std::uint32_t find_cell(key_type key) const
+	{
+		if (m_table.empty()) return invalid_index;
+		const std::size_t mask = m_table.size() - 1;
+		for (std::size_t i = get_home(key); ; i = (i + 1) & mask)
+		{
+			const slot& s = m_table[i];
+			if (s.index == invalid_index) return invalid_index;
+			if (s.key == key) return s.index;
+		}
+	}
+
+	/// @brief Set the index of a cell in the table, adding the cell if it is not in the table.
+	void assign_cell(key_type key, std::uint32_t index)
+	{
+		const std::size_t mask = m_table.size() - 1;
+		for (std::size_t i = get_home(key); ; i = (i + 1) & mask)
+		{
+			slot& s = m_table[i];
+			if (s.index == invalid_index || s.key == key)
+			{
+				s.key = key;
+				s.index = index;
+				return;
+			}
+		}
+	}
+
+	void erase_cell(key_type key)
+	{
+		const std::size_t mask = m_table.size() - 1;
+		std::size_t i = get_home(key);
+		while (m_table[i].key != key || m_table[i].index == invalid_index) i = (i + 1) & mask;
+		for (std::size_t j = (i + 1) & mask; m_table[j].index != invalid_index; j = (j + 1) & mask)
+		{
+			// Move the entry at j to the hole at i if its home is not cyclically within (i, j].
+			const std::size_t k = get_home(m_table[j].key);
+			if (((j - k) & mask) >= ((j - i) & mask))
+			{
+				m_table[i] = m_table[j];
+				i = j;
+			}
+		}
+		m_table[i].index = invalid_index;
+	}
+
+	/// @}
+
+	/// @brief Occupy a cell.
+	/// @remark Free cells are reused such that the indices of the cells are stable and their storage is reused.
+	std::uint32_t create_cell(key_type key)
+	{
+		if (2 * (m_cell_count + 1) > m_table.size())
+		{
+			std::size_t size = std::max<std::size_t>(64, 2 * m_table.size());
+			std::vector<slot> table(size, slot{ 0, invalid_index });
+			m_table.swap(table);
+			m_table_shift = 64;
+			for (; size > 1; size /= 2) m_table_shift--;
+			for (std::uint32_t i = 0; i < m_cells.size(); ++i)
+			{
+				if (!m_cells[i].handles.empty()) assign_cell(m_cells[i].key, i);
+			}
+		}
+		std::uint32_t index;
+		if (!m_free_cells.empty())
+		{
+			index = m_free_cells.back();
+			m_free_cells.pop_back();
+		}
+		else
+		{
+			index = std::uint32_t(m_cells.size());
+			m_cells.emplace_back();
+		}
+		cell& c = m_cells[index];
+		c.key = key;
+		c.generation++;
+		c.ordered = false;
+		m_created.push_back(index);
+		assign_cell(key, index);
+		++m_cell_count;
+		return index;
+	}
+
+	/// @brief Free an empty cell.
+	void destroy_cell(std::uint32_t index)
+	{
+		erase_cell(m_cells[index].key);
+		if (m_cells[index].ordered) ++m_stale_count;
+		m_free_cells.push_back(index);
+		--m_cell_count;
+	}
+
+	/// @brief Invoke a function for each occupied cell whose small geometries may intersect a box.
+	template <typename F>
+	void for_each_cell_near(const box_type& box, F&& f) const
+	{
+		cell_coordinates lower, upper;
+		std::uint64_t volume = 1;
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			lower[i] = get_cell(box.get_min()[i]) - 1;
+			upper[i] = get_cell(box.get_max()[i]) + 1;
+			volume *= std::uint64_t(upper[i] - lower[i] + 1);
+		}
+		// Look up the cells of the range or scan the occupied cells, whatever is fewer.
+		if (volume <= m_cell_count)
+		{
+			cell_coordinates x = lower;
+			while (true)
+			{
+				const std::uint32_t index = find_cell(get_key(x));
+				if (index != invalid_index) f(m_cells[index]);
+				std::size_t i = 0;
+				for (; i < dimensionality(); ++i)
+				{
+					if (x[i] < upper[i])
+					{
+						++x[i];
+						break;
+					}
+					x[i] = lower[i];
+				}
+				if (i == dimensionality()) break;
+			}
+		}
+		else
+		{
+			static constexpr key_type mask = (key_type(1) << key_bits) - 1;
+			for (const auto& c : m_cells)
+			{
+				if (c.handles.empty()) continue;
+				bool within = true;
+				for (std::size_t i = 0; i < dimensionality(); ++i)
+				{
+					const std::int64_t y = std::int64_t((c.key >> (key_bits * i)) & mask) - key_bound - 1;
+					within = within && lower[i] <= y && y <= upper[i];
+				}
+				if (within) f(c);
+			}
+		}
+	}
+
+	bool is_current(const order_entry& e) const
+	{
+		const cell& c = m_cells[e.index];
+		return c.generation == e.generation && !c.handles.empty();
+	}
+
+	/// @brief Merge the cells occupied since the last update into the order and remove outdated entries if they are many.
+	void update_order()
+	{
+		if (m_created.empty() && 4 * m_stale_count <= m_order.size()) return;
+		const bool compact = 4 * m_stale_count > m_order.size();
+		// Collect the entries of the occupied cells which are not in the order.
+		const std::size_t old_size = m_order.size();
+		for (std::uint32_t index : m_created)
+		{
+			cell& c = m_cells[index];
+			if (c.handles.empty() || c.ordered) continue;
+			c.ordered = true;
+			m_order.push_back(order_entry{ c.key, index, c.generation });
+		}
+		m_created.clear();
+		auto compare = [](const order_entry& a, const order_entry& b) { return a.key < b.key; };
+		std::sort(m_order.begin() + old_size, m_order.end(), compare);
+		// Merge the sorted ranges into the scratch storage.
+		m_scratch.resize(m_order.size());
+		std::size_t n = 0;
+		auto emit = [&](const order_entry& e)
+		{
+			if (compact && !is_current(e)) return;
+			m_scratch[n++] = e;
+		};
+		std::size_t i = 0, j = old_size;
+		while (i < old_size && j < m_order.size())
+		{ emit(compare(m_order[j], m_order[i]) ? m_order[j++] : m_order[i++]); }
+		while (i < old_size) emit(m_order[i++]);
+		while (j < m_order.size()) emit(m_order[j++]);
+		m_scratch.resize(n);
+		m_order.swap(m_scratch);
+		if (compact)
+		{
+			m_stale_count = 0;
+			for (auto& c : m_cells) c.ordered = false;
+			for (const auto& e : m_order) m_cells[e.index].ordered = true;
+		}
+	}
+
+	/// @brief Copy the small geometries of the occupied cells in the order into contiguous storage.
+	/// @remark The cells are counted and copied in the same ranges of the order by multiple threads.
+	void update_snapshot(std::size_t thread_count)
+	{
+		if (thread_count == 0) thread_count = get_default_thread_count();
+		std::vector<std::array<std::size_t, 2>> offsets(thread_count + 1);
+		const std::size_t k = parallel_for(0, m_order.size(), grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t i)
+		{
+			std::size_t cells = 0, geometries = 0;
+			for (std::size_t j = b; j < e; ++j)
+			{
+				if (!is_current(m_order[j])) continue;
+				cells++;
+				geometries += m_cells[m_order[j].index].handles.size();
+			}
+			offsets[i + 1] = { cells, geometries };
+		});
+		for (std::size_t i = 0; i < k; ++i)
+		{
+			offsets[i + 1][0] += offsets[i][0];
+			offsets[i + 1][1] += offsets[i][1];
+		}
+		m_snapshot.resize(offsets[k][0] + 1);
+		m_snapshot_handles.resize(offsets[k][1]);
+		m_snapshot_geometries.resize(offsets[k][1]);
+		// The last entry is a sentinel.
+		m_snapshot.back() = snapshot_entry{ ~key_type(0), std::uint32_t(offsets[k][1]) };
+		parallel_for(0, m_order.size(), grain, thread_count, [&](std::size_t b, std::size_t e, std::size_t i)
+		{
+			std::size_t cells = offsets[i][0], geometries = offsets[i][1];
+			for (std::size_t j = b; j < e; ++j)
+			{
+				if (!is_current(m_order[j])) continue;
+				const cell& c = m_cells[m_order[j].index];
+				m_snapshot[cells++] = snapshot_entry{ c.key, std::uint32_t(geometries) };
+				std::copy(c.handles.begin(), c.handles.end(), m_snapshot_handles.begin() + geometries);
+				std::copy(c.geometries.begin(), c.geometries.end(), m_snapshot_geometries.begin() + geometries);
+				geometries += c.handles.size();
+			}
+		});
+	}
+
+	/// @brief Test the geometries of a cell of the snapshot against each other.
+	void test(std::size_t i, pair_buffer& buffer) const
+	{
+		const handle_type *h = m_snapshot_handles.data();
+		const geometry_type *g = m_snapshot_geometries.data();
+		for (std::size_t x = m_snapshot[i].begin, e = m_snapshot[i + 1].begin; x < e; ++x)
+		{
+			for (std::size_t y = x + 1; y < e; ++y)
+			{
+				if (is_intersecting(g[x], g[y])) buffer.push_back(h[x], h[y]);
+			}
+		}
+	}
+
+	/// @brief Test the geometries of a cell of the snapshot against the geometries of the cells [j, k) of the snapshot.
+	void test(std::size_t i, std::size_t j, std::size_t k, pair_buffer& buffer) const
+	{
+		const handle_type *h = m_snapshot_handles.data();
+		const geometry_type *g = m_snapshot_geometries.data();
+		for (std::size_t x = m_snapshot[i].begin, e = m_snapshot[i + 1].begin; x < e; ++x)
+		{
+			for (std::size_t y = m_snapshot[j].begin, f = m_snapshot[k].begin; y < f; ++y)
+			{
+				if (is_intersecting(g[x], g[y])) buffer.push_back(h[x], h[y]);
+			}
+		}
+	}
+
+	/// @brief Find the pairs of small geometries of a range of cells of the snapshot.
+	/// @details For each cell the pairs within the cell and the pairs with the adjacent cells succeeding the cell in
+	/// the order are found, hence each pair is found once.
+	/// The adjacent cell in the same row (i.e. all coordinates but the first are equal) immediately succeeds the cell.
+	/// Each other row with adjacent cells succeeding the cell has a cursor which is advanced to the first such cell.
+	/// As the adjacent cells of a row are consecutive in the snapshot, they are tested in one go.
+	void find_pairs_of_cells(std::size_t begin, std::size_t end, pair_buffer& buffer) const
+	{
+		static constexpr std::size_t row_count = (power(3, dimensionality() - 1) - 1) / 2;
+		key_type offsets[row_count + 1];
+		std::size_t cursors[row_count + 1];
+		for (std::size_t r = 0; r < row_count; ++r)
+		{
+			cell_coordinates offset;
+			offset[0] = -1;
+			for (std::size_t i = 1, m = row_count + 1 + r; i < dimensionality(); ++i, m /= 3)
+			{ offset[i] = std::int64_t(m % 3) - 1; }
+			offsets[r] = get_key_offset(offset);
+		}
+		const snapshot_entry *s = m_snapshot.data();
+		for (std::size_t r = 0; r < row_count; ++r)
+		{
+			const key_type t = s[begin].key + offsets[r];
+			cursors[r] = std::lower_bound(s, s + end, t, [](const snapshot_entry& a, key_type b) { return a.key < b; }) - s;
+		}
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const key_type key = s[i].key;
+			test(i, buffer);
+			// The adjacent cell in the same row. The sentinel terminates the snapshot.
+			if (s[i + 1].key == key + 1) test(i, i + 1, i + 2, buffer);
+			// The adjacent cells in the succeeding rows.
+			for (std::size_t r = 0; r < row_count; ++r)
+			{
+				const key_type t = key + offsets[r];
+				std::size_t j = cursors[r];
+				while (s[j].key < t) ++j;
+				cursors[r] = j;
+				std::size_t k = j;
+				while (s[k].key <= t + 2) ++k;
+				if (j != k) test(i, j, k, buffer);
+			}
+		}
+	}
+
+	static constexpr std::size_t power(std::size_t x, std::size_t n)
+	{ return n == 0 ? 1 : x * power(x, n - 1); }
+
+	/// @brief Find the pairs of a large geometry and small geometries or succeeding large geometries.
+	void find_pairs_of_large(std::size_t index, pair_buffer& buffer) const
+	{
+		const handle_type h = m_large[index];
+		const geometry_type& g = m_large_geometries[index];
+		for_each_cell_near(enclose<box_type>(g), [&](const cell& c)
+		{
+			for (std::size_t y = 0; y < c.handles.size(); ++y)
+			{
+				if (is_intersecting(g, c.geometries[y])) buffer.push_back(h, c.handles[y]);
+			}
+		});
+		for (std::size_t i = index + 1; i < m_large.size(); ++i)
+		{
+			if (is_intersecting(g, m_large_geometries[i])) buffer.push_back(h, m_large[i]);
+		}
+	}
+
+	/// @brief The size of the cells.
+	scalar_type m_cell_size;
+
+	/// @brief The inverse of the size of the cells.
+	scalar_type m_inverse_cell_size;
+
+	/// @brief The maximal extent of a small geometry.
+	scalar_type m_small_extent;
+
+	/// @brief The number of geometries.
+	std::size_t m_size = 0;
+
+	/// @brief The locations of the geometries indexed by their handles.
+	std::vector<object> m_objects;
+
+	/// @brief The handles of removed geometries.
+	std::vector<handle_type> m_free;
+
+	/// @brief The handles of the large geometries.
+	std::vector<handle_type> m_large;
+
+	/// @brief The large geometries.
+	std::vector<geometry_type> m_large_geometries;
+
+	/// @brief The occupied and the free cells.
+	std::vector<cell> m_cells;
+
+	/// @brief The indices of the free cells.
+	std::vector<std::uint32_t> m_free_cells;
+
+	/// @brief The number of occupied cells.
+	std::size_t m_cell_count = 0;
+
+	/// @brief The open addressing hash table mapping keys to indices of occupied cells.
+	/// Its size is zero or a power of two.
+	std::vector<slot> m_table;
+
+	/// @brief The shift of the product of a key and the multiplier of the hash function.
+	std::size_t m_table_shift = 64;
+
+	/// @brief The entries of the occupied cells in ascending order of their keys.
+	/// Contains outdated entries which are skipped.
+	std::vector<order_entry> m_order;
+
+	/// @brief Scratch storage for updating the order.
+	std::vector<order_entry> m_scratch;
+
+	/// @brief The indices of the cells occupied since the last update of the order.
+	std::vector<std::uint32_t> m_created;
+
+	/// @brief An upper bound of the number of outdated entries in the order.
+	std::size_t m_stale_count = 0;
+
+	/// @brief The occupied cells in the order followed by a sentinel.
+	std::vector<snapshot_entry> m_snapshot;
+
+	/// @brief The handles of the small geometries in the order of the cells.
+	std::vector<handle_type> m_snapshot_handles;
+
+	/// @brief The small geometries in the order of the cells.
+	std::vector<geometry_type> m_snapshot_geometries;
+
+}; // struct spatial_hash_grid
+
+} // namespace idlib
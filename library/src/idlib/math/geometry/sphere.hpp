@@ -29,6 +29,7 @@
 #pragma once
 
 #include "idlib/math/point.hpp"
+#include "idlib/math/geometry/axis_aligned_box.hpp"
 #include "idlib/crtp.hpp"
 #include "idlib/math/floating_point.hpp"
 
@@ -123,7 +124,7 @@ public:
     /// @return the diameter of this sphere
 	scalar_type get_diameter() const
 	{ 
-		static const auto TWO = one<scalar_type>() + one<scalar_type>();
+		static constexpr auto TWO = one<scalar_type>() + one<scalar_type>();
 		return get_radius() * TWO;
 	}
 
@@ -164,6 +165,20 @@ struct enclose_functor<sphere<P>, sphere<P>>
 	{ return source; }
 }; // struct enclose_functor
 
+/// @brief Specialization of idlib::enclose_functor enclosing a sphere into an axis aligned box.
+/// @detail The axis aligned box \f$b\f$ enclosing a sphere \f$a\f$ with center \f$c\f$ and radius \f$r\f$
+/// is given by \f$b_{min} = c - (r,\ldots,r)\f$ and \f$b_{max} = c + (r,\ldots,r)\f$.
+/// @tparam P the point type of the sphere and the axis aligned box
+template <typename P>
+struct enclose_functor<axis_aligned_box<P>, sphere<P>>
+{
+	auto operator()(const sphere<P>& source) const
+	{
+		const auto extent = one<typename P::vector_type>() * source.get_radius();
+		return axis_aligned_box<P>(source.get_center() - extent, source.get_center() + extent);
+	}
+}; // struct enclose_functor
+
 /// @brief Specialization of idlib::is_enclosing_functor.
 /// Determines wether a sphere contains a point.
 /// @remark A sphere \f$(c,r)\f$ with the center $c$ and the radius $r$
@@ -289,4 +304,46 @@ struct is_intersecting_functor<P, sphere<P>>
 	{ return is_intersecting(b, a); }
 }; // struct is_intersecting_functor
 
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if a sphere and an axis aligned box intersect.
+/// @remark A sphere with the center \f$C\f$ and the radius \f$r\f$ and an axis aligned box \f$A\f$ intersect
+/// if the squared distance from \f$C\f$ to the closest point of \f$A\f$ is smaller than or equal to \f$r^2\f$.
+/// Along each axis \f$k\f$ that distance is \f$A_{min_k} - C_k\f$ if \f$C_k < A_{min_k}\f$,
+/// \f$C_k - A_{max_k}\f$ if \f$C_k > A_{max_k}\f$, and \f$0\f$ otherwise.
+template <typename P>
+struct is_intersecting_functor<sphere<P>, axis_aligned_box<P>>
+{
+	bool operator()(const sphere<P>& a, const axis_aligned_box<P>& b) const
+	{
+		auto distance_squared = zero<typename P::scalar_type>();
+		for (size_t i = 0; i < P::dimensionality(); ++i)
+		{
+			const auto c = a.get_center()[i];
+			if (c < b.get_min()[i])
+			{
+				const auto d = b.get_min()[i] - c;
+				distance_squared += d * d;
+			}
+			else if (c > b.get_max()[i])
+			{
+				const auto d = c - b.get_max()[i];
+				distance_squared += d * d;
+			}
+		}
+		return distance_squared <= a.get_radius_squared();
+	}
+}; // struct is_intersecting_functor
+
+/// @brief Specialization of idlib::is_intersecting_functor.
+/// Determines if an axis aligned box and a sphere intersect.
+/// @remark The method for determinating if a sphere and an axis aligned box intersect is
+/// commutative. By swapping the arguments that method can be reused to determine if an
+/// axis aligned box and a sphere intersect.
+template <typename P>
+struct is_intersecting_functor<axis_aligned_box<P>, sphere<P>>
+{
+	bool operator()(const axis_aligned_box<P>& a, const sphere<P>& b) const
+	{ return is_intersecting(b, a); }
+}; // struct is_intersecting_functor
+
 } // namespace idlib
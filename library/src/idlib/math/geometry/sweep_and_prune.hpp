@@ -0,0 +1,591 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/geometry/sweep_and_prune.hpp
+/// @brief Incremental sweep and prune over axis aligned boxes.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/geometry/axis_aligned_box.hpp"
+#include "idlib/math/is_intersecting.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/utility/invalid_argument_error.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief The counters of an update of an idlib::sweep_and_prune.
+struct sweep_and_prune_counters
+{
+	/// @brief The number of swaps of endpoints performed by the insertion sorts.
+	std::size_t swap_count = 0;
+
+	/// @brief The number of tests of pairs of boxes.
+	std::size_t test_count = 0;
+
+	/// @brief The number of added pairs.
+	std::size_t added_count = 0;
+
+	/// @brief The number of removed pairs.
+	std::size_t removed_count = 0;
+
+	/// @brief The number of pairs after the update.
+	std::size_t pair_count = 0;
+
+	/// @brief If the endpoints were sorted from scratch rather than by insertion sort.
+	bool rebuilt = false;
+
+}; // struct sweep_and_prune_counters
+
+/// @ingroup math
+/// @brief A persistent sweep and prune (SAP) structure over axis aligned boxes.
+/// @details
+/// For each axis the minima and maxima of the boxes along that axis, the endpoints, are kept in ascending order.
+/// If the boxes move coherently, the order changes little between updates and is restored by insertion sort.
+/// Whenever a minimum passes a maximum, the intervals of the two boxes along that axis begin or cease to overlap.
+/// Hence the pairs of intersecting boxes are maintained by testing (by idlib::is_intersecting) or removing only these pairs.
+/// An update reports the pairs which began and the pairs which ceased to intersect since the previous update.
+/// @details
+/// Insertions, moves and removals are recorded and take effect by the next update.
+/// Inserted boxes enter the order from its end. If many boxes were inserted,
+/// the endpoints are sorted from scratch and the pairs are found by a sweep along the first axis instead.
+/// @details
+/// Boxes are identified by handles which are returned by insert and remain valid until remove.
+/// The handle of a removed box may be returned by insertions after the next update.
+/// @tparam P the point type of the axis aligned boxes. Its scalar type must be a floating point type.
+template <typename P>
+struct sweep_and_prune
+{
+public:
+	/// @brief The point type of this SAP type.
+	using point_type = P;
+
+	/// @brief The scalar type of this SAP type.
+	using scalar_type = typename P::scalar_type;
+
+	/// @brief The box type of this SAP type.
+	using box_type = axis_aligned_box<P>;
+
+	/// @brief The handle type of this SAP type.
+	using handle_type = std::uint32_t;
+
+	/// @brief The pair type of this SAP type.
+	/// The first handle is smaller than the second handle.
+	using pair_type = std::pair<handle_type, handle_type>;
+
+	static_assert(std::is_floating_point<scalar_type>::value, "scalar type must be a floating point type");
+
+	/// @brief The dimensionality of this SAP type.
+	/// @return the dimensionality
+	static constexpr std::size_t dimensionality()
+	{ return P::dimensionality(); }
+
+	/// @brief Construct this SAP with no boxes.
+	sweep_and_prune()
+	{}
+
+	sweep_and_prune(const sweep_and_prune&) = default;
+	sweep_and_prune(sweep_and_prune&&) = default;
+	sweep_and_prune& operator=(const sweep_and_prune&) = default;
+	sweep_and_prune& operator=(sweep_and_prune&&) = default;
+
+	/// @brief Get the number of boxes of this SAP.
+	/// @return the number of boxes
+	std::size_t size() const
+	{ return m_size; }
+
+	/// @brief Get if this SAP has no boxes.
+	/// @return @a true if this SAP has no boxes, @a false otherwise
+	bool empty() const
+	{ return m_size == 0; }
+
+	/// @brief Get if a handle refers to a box of this SAP.
+	/// @param handle the handle
+	/// @return @a true if the handle refers to a box, @a false otherwise
+	bool contains(handle_type handle) const
+	{ return handle < m_states.size() && m_states[handle] == state_alive; }
+
+	/// @brief Get the box of a handle.
+	/// @param handle the handle
+	/// @return the box
+	/// @throw idlib::invalid_argument_error the handle does not refer to a box of this SAP
+	const box_type& get(handle_type handle) const
+	{
+		ensure_contains(handle);
+		return m_boxes[handle];
+	}
+
+	/// @brief Get the number of pairs of intersecting boxes as of the last update.
+	/// @return the number of pairs
+	std::size_t get_pair_count() const
+	{ return m_pairs.size(); }
+
+	/// @brief Get if two boxes intersected as of the last update.
+	/// @param a, b the handles of the boxes
+	/// @return @a true if the boxes intersected, @a false otherwise
+	bool is_overlapping(handle_type a, handle_type b) const
+	{ return a != b && m_pairs.contains(get_key(a, b)); }
+
+	/// @brief Invoke a function for each pair of intersecting boxes as of the last update.
+	/// @param f a function invoked as <c>f(p)</c> for each pair @a p in an unspecified order
+	template <typename F>
+	void for_each_pair(F&& f) const
+	{ m_pairs.for_each([&](std::uint64_t key) { f(get_pair(key)); }); }
+
+	/// @brief Get the counters of the last update.
+	/// @return the counters
+	const sweep_and_prune_counters& get_counters() const
+	{ return m_counters; }
+
+	/// @brief Insert a box.
+	/// @param box the box
+	/// @return the handle of the box
+	/// @throw idlib::invalid_argument_error a coordinate of the box is not finite
+	/// @throw idlib::invalid_argument_error there are 2<sup>31</sup> boxes
+	handle_type insert(const box_type& box)
+	{
+		ensure_finite(box);
+		handle_type handle;
+		if (!m_free.empty())
+		{
+			handle = m_free.back();
+			m_free.pop_back();
+		}
+		else
+		{
+			if (m_states.size() >= max_handle_count)
+			{ throw invalid_argument_error(__FILE__, __LINE__, "too many boxes"); }
+			handle = handle_type(m_states.size());
+			m_states.push_back(state_free);
+			m_boxes.emplace_back();
+		}
+		m_states[handle] = state_alive;
+		m_boxes[handle] = box;
+		for (auto& endpoints : m_endpoints)
+		{
+			endpoints.push_back(endpoint{ zero<scalar_type>(), handle << 1 });
+			endpoints.push_back(endpoint{ zero<scalar_type>(), (handle << 1) | 1 });
+		}
+		++m_size;
+		++m_inserted_count;
+		m_dirty = true;
+		return handle;
+	}
+
+	/// @brief Move a box i.e. replace the box of a handle.
+	/// @param handle the handle
+	/// @param box the box
+	/// @throw idlib::invalid_argument_error the handle does not refer to a box of this SAP
+	/// @throw idlib::invalid_argument_error a coordinate of the box is not finite
+	void move(handle_type handle, const box_type& box)
+	{
+		ensure_contains(handle);
+		ensure_finite(box);
+		m_boxes[handle] = box;
+		m_dirty = true;
+	}
+
+	/// @brief Remove a box.
+	/// @param handle the handle of the box
+	/// @throw idlib::invalid_argument_error the handle does not refer to a box of this SAP
+	/// @remark The pairs of the box are reported as removed by the next update.
+	void remove(handle_type handle)
+	{
+		ensure_contains(handle);
+		m_states[handle] = state_removed;
+		m_removed.push_back(handle);
+		--m_size;
+		m_dirty = true;
+	}
+
+	/// @brief Remove all boxes.
+	/// @post All handles are invalid. No pairs are reported as removed.
+	void clear()
+	{
+		m_boxes.clear();
+		m_states.clear();
+		m_free.clear();
+		m_removed.clear();
+		for (auto& endpoints : m_endpoints) endpoints.clear();
+		m_pairs.clear();
+		m_size = 0;
+		m_inserted_count = 0;
+		m_dirty = false;
+		m_counters = sweep_and_prune_counters();
+	}
+
+	/// @brief Update the pairs of intersecting boxes.
+	/// @param[out] added receives the pairs of boxes which began to intersect since the last update
+	/// @param[out] removed receives the pairs of boxes which ceased to intersect or were removed since the last update
+	/// @return the counters of this update
+	/// @remark A pair is not reported if it began and ceased to intersect between two updates.
+	const sweep_and_prune_counters& update(std::vector<pair_type>& added, std::vector<pair_type>& removed)
+	{
+		added.clear();
+		removed.clear();
+		m_counters = sweep_and_prune_counters();
+		if (m_dirty)
+		{
+			if (4 * m_inserted_count > m_size)
+			{ rebuild(added, removed); }
+			else
+			{ sort(added, removed); }
+			for (auto handle : m_removed)
+			{
+				m_states[handle] = state_free;
+				m_free.push_back(handle);
+			}
+			m_removed.clear();
+			m_inserted_count = 0;
+			m_dirty = false;
+		}
+		m_counters.added_count = added.size();
+		m_counters.removed_count = removed.size();
+		m_counters.pair_count = m_pairs.size();
+		return m_counters;
+	}
+
+private:
+	/// @brief The maximal number of handles.
+	static constexpr std::size_t max_handle_count = std::size_t(1) << 31;
+
+	/// @brief The states of a handle.
+	enum handle_state : std::uint8_t
+	{
+		/// @brief The handle refers to a box.
+		state_alive,
+		/// @brief The box was removed since the last update.
+		state_removed,
+		/// @brief The handle is free.
+		state_free,
+	};
+
+	/// @brief An endpoint i.e. the minimum or the maximum of a box along an axis.
+	struct endpoint
+	{
+		scalar_type value;
+		/// @brief The handle of the box shifted left by one, the least significant bit is set for maxima.
+		std::uint32_t data;
+
+		handle_type get_handle() const
+		{ return data >> 1; }
+
+		bool is_max() const
+		{ return (data & 1) != 0; }
+	};
+
+	/// @brief Get if an endpoint precedes another endpoint.
+	/// @remark Minima precede maxima of the same value such that touching boxes intersect as by idlib::is_intersecting.
+	static bool less(const endpoint& a, const endpoint& b)
+	{ return a.value < b.value || (a.value == b.value && !a.is_max() && b.is_max()); }
+
+	/// @brief An open addressing hash set of pairs.
+	/// @remark The set uses linear probing with backward shift deletion and a load factor of at most 1/2.
+	struct pair_set
+	{
+		static constexpr std::uint64_t empty_key = ~std::uint64_t(0);
+
+		std::vector<std::uint64_t> keys;
+		std::size_t count = 0;
+		std::size_t shift = 64;
+
+		std::size_t size() const
+		{ return count; }
+
+		std::size_t get_home(std::uint64_t key) const
+		{ return std::size_t((key * UINT64_C(0x9E3779B97F4A7C15)) >> shift); }
+
+		bool contains(std::uint64_t key) const
+		{
+			if (keys.empty()) return false;
+			const std::size_t mask = keys.size() - 1;
+			for (std::size_t i = get_home(key); keys[i] != empty_key; i = (i + 1) & mask)
+			{
+				if (keys[i] == key) return true;
+			}
+			return false;
+		}
+
+		/// @return @a true if the key was inserted, @a false if the set contains the key
+		bool insert(std::uint64_t key)
+		{
+			if (2 * (count + 1) > keys.size())
+			{ grow(); }
+			const std::size_t mask = keys.size() - 1;
+			std::size_t i = get_home(key);
+			for (; keys[i] != empty_key; i = (i + 1) & mask)
+			{
+				if (keys[i] == key) return false;
+			}
+			keys[i] = key;
+			++count;
+			return true;
+		}
+
+		/// @return @a true if the key was erased, @a false if the set does not contain the key
+		bool erase(std::uint64_t key)
+		{
+			if (keys.empty()) return false;
+			const std::size_t mask = keys.size() - 1;
+			std::size_t i = get_home(key);
+			for (; keys[i] != key; i = (i + 1) & mask)
+			{
+				if (keys[i] == empty_key) return false;
+			}
+			for (std::size_t j = (i + 1) & mask; keys[j] != empty_key; j = (j + 1) & mask)
+			{
+				// Move the key at j to the hole at i if its home is not cyclically within (i, j].
+				const std::size_t k = get_home(keys[j]);
+				if (((j - k) & mask) >= ((j - i) & mask))
+				{
+					keys[i] = keys[j];
+					i = j;
+				}
+			}
+			keys[i] = empty_key;
+			--count;
+			return true;
+		}
+
+		void grow()
+		{
+			std::vector<std::uint64_t> old(std::max<std::size_t>(64, 2 * keys.size()), empty_key);
+			old.swap(keys);
+			shift = 64;
+			for (std::size_t size = keys.size(); size > 1; size /= 2) shift--;
+			count = 0;
+			for (auto key : old)
+			{
+				if (key != empty_key) insert(key);
+			}
+		}
+
+		void clear()
+		{
+			keys.clear();
+			count = 0;
+			shift = 64;
+		}
+
+		template <typename F>
+		void for_each(F&& f) const
+		{
+			for (auto key : keys)
+			{
+				if (key != empty_key) f(key);
+			}
+		}
+	};
+
+	static std::uint64_t get_key(handle_type a, handle_type b)
+	{ return a < b ? (std::uint64_t(a) << 32) | b : (std::uint64_t(b) << 32) | a; }
+
+	static pair_type get_pair(std::uint64_t key)
+	{ return pair_type(handle_type(key >> 32), handle_type(key)); }
+
+	void ensure_contains(handle_type handle) const
+	{
+		if (!contains(handle))
+		{ throw invalid_argument_error(__FILE__, __LINE__, "invalid handle"); }
+	}
+
+	static void ensure_finite(const box_type& box)
+	{
+		for (std::size_t i = 0; i < dimensionality(); ++i)
+		{
+			if (!std::isfinite(box.get_min()[i]) || !std::isfinite(box.get_max()[i]))
+			{ throw invalid_argument_error(__FILE__, __LINE__, "coordinate is not finite"); }
+		}
+	}
+
+	/// @brief Update the order of the endpoints by insertion sort and the pairs by the swaps of minima and maxima.
+	/// @remark The minima of removed boxes are moved to infinity and their maxima to the greatest finite value.
+	/// Hence their intervals cease to overlap with any other interval and their pairs are removed.
+	/// Their endpoints are dropped afterwards.
+	void sort(std::vector<pair_type>& added, std::vector<pair_type>& removed)
+	{
+		static constexpr scalar_type infinity = std::numeric_limits<scalar_type>::infinity();
+		static constexpr scalar_type greatest = std::numeric_limits<scalar_type>::max();
+		for (std::size_t k = 0; k < dimensionality(); ++k)
+		{
+			auto& endpoints = m_endpoints[k];
+			for (auto& e : endpoints)
+			{
+				const handle_type h = e.get_handle();
+				if (m_states[h] != state_alive) e.value = e.is_max() ? greatest : infinity;
+				else e.value = e.is_max() ? m_boxes[h].get_max()[k] : m_boxes[h].get_min()[k];
+			}
+			endpoint *a = endpoints.data();
+			for (std::size_t i = 1, n = endpoints.size(); i < n; ++i)
+			{
+				const endpoint e = a[i];
+				std::size_t j = i;
+				for (; j > 0 && less(e, a[j - 1]); --j)
+				{
+					const endpoint& f = a[j - 1];
+					m_counters.swap_count++;
+					if (e.is_max() != f.is_max())
+					{
+						if (e.is_max())
+						{
+							// The intervals ceased to overlap along this axis.
+							if (m_pairs.erase(get_key(e.get_handle(), f.get_handle())))
+							{ removed.push_back(get_pair(get_key(e.get_handle(), f.get_handle()))); }
+						}
+						else
+						{
+							// The intervals began to overlap along this axis.
+							add(e.get_handle(), f.get_handle(), added);
+						}
+					}
+					a[j] = f;
+				}
+				a[j] = e;
+			}
+			if (!m_removed.empty())
+			{
+				endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(), [this](const endpoint& e)
+				{ return m_states[e.get_handle()] != state_alive; }), endpoints.end());
+			}
+		}
+	}
+
+	/// @brief Add a pair if both boxes are alive and intersect.
+	void add(handle_type a, handle_type b, std::vector<pair_type>& added)
+	{
+		if (m_states[a] != state_alive || m_states[b] != state_alive) return;
+		const std::uint64_t key = get_key(a, b);
+		if (m_pairs.contains(key)) return;
+		m_counters.test_count++;
+		if (is_intersecting(m_boxes[a], m_boxes[b]))
+		{
+			m_pairs.insert(key);
+			added.push_back(get_pair(key));
+		}
+	}
+
+	/// @brief Sort the endpoints from scratch, find the pairs by a sweep along the first axis
+	/// and report the differences of the old and the new pairs.
+	void rebuild(std::vector<pair_type>& added, std::vector<pair_type>& removed)
+	{
+		m_counters.rebuilt = true;
+		for (std::size_t k = 0; k < dimensionality(); ++k)
+		{
+			auto& endpoints = m_endpoints[k];
+			endpoints.clear();
+			for (handle_type h = 0; h < m_states.size(); ++h)
+			{
+				if (m_states[h] != state_alive) continue;
+				endpoints.push_back(endpoint{ m_boxes[h].get_min()[k], h << 1 });
+				endpoints.push_back(endpoint{ m_boxes[h].get_max()[k], (h << 1) | 1 });
+			}
+			std::sort(endpoints.begin(), endpoints.end(), less);
+		}
+		// The boxes whose intervals along the first axis contain the current endpoint.
+		// The boxes are copied such that they are tested in contiguous memory.
+		struct active_box
+		{
+			box_type box;
+			handle_type handle;
+		};
+		std::vector<active_box> active;
+		std::vector<std::uint32_t> positions(m_states.size());
+		pair_set pairs;
+		for (const auto& e : m_endpoints[0])
+		{
+			const handle_type h = e.get_handle();
+			if (e.is_max())
+			{
+				const std::uint32_t i = positions[h];
+				active[i] = active.back();
+				positions[active[i].handle] = i;
+				active.pop_back();
+				continue;
+			}
+			const box_type& box = m_boxes[h];
+			m_counters.test_count += active.size();
+			for (const auto& x : active)
+			{
+				if (!is_intersecting(box, x.box)) continue;
+				const std::uint64_t key = get_key(h, x.handle);
+				pairs.insert(key);
+				if (!m_pairs.contains(key)) added.push_back(get_pair(key));
+			}
+			positions[h] = std::uint32_t(active.size());
+			active.push_back(active_box{ box, h });
+		}
+		m_pairs.for_each([&](std::uint64_t key)
+		{
+			if (!pairs.contains(key)) removed.push_back(get_pair(key));
+		});
+		m_pairs = std::move(pairs);
+	}
+
+	/// @brief The boxes indexed by their handles.
+	std::vector<box_type> m_boxes;
+
+	/// @brief The states of the handles.
+	std::vector<handle_state> m_states;
+
+	/// @brief The free handles.
+	std::vector<handle_type> m_free;
+
+	/// @brief The handles of the boxes removed since the last update.
+	std::vector<handle_type> m_removed;
+
+	/// @brief The endpoints along each axis in ascending order as of the last update.
+	/// The endpoints of boxes inserted since the last update are at the end.
+	std::array<std::vector<endpoint>, dimensionality()> m_endpoints;
+
+	/// @brief The pairs of intersecting boxes as of the last update.
+	pair_set m_pairs;
+
+	/// @brief The number of boxes.
+	std::size_t m_size = 0;
+
+	/// @brief The number of boxes inserted since the last update.
+	std::size_t m_inserted_count = 0;
+
+	/// @brief If boxes were inserted, moved or removed since the last update.
+	bool m_dirty = false;
+
+	/// @brief The counters of the last update.
+	sweep_and_prune_counters m_counters;
+
+}; // struct sweep_and_prune
+
+} // namespace idlib
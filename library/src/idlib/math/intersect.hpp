@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/intersect.hpp
+/// @brief "intersect" functor and function
+/// @author Michael Heilmann
+
+#pragma once
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A functor computing the intersection of two geometries.
+/// @details
+/// Unlike idlib::is_intersecting_functor, which only determines if two geometries intersect,
+/// specializations of this functor compute information about the intersection (e.g. the distance along a ray at which the intersection begins).
+/// The type of that information depends on the specialization.
+/// @tparam A, B the types of the geometries
+template <typename ... T>
+struct intersect_functor;
+
+template <typename A, typename B>
+auto intersect(const A& a, const B& b) -> decltype(intersect_functor<A, B>()(a, b))
+{
+	return intersect_functor<A, B>()(a, b);
+}
+
+} // namespace idlib
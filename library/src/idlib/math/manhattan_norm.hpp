@@ -41,7 +41,7 @@ template <typename Vector>
 struct manhattan_norm_functor;
 
 template <typename Vector>
-auto manhattan_norm(const Vector& v) -> decltype(manhattan_norm_functor<Vector>()(v))
+constexpr auto manhattan_norm(const Vector& v) -> decltype(manhattan_norm_functor<Vector>()(v))
 { return manhattan_norm_functor<Vector>()(v); }
 
 } // namespace idlib
@@ -0,0 +1,41 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define IDLIB_PRIVATE 1
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/floating_point.hpp"
+#undef IDLIB_PRIVATE
+
+template struct idlib::matrix<single, 3, 3>;
+template struct idlib::matrix<single, 4, 4>;
+
+template struct idlib::matrix<double, 3, 3>;
+template struct idlib::matrix<double, 4, 4>;
+
+template struct idlib::matrix<quadruple, 3, 3>;
+template struct idlib::matrix<quadruple, 4, 4>;
+
+template struct idlib::invert_functor<idlib::matrix<single, 4, 4>>;
+template struct idlib::invert_functor<idlib::matrix<double, 4, 4>>;
+template struct idlib::invert_functor<idlib::matrix<quadruple, 4, 4>>;
@@ -0,0 +1,432 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/matrix.hpp
+/// @brief Matrices and affine transformations.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/point.hpp"
+#include "idlib/math/matrix_kernel.hpp"
+#include "idlib/math/angle.hpp"
+#include "idlib/math/angle-degrees-radians-turns.hpp"
+#include "idlib/math/invert.hpp"
+#include "idlib/math/translate.hpp"
+#include "idlib/range/span.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A matrix.
+/// @detail The elements are stored in row-major order.
+/// Points and vectors are column vectors i.e. a matrix \f$m\f$ is applied to a vector \f$v\f$ as \f$m v\f$.
+/// @remark Matrices are <a href=http://en.cppreference.com/w/cpp/concept/DefaultConstructible">DefaultConstructible</a>.
+/// A default-constructed matrix is the zero matrix. The identity matrix is idlib::one for square matrices.
+/// @remark The product of two matrices computes the sums of products left-to-right.
+/// For \f$4 \times 4\f$ matrices the product and the inverse are SIMD-backed if SIMD is available (see idlib::internal::matrix4_kernel).
+/// @tparam Scalar the scalar type
+/// @tparam Rows the number of rows
+/// @tparam Columns the number of columns
+template <typename Scalar, size_t Rows, size_t Columns>
+struct matrix
+{
+public:
+	/// @brief The scalar type.
+	using scalar_type = Scalar;
+
+	/// @brief The type of this template/template specialization.
+	using matrix_type = matrix<scalar_type, Rows, Columns>;
+
+	/// @brief The implementation type.
+	using implementation_type = arithmetic_tuple<scalar_type, Rows * Columns, zero_functor<scalar_type>>;
+
+	/// @brief Get the number of rows.
+	/// @return the number of rows
+	static constexpr size_t rows()
+	{ return Rows; }
+
+	/// @brief Get the number of columns.
+	/// @return the number of columns
+	static constexpr size_t columns()
+	{ return Columns; }
+
+private:
+	/// @brief The implementation.
+	implementation_type m_implementation;
+
+public:
+	/// @brief Construct this matrix with the specified element values in row-major order.
+	/// @param arguments ... the element values
+	/// @pre The number of specified element values must be equal to the number of elements of the matrix type.
+	/// @pre Each specified element value must be convertible into a scalar type value.
+	template<typename ... Arguments,
+	         typename = std::enable_if_t<(sizeof...(Arguments)) == Rows * Columns &&
+	                                     all_convertible<scalar_type, typename std::decay<Arguments>::type...>::value>>
+	matrix(Arguments&& ... arguments)
+		: m_implementation(std::forward<Arguments>(arguments)...)
+	{}
+
+	/// @internal
+	/// @brief Construct this matrix.
+	/// @param other the implementation_type value
+	matrix(const implementation_type& other) :
+		m_implementation(other)
+	{}
+
+	/// @brief Default-construct this matrix.
+	/// @post This matrix is the zero matrix.
+	matrix()
+		: m_implementation()
+	{ /* Intentionally empty. */ }
+
+	matrix(const matrix&) = default;
+	matrix& operator=(const matrix&) = default;
+
+public:
+	/// @{
+	/// @brief Get the element at the specified row and column.
+	/// @param row the row index
+	/// @param column the column index
+	/// @return a reference to the element
+	/// @pre The indices are within bounds.
+	scalar_type& operator()(size_t row, size_t column)
+	{ return m_implementation[row * Columns + column]; }
+
+	const scalar_type& operator()(size_t row, size_t column) const
+	{ return m_implementation[row * Columns + column]; }
+	/// @}
+
+	/// @{
+	/// @brief Get a pointer to the elements in row-major order.
+	/// @return a pointer to the elements
+	scalar_type *data()
+	{ return &(m_implementation[0]); }
+
+	const scalar_type *data() const
+	{ return &(m_implementation[0]); }
+	/// @}
+
+	/// @brief Get the row of the specified index.
+	/// @param index the row index
+	/// @return the row
+	/// @pre The index is within bounds.
+	vector<scalar_type, Columns> get_row(size_t index) const
+	{ return vector<scalar_type, Columns>::generate([this, index](size_t j) { return (*this)(index, j); }); }
+
+	/// @brief Get the column of the specified index.
+	/// @param index the column index
+	/// @return the column
+	/// @pre The index is within bounds.
+	vector<scalar_type, Rows> get_column(size_t index) const
+	{ return vector<scalar_type, Rows>::generate([this, index](size_t i) { return (*this)(i, index); }); }
+
+	/// @brief Get the transpose of this matrix.
+	/// @return the transpose
+	matrix<scalar_type, Columns, Rows> transpose() const
+	{
+		matrix<scalar_type, Columns, Rows> t;
+		for (size_t i = 0; i < Rows; ++i)
+		{
+			for (size_t j = 0; j < Columns; ++j)
+			{ t(j, i) = (*this)(i, j); }
+		}
+		return t;
+	}
+
+public:
+	bool operator==(const matrix_type& other) const
+	{ return m_implementation == other.m_implementation; }
+
+	bool operator!=(const matrix_type& other) const
+	{ return m_implementation != other.m_implementation; }
+
+public:
+	matrix_type operator+() const
+	{ return *this; }
+
+	matrix_type operator-() const
+	{ return matrix_type(-m_implementation); }
+
+	matrix_type operator+(const matrix_type& other) const
+	{ return matrix_type(m_implementation + other.m_implementation); }
+
+	matrix_type& operator+=(const matrix_type& other)
+	{ m_implementation += other.m_implementation; return *this; }
+
+	matrix_type operator-(const matrix_type& other) const
+	{ return matrix_type(m_implementation - other.m_implementation); }
+
+	matrix_type& operator-=(const matrix_type& other)
+	{ m_implementation -= other.m_implementation; return *this; }
+
+	matrix_type operator*(const scalar_type& other) const
+	{ return matrix_type(m_implementation * other); }
+
+	matrix_type& operator*=(const scalar_type& other)
+	{ m_implementation *= other; return *this; }
+
+	matrix_type operator/(const scalar_type& other) const
+	{ return matrix_type(m_implementation / other); }
+
+	matrix_type& operator/=(const scalar_type& other)
+	{ m_implementation /= other; return *this; }
+
+public:
+	/// @brief Compute the product of this matrix and another matrix.
+	/// @param other the other matrix
+	/// @return the product
+	template <size_t OtherColumns>
+	matrix<scalar_type, Rows, OtherColumns> operator*(const matrix<scalar_type, Columns, OtherColumns>& other) const
+	{
+		matrix<scalar_type, Rows, OtherColumns> c;
+		if constexpr (Rows == 4 && Columns == 4 && OtherColumns == 4)
+		{ internal::matrix4_kernel<scalar_type>::multiply(data(), other.data(), c.data()); }
+		else
+		{
+			for (size_t i = 0; i < Rows; ++i)
+			{
+				for (size_t k = 0; k < OtherColumns; ++k)
+				{
+					scalar_type t = (*this)(i, 0) * other(0, k);
+					for (size_t j = 1; j < Columns; ++j)
+					{ t = t + (*this)(i, j) * other(j, k); }
+					c(i, k) = t;
+				}
+			}
+		}
+		return c;
+	}
+
+	/// @brief Compute the product of this matrix and another matrix.
+	/// @param other the other matrix
+	/// @return this matrix
+	template <size_t LocalColumns = Columns>
+	std::enable_if_t<LocalColumns == Rows, matrix_type&> operator*=(const matrix_type& other)
+	{ return (*this) = (*this) * other; }
+
+	/// @brief Compute the product of this matrix and a vector.
+	/// @param v the vector
+	/// @return the product
+	vector<scalar_type, Rows> operator*(const vector<scalar_type, Columns>& v) const
+	{
+		vector<scalar_type, Rows> w;
+		for (size_t i = 0; i < Rows; ++i)
+		{
+			scalar_type t = (*this)(i, 0) * v[0];
+			for (size_t j = 1; j < Columns; ++j)
+			{ t = t + (*this)(i, j) * v[j]; }
+			w[i] = t;
+		}
+		return w;
+	}
+
+}; // struct matrix
+
+template <typename Scalar, size_t Rows, size_t Columns>
+struct zero_functor<matrix<Scalar, Rows, Columns>>
+{
+	using scalar_type = Scalar;
+	using matrix_type = matrix<scalar_type, Rows, Columns>;
+
+	auto operator()() const
+	{ return matrix_type(); }
+};
+
+/// @brief Specialization of idlib::one_functor for square matrices.
+/// Returns the identity matrix.
+template <typename Scalar, size_t Size>
+struct one_functor<matrix<Scalar, Size, Size>>
+{
+	using scalar_type = Scalar;
+	using matrix_type = matrix<scalar_type, Size, Size>;
+
+	auto operator()() const
+	{
+		matrix_type m;
+		for (size_t i = 0; i < Size; ++i)
+		{ m(i, i) = one<scalar_type>(); }
+		return m;
+	}
+};
+
+/// @brief The result of an inversion of a matrix.
+template <typename Scalar, size_t Size>
+struct inversion_result
+{
+	using scalar_type = Scalar;
+	using matrix_type = matrix<scalar_type, Size, Size>;
+	matrix_type m_matrix;
+	scalar_type m_determinant;
+
+	inversion_result(const matrix_type& matrix, const scalar_type& determinant)
+		: m_matrix(matrix), m_determinant(determinant)
+	{}
+
+	/// @brief Get the determinant of the inverted matrix.
+	/// @return the determinant
+	scalar_type get_determinant() const
+	{ return m_determinant; }
+
+	/// @brief Get the inverse matrix.
+	/// @return the inverse matrix
+	/// @throw std::domain_error the matrix is singular i.e. its determinant is @a 0
+	matrix_type get_matrix() const
+	{
+		if (m_determinant != zero<scalar_type>())
+		{ return m_matrix; }
+		else
+		{ throw std::domain_error("unable to invert singular matrix"); }
+	}
+};
+
+/// @brief Specialization of idlib::invert_functor for \f$4 \times 4\f$ matrices.
+/// Computes the inverse of a matrix.
+/// @remark The inverse is computed from the \f$2 \times 2\f$ sub-determinants (Laplace expansion).
+template <typename Scalar>
+struct invert_functor<matrix<Scalar, 4, 4>>
+{
+	using scalar_type = Scalar;
+	using matrix_type = matrix<scalar_type, 4, 4>;
+	using result_type = inversion_result<scalar_type, 4>;
+
+	result_type operator()(const matrix_type& m) const
+	{
+		matrix_type n;
+		auto d = internal::matrix4_kernel<scalar_type>::inverse(m.data(), n.data());
+		return result_type(n, d);
+	}
+
+}; // struct invert_functor
+
+/// @brief Create a translation matrix.
+/// @param t the translation vector
+/// @return the matrix
+template <typename Scalar>
+matrix<Scalar, 4, 4> translation(const vector<Scalar, 3>& t)
+{
+	auto m = one<matrix<Scalar, 4, 4>>();
+	m(0, 3) = t[0]; m(1, 3) = t[1]; m(2, 3) = t[2];
+	return m;
+}
+
+/// @brief Create a scaling matrix.
+/// @param s the scaling factors along the axes
+/// @return the matrix
+template <typename Scalar>
+matrix<Scalar, 4, 4> scaling(const vector<Scalar, 3>& s)
+{
+	auto m = one<matrix<Scalar, 4, 4>>();
+	m(0, 0) = s[0]; m(1, 1) = s[1]; m(2, 2) = s[2];
+	return m;
+}
+
+/// @brief Create a rotation matrix.
+/// @param axis the rotation axis
+/// @param a the counter-clockwise rotation angle
+/// @return the matrix
+/// @pre The rotation axis is a unit vector.
+template <typename Scalar>
+matrix<Scalar, 4, 4> rotation(const vector<Scalar, 3>& axis, const angle<Scalar, radians>& a)
+{
+	const Scalar c = std::cos(a.get_value()), s = std::sin(a.get_value()), t = one<Scalar>() - c;
+	const Scalar x = axis[0], y = axis[1], z = axis[2];
+	return matrix<Scalar, 4, 4>(t * x * x + c,     t * x * y - s * z, t * x * z + s * y, zero<Scalar>(),
+	                            t * x * y + s * z, t * y * y + c,     t * y * z - s * x, zero<Scalar>(),
+	                            t * x * z - s * y, t * y * z + s * x, t * z * z + c,     zero<Scalar>(),
+	                            zero<Scalar>(),    zero<Scalar>(),    zero<Scalar>(),    one<Scalar>());
+}
+
+/// @brief Specialization of idlib::translate_functor for \f$4 \times 4\f$ matrices.
+/// The translated matrix is the translation matrix of the translation vector multiplied by the matrix i.e.
+/// the translated matrix first applies the matrix and then the translation.
+template <typename Scalar>
+struct translate_functor<matrix<Scalar, 4, 4>, vector<Scalar, 3>>
+{
+	using scalar_type = Scalar;
+	using vector_type = vector<scalar_type, 3>;
+	using matrix_type = matrix<scalar_type, 4, 4>;
+
+	auto operator()(const matrix_type& m, const vector_type& t) const
+	{ return translation(t) * m; }
+
+}; // struct translate_functor
+
+/// @brief Transform a point by an affine transformation.
+/// @param m the matrix of the affine transformation. The last row is ignored.
+/// @param p the point
+/// @return the transformed point \f$m (p_x, p_y, p_z, 1)\f$
+template <typename Scalar>
+point<vector<Scalar, 3>> transform_point(const matrix<Scalar, 4, 4>& m, const point<vector<Scalar, 3>>& p)
+{
+	point<vector<Scalar, 3>> q;
+	internal::matrix4_kernel<Scalar>::transform_points(m.data(), 1, [&p](size_t) { return &(p[0]); }, [&q](size_t) { return &(q[0]); });
+	return q;
+}
+
+/// @brief Transform a vector by the linear part of an affine transformation.
+/// @param m the matrix of the affine transformation. The last row and the last column are ignored.
+/// @param v the vector
+/// @return the transformed vector \f$m (v_x, v_y, v_z, 0)\f$
+template <typename Scalar>
+vector<Scalar, 3> transform_vector(const matrix<Scalar, 4, 4>& m, const vector<Scalar, 3>& v)
+{
+	vector<Scalar, 3> w;
+	for (size_t i = 0; i < 3; ++i)
+	{ w[i] = (m(i, 0) * v[0] + m(i, 1) * v[1]) + m(i, 2) * v[2]; }
+	return w;
+}
+
+/// @brief Transform points by an affine transformation.
+/// @param m the matrix of the affine transformation. The last row is ignored.
+/// @param source the source points
+/// @param target the target points. May be @a source.
+/// @throw idlib::invalid_argument_error @a source and @a target are of different sizes
+/// @remark The results are bit-identical to the results of idlib::transform_point.
+/// @remark SIMD-backed if SIMD is available for the scalar type.
+template <typename Scalar>
+void transform_points(const matrix<Scalar, 4, 4>& m, span<const point<vector<Scalar, 3>>> source, span<point<vector<Scalar, 3>>> target)
+{
+	if (source.size() != target.size())
+	{ throw invalid_argument_error(__FILE__, __LINE__, "spans are of different sizes"); }
+	if (source.empty())
+	{ return; }
+	internal::matrix4_kernel<Scalar>::transform_points(m.data(), source.size(),
+	                                                   [&source](size_t i) { return &(source[i][0]); },
+	                                                   [&target](size_t i) { return &(target[i][0]); });
+}
+
+/// @brief Transform points in-place by an affine transformation.
+/// @param m the matrix of the affine transformation. The last row is ignored.
+/// @param points the points
+/// @remark The results are bit-identical to the results of idlib::transform_point.
+/// @remark SIMD-backed if SIMD is available for the scalar type.
+template <typename Scalar>
+void transform_points(const matrix<Scalar, 4, 4>& m, span<point<vector<Scalar, 3>>> points)
+{ transform_points(m, span<const point<vector<Scalar, 3>>>(points), points); }
+
+} // namespace idlib
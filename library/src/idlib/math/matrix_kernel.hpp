@@ -0,0 +1,234 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/matrix_kernel.hpp
+/// @brief Kernels of idlib::matrix for \f$4 \times 4\f$ matrices.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/batch_kernel.hpp"
+
+namespace idlib { namespace internal {
+
+/// @brief Kernels for \f$4 \times 4\f$ matrices stored in row-major order.
+/// @tparam Scalar the scalar type
+/// @tparam Enabled for SFINAE
+/// @remark A specialization using idlib::internal::simd_traits is provided for scalar types for which SIMD is available.
+/// Its results are bit-identical to the results of the scalar implementation.
+/// @remark Sums of products are computed left-to-right.
+template <typename Scalar, typename Enabled = void>
+struct matrix4_kernel
+{
+	/// @brief Compute the product \f$c = a b\f$.
+	/// @param a, b the factor matrices
+	/// @param c the product matrix. Must not be @a a or @a b.
+	static void multiply(const Scalar *a, const Scalar *b, Scalar *c)
+	{
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			for (std::size_t k = 0; k < 4; ++k)
+			{
+				Scalar t = a[4 * i + 0] * b[0 * 4 + k];
+				for (std::size_t j = 1; j < 4; ++j)
+				{ t = t + a[4 * i + j] * b[j * 4 + k]; }
+				c[4 * i + k] = t;
+			}
+		}
+	}
+
+	/// @brief Compute the inverse \f$b = a^{-1}\f$.
+	/// @param a the matrix
+	/// @param b the inverse matrix. May be @a a. Only assigned to if the determinant is not @a 0.
+	/// @return the determinant of @a a
+	static Scalar inverse(const Scalar *a, Scalar *b)
+	{
+		inverse_coefficients coefficients(a);
+		if (coefficients.determinant == Scalar(0))
+		{ return coefficients.determinant; }
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			const auto& row = coefficients.rows[i];
+			for (std::size_t l = 0; l < 4; ++l)
+			{ b[4 * i + l] = ((row.x[l] * row.p[l] - row.y[l] * row.q[l]) + row.z[l] * row.r[l]) * coefficients.inverse_determinant; }
+		}
+		return coefficients.determinant;
+	}
+
+	/// @brief Transform points \f$p' = m p\f$ where \f$p = (x, y, z, 1)\f$.
+	/// @param m the matrix
+	/// @param n the number of points
+	/// @param source a functor mapping an index to a pointer to the three components of the source point of that index
+	/// @param target a functor mapping an index to a pointer to the three components of the target point of that index.
+	/// The target point may be the source point.
+	/// @remark The last row of the matrix is ignored.
+	template <typename Source, typename Target>
+	static void transform_points(const Scalar *m, std::size_t n, Source&& source, Target&& target)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const Scalar *p = source(i);
+			const Scalar x = p[0], y = p[1], z = p[2];
+			Scalar *q = target(i);
+			for (std::size_t j = 0; j < 3; ++j)
+			{ q[j] = ((m[4 * j + 0] * x + m[4 * j + 1] * y) + m[4 * j + 2] * z) + m[4 * j + 3]; }
+		}
+	}
+
+protected:
+	/// @brief The coefficients of the inverse of a \f$4 \times 4\f$ matrix.
+	/// @remark
+	/// The element \f$b_{il}\f$ of the inverse \f$b\f$ of a matrix \f$a\f$ is
+	/// \f$((x_{il} p_{il} - y_{il} q_{il}) + z_{il} r_{il}) \cdot d^{-1}\f$
+	/// where \f$x, y, z\f$ are elements of \f$a\f$, \f$p, q, r\f$ are (signed) \f$2 \times 2\f$ sub-determinants of \f$a\f$,
+	/// and \f$d\f$ is the determinant of \f$a\f$.
+	struct inverse_coefficients
+	{
+		struct row_coefficients
+		{
+			alignas(32) Scalar x[4], y[4], z[4], p[4], q[4], r[4];
+		};
+		row_coefficients rows[4];
+		Scalar determinant;
+		Scalar inverse_determinant;
+
+		explicit inverse_coefficients(const Scalar *a)
+		{
+			auto e = [a](std::size_t i, std::size_t j) { return a[4 * i + j]; };
+			const Scalar s[6] =
+			{
+				e(0, 0) * e(1, 1) - e(1, 0) * e(0, 1),
+				e(0, 0) * e(1, 2) - e(1, 0) * e(0, 2),
+				e(0, 0) * e(1, 3) - e(1, 0) * e(0, 3),
+				e(0, 1) * e(1, 2) - e(1, 1) * e(0, 2),
+				e(0, 1) * e(1, 3) - e(1, 1) * e(0, 3),
+				e(0, 2) * e(1, 3) - e(1, 2) * e(0, 3),
+			};
+			const Scalar c[6] =
+			{
+				e(2, 0) * e(3, 1) - e(3, 0) * e(2, 1),
+				e(2, 0) * e(3, 2) - e(3, 0) * e(2, 2),
+				e(2, 0) * e(3, 3) - e(3, 0) * e(2, 3),
+				e(2, 1) * e(3, 2) - e(3, 1) * e(2, 2),
+				e(2, 1) * e(3, 3) - e(3, 1) * e(2, 3),
+				e(2, 2) * e(3, 3) - e(3, 2) * e(2, 3),
+			};
+			determinant = ((((s[0] * c[5] - s[1] * c[4]) + s[2] * c[3]) + s[3] * c[2]) - s[4] * c[1]) + s[5] * c[0];
+			inverse_determinant = Scalar(1) / determinant;
+			// The lanes of the columns of a in the order 1, 0, 3, 2.
+			auto column = [&e](std::size_t j, Scalar *t) { t[0] = e(1, j); t[1] = e(0, j); t[2] = e(3, j); t[3] = e(2, j); };
+			// The signed sub-determinants (c[k], c[k], s[k], s[k]) with the specified lane signs.
+			auto coefficient = [&s, &c](std::size_t k, bool positive, Scalar *t)
+			{
+				t[0] = positive ? c[k] : -c[k]; t[1] = positive ? -c[k] : c[k];
+				t[2] = positive ? s[k] : -s[k]; t[3] = positive ? -s[k] : s[k];
+			};
+			static const std::size_t x[4] = { 1, 0, 0, 0 }, y[4] = { 2, 2, 1, 1 }, z[4] = { 3, 3, 3, 2 };
+			static const std::size_t p[4] = { 5, 5, 4, 3 }, q[4] = { 4, 2, 2, 1 }, r[4] = { 3, 1, 0, 0 };
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				const bool positive = (i % 2) == 0;
+				column(x[i], rows[i].x); column(y[i], rows[i].y); column(z[i], rows[i].z);
+				coefficient(p[i], positive, rows[i].p); coefficient(q[i], positive, rows[i].q); coefficient(r[i], positive, rows[i].r);
+			}
+		}
+	};
+
+}; // struct matrix4_kernel
+
+template <typename Scalar>
+struct matrix4_kernel<Scalar, std::enable_if_t<has_simd_traits<Scalar>::value>> : protected matrix4_kernel<Scalar, bool>
+{
+private:
+	using traits = simd_traits<Scalar>;
+	// The primary template (selected by any Enabled type other than void).
+	using scalar_kernel = matrix4_kernel<Scalar, bool>;
+	using inverse_coefficients = typename scalar_kernel::inverse_coefficients;
+	static constexpr std::size_t W = traits::width;
+
+public:
+	static void multiply(const Scalar *a, const Scalar *b, Scalar *c)
+	{
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			for (std::size_t h = 0; h < 4; h += W)
+			{
+				auto t = traits::multiply(traits::set1(a[4 * i + 0]), traits::load(b + 0 * 4 + h));
+				for (std::size_t j = 1; j < 4; ++j)
+				{ t = traits::add(t, traits::multiply(traits::set1(a[4 * i + j]), traits::load(b + j * 4 + h))); }
+				traits::store(c + 4 * i + h, t);
+			}
+		}
+	}
+
+	static Scalar inverse(const Scalar *a, Scalar *b)
+	{
+		inverse_coefficients coefficients(a);
+		if (coefficients.determinant == Scalar(0))
+		{ return coefficients.determinant; }
+		auto d = traits::set1(coefficients.inverse_determinant);
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			const auto& row = coefficients.rows[i];
+			for (std::size_t h = 0; h < 4; h += W)
+			{
+				auto t = traits::subtract(traits::multiply(traits::load(row.x + h), traits::load(row.p + h)),
+				                          traits::multiply(traits::load(row.y + h), traits::load(row.q + h)));
+				t = traits::add(t, traits::multiply(traits::load(row.z + h), traits::load(row.r + h)));
+				traits::store(b + 4 * i + h, traits::multiply(t, d));
+			}
+		}
+		return coefficients.determinant;
+	}
+
+	template <typename Source, typename Target>
+	static void transform_points(const Scalar *m, std::size_t n, Source&& source, Target&& target)
+	{
+		// The columns of m.
+		alignas(32) Scalar c[4][4];
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			for (std::size_t j = 0; j < 4; ++j)
+			{ c[j][i] = m[4 * i + j]; }
+		}
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const Scalar *p = source(i);
+			auto x = traits::set1(p[0]), y = traits::set1(p[1]), z = traits::set1(p[2]);
+			// The fourth component is computed into the buffer and not stored to the target point.
+			alignas(32) Scalar q[4];
+			for (std::size_t h = 0; h < 4; h += W)
+			{
+				auto t = traits::add(traits::multiply(traits::load(c[0] + h), x), traits::multiply(traits::load(c[1] + h), y));
+				t = traits::add(traits::add(t, traits::multiply(traits::load(c[2] + h), z)), traits::load(c[3] + h));
+				traits::store(q + h, t);
+			}
+			Scalar *r = target(i);
+			r[0] = q[0]; r[1] = q[1]; r[2] = q[2];
+		}
+	}
+
+}; // struct matrix4_kernel
+
+} } // namespace idlib::internal
@@ -30,7 +30,7 @@ template <typename T>
 struct max_element_functor;
 
 template <typename T>
-auto max_element(const T& v)
+constexpr auto max_element(const T& v)
 { return max_element_functor<T>()(v); }
 
 } // namespace idlib
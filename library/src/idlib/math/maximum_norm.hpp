@@ -41,7 +41,7 @@ template <typename Vector>
 struct maximum_norm_functor;
 
 template <typename Vector>
-auto maximum_norm(const Vector& v) -> decltype(maximum_norm_functor<Vector>()(v))
+constexpr auto maximum_norm(const Vector& v) -> decltype(maximum_norm_functor<Vector>()(v))
 { return maximum_norm_functor<Vector>()(v); }
 
 } // namespace idlib
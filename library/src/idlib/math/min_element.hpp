@@ -30,7 +30,7 @@ template <typename T>
 struct min_element_functor;
 
 template <typename T>
-auto min_element(const T& v)
+constexpr auto min_element(const T& v)
 { return min_element_functor<T>()(v); }
 
 } // namespace idlib
@@ -83,7 +83,7 @@ struct one_functor<T, std::enable_if_t<std::is_integral<T>::value && !std::is_sa
 /// @tparam T the type
 /// @return the zero value of the type @a T
 template <typename T>
-decltype(auto) zero()
+constexpr decltype(auto) zero()
 {
 	return zero_functor<T>()();
 }
@@ -92,7 +92,7 @@ decltype(auto) zero()
 /// @tparam T the type
 /// @return the one value of the type @a T
 template <typename T>
-decltype(auto) one()
+constexpr decltype(auto) one()
 { return one_functor<T>()(); }
 
 } // namespace idlib
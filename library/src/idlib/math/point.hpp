@@ -43,6 +43,7 @@ namespace idlib {
 /// @ingroup math
 /// @brief A point in the \f$n\f$-dimensional Euclidean space.
 /// @remark Vectors are <a href=http://en.cppreference.com/w/cpp/concept/DefaultConstructible">DefaultConstructible</a>.
+/// @remark Points are literal types. Their constructors, accessors, and operators are @a constexpr.
 /// @tparam Vector the vector type
 template <typename Vector>
 struct point
@@ -77,17 +78,17 @@ public:
     template<typename ... Arguments,
              typename = std::enable_if_t<(sizeof...(Arguments)) == point_type::dimensionality() &&
                                          all_convertible<scalar_type, typename std::decay<Arguments>::type...>::value>>
-    point(Arguments&& ... arguments)
+    constexpr point(Arguments&& ... arguments)
         : m_implementation{ std::forward<Arguments>(arguments)...}
 	{ static_assert(dimensionality() == sizeof...(arguments), "wrong number of arguments"); }
 
     /// @brief Copy-construct this point with the values of another point.
     /// @param other the other point
-    point(const point_type& other) = default;
+    constexpr point(const point_type& other) = default;
 
 	/// @internal
 	template <typename G, std::size_t...Is>
-	static point_type generate(const G& g, std::index_sequence<Is...>)
+	static constexpr point_type generate(const G& g, std::index_sequence<Is...>)
 	{ return point_type((g(Is))...); }
 	
 	/// @brief Create a point with the values of a sequence generator.
@@ -95,31 +96,31 @@ public:
 	/// @param g the generator
 	/// @return the point
     template <typename G>
-    static point_type generate(const G& g)
+    static constexpr point_type generate(const G& g)
 	{ return generate(g, std::make_index_sequence<dimensionality()>{});	}
 	
 	/// @internal
 	/// @brief Construct this point.
 	/// @param other the implementation_type value
-	point(const implementation_type& other) :
+	constexpr point(const implementation_type& other) :
 		m_implementation(other)
 	{}
 
     /// @brief Default-construct this point.
-    point() : m_implementation()
+    constexpr point() : m_implementation()
 	{ /* Intentionally empty. */ }
 
 	/// @{
 	/// @brief Get the component value of the \f$x\f$ component.
 	/// @return a reference to the component value of the \f$x\f$ component
 	template <std::size_t LocalDimensionality = point_type::dimensionality()>
-    std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x()
+    constexpr std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x()
 	{
         static_assert(point_type::dimensionality() >= 1, "cannot call for member x() with dimensionality less than 1");
         return m_implementation[0];
     }
 	template <std::size_t LocalDimensionality = point_type::dimensionality()>
-    const std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x() const
+    constexpr const std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x() const
 	{
         static_assert(point_type::dimensionality() >= 1, "cannot call for member x() with dimensionality less than 1");
         return m_implementation[0];
@@ -130,13 +131,13 @@ public:
 	/// @brief Get the component value of the \f$y\f$ component.
 	/// @return a reference to the component value of the \f$y\f$ component
 	template <std::size_t LocalDimensionality = point_type::dimensionality()>
-    std::enable_if_t<(LocalDimensionality >= 2), scalar_type>& y()
+    constexpr std::enable_if_t<(LocalDimensionality >= 2), scalar_type>& y()
 	{
         static_assert(point_type::dimensionality() >= 2, "cannot call for member y() with dimensionality less than 2");
         return m_implementation[1];
     }
 	template <std::size_t LocalDimensionality = point_type::dimensionality()>
-	const std::enable_if_t<(LocalDimensionality >= 2), scalar_type>& y() const
+	constexpr const std::enable_if_t<(LocalDimensionality >= 2), scalar_type>& y() const
 	{
         static_assert(point_type::dimensionality() >= 2, "cannot call for member y() with dimensionality less than 2");
         return m_implementation[1];
@@ -147,13 +148,13 @@ public:
 	/// @brief Get the component value of the \f$z\f$ component.
 	/// @return a reference to the component value of the \f$z\f$ component
 	template <std::size_t LocalDimensionality = point_type::dimensionality()>
-	std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z()
+	constexpr std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z()
 	{
         static_assert(point_type::dimensionality() >= 3, "cannot call for member z() with dimensionality less than 3");
         return m_implementation[2];
     }
 	template <std::size_t LocalDimensionality = point_type::dimensionality()>
-	const std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z() const
+	constexpr const std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z() const
 	{
         static_assert(point_type::dimensionality() >= 3, "cannot call for member z() with dimensionality less than 3");
         return m_implementation[2];
@@ -161,53 +162,53 @@ public:
 	/// @}
 
 public:
-	bool operator==(const point_type& other) const
+	constexpr bool operator==(const point_type& other) const
 	{ return m_implementation == other.m_implementation; }
 	
-	bool operator!=(const point_type& other) const
+	constexpr bool operator!=(const point_type& other) const
 	{ return m_implementation != other.m_implementation; }
 
-	point_type& operator=(const point_type& other)
+	constexpr point_type& operator=(const point_type& other)
 	{
 		m_implementation = other.m_implementation;
 		return *this;
 	}
 	
 
-	point_type operator+(const vector_type& other) const
+	constexpr point_type operator+(const vector_type& other) const
 	{ return point_type(m_implementation + other.m_implementation); }
 
-	point_type& operator+=(const vector_type& other)
+	constexpr point_type& operator+=(const vector_type& other)
 	{ m_implementation += other.m_implementation; return *this; }
 
 	
-	point_type operator-(const vector_type& other) const
+	constexpr point_type operator-(const vector_type& other) const
 	{ return point_type(m_implementation - other.m_implementation); }
 	
-	point_type& operator-=(const vector_type& other)
+	constexpr point_type& operator-=(const vector_type& other)
 	{ m_implementation -= other.m_implementation; return *this; }
 
 
-	vector_type operator-(const point_type& other) const
+	constexpr vector_type operator-(const point_type& other) const
 	{ return vector_type(m_implementation - other.m_implementation); }
 
 
-    scalar_type& operator[](size_t const& index)
+    constexpr scalar_type& operator[](size_t const& index)
 	{ return m_implementation[index]; }
 
-    const scalar_type& operator[](size_t const& index) const
+    constexpr const scalar_type& operator[](size_t const& index) const
 	{ return m_implementation[index]; }
 
 	
-    scalar_type& operator()(size_t const& index)
+    constexpr scalar_type& operator()(size_t const& index)
 	{ return m_implementation[index]; }
 
-    const scalar_type& operator()(size_t const& index) const
+    constexpr const scalar_type& operator()(size_t const& index) const
 	{ return m_implementation[index]; }
 	
 private:
 	template <typename C, std::size_t...Is>
-	bool equal_to(const point_type& other, const C& c, std::index_sequence<Is ...>) const
+	constexpr bool equal_to(const point_type& other, const C& c, std::index_sequence<Is ...>) const
 	{ return and_fold_expr()(c((*this)[Is], other[Is]) ...); }
 
 public:
@@ -216,7 +217,7 @@ public:
 	/// @param other the other vector
 	/// @param c the comparator
 	template <typename C>
-	bool equal_to(const point_type& other, const C& c) const
+	constexpr bool equal_to(const point_type& other, const C& c) const
 	{ return equal_to(other, c, std::make_index_sequence<dimensionality()>{}); }
 #if 0
 	/**
@@ -276,7 +277,7 @@ struct zero_functor<point<Vector>>
 	
 	static constexpr size_t dimensionality() { return vector_type::dimensionality(); }
 
-	auto operator()() const
+	constexpr auto operator()() const
 	{ return point_type::generate(constant_generator<scalar_type>(zero<scalar_type>())); }
 
 }; // struct zero_functor
@@ -292,7 +293,7 @@ struct enclose_functor<point<Vector>, point<Vector>>
 	using point_type = point<vector_type>;
 	static constexpr size_t dimensionality() { return vector_type::dimensionality(); }
 
-	auto operator()(const point_type& source) const
+	constexpr auto operator()(const point_type& source) const
 	{ return source; }
 
 }; // struct enclose_functor
@@ -308,7 +309,7 @@ struct is_enclosing_functor<point<Vector>, point<Vector>>
 	using point_type = point<vector_type>;	
 	static constexpr size_t dimensionality() { return vector_type::dimensionality(); }
 	
-	bool operator()(const point_type& a, const point_type& b) const
+	constexpr bool operator()(const point_type& a, const point_type& b) const
 	{
 		for (size_t i = 0, n = dimensionality(); i < n; ++i)
 		{
@@ -332,7 +333,7 @@ struct translate_functor<point<Vector>, Vector>
 	using point_type = point<vector_type>;
 	static constexpr size_t dimensionality() { return vector_type::dimensionality(); }
 	
-	auto operator()(const point_type& x, const vector_type& t) const
+	constexpr auto operator()(const point_type& x, const vector_type& t) const
 	{
 		return semantic_cast<point_type>(semantic_cast<vector_type>(x) + t);
 	}
@@ -349,7 +350,7 @@ struct is_intersecting_functor<point<Vector>, point<Vector>>
 	using point_type = point<vector_type>;
 	static constexpr size_t dimensionality() { return vector_type::dimensionality(); }
 	
-	bool operator()(const point_type& a, const point_type& b) const
+	constexpr bool operator()(const point_type& a, const point_type& b) const
 	{
 		for (size_t i = 0, n = dimensionality(); i < n; ++i)
 		{
@@ -368,15 +369,15 @@ struct max_element_functor<point<Vector>>
 {
 	using point_type = point<Vector>;
 
-	auto operator()(const point_type& p) const
+	constexpr auto operator()(const point_type& p) const
 	{ return impl(p); }
 	
 private:
 	template<std::size_t...Is>
-	auto impl(const point_type& p, std::index_sequence<Is...>) const
+	constexpr auto impl(const point_type& p, std::index_sequence<Is...>) const
 	{ return variadic::max((p[Is])...); }
 
-	auto impl(const point_type& p) const
+	constexpr auto impl(const point_type& p) const
 	{ return impl(p, std::make_index_sequence<point_type::dimensionality()>{}); }
 	
 }; // struct max_element_functor
@@ -387,15 +388,15 @@ struct min_element_functor<point<Vector>>
 {
 	using point_type = point<Vector>;
 
-	auto operator()(const point_type& p) const
+	constexpr auto operator()(const point_type& p) const
 	{ return impl(p); }
 
 private:
 	template<std::size_t...Is>
-	auto impl(const point_type& p, std::index_sequence<Is...>) const
+	constexpr auto impl(const point_type& p, std::index_sequence<Is...>) const
 	{ return variadic::min((p[Is])...); }
 
-	auto impl(const point_type& p) const
+	constexpr auto impl(const point_type& p) const
 	{ return impl(p, std::make_index_sequence<point_type::dimensionality()>{}); }
 
 }; // struct min_element_functor
@@ -421,12 +422,12 @@ struct lineary_interpolate_functor<point<Vector>, typename Vector::scalar_type,
 template <typename V>
 struct semantic_cast_functor<point<V>, V, void>
 {
-	auto operator()(const V& v) const
+	constexpr auto operator()(const V& v) const
 	{ return impl(v, std::make_index_sequence<V::dimensionality()>{}); }
 	
 private:
     template <std::size_t...Is>
-    static decltype(auto) impl(const V& v, std::index_sequence<Is ...>)
+    static constexpr decltype(auto) impl(const V& v, std::index_sequence<Is ...>)
 	{ return point<V>(v[Is]...); }
 	
 }; // struct semantic_cast_functor
@@ -434,12 +435,12 @@ private:
 template <typename V>
 struct semantic_cast_functor<V, point<V>, void>
 {
-	auto operator()(const point<V>& p) const
+	constexpr auto operator()(const point<V>& p) const
 	{ return impl(p, std::make_index_sequence<point<V>::dimensionality()>{}); }
 	
 private:
     template <std::size_t...Is>
-    static decltype(auto) impl(const point<V>& p, std::index_sequence<Is ...>)
+    static constexpr decltype(auto) impl(const point<V>& p, std::index_sequence<Is ...>)
 	{ return V(p[Is]...); }
 	
 }; // struct semantic_cast_functor
@@ -0,0 +1,331 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/quaternion.hpp
+/// @brief Quaternions.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/matrix.hpp"
+#include "idlib/math/quaternion_kernel.hpp"
+#include "idlib/math/interpolate.hpp"
+#include "idlib/math/dot_product.hpp"
+#include "idlib/math/squared_euclidean_norm.hpp"
+#include "idlib/math/euclidean_norm.hpp"
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A quaternion \f$x i + y j + z k + w\f$.
+/// @detail Unit quaternions represent rotations in the 3-dimensional Euclidean space.
+/// @remark Quaternions are <a href=http://en.cppreference.com/w/cpp/concept/DefaultConstructible">DefaultConstructible</a>.
+/// A default-constructed quaternion is the identity quaternion \f$(0, 0, 0, 1)\f$ i.e. idlib::one.
+/// @tparam Scalar the scalar type
+template <typename Scalar>
+struct quaternion
+{
+public:
+	/// @brief The scalar type.
+	using scalar_type = Scalar;
+
+	/// @brief The type of this template/template specialization.
+	using quaternion_type = quaternion<scalar_type>;
+
+	/// @brief The vector type.
+	using vector_type = vector<scalar_type, 3>;
+
+	/// @brief The implementation type.
+	using implementation_type = arithmetic_tuple<scalar_type, 4, zero_functor<scalar_type>>;
+
+private:
+	/// @brief The implementation.
+	implementation_type m_implementation;
+
+public:
+	/// @brief Construct this quaternion with the specified component values.
+	/// @param x, y, z the component values of the imaginary part
+	/// @param w the component value of the real part
+	quaternion(scalar_type x, scalar_type y, scalar_type z, scalar_type w)
+		: m_implementation(x, y, z, w)
+	{}
+
+	/// @brief Construct this quaternion from a rotation.
+	/// @param axis the rotation axis
+	/// @param a the counter-clockwise rotation angle
+	/// @pre The rotation axis is a unit vector.
+	quaternion(const vector_type& axis, const angle<scalar_type, radians>& a)
+	{
+		const auto h = a.get_value() / scalar_type(2);
+		const auto s = std::sin(h);
+		m_implementation = implementation_type(axis[0] * s, axis[1] * s, axis[2] * s, std::cos(h));
+	}
+
+	/// @internal
+	/// @brief Construct this quaternion.
+	/// @param other the implementation_type value
+	quaternion(const implementation_type& other) :
+		m_implementation(other)
+	{}
+
+	/// @brief Default-construct this quaternion.
+	/// @post This quaternion is the identity quaternion.
+	quaternion()
+		: m_implementation(zero<scalar_type>(), zero<scalar_type>(), zero<scalar_type>(), one<scalar_type>())
+	{ /* Intentionally empty. */ }
+
+	quaternion(const quaternion&) = default;
+	quaternion& operator=(const quaternion&) = default;
+
+public:
+	/// @{
+	/// @brief Get the component value at the specified index.
+	/// @param index the index. The indices @a 0, @a 1, @a 2, and @a 3 denote the components \f$x\f$, \f$y\f$, \f$z\f$, and \f$w\f$.
+	/// @return a reference to the component value
+	/// @pre The index is within bounds.
+	scalar_type& operator[](size_t index)
+	{ return m_implementation[index]; }
+
+	const scalar_type& operator[](size_t index) const
+	{ return m_implementation[index]; }
+	/// @}
+
+	const scalar_type& x() const { return m_implementation[0]; }
+	const scalar_type& y() const { return m_implementation[1]; }
+	const scalar_type& z() const { return m_implementation[2]; }
+	const scalar_type& w() const { return m_implementation[3]; }
+
+	/// @brief Get the conjugate of this quaternion.
+	/// @return the conjugate \f$(-x, -y, -z, w)\f$
+	/// @remark The conjugate of a unit quaternion is its inverse.
+	quaternion_type conjugate() const
+	{ return quaternion_type(-x(), -y(), -z(), w()); }
+
+public:
+	bool operator==(const quaternion_type& other) const
+	{ return m_implementation == other.m_implementation; }
+
+	bool operator!=(const quaternion_type& other) const
+	{ return m_implementation != other.m_implementation; }
+
+public:
+	quaternion_type operator+() const
+	{ return *this; }
+
+	quaternion_type operator-() const
+	{ return quaternion_type(-m_implementation); }
+
+	quaternion_type operator+(const quaternion_type& other) const
+	{ return quaternion_type(m_implementation + other.m_implementation); }
+
+	quaternion_type& operator+=(const quaternion_type& other)
+	{ m_implementation += other.m_implementation; return *this; }
+
+	quaternion_type operator-(const quaternion_type& other) const
+	{ return quaternion_type(m_implementation - other.m_implementation); }
+
+	quaternion_type& operator-=(const quaternion_type& other)
+	{ m_implementation -= other.m_implementation; return *this; }
+
+	quaternion_type operator*(const scalar_type& other) const
+	{ return quaternion_type(m_implementation * other); }
+
+	quaternion_type& operator*=(const scalar_type& other)
+	{ m_implementation *= other; return *this; }
+
+	quaternion_type operator/(const scalar_type& other) const
+	{ return quaternion_type(m_implementation / other); }
+
+	quaternion_type& operator/=(const scalar_type& other)
+	{ m_implementation /= other; return *this; }
+
+	/// @brief Compute the Hamilton product of this quaternion and another quaternion.
+	/// @param other the other quaternion
+	/// @return the product
+	/// @remark If both quaternions are unit quaternions, the product is the rotation of the other quaternion followed by the rotation of this quaternion.
+	quaternion_type operator*(const quaternion_type& other) const
+	{
+		const auto& a = *this;
+		const auto& b = other;
+		return quaternion_type(a.w() * b.x() + a.x() * b.w() + a.y() * b.z() - a.z() * b.y(),
+		                       a.w() * b.y() - a.x() * b.z() + a.y() * b.w() + a.z() * b.x(),
+		                       a.w() * b.z() + a.x() * b.y() - a.y() * b.x() + a.z() * b.w(),
+		                       a.w() * b.w() - a.x() * b.x() - a.y() * b.y() - a.z() * b.z());
+	}
+
+	quaternion_type& operator*=(const quaternion_type& other)
+	{ return (*this) = (*this) * other; }
+
+	/// @internal
+	const implementation_type& get_implementation() const
+	{ return m_implementation; }
+
+}; // struct quaternion
+
+template <typename Scalar>
+struct zero_functor<quaternion<Scalar>>
+{
+	auto operator()() const
+	{ return quaternion<Scalar>(zero<Scalar>(), zero<Scalar>(), zero<Scalar>(), zero<Scalar>()); }
+};
+
+/// @brief Specialization of idlib::one_functor for quaternions.
+/// Returns the identity quaternion.
+template <typename Scalar>
+struct one_functor<quaternion<Scalar>>
+{
+	auto operator()() const
+	{ return quaternion<Scalar>(); }
+};
+
+template <typename Scalar>
+struct dot_product_functor<quaternion<Scalar>>
+{
+	auto operator()(const quaternion<Scalar>& a, const quaternion<Scalar>& b) const
+	{ return a.get_implementation().inner_product(b.get_implementation()); }
+
+}; // struct dot_product_functor
+
+template <typename Scalar>
+struct squared_euclidean_norm_functor<quaternion<Scalar>>
+{
+	auto operator()(const quaternion<Scalar>& a) const
+	{ return a.get_implementation().inner_product(a.get_implementation()); }
+
+}; // struct squared_euclidean_norm_functor
+
+template <typename Scalar>
+struct euclidean_norm_functor<quaternion<Scalar>>
+{
+	auto operator()(const quaternion<Scalar>& a) const
+	{ return std::sqrt(a.get_implementation().inner_product(a.get_implementation())); }
+
+}; // struct euclidean_norm_functor
+
+namespace internal {
+
+/// @brief The operands of an idlib::internal::quaternion_kernel applied to a single quaternion or vector.
+/// @remark The component pointers point into the component arrays of this object.
+/// Hence operands can neither be copied nor moved.
+template <typename Scalar>
+struct quaternion_operands
+{
+	Scalar a[4], b[4], c[4];
+	const Scalar *const a_pointers[4] = { a + 0, a + 1, a + 2, a + 3 };
+	const Scalar *const b_pointers[4] = { b + 0, b + 1, b + 2, b + 3 };
+	Scalar *const c_pointers[4] = { c + 0, c + 1, c + 2, c + 3 };
+
+	template <typename A, typename B>
+	quaternion_operands(const A& x, const B& y)
+	{
+		for (size_t i = 0; i < A::implementation_type::size(); ++i) a[i] = x[i];
+		for (size_t i = 0; i < B::implementation_type::size(); ++i) b[i] = y[i];
+	}
+
+	quaternion_operands(const quaternion_operands&) = delete;
+	quaternion_operands(quaternion_operands&&) = delete;
+	quaternion_operands& operator=(const quaternion_operands&) = delete;
+	quaternion_operands& operator=(quaternion_operands&&) = delete;
+};
+
+} // namespace internal
+
+/// @brief Specialization of idlib::lineary_interpolate_functor for idlib::quaternion values.
+/// Computes the normalized linear interpolation (nlerp) along the shortest arc.
+/// @remark The results are bit-identical to the results of idlib::nlerp for idlib::quaternion_batch values.
+/// @pre The quaternions are unit quaternions.
+template <typename Scalar>
+struct lineary_interpolate_functor<quaternion<Scalar>, Scalar, void>
+{
+	using parameter_type = Scalar;
+	using value_type = quaternion<Scalar>;
+
+	auto operator()(const value_type& x, const value_type& y, parameter_type t) const
+	{ return (*this)(x, y, mu<parameter_type>(t)); }
+
+	auto operator()(const value_type& x, const value_type& y, const mu<parameter_type>& mu) const
+	{
+		internal::quaternion_operands<Scalar> o(x, y);
+		internal::quaternion_kernel<Scalar>::nlerp(o.a_pointers, o.b_pointers, mu.get_mu(), mu.get_one_minus_mu(), o.c_pointers, 1);
+		return value_type(o.c[0], o.c[1], o.c[2], o.c[3]);
+	}
+
+}; // struct lineary_interpolate_functor
+
+/// @brief Compute the normalized linear interpolation (nlerp) of two quaternions along the shortest arc.
+/// @param x, y the quaternions
+/// @param t the interpolation parameter
+/// @return the interpolated quaternion
+/// @pre The quaternions are unit quaternions.
+/// @remark Equivalent to idlib::lineary_interpolate.
+template <typename Scalar>
+quaternion<Scalar> nlerp(const quaternion<Scalar>& x, const quaternion<Scalar>& y, const mu<Scalar>& t)
+{ return lineary_interpolate(x, y, t); }
+
+/// @brief Compute the spherical linear interpolation (slerp) of two quaternions along the shortest arc.
+/// @param x, y the quaternions
+/// @param t the interpolation parameter
+/// @return the interpolated quaternion
+/// @pre The quaternions are unit quaternions.
+/// @remark The interpolation weights are computed by a polynomial approximation without trigonometric functions
+/// (D. Eberly, "A Fast and Accurate Algorithm for Computing SLERP", 2011).
+/// The absolute error of the weights is below \f$3.1 \cdot 10^{-8}\f$ plus rounding errors.
+/// @remark The results are bit-identical to the results of idlib::slerp for idlib::quaternion_batch values.
+template <typename Scalar>
+quaternion<Scalar> slerp(const quaternion<Scalar>& x, const quaternion<Scalar>& y, const mu<Scalar>& t)
+{
+	internal::quaternion_operands<Scalar> o(x, y);
+	internal::quaternion_kernel<Scalar>::slerp(o.a_pointers, o.b_pointers, t.get_mu(), t.get_one_minus_mu(), o.c_pointers, 1);
+	return quaternion<Scalar>(o.c[0], o.c[1], o.c[2], o.c[3]);
+}
+
+/// @brief Rotate a vector by a unit quaternion.
+/// @param q the quaternion
+/// @param v the vector
+/// @return the rotated vector
+/// @pre The quaternion is a unit quaternion.
+/// @remark The results are bit-identical to the results of idlib::rotate for idlib::quaternion_batch values.
+template <typename Scalar>
+vector<Scalar, 3> rotate(const quaternion<Scalar>& q, const vector<Scalar, 3>& v)
+{
+	internal::quaternion_operands<Scalar> o(q, v);
+	internal::quaternion_kernel<Scalar>::rotate(o.a_pointers, o.b_pointers, o.c_pointers, 1);
+	return vector<Scalar, 3>(o.c[0], o.c[1], o.c[2]);
+}
+
+/// @brief Create a rotation matrix from a unit quaternion.
+/// @param q the quaternion
+/// @return the matrix
+/// @pre The quaternion is a unit quaternion.
+template <typename Scalar>
+matrix<Scalar, 4, 4> rotation(const quaternion<Scalar>& q)
+{
+	const Scalar x = q.x(), y = q.y(), z = q.z(), w = q.w(), o = one<Scalar>(), t = Scalar(2);
+	return matrix<Scalar, 4, 4>(o - t * (y * y + z * z), t * (x * y - z * w),     t * (x * z + y * w),     zero<Scalar>(),
+	                            t * (x * y + z * w),     o - t * (x * x + z * z), t * (y * z - x * w),     zero<Scalar>(),
+	                            t * (x * z - y * w),     t * (y * z + x * w),     o - t * (x * x + y * y), zero<Scalar>(),
+	                            zero<Scalar>(),          zero<Scalar>(),          zero<Scalar>(),          one<Scalar>());
+}
+
+} // namespace idlib
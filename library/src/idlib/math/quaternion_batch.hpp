@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/quaternion_batch.hpp
+/// @brief Batches of quaternions in structure-of-arrays layout.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/quaternion.hpp"
+#include "idlib/math/vector_batch.hpp"
+#include <array>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A batch of quaternions.
+/// @detail
+/// The quaternions are stored in structure-of-arrays layout:
+/// The \f$x\f$, \f$y\f$, \f$z\f$, and \f$w\f$ components of all quaternions are stored contiguously in arrays aligned to a 64 Byte boundary.
+/// The bulk operations on batches (idlib::nlerp, idlib::slerp, and idlib::rotate) operate on these arrays using SIMD instructions
+/// if available (see idlib::internal::quaternion_kernel).
+/// @remark Batches are <a href=http://en.cppreference.com/w/cpp/concept/DefaultConstructible">DefaultConstructible</a>.
+/// @tparam Scalar the scalar type
+template <typename Scalar>
+struct quaternion_batch
+{
+public:
+	/// @brief The scalar type.
+	using scalar_type = Scalar;
+
+	/// @brief The quaternion type.
+	using quaternion_type = quaternion<scalar_type>;
+
+	/// @brief The alignment in Bytes of the component arrays.
+	static constexpr size_t alignment = 64;
+
+	/// @brief The type of a component array.
+	using component_array_type = std::vector<scalar_type, aligned_allocator<scalar_type, alignment>>;
+
+private:
+	/// @brief The component arrays.
+	component_array_type m_components[4];
+
+public:
+	/// @brief Default-construct this batch.
+	/// @post This batch is empty.
+	quaternion_batch()
+	{ /* Intentionally empty. */ }
+
+	/// @brief Construct this batch with the specified number of identity quaternions.
+	/// @param size the number of quaternions
+	explicit quaternion_batch(size_t size)
+	{ resize(size); }
+
+	/// @brief Construct this batch from a sequence of quaternions.
+	/// @param quaternions the quaternions
+	explicit quaternion_batch(const std::vector<quaternion_type>& quaternions)
+	{ assign(quaternions); }
+
+	quaternion_batch(const quaternion_batch&) = default;
+	quaternion_batch(quaternion_batch&&) = default;
+	quaternion_batch& operator=(const quaternion_batch&) = default;
+	quaternion_batch& operator=(quaternion_batch&&) = default;
+
+public:
+	/// @brief Get the number of quaternions in this batch.
+	/// @return the number of quaternions
+	size_t size() const
+	{ return m_components[0].size(); }
+
+	/// @brief Get if this batch is empty.
+	/// @return @a true if this batch is empty, @a false otherwise
+	bool empty() const
+	{ return m_components[0].empty(); }
+
+	/// @brief Reserve storage for the specified number of quaternions.
+	/// @param capacity the number of quaternions
+	void reserve(size_t capacity)
+	{
+		for (auto& c : m_components)
+		{ c.reserve(capacity); }
+	}
+
+	/// @brief Resize this batch to the specified number of quaternions.
+	/// @param size the number of quaternions
+	/// @post If the batch grows, the new quaternions are identity quaternions.
+	void resize(size_t size)
+	{
+		const quaternion_type identity;
+		for (size_t j = 0; j < 4; ++j)
+		{ m_components[j].resize(size, identity[j]); }
+	}
+
+	/// @brief Remove all quaternions from this batch.
+	void clear()
+	{
+		for (auto& c : m_components)
+		{ c.clear(); }
+	}
+
+	/// @brief Append a quaternion to this batch.
+	/// @param q the quaternion
+	void push_back(const quaternion_type& q)
+	{
+		for (size_t j = 0; j < 4; ++j)
+		{ m_components[j].push_back(q[j]); }
+	}
+
+	/// @brief Get the quaternion at the specified index.
+	/// @param index the index
+	/// @return the quaternion
+	/// @pre The index is within bounds.
+	quaternion_type get(size_t index) const
+	{ return quaternion_type(m_components[0][index], m_components[1][index], m_components[2][index], m_components[3][index]); }
+
+	/// @brief Set the quaternion at the specified index.
+	/// @param index the index
+	/// @param q the quaternion
+	/// @pre The index is within bounds.
+	void set(size_t index, const quaternion_type& q)
+	{
+		for (size_t j = 0; j < 4; ++j)
+		{ m_components[j][index] = q[j]; }
+	}
+
+	/// @{
+	/// @brief Get a pointer to the array of the components of the specified index.
+	/// @param component the component index
+	/// @return a pointer to the array of size() component values
+	/// @pre The component index is smaller than @a 4.
+	scalar_type *data(size_t component)
+	{ return m_components[component].data(); }
+
+	const scalar_type *data(size_t component) const
+	{ return m_components[component].data(); }
+	/// @}
+
+public:
+	/// @brief Assign this batch the quaternions of a sequence of quaternions.
+	/// @param quaternions the quaternions
+	void assign(const std::vector<quaternion_type>& quaternions)
+	{
+		resize(quaternions.size());
+		for (size_t j = 0; j < 4; ++j)
+		{
+			auto *c = m_components[j].data();
+			for (size_t i = 0, n = quaternions.size(); i < n; ++i)
+			{ c[i] = quaternions[i][j]; }
+		}
+	}
+
+	/// @brief Get the quaternions of this batch as a sequence of quaternions.
+	/// @return the quaternions
+	std::vector<quaternion_type> get_quaternions() const
+	{
+		std::vector<quaternion_type> quaternions;
+		quaternions.reserve(size());
+		for (size_t i = 0, n = size(); i < n; ++i)
+		{ quaternions.push_back(get(i)); }
+		return quaternions;
+	}
+
+}; // struct quaternion_batch
+
+namespace internal {
+
+template <typename Scalar>
+void assert_same_size(const quaternion_batch<Scalar>& a, const quaternion_batch<Scalar>& b)
+{
+	if (a.size() != b.size())
+	{ throw invalid_argument_error(__FILE__, __LINE__, "batches are of different sizes"); }
+}
+
+template <typename Batch, size_t...Is>
+auto component_pointers(const Batch& a, std::index_sequence<Is...>)
+{ return std::array<const typename Batch::scalar_type *, sizeof...(Is)>{ a.data(Is)... }; }
+
+template <typename Batch, size_t...Is>
+auto component_pointers(Batch& a, std::index_sequence<Is...>)
+{ return std::array<typename Batch::scalar_type *, sizeof...(Is)>{ a.data(Is)... }; }
+
+} // namespace internal
+
+/// @brief Compute the normalized linear interpolations (nlerp) of the quaternions of two batches along the shortest arcs.
+/// @param a, b the batches
+/// @param t the interpolation parameter
+/// @param r the batch to assign the interpolated quaternions to. May be @a a or @a b.
+/// @throw idlib::invalid_argument_error @a a and @a b are of different sizes
+/// @pre The quaternions are unit quaternions.
+/// @remark The results are bit-identical to the results of idlib::nlerp for idlib::quaternion values.
+template <typename Scalar>
+void nlerp(const quaternion_batch<Scalar>& a, const quaternion_batch<Scalar>& b, const mu<Scalar>& t, quaternion_batch<Scalar>& r)
+{
+	internal::assert_same_size(a, b);
+	r.resize(a.size());
+	auto x = internal::component_pointers(a, std::make_index_sequence<4>{}), y = internal::component_pointers(b, std::make_index_sequence<4>{});
+	auto z = internal::component_pointers(r, std::make_index_sequence<4>{});
+	internal::quaternion_kernel<Scalar>::nlerp(x.data(), y.data(), t.get_mu(), t.get_one_minus_mu(), z.data(), a.size());
+}
+
+/// @brief Compute the spherical linear interpolations (slerp) of the quaternions of two batches along the shortest arcs.
+/// @param a, b the batches
+/// @param t the interpolation parameter
+/// @param r the batch to assign the interpolated quaternions to. May be @a a or @a b.
+/// @throw idlib::invalid_argument_error @a a and @a b are of different sizes
+/// @pre The quaternions are unit quaternions.
+/// @remark The results are bit-identical to the results of idlib::slerp for idlib::quaternion values.
+template <typename Scalar>
+void slerp(const quaternion_batch<Scalar>& a, const quaternion_batch<Scalar>& b, const mu<Scalar>& t, quaternion_batch<Scalar>& r)
+{
+	internal::assert_same_size(a, b);
+	r.resize(a.size());
+	auto x = internal::component_pointers(a, std::make_index_sequence<4>{}), y = internal::component_pointers(b, std::make_index_sequence<4>{});
+	auto z = internal::component_pointers(r, std::make_index_sequence<4>{});
+	internal::quaternion_kernel<Scalar>::slerp(x.data(), y.data(), t.get_mu(), t.get_one_minus_mu(), z.data(), a.size());
+}
+
+/// @brief Rotate the vectors of a batch by the quaternions of a batch.
+/// @param q the batch of quaternions
+/// @param v the batch of vectors
+/// @param r the batch to assign the rotated vectors to. May be @a v.
+/// @throw idlib::invalid_argument_error @a q and @a v are of different sizes
+/// @pre The quaternions are unit quaternions.
+/// @remark The results are bit-identical to the results of idlib::rotate for idlib::quaternion and idlib::vector values.
+template <typename Scalar>
+void rotate(const quaternion_batch<Scalar>& q, const vector_batch<Scalar, 3>& v, vector_batch<Scalar, 3>& r)
+{
+	if (q.size() != v.size())
+	{ throw invalid_argument_error(__FILE__, __LINE__, "batches are of different sizes"); }
+	r.resize(v.size());
+	auto x = internal::component_pointers(q, std::make_index_sequence<4>{}), y = internal::component_pointers(v, std::make_index_sequence<3>{});
+	auto z = internal::component_pointers(r, std::make_index_sequence<3>{});
+	internal::quaternion_kernel<Scalar>::rotate(x.data(), y.data(), z.data(), v.size());
+}
+
+} // namespace idlib
@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/quaternion_kernel.hpp
+/// @brief Kernels of idlib::quaternion.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/batch_kernel.hpp"
+
+namespace idlib { namespace internal {
+
+/// @brief Kernels for quaternions stored in structure-of-arrays layout.
+/// @detail
+/// Quaternions \f$(x, y, z, w)\f$ and vectors \f$(x, y, z)\f$ are passed as arrays of pointers to their component arrays.
+/// The output arrays may be input arrays.
+/// @tparam Scalar the scalar type
+/// @tparam Enabled for SFINAE
+/// @remark Each algorithm is written once in terms of idlib::internal::scalar_value and idlib::internal::simd_value.
+/// The specialization for scalar types for which SIMD is available hence computes bit-identical results.
+template <typename Scalar, typename Enabled = void>
+struct quaternion_kernel
+{
+	/// @brief Normalized linear interpolation along the shortest arc.
+	static void nlerp(const Scalar *const *a, const Scalar *const *b, Scalar t, Scalar one_minus_t, Scalar *const *r, std::size_t n)
+	{ nlerp<scalar_value<Scalar>>(a, b, t, one_minus_t, r, 0, n); }
+
+	/// @brief Spherical linear interpolation along the shortest arc.
+	static void slerp(const Scalar *const *a, const Scalar *const *b, Scalar t, Scalar one_minus_t, Scalar *const *r, std::size_t n)
+	{ slerp<scalar_value<Scalar>>(a, b, t, one_minus_t, r, 0, n); }
+
+	/// @brief Rotate vectors by unit quaternions.
+	static void rotate(const Scalar *const *q, const Scalar *const *v, Scalar *const *r, std::size_t n)
+	{ rotate<scalar_value<Scalar>>(q, v, r, 0, n); }
+
+protected:
+	/// @brief Load the quaternion at the specified index.
+	template <typename V, std::size_t N>
+	static void load(const Scalar *const *a, std::size_t i, V (&x)[N])
+	{
+		for (std::size_t j = 0; j < N; ++j)
+		{ x[j] = V::load(a[j] + i); }
+	}
+
+	/// @brief \f$a_x b_x + (a_y b_y + (a_z b_z + a_w b_w))\f$ (right-to-left like idlib::plus_fold_expr).
+	template <typename V>
+	static V dot(const V (&a)[4], const V (&b)[4])
+	{ return a[0] * b[0] + (a[1] * b[1] + (a[2] * b[2] + a[3] * b[3])); }
+
+	template <typename V>
+	static std::size_t nlerp(const Scalar *const *a, const Scalar *const *b, Scalar t, Scalar one_minus_t, Scalar *const *r, std::size_t i, std::size_t n)
+	{
+		const V zero = V::broadcast(Scalar(0)), s = V::broadcast(one_minus_t), u = V::broadcast(t), v = V::broadcast(-t);
+		for (; i + V::width <= n; i += V::width)
+		{
+			V x[4], y[4];
+			load(a, i, x); load(b, i, y);
+			// Negate the weight of the second quaternion if the quaternions are in opposite hemispheres.
+			const V w = select_less(dot(x, y), zero, v, u);
+			V c[4];
+			for (std::size_t j = 0; j < 4; ++j)
+			{ c[j] = x[j] * s + y[j] * w; }
+			const V l = sqrt(dot(c, c));
+			for (std::size_t j = 0; j < 4; ++j)
+			{ (c[j] / l).store(r[j] + i); }
+		}
+		return i;
+	}
+
+	/// @remark The interpolation weights \f$\frac{\sin(t \theta)}{\sin \theta}\f$ are computed by the series expansion in \f$\cos\theta - 1\f$ of
+	/// D. Eberly, "A Fast and Accurate Algorithm for Computing SLERP", Journal of Graphics, GPU, and Game Tools, 15:3, 2011.
+	/// It does not require trigonometric functions. The series is truncated after 16 terms and the last term is scaled by \f$\mu\f$
+	/// (fitted to minimize the maximum error for \f$0 \leq \cos\theta \leq 1\f$) such that the absolute error of the weights is below \f$3.1 \cdot 10^{-8}\f$.
+	template <typename V>
+	static std::size_t slerp(const Scalar *const *a, const Scalar *const *b, Scalar t, Scalar one_minus_t, Scalar *const *r, std::size_t i, std::size_t n)
+	{
+		static constexpr std::size_t N = 16;
+		static constexpr long double mu = 1.916672145707949L;
+		Scalar c[N], d[N];
+		for (std::size_t k = 0; k < N - 1; ++k)
+		{
+			c[k] = Scalar(1) / Scalar((k + 1) * (2 * k + 3));
+			d[k] = Scalar(k + 1) / Scalar(2 * k + 3);
+		}
+		c[N - 1] = Scalar(mu) / Scalar(N * (2 * N + 1));
+		d[N - 1] = Scalar(mu) * Scalar(N) / Scalar(2 * N + 1);
+		// The coefficients (c_k t^2 - d_k) and (c_k (1 - t)^2 - d_k) do not depend on the quaternions.
+		V p[N], q[N];
+		for (std::size_t k = 0; k < N; ++k)
+		{
+			p[k] = V::broadcast(c[k] * (t * t) - d[k]);
+			q[k] = V::broadcast(c[k] * (one_minus_t * one_minus_t) - d[k]);
+		}
+		const V zero = V::broadcast(Scalar(0)), one = V::broadcast(Scalar(1)), u = V::broadcast(t), s = V::broadcast(one_minus_t);
+		for (; i + V::width <= n; i += V::width)
+		{
+			V x[4], y[4];
+			load(a, i, x); load(b, i, y);
+			const V e = dot(x, y);
+			// The cosine of the angle between the quaternions along the shortest arc minus one.
+			const V f = select_less(e, zero, zero - e, e) - one;
+			V g = one + p[N - 1] * f, h = one + q[N - 1] * f;
+			for (std::size_t k = N - 1; k > 0; --k)
+			{
+				g = one + (p[k - 1] * f) * g;
+				h = one + (q[k - 1] * f) * h;
+			}
+			g = u * g;
+			h = s * h;
+			// Negate the weight of the second quaternion if the quaternions are in opposite hemispheres.
+			g = select_less(e, zero, zero - g, g);
+			for (std::size_t j = 0; j < 4; ++j)
+			{ (x[j] * h + y[j] * g).store(r[j] + i); }
+		}
+		return i;
+	}
+
+	/// @remark Computes \f$v' = v + w t + u \times t\f$ where \f$u = (q_x, q_y, q_z)\f$, \f$w = q_w\f$, and \f$t = 2 (u \times v)\f$.
+	template <typename V>
+	static std::size_t rotate(const Scalar *const *q, const Scalar *const *v, Scalar *const *r, std::size_t i, std::size_t n)
+	{
+		const V two = V::broadcast(Scalar(2));
+		for (; i + V::width <= n; i += V::width)
+		{
+			V a[4], b[3];
+			load(q, i, a); load(v, i, b);
+			const V t[3] =
+			{
+				two * (a[1] * b[2] - a[2] * b[1]),
+				two * (a[2] * b[0] - a[0] * b[2]),
+				two * (a[0] * b[1] - a[1] * b[0]),
+			};
+			(b[0] + a[3] * t[0] + (a[1] * t[2] - a[2] * t[1])).store(r[0] + i);
+			(b[1] + a[3] * t[1] + (a[2] * t[0] - a[0] * t[2])).store(r[1] + i);
+			(b[2] + a[3] * t[2] + (a[0] * t[1] - a[1] * t[0])).store(r[2] + i);
+		}
+		return i;
+	}
+
+}; // struct quaternion_kernel
+
+#if defined(IDLIB_WITH_SSE2)
+
+template <typename Scalar>
+struct quaternion_kernel<Scalar, std::enable_if_t<has_simd_traits<Scalar>::value>> : protected quaternion_kernel<Scalar, bool>
+{
+private:
+	// The primary template (selected by any Enabled type other than void).
+	using base = quaternion_kernel<Scalar, bool>;
+
+public:
+	static void nlerp(const Scalar *const *a, const Scalar *const *b, Scalar t, Scalar one_minus_t, Scalar *const *r, std::size_t n)
+	{
+		auto i = base::template nlerp<simd_value<Scalar>>(a, b, t, one_minus_t, r, 0, n);
+		base::template nlerp<scalar_value<Scalar>>(a, b, t, one_minus_t, r, i, n);
+	}
+
+	static void slerp(const Scalar *const *a, const Scalar *const *b, Scalar t, Scalar one_minus_t, Scalar *const *r, std::size_t n)
+	{
+		auto i = base::template slerp<simd_value<Scalar>>(a, b, t, one_minus_t, r, 0, n);
+		base::template slerp<scalar_value<Scalar>>(a, b, t, one_minus_t, r, i, n);
+	}
+
+	static void rotate(const Scalar *const *q, const Scalar *const *v, Scalar *const *r, std::size_t n)
+	{
+		auto i = base::template rotate<simd_value<Scalar>>(q, v, r, 0, n);
+		base::template rotate<scalar_value<Scalar>>(q, v, r, i, n);
+	}
+
+}; // struct quaternion_kernel
+
+#endif
+
+} } // namespace idlib::internal
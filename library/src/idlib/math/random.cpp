@@ -22,56 +22,173 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define IDLIB_PRIVATE 1
 #include "idlib/math/random.hpp"
+#include "idlib/math/random_engine.hpp"
+#include "idlib/math/batch_kernel.hpp"
+#undef IDLIB_PRIVATE
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <variant>
 
 namespace idlib {
-	
+
+namespace {
+
+/// @brief Get a seed. Consecutive calls return different seeds.
+std::uint64_t unspecified_seed()
+{
+	static std::atomic<std::uint64_t> counter(0);
+	const auto t = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+	return splitmix64(t ^ (counter.fetch_add(1) * UINT64_C(0x9e3779b97f4a7c15)))();
+}
+
+/// @brief Map 64 random bits to a floating point value in the interval \f$[0,1]\f$.
+/// @remark The most significant bits fitting into the significand of @a T are used.
+/// Both @a 0 and @a 1 are attained.
+template <typename T>
+struct unit_interval
+{
+	static constexpr int bits = std::numeric_limits<T>::digits < 64 ? std::numeric_limits<T>::digits : 64;
+	static constexpr std::uint64_t maximum = std::numeric_limits<std::uint64_t>::max() >> (64 - bits);
+
+	static T map(std::uint64_t x)
+	{
+		static const T scale = T(1) / static_cast<T>(maximum);
+		return static_cast<T>(x >> (64 - bits)) * scale;
+	}
+}; // struct unit_interval
+
+} // namespace
+
 struct rng_implementation
 {
-	rng_implementation() :
-		generator(time(nullptr))
+	/// @remark The alternatives are in the order of the enumeration elements of idlib::rng_engine.
+	using generator_type = std::variant<std::mt19937_64, xoshiro256_star_star, pcg64, philox4x32>;
+
+	rng_implementation(rng_engine engine, std::uint64_t seed, std::uint64_t stream) :
+		engine(engine), stream(stream), generator(make_generator(engine, seed, stream))
 	{}
-	
-    single next(const interval<single>& interval)
-    {
-        auto min = interval.lower();
-        auto max = std::nextafter(interval.upper(), std::numeric_limits<single>::max());
-        std::uniform_real_distribution<single> distribution(min, max);
-        return distribution(generator);
-    }
-
-    double next(const interval<double>& interval)
-    {
-        auto min = interval.lower();
-        auto max = std::nextafter(interval.upper(), std::numeric_limits<double>::max());
-        std::uniform_real_distribution<double> distribution(min, max);
-        return distribution(generator);
-    }
-	
-	quadruple next(const interval<quadruple>& interval)
+
+	rng_engine get_engine() const
+	{ return engine; }
+
+	std::uint64_t get_stream() const
+	{ return stream; }
+
+	void seed(std::uint64_t seed)
+	{ generator = make_generator(engine, seed, stream); }
+
+	void discard(std::uint64_t n)
+	{ std::visit([n](auto& g) { g.discard(n); }, generator); }
+
+	template <typename T>
+	T next(const interval<T>& interval)
+	{ return std::visit([&interval](auto& g) { return uniform(g, interval); }, generator); }
+
+	template <typename T>
+	void fill(span<T> target, const interval<T>& interval)
 	{
-        auto min = interval.lower();
-        auto max = std::nextafter(interval.upper(), std::numeric_limits<quadruple>::max());
-        std::uniform_real_distribution<quadruple> distribution(min, max);
-        return distribution(generator);		
+		std::visit([&target, &interval](auto& g)
+		{
+			// The random bits of a block are converted to values in [0,1],
+			// then the block is mapped to the interval while it is in the cache.
+			static constexpr std::size_t block_size = 256;
+			const T l = interval.lower(), u = interval.upper(), w = u - l;
+			for (std::size_t i = 0; i < target.size(); i += block_size)
+			{
+				const std::size_t n = std::min(block_size, target.size() - i);
+				T *z = target.data() + i;
+				for (std::size_t j = 0; j < n; ++j)
+				{ z[j] = unit_interval<T>::map(g()); }
+				internal::batch_kernel<T>::multiply_add_min(z, w, l, u, z, n);
+			}
+		}, generator);
 	}
-	
-	int next(const interval<int>& interval)
+
+	void fill(span<int> target, const interval<int>& interval)
 	{
-        auto min = interval.lower();
-        auto max = interval.upper();
-        std::uniform_int_distribution<int> distribution(min, max);
-        return distribution(generator);
-    }
-	
+		std::visit([&target, &interval](auto& g)
+		{
+			for (auto& z : target)
+			{ z = uniform(g, interval); }
+		}, generator);
+	}
+
 private:
-    /// @brief Mersenne Twister randomizer.
-    std::mt19937 generator;
+	static generator_type make_generator(rng_engine engine, std::uint64_t seed, std::uint64_t stream)
+	{
+		if (stream != 0 && engine != rng_engine::philox4x32)
+		{ throw invalid_argument_error(__FILE__, __LINE__, "engine does not support streams"); }
+		switch (engine)
+		{
+			case rng_engine::mersenne_twister:
+				return generator_type(std::in_place_index<0>, seed);
+			case rng_engine::xoshiro256_star_star:
+				return generator_type(std::in_place_index<1>, seed);
+			case rng_engine::pcg64:
+				return generator_type(std::in_place_index<2>, seed);
+			case rng_engine::philox4x32:
+				return generator_type(std::in_place_index<3>, seed, stream);
+			default:
+				throw invalid_argument_error(__FILE__, __LINE__, "unknown engine");
+		};
+	}
+
+	/// @remark Computes the same value as idlib::internal::batch_kernel::multiply_add_min.
+	template <typename G, typename T>
+	static T uniform(G& g, const interval<T>& interval)
+	{
+		const T l = interval.lower(), u = interval.upper(), w = u - l;
+		const T v = unit_interval<T>::map(g()) * w + l;
+		return u < v ? u : v;
+	}
+
+	/// @remark Lemire, "Fast Random Integer Generation in an Interval", 2019.
+	template <typename G>
+	static int uniform(G& g, const interval<int>& interval)
+	{
+		const std::int64_t l = interval.lower();
+		const std::uint64_t range = static_cast<std::uint64_t>(interval.upper() - l) + 1;
+		std::uint32_t x = static_cast<std::uint32_t>(g() >> 32);
+		if (range > std::numeric_limits<std::uint32_t>::max())
+		{ return static_cast<int>(l + x); }
+		const auto r = static_cast<std::uint32_t>(range);
+		std::uint64_t m = std::uint64_t(x) * r;
+		if (static_cast<std::uint32_t>(m) < r)
+		{
+			const std::uint32_t t = (0 - r) % r;
+			while (static_cast<std::uint32_t>(m) < t)
+			{
+				x = static_cast<std::uint32_t>(g() >> 32);
+				m = std::uint64_t(x) * r;
+			}
+		}
+		return static_cast<int>(l + static_cast<std::int64_t>(m >> 32));
+	}
+
+	rng_engine engine;
+	std::uint64_t stream;
+	generator_type generator;
 	
 }; // rng_implementation
 
 rng::rng() :
-	m_implementation(std::make_unique<rng_implementation>())
+	rng(default_engine, unspecified_seed())
+{}
+
+rng::rng(std::uint64_t seed) :
+	rng(default_engine, seed)
+{}
+
+rng::rng(rng_engine engine, std::uint64_t seed) :
+	rng(engine, seed, 0)
+{}
+
+rng::rng(rng_engine engine, std::uint64_t seed, std::uint64_t stream) :
+	m_implementation(std::make_unique<rng_implementation>(engine, seed, stream))
 {}
 
 rng::~rng()
@@ -87,6 +204,18 @@ rng& rng::operator=(rng&& other)
 	return *this;
 }
 
+rng_engine rng::get_engine() const
+{ return m_implementation->get_engine(); }
+
+std::uint64_t rng::get_stream() const
+{ return m_implementation->get_stream(); }
+
+void rng::seed(std::uint64_t seed)
+{ m_implementation->seed(seed); }
+
+void rng::discard(std::uint64_t n)
+{ m_implementation->discard(n); }
+
 single rng::next(const interval<single>& interval)
 { return m_implementation->next(interval); }
 
@@ -98,5 +227,17 @@ quadruple rng::next(const interval<quadruple>& interval)
 
 int rng::next(const interval<int>& interval)
 { return m_implementation->next(interval); }
+
+void rng::fill(span<single> target, const interval<single>& interval)
+{ m_implementation->fill(target, interval); }
+
+void rng::fill(span<double> target, const interval<double>& interval)
+{ m_implementation->fill(target, interval); }
+
+void rng::fill(span<quadruple> target, const interval<quadruple>& interval)
+{ m_implementation->fill(target, interval); }
+
+void rng::fill(span<int> target, const interval<int>& interval)
+{ m_implementation->fill(target, interval); }
     
 } // namespace idlib
@@ -25,19 +25,69 @@
 #pragma once
 
 #include "idlib/math/interval.hpp"
+#pragma push_macro("IDLIB_PRIVATE")
+#if !defined(IDLIB_PRIVATE)
+#define IDLIB_PRIVATE (1)
+#endif
+#include "idlib/range/span.hpp"
+#undef IDLIB_PRIVATE
+#pragma pop_macro("IDLIB_PRIVATE")
+#include <cstdint>
+#include <memory>
 
 namespace idlib {
 
 // Forward declaration.
 struct rng_implementation;
-	
+
+/// @ingroup math
+/// @brief The pseudo random number engines of idlib::rng.
+enum class rng_engine
+{
+	/// @brief std::mt19937_64.
+	mersenne_twister,
+	/// @brief idlib::xoshiro256_star_star.
+	xoshiro256_star_star,
+	/// @brief idlib::pcg64.
+	pcg64,
+	/// @brief idlib::philox4x32.
+	/// @remark The only engine supporting streams.
+	philox4x32,
+}; // enum class rng_engine
+
 /// @ingroup math
-/// @brief Mersenne Twiser random number generator.
+/// @brief Random number generator.
 /// @remark This class is not copyable, only movable.
+/// @remark Given the same engine and the same seed, a random number generator generates the same sequence of values.
+/// Each value generated by a call to @a next or generated by a call to @a fill advances the sequence by the same amount.
+/// That is, <c>fill(s, i)</c> stores the same values into @a s as <c>s.size()</c> consecutive calls to <c>next(i)</c> would return.
+/// @remark For reproducible parallel computations, use the engine idlib::rng_engine::philox4x32 and assign each task its own stream of a common seed:
+/// @code
+/// parallel_for(0, tasks, [seed](std::uint64_t task) { rng rng(rng_engine::philox4x32, seed, task); ... });
+/// @endcode
+/// The values of a task depend only on the seed and the task index, not on the number of threads or the scheduling of the tasks.
 struct rng
 {
-	/// @brief Construct this random number generator.
+	/// @brief The default engine.
+	static constexpr rng_engine default_engine = rng_engine::xoshiro256_star_star;
+
+	/// @brief Construct this random number generator with the default engine and an unspecified seed.
+	/// @remark The seed differs between random number generators constructed by this constructor.
 	rng();
+	/// @brief Construct this random number generator with the default engine and the specified seed.
+	/// @param seed the seed
+	explicit rng(std::uint64_t seed);
+	/// @brief Construct this random number generator with the specified engine and the specified seed.
+	/// @param engine the engine
+	/// @param seed the seed
+	rng(rng_engine engine, std::uint64_t seed);
+	/// @brief Construct this random number generator with the specified engine, the specified seed, and the specified stream.
+	/// @param engine the engine
+	/// @param seed the seed
+	/// @param stream the stream index
+	/// @throw idlib::invalid_argument_error @a stream is not @a 0 and @a engine does not support streams
+	/// @remark The streams of a seed are non-overlapping sequences.
+	rng(rng_engine engine, std::uint64_t seed, std::uint64_t stream);
 	/// @brief Destruct this random number generator.
 	~rng();
 	/// @brief Move-construct this random number generator.
@@ -48,7 +98,25 @@ struct rng
 	rng& operator=(rng&&); // movable	
 	rng& operator=(const rng&) = delete; // not copyable
 
-	
+	/// @brief Get the engine of this random number generator.
+	/// @return the engine
+	rng_engine get_engine() const;
+
+	/// @brief Get the stream index of this random number generator.
+	/// @return the stream index
+	std::uint64_t get_stream() const;
+
+	/// @brief Re-seed this random number generator.
+	/// @param seed the seed
+	/// @post This random number generator generates the same sequence as a random number generator constructed with the same engine, the same stream, and the specified seed.
+	void seed(std::uint64_t seed);
+
+	/// @brief Advance this random number generator.
+	/// @param n the number of values of the engine to skip
+	/// @remark Constant time for idlib::rng_engine::philox4x32, linear time for the other engines.
+	/// Each floating point value generated consumes one value of the engine, each @a int value consumes at least one value of the engine.
+	void discard(std::uint64_t n);
+
 	/// @{
     /// @brief Generate a random floating point value within the bounds of a floating point interval.
     /// @param interval the interval
@@ -70,6 +138,22 @@ struct rng
 	int next(const interval<int>& interval);
 	
 	/// @}
+
+	/// @{
+	/// @brief Fill a span with random values within the bounds of an interval.
+	/// @param target the span
+	/// @param interval the interval
+	/// @remark For floating point values, the mapping of the random bits to the interval is computed on blocks of values with SIMD instructions if available.
+
+	void fill(span<single> target, const interval<single>& interval);
+
+	void fill(span<double> target, const interval<double>& interval);
+
+	void fill(span<quadruple> target, const interval<quadruple>& interval);
+
+	void fill(span<int> target, const interval<int>& interval);
+
+	/// @}
 	
 private:
 	std::unique_ptr<rng_implementation> m_implementation;
@@ -0,0 +1,313 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/random_engine.hpp
+/// @brief Fast pseudo random number engines.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief The SplitMix64 pseudo random number engine.
+/// @remark This engine is used to expand a 64 bit seed into the state of the other engines,
+/// see Steele, Lea, Flood, "Fast Splittable Pseudorandom Number Generators", 2014.
+/// Models the UniformRandomBitGenerator concept of the C++ standard library.
+struct splitmix64
+{
+	using result_type = std::uint64_t;
+
+	static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	/// @brief Construct this engine.
+	/// @param seed the seed
+	explicit constexpr splitmix64(std::uint64_t seed) :
+		m_state(seed)
+	{}
+
+	/// @brief Generate the next value.
+	/// @return the value
+	constexpr result_type operator()()
+	{
+		std::uint64_t z = (m_state += UINT64_C(0x9e3779b97f4a7c15));
+		z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+		z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+		return z ^ (z >> 31);
+	}
+
+private:
+	std::uint64_t m_state;
+
+}; // struct splitmix64
+
+/// @ingroup math
+/// @brief The xoshiro256** pseudo random number engine.
+/// @remark 256 bits of state, a period of \f$2^{256} - 1\f$, see Blackman, Vigna, "Scrambled Linear Pseudorandom Number Generators", 2018.
+/// Models the UniformRandomBitGenerator concept of the C++ standard library.
+struct xoshiro256_star_star
+{
+	using result_type = std::uint64_t;
+
+	static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	/// @brief Construct this engine.
+	/// @param seed the seed
+	explicit constexpr xoshiro256_star_star(std::uint64_t seed) :
+		m_state{}
+	{ this->seed(seed); }
+
+	/// @brief Seed this engine.
+	/// @param seed the seed
+	/// @remark The state is obtained from the first four values of idlib::splitmix64 seeded with @a seed.
+	constexpr void seed(std::uint64_t seed)
+	{
+		splitmix64 g(seed);
+		for (auto& s : m_state) s = g();
+	}
+
+	/// @brief Generate the next value.
+	/// @return the value
+	constexpr result_type operator()()
+	{
+		const std::uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+		const std::uint64_t t = m_state[1] << 17;
+		m_state[2] ^= m_state[0];
+		m_state[3] ^= m_state[1];
+		m_state[1] ^= m_state[2];
+		m_state[0] ^= m_state[3];
+		m_state[2] ^= t;
+		m_state[3] = rotl(m_state[3], 45);
+		return result;
+	}
+
+	/// @brief Advance this engine.
+	/// @param n the number of values to skip
+	constexpr void discard(std::uint64_t n)
+	{
+		for (; n != 0; --n) (*this)();
+	}
+
+private:
+	static constexpr std::uint64_t rotl(std::uint64_t x, int k)
+	{ return (x << k) | (x >> (64 - k)); }
+
+	std::uint64_t m_state[4];
+
+}; // struct xoshiro256_star_star
+
+/// @ingroup math
+/// @brief The PCG64 (XSL RR 128/64) pseudo random number engine.
+/// @remark 128 bits of state, a period of \f$2^{128}\f$, see O'Neill, "PCG: A Family of Simple Fast Space-Efficient Statistically Good Algorithms for Random Number Generation", 2014.
+/// Models the UniformRandomBitGenerator concept of the C++ standard library.
+struct pcg64
+{
+	using result_type = std::uint64_t;
+
+	static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	/// @brief Construct this engine.
+	/// @param seed the seed
+	explicit constexpr pcg64(std::uint64_t seed) :
+		m_state{0, 0}
+	{ this->seed(seed); }
+
+	/// @brief Seed this engine.
+	/// @param seed the seed
+	/// @remark The initial state is obtained from the first two values of idlib::splitmix64 seeded with @a seed.
+	/// The stream is the default stream.
+	constexpr void seed(std::uint64_t seed)
+	{
+		splitmix64 g(seed);
+		const std::uint64_t hi = g(), lo = g();
+		m_state = {0, 0};
+		step();
+		m_state = add(m_state, {hi, lo});
+		step();
+	}
+
+	/// @brief Generate the next value.
+	/// @return the value
+	constexpr result_type operator()()
+	{
+		step();
+		const std::uint64_t x = m_state.hi ^ m_state.lo;
+		const int r = static_cast<int>(m_state.hi >> 58);
+		return (x >> r) | (x << ((64 - r) & 63));
+	}
+
+	/// @brief Advance this engine.
+	/// @param n the number of values to skip
+	constexpr void discard(std::uint64_t n)
+	{
+		for (; n != 0; --n) (*this)();
+	}
+
+private:
+	/// @brief An unsigned 128 bit integer.
+	struct uint128
+	{
+		std::uint64_t hi, lo;
+	};
+
+	static constexpr uint128 add(uint128 x, uint128 y)
+	{
+		const std::uint64_t lo = x.lo + y.lo;
+		return { x.hi + y.hi + (lo < x.lo ? 1 : 0), lo };
+	}
+
+	/// @brief Compute the product of two 128 bit integers modulo \f$2^{128}\f$.
+	static constexpr uint128 multiply(uint128 x, uint128 y)
+	{
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 p = static_cast<unsigned __int128>(x.lo) * y.lo;
+		return { static_cast<std::uint64_t>(p >> 64) + x.hi * y.lo + x.lo * y.hi, static_cast<std::uint64_t>(p) };
+#else
+		const std::uint64_t a0 = x.lo & 0xffffffff, a1 = x.lo >> 32,
+		                    b0 = y.lo & 0xffffffff, b1 = y.lo >> 32;
+		const std::uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+		const std::uint64_t m = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+		const std::uint64_t lo = (m << 32) | (p00 & 0xffffffff);
+		const std::uint64_t hi = p11 + (p01 >> 32) + (p10 >> 32) + (m >> 32);
+		return { hi + x.hi * y.lo + x.lo * y.hi, lo };
+#endif
+	}
+
+	constexpr void step()
+	{
+		constexpr uint128 multiplier{ UINT64_C(2549297995355413924), UINT64_C(4865540595714422341) };
+		constexpr uint128 increment{ UINT64_C(6364136223846793005), UINT64_C(1442695040888963407) };
+		m_state = add(multiply(m_state, multiplier), increment);
+	}
+
+	uint128 m_state;
+
+}; // struct pcg64
+
+/// @ingroup math
+/// @brief The Philox4x32-10 counter-based pseudo random number engine.
+/// @remark The values are obtained by applying a keyed bijection to a 128 bit counter,
+/// see Salmon, Moraes, Dror, Shaw, "Parallel Random Numbers: As Easy as 1, 2, 3", 2011.
+/// The key is the seed. The upper 64 bits of the counter are the stream index, the lower 64 bits are the block index.
+/// Each block provides two values. Each of the \f$2^{64}\f$ streams of a seed provides \f$2^{64}\f$ values.
+/// Streams of the same seed do not overlap, and the value at any position of any stream is computed in constant time.
+/// Models the UniformRandomBitGenerator concept of the C++ standard library.
+struct philox4x32
+{
+	using result_type = std::uint64_t;
+
+	/// @brief The type of a counter.
+	using counter_type = std::array<std::uint32_t, 4>;
+
+	/// @brief The type of a key.
+	using key_type = std::array<std::uint32_t, 2>;
+
+	static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	/// @brief Construct this engine.
+	/// @param seed the seed
+	/// @param stream the stream index
+	explicit constexpr philox4x32(std::uint64_t seed, std::uint64_t stream = 0) :
+		m_key{}, m_stream(0), m_position(0), m_block{}
+	{ this->seed(seed, stream); }
+
+	/// @brief Seed this engine.
+	/// @param seed the seed
+	/// @param stream the stream index
+	/// @post This engine is at the beginning of the specified stream.
+	constexpr void seed(std::uint64_t seed, std::uint64_t stream = 0)
+	{
+		m_key = { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+		m_stream = stream;
+		m_position = 0;
+	}
+
+	/// @brief Generate the next value.
+	/// @return the value
+	constexpr result_type operator()()
+	{
+		if (m_position % 2 == 0)
+		{ m_block = block(m_position / 2); }
+		const std::size_t i = static_cast<std::size_t>(m_position % 2) * 2;
+		++m_position;
+		return (static_cast<std::uint64_t>(m_block[i + 1]) << 32) | m_block[i];
+	}
+
+	/// @brief Advance this engine.
+	/// @param n the number of values to skip
+	/// @remark Constant time.
+	constexpr void discard(std::uint64_t n)
+	{
+		m_position += n;
+		if (m_position % 2 != 0)
+		{ m_block = block(m_position / 2); }
+	}
+
+	/// @brief Compute the block of a counter.
+	/// @param counter the counter
+	/// @param key the key
+	/// @return the block
+	static constexpr counter_type block(counter_type counter, key_type key)
+	{
+		for (int round = 0; round < 10; ++round)
+		{
+			if (round != 0)
+			{
+				key[0] += UINT32_C(0x9e3779b9);
+				key[1] += UINT32_C(0xbb67ae85);
+			}
+			const std::uint64_t p = std::uint64_t(UINT32_C(0xd2511f53)) * counter[0],
+			                    q = std::uint64_t(UINT32_C(0xcd9e8d57)) * counter[2];
+			counter = { static_cast<std::uint32_t>(q >> 32) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(q),
+			            static_cast<std::uint32_t>(p >> 32) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(p) };
+		}
+		return counter;
+	}
+
+private:
+	constexpr counter_type block(std::uint64_t index) const
+	{
+		return block({ static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+		               static_cast<std::uint32_t>(m_stream), static_cast<std::uint32_t>(m_stream >> 32) }, m_key);
+	}
+
+	key_type m_key;
+	std::uint64_t m_stream;
+	/// @brief The index of the next value in the stream.
+	std::uint64_t m_position;
+	/// @brief If the position is odd, the block of the next value.
+	counter_type m_block;
+
+}; // struct philox4x32
+
+} // namespace idlib
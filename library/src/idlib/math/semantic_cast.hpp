@@ -37,12 +37,12 @@ struct semantic_cast_functor {};
 template <typename T>
 struct semantic_cast_functor<T, T, void>
 {
-	auto operator()(const T& v) const
+	constexpr auto operator()(const T& v) const
 	{ return v; }
 }; // struct semantic_cast_functor
 
 template <typename T, typename S>
-auto semantic_cast(const S& s)
+constexpr auto semantic_cast(const S& s)
 { return semantic_cast_functor<T, S, void>()(s); }
 
 } // namespace idlib
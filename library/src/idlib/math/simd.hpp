@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/simd.hpp
+/// @brief Compile-time detection of SIMD instruction set extensions.
+/// @author Michael Heilmann
+
+/// @detail
+/// This file detects the SIMD instruction set extensions the compiler generates code for based on common predefined preprocessor symbols.
+/// The following symbolic constants are defined to @a 1 if the respective extension is available:
+/// - #IDLIB_WITH_SSE2 (SSE and SSE2),
+/// - #IDLIB_WITH_SSE41 (SSE 4.1),
+/// - #IDLIB_WITH_AVX (AVX).
+/// If an extension is available, all extensions listed before it are available as well.
+/// </br>
+/// By pre-defining the constant #IDLIB_NO_SIMD, the detection is skipped and none of the above constants is defined.
+/// Code using SIMD instructions must provide a scalar fallback for that case.
+/// </br>
+/// SIMD intrinsics can not be evaluated in constant expressions.
+/// @a constexpr functions using SIMD instructions must select the scalar fallback if #IDLIB_IS_CONSTANT_EVALUATED() is @a true.
+/// If the compiler can not tell constant evaluation from evaluation at runtime, #IDLIB_NO_SIMD is defined.
+
+#pragma once
+
+/// @brief Expands to an expression which is @a true if it is evaluated in a constant expression and @a false otherwise.
+/// @remark If the compiler does not support this query, the expression is always @a false and #IDLIB_NO_SIMD is defined,
+/// such that @a constexpr functions always use their scalar fallback and can be evaluated in constant expressions.
+#if defined(__has_builtin)
+	#if __has_builtin(__builtin_is_constant_evaluated)
+		#define IDLIB_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+	#endif
+#endif
+#if !defined(IDLIB_IS_CONSTANT_EVALUATED)
+	#if (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+		#define IDLIB_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+	#else
+		#define IDLIB_IS_CONSTANT_EVALUATED() false
+		#if !defined(IDLIB_NO_SIMD)
+			#define IDLIB_NO_SIMD 1
+		#endif
+	#endif
+#endif
+
+#if !defined(IDLIB_NO_SIMD)
+
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define IDLIB_WITH_SSE2 1
+	#endif
+
+	#if defined(IDLIB_WITH_SSE2) && (defined(__SSE4_1__) || defined(__AVX__))
+		#define IDLIB_WITH_SSE41 1
+	#endif
+
+	#if defined(IDLIB_WITH_SSE41) && defined(__AVX__)
+		#define IDLIB_WITH_AVX 1
+	#endif
+
+#endif
+
+#if defined(IDLIB_WITH_AVX)
+	#include <immintrin.h>
+#elif defined(IDLIB_WITH_SSE41)
+	#include <smmintrin.h>
+#elif defined(IDLIB_WITH_SSE2)
+	#include <emmintrin.h>
+#endif
@@ -24,7 +24,10 @@
 
 #pragma once
 
+#include "idlib/math/simd.hpp"
 #include <cmath>
+#include <limits>
+#include <type_traits>
 
 namespace idlib {
 	
@@ -37,14 +40,72 @@ struct sqrt_functor;
 
 /// @brief The function corresponding to idlib::sqrt_functor.
 template <typename T>
-auto sqrt(const T& v)
-{ return sq_functor<T>()(v); }
+constexpr auto sqrt(const T& v)
+{ return sqrt_functor<T>()(v); }
+
+namespace internal {
+
+/// @brief Get the sign of \f$m^2 - x\f$ for a value \f$m\f$ of at most \f$p + 1\f$ significant bits
+/// and a value \f$x\f$ of at most \f$p\f$ significant bits where \f$p\f$ is the number of significant bits of @a T.
+/// @remark \f$m\f$ is split into two halves of at most \f$\lceil (p + 1) / 2 \rceil\f$ significant bits (Veltkamp).
+/// The partial products and their first sum are exact in @a quadruple precision, hence the final rounded sum has the sign of \f$m^2 - x\f$.
+template <typename T>
+constexpr long double constant_sqrt_residual(long double m, long double x)
+{
+	constexpr int s = std::numeric_limits<long double>::digits - (std::numeric_limits<T>::digits + 2) / 2;
+	long double c = 1.0l;
+	for (int i = 0; i < s; ++i) c = c * 2.0l;
+	long double t = (c + 1.0l) * m, h = t - (t - m), l = m - h;
+	return ((h * h - x) + 2.0l * h * l) + l * l;
+}
+
+/// @brief Compute the square root of a floating-point value in a constant expression.
+/// @param x the value
+/// @return the square root of @a x
+/// @remark The square root is computed by Newton iteration in @a quadruple precision,
+/// starting above the square root, until the iterates stop decreasing.
+/// The result is rounded to @a T and corrected by comparing @a x with the squares of the midpoints between the result and its neighbours.
+/// Hence the result is correctly rounded i.e. identical to the result of std::sqrt if @a quadruple provides at least
+/// \f$p + 11\f$ significant bits where \f$p\f$ is the number of significant bits of @a T
+/// (e.g. @a single and @a double on x86 targets) and faithfully rounded otherwise.
+template <typename T>
+constexpr T constant_sqrt(T x)
+{
+	if (x != x || x == T(0) || x == std::numeric_limits<T>::infinity())
+	{ return x; }
+	if (x < T(0))
+	{ return std::numeric_limits<T>::quiet_NaN(); }
+	long double y = x, r = y > 1.0l ? y : 1.0l;
+	while (true)
+	{
+		long double s = 0.5l * (r + y / r);
+		if (!(s < r)) break;
+		r = s;
+	}
+	T z = static_cast<T>(r);
+	if constexpr (std::numeric_limits<long double>::digits >= std::numeric_limits<T>::digits + 11)
+	{
+		// The square root of a positive finite value is a normal value.
+		// Compute the power of two p with p <= z < 2p and the unit in the last place u of z.
+		long double p = 1.0l;
+		while (p * 2.0l <= z) p = p * 2.0l;
+		while (p > z) p = p / 2.0l;
+		long double u = p * std::numeric_limits<T>::epsilon(),
+			        d = z == p ? u / 2.0l : u;
+		if (constant_sqrt_residual<T>(z - d / 2.0l, y) > 0.0l) z = static_cast<T>(z - d);
+		else if (constant_sqrt_residual<T>(z + u / 2.0l, y) < 0.0l) z = static_cast<T>(z + u);
+	}
+	return z;
+}
+
+} // namespace internal
 
 template <typename T>
 struct sqrt_functor<T, std::enable_if_t<std::is_floating_point<T>::value>>
 {
-	T operator()(T x) const
-	{ return std::sqrt(x); }
-}; // struct sq_functor
+	/// @remark In constant expressions, the square root is computed by idlib::internal::constant_sqrt.
+	constexpr T operator()(T x) const
+	{ return IDLIB_IS_CONSTANT_EVALUATED() ? internal::constant_sqrt(x) : std::sqrt(x); }
+}; // struct sqrt_functor
 
-} // namespace idlib
\ No newline at end of file
+} // namespace idlib
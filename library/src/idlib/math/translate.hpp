@@ -51,7 +51,7 @@ template <typename A, typename T>
 struct translate_functor;
 
 template <typename A, typename T>
-auto translate(const A& a, const T& t) -> decltype(translate_functor<A, T>()(a, t))
+constexpr auto translate(const A& a, const T& t) -> decltype(translate_functor<A, T>()(a, t))
 {
 	return translate_functor<A, T>()(a, t);
 }
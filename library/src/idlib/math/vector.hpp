@@ -37,7 +37,11 @@
 
 // Includes of functors idlib::vector provides a plugin for.
 #include "idlib/math/one_zero.hpp"
+#include "idlib/math/abs.hpp"
+#include "idlib/math/sqrt.hpp"
 #include "idlib/math/euclidean_norm.hpp"
+#include "idlib/math/fast_euclidean_norm.hpp"
+#include "idlib/math/batch_kernel.hpp"
 #include "idlib/math/manhattan_norm.hpp"
 #include "idlib/math/maximum_norm.hpp"
 #include "idlib/math/squared_euclidean_norm.hpp"
@@ -54,6 +58,7 @@ namespace idlib {
 /// @ingroup math
 /// @brief A vector.
 /// @remark Vectors are <a href=http://en.cppreference.com/w/cpp/concept/DefaultConstructible">DefaultConstructible</a>.
+/// @remark Vectors are literal types. Their constructors, accessors, and operators are @a constexpr.
 /// @tparam Scalar the scalar type
 /// @tparam Dimensionality the dimensionality
 template <typename Scalar, size_t Dimensionality>
@@ -85,19 +90,19 @@ public:
     template<typename ... Arguments,
              typename = std::enable_if_t<(sizeof...(Arguments)) == vector_type::dimensionality() &&
                                          all_convertible<scalar_type, typename std::decay<Arguments>::type...>::value>>
-    vector(Arguments&& ... arguments)
+    constexpr vector(Arguments&& ... arguments)
         : m_implementation(std::forward<Arguments>(arguments)...)
 	{ static_assert(dimensionality() == sizeof ... (arguments), "wrong number of arguments"); }
 
     /// @brief Copy-construct this vector with the values of another vector.
     /// @param other the other vector
-    vector(const vector_type& other)
+    constexpr vector(const vector_type& other)
 		: m_implementation(other.m_implementation)
 	{}
 	
 	/// @internal
 	template <typename G, std::size_t...Is>
-	static vector_type generate(const G& g, std::index_sequence<Is...>)
+	static constexpr vector_type generate(const G& g, std::index_sequence<Is...>)
 	{
 		return vector_type((g(Is))...);
 	}
@@ -107,7 +112,7 @@ public:
 	/// @param g the generator
 	/// @return the vector
 	template <typename G>
-	static vector_type generate(const G& g)
+	static constexpr vector_type generate(const G& g)
 	{
 		return generate(g, std::make_index_sequence<dimensionality()>{});
 	}
@@ -115,19 +120,19 @@ public:
 	/// @internal
 	/// @brief Construct this vector.
 	/// @param other the implementation_type value
-	vector(const implementation_type& other) :
+	constexpr vector(const implementation_type& other) :
 		m_implementation(other)
 	{}
     
 	/// @brief Default-construct this vector.
-    vector()
+    constexpr vector()
 		: m_implementation()
 	{ /* Intentionally empty. */ }
 
 public:
     /// @brief Get a unit vector in which the component of the specified index is @a 1.
     /// @return the unit vector
-    static vector_type unit(size_t index)
+    static constexpr vector_type unit(size_t index)
 	{
 		using a = constant_generator<scalar_type>;
 		using b = constant_generator<scalar_type>;
@@ -140,13 +145,13 @@ public:
 	/// @brief Get the component value of the \f$x\f$ component.
 	/// @return a reference to the component value of the \f$x\f$ component
 	template <std::size_t LocalDimensionality = vector_type::dimensionality()>
-    std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x()
+    constexpr std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x()
 	{
         static_assert(vector_type::dimensionality() >= 1, "cannot call for member x() with dimensionality less than 1");
         return m_implementation[0];
     }
 	template <std::size_t LocalDimensionality = vector_type::dimensionality()>
-	const std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x() const
+	constexpr const std::enable_if_t<(LocalDimensionality >= 1), scalar_type>& x() const
 	{
         static_assert(vector_type::dimensionality() >= 1, "cannot call for member x() with dimensionality less than 1");
         return m_implementation[0];
@@ -157,13 +162,13 @@ public:
 	/// @brief Get the component value of the \f$y\f$ component.
 	/// @return a reference to the component value of the \f$y\f$ component
 	template <std::size_t LocalDimensionality = vector_type::dimensionality()>
-    scalar_type& y()
+    constexpr scalar_type& y()
 	{
         static_assert(vector_type::dimensionality() >= 2, "cannot call for member y() with dimensionality less than 2");
         return m_implementation[1];
     }
 	template <std::size_t LocalDimensionality = vector_type::dimensionality()>
-    const scalar_type& y() const
+    constexpr const scalar_type& y() const
 	{
         static_assert(vector_type::dimensionality() >= 2, "cannot call for member y() with dimensionality less than 2");
         return m_implementation[1];
@@ -174,13 +179,13 @@ public:
 	/// @brief Get the component value of the \f$z\f$ component.
 	/// @return a reference to the component value of the \f$z\f$ component
 	template <std::size_t LocalDimensionality = vector_type::dimensionality()>
-    std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z()
+    constexpr std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z()
 	{
         static_assert(vector_type::dimensionality() >= 3, "cannot call for member z() with dimensionality less than 3");
         return m_implementation[2];
     }
 	template <std::size_t LocalDimensionality = vector_type::dimensionality()>
-    const std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z() const
+    constexpr const std::enable_if_t<(LocalDimensionality >= 3), scalar_type>& z() const
 	{
         static_assert(vector_type::dimensionality() >= 3, "cannot call for member z() with dimensionality less than 3");
         return m_implementation[2];
@@ -188,13 +193,13 @@ public:
 	/// @}
 
 public:
-	bool operator==(const vector_type& other) const
+	constexpr bool operator==(const vector_type& other) const
 	{ return m_implementation == other.m_implementation; }
 	
-	bool operator!=(const vector_type& other) const
+	constexpr bool operator!=(const vector_type& other) const
 	{ return m_implementation != other.m_implementation; }
 	
-	vector_type& operator=(const vector_type& other)
+	constexpr vector_type& operator=(const vector_type& other)
 	{
 		m_implementation = other.m_implementation;
 		return *this;
@@ -240,7 +245,7 @@ public:
 
 private:
 	template <typename C, std::size_t...Is>
-	bool equal_to(const vector_type& other, const C& c, std::index_sequence<Is ...>) const
+	constexpr bool equal_to(const vector_type& other, const C& c, std::index_sequence<Is ...>) const
 	{ return and_fold_expr()(c((*this)[Is], other[Is]) ...); }
 
 public:
@@ -249,7 +254,7 @@ public:
 	/// @param other the other vector
 	/// @param c the comparator
 	template <typename C>
-	bool equal_to(const vector_type& other, const C& c) const
+	constexpr bool equal_to(const vector_type& other, const C& c) const
 	{ return equal_to(other, c, std::make_index_sequence<Dimensionality>{}); }
 
 #if 0
@@ -298,12 +303,12 @@ public:
 private:
     /** @internal */
     template <size_t...Is>
-    vector_type max(std::index_sequence<Is...>, const vector_type& other) const
+    constexpr vector_type max(std::index_sequence<Is...>, const vector_type& other) const
 	{ return vector_type((std::max((*this)(Is), other(Is))) ...); }
 
     /** @internal */
     template <size_t...Is>
-    vector_type min(std::index_sequence<Is...>, const vector_type& other) const
+    constexpr vector_type min(std::index_sequence<Is...>, const vector_type& other) const
 	{ return vector_type((std::min((*this)(Is), other(Is))) ...); }
 
 public:  
@@ -315,7 +320,7 @@ public:
     /// \f[
     /// max\left(\vec{u},\vec{v}\right)=left(max(u_1,v_1),\ldots,max(u_n,v_n)\right)
     /// \f]
-    vector_type max(const vector_type& other) const
+    constexpr vector_type max(const vector_type& other) const
 	{ return max(std::make_index_sequence<vector_type::dimensionality()>{}, other); }
 
     /// @brief Get the component-wise minimum of this vector and another vector.
@@ -326,39 +331,39 @@ public:
     ///	\f[
     ///	min\left(\vec{u},\vec{v}\right)=left(min(u_1,v_1),\ldots,min(u_n,v_n)\right)
     ///	\f]
-    vector_type min(const vector_type& other) const
+    constexpr vector_type min(const vector_type& other) const
 	{ return min(std::make_index_sequence<vector_type::dimensionality()>{}, other); }
 
 public:
-    scalar_type& operator[](size_t const& index)
+    constexpr scalar_type& operator[](size_t const& index)
 	{ return m_implementation[index]; }
 
-    const scalar_type& operator[](size_t const& index) const
+    constexpr const scalar_type& operator[](size_t const& index) const
 	{ return m_implementation[index]; }
 	
-    scalar_type& operator()(size_t const& index)
+    constexpr scalar_type& operator()(size_t const& index)
 	{ return m_implementation[index]; }
 
-    const scalar_type& operator()(size_t const& index) const
+    constexpr const scalar_type& operator()(size_t const& index) const
 	{ return m_implementation[index]; }
 
 public:
-	vector_type& operator+=(const vector_type& other) { m_implementation += other.m_implementation; return *this; }
-	vector_type operator+(const vector_type& other) const { auto t = m_implementation; t += other.m_implementation; return vector_type(t); }
-	vector_type& operator-=(const vector_type& other) { m_implementation -= other.m_implementation; return *this; }
-	vector_type operator-(const vector_type& other) const { auto t = m_implementation; t -= other.m_implementation; return vector_type(t); }
-	vector_type& operator*=(const scalar_type& other) { m_implementation *= other; return *this; }
-	vector_type operator*(const scalar_type& other) const { auto t = m_implementation; t *= other; return vector_type(t); }
-	vector_type& operator/=(const scalar_type& other) { m_implementation /= other; return *this; }
-	vector_type operator/(const scalar_type& other) const { auto t = m_implementation; t /= other; return vector_type(t); }
-	vector_type operator-() const { return vector_type(-m_implementation); }
-	vector_type operator+() const { return vector_type(+m_implementation); }
+	constexpr vector_type& operator+=(const vector_type& other) { m_implementation += other.m_implementation; return *this; }
+	constexpr vector_type operator+(const vector_type& other) const { auto t = m_implementation; t += other.m_implementation; return vector_type(t); }
+	constexpr vector_type& operator-=(const vector_type& other) { m_implementation -= other.m_implementation; return *this; }
+	constexpr vector_type operator-(const vector_type& other) const { auto t = m_implementation; t -= other.m_implementation; return vector_type(t); }
+	constexpr vector_type& operator*=(const scalar_type& other) { m_implementation *= other; return *this; }
+	constexpr vector_type operator*(const scalar_type& other) const { auto t = m_implementation; t *= other; return vector_type(t); }
+	constexpr vector_type& operator/=(const scalar_type& other) { m_implementation /= other; return *this; }
+	constexpr vector_type operator/(const scalar_type& other) const { auto t = m_implementation; t /= other; return vector_type(t); }
+	constexpr vector_type operator-() const { return vector_type(-m_implementation); }
+	constexpr vector_type operator+() const { return vector_type(+m_implementation); }
 
 public:
     /// @brief Get if this vector is a unit vector.
     /// @return @a true if this vector is a unit vector, @a false otherwise
     /// @obsolete
-    bool is_unit() const {
+    constexpr bool is_unit() const {
         auto t = squared_euclidean_norm(*this);
         return 0.99 < t && t < 1.01;
     }
@@ -366,13 +371,17 @@ public:
     /// @brief Get if this vector is a zero vector.
     /// @return @a true if this vector is a zero vector, @a false otherwise
     /// @obsolete
-    bool is_zero() const {
+    constexpr bool is_zero() const {
 		auto t = squared_euclidean_norm(*this);
         return t < 0.01f;
     }
 
 }; // struct vector
 
+// The layout of vectors does not depend on the SIMD instruction set extensions the code is compiled for.
+static_assert(sizeof(vector<single, 3>) == 12 && alignof(vector<single, 3>) == alignof(single), "unexpected layout of vector<single, 3>");
+static_assert(sizeof(vector<double, 4>) == 32 && alignof(vector<double, 4>) == 32, "unexpected layout of vector<double, 4>");
+
 } // namespace idlib
 
 namespace idlib {
@@ -383,7 +392,7 @@ struct zero_functor<vector<Scalar, Dimensionality>>
 	using scalar_type = Scalar;
 	using vector_type = vector<scalar_type, Dimensionality>;
 
-	auto operator()() const
+	constexpr auto operator()() const
 	{ return vector_type::generate(constant_generator<scalar_type>(zero<scalar_type>())); }
 };
 
@@ -393,7 +402,7 @@ struct one_functor<vector<Scalar, Dimensionality>>
 	using scalar_type = Scalar;
 	using vector_type = vector<scalar_type, Dimensionality>;
 
-	auto operator()() const
+	constexpr auto operator()() const
 	{ return vector_type::generate(constant_generator<scalar_type>(one<scalar_type>())); }
 };
 
@@ -493,7 +502,7 @@ template <typename Scalar>
 struct cross_product_functor<vector<Scalar, 3>>
 {
 	using vector_type = vector<Scalar, 3>;
-	auto operator()(const vector_type& v, const vector_type& w) const
+	constexpr auto operator()(const vector_type& v, const vector_type& w) const
 	{
         return
             vector_type
@@ -511,16 +520,9 @@ struct dot_product_functor<vector<Scalar, Dimensionality>>
 	using scalar_type = Scalar;
 	using vector_type = vector<scalar_type, Dimensionality>;
 	
-	auto operator()(const vector_type& v, const vector_type& w) const
-	{ return impl(v, w); }
-
-private:
-	template <std::size_t...Is>
-	static scalar_type impl(const vector_type& v, const vector_type& w, std::index_sequence<Is...>)
-	{ return idlib::plus_fold_expr()((v[Is] * w[Is])...); }
+	constexpr auto operator()(const vector_type& v, const vector_type& w) const
+	{ return v.m_implementation.inner_product(w.m_implementation); }
 
-	static scalar_type impl(const vector_type& v, const vector_type& w)
-	{ return impl(v, w, std::make_index_sequence<vector_type::dimensionality()>{}); }
 }; // struct dot_product_functor
 
 template <typename Scalar, std::size_t Dimensionality>
@@ -529,16 +531,8 @@ struct squared_euclidean_norm_functor<vector<Scalar, Dimensionality>>
 	using scalar_type = Scalar;
 	using vector_type = vector<scalar_type, Dimensionality>;
 	
-	auto operator()(const vector_type& v) const
-	{ return impl(v); }
-	
-private:
-	template <std::size_t...Is>
-	static scalar_type impl(const vector_type& v, std::index_sequence<Is...>)
-	{ return idlib::plus_fold_expr()((v[Is] * v[Is])...); }
-
-	static scalar_type impl(const vector_type& v)
-	{ return impl(v, std::make_index_sequence<vector_type::dimensionality()>{}); }
+	constexpr auto operator()(const vector_type& v) const
+	{ return v.m_implementation.inner_product(v.m_implementation); }
 
 }; // struct squared_euclidean_norm_functor
 
@@ -548,34 +542,46 @@ struct euclidean_norm_functor<vector<Scalar, Dimensionality>>
 	using scalar_type = Scalar;
 	using vector_type = vector<scalar_type, Dimensionality>;
 	
-	auto operator()(const vector_type& v) const
-	{ return impl(v); }
+	constexpr auto operator()(const vector_type& v) const
+	{ return sqrt_functor<scalar_type>()(v.m_implementation.inner_product(v.m_implementation)); }
 
-private:
-	template <std::size_t...Is>
-	static scalar_type impl(const vector_type& v, std::index_sequence<Is...>)
-	{ return std::sqrt(idlib::plus_fold_expr()((v[Is] * v[Is])...)); }
-
-	static scalar_type impl(const vector_type& v)
-	{ return impl(v, std::make_index_sequence<vector_type::dimensionality()>{}); }
-	
 }; // struct euclidean_norm_functor
 
+template <typename Scalar, std::size_t Dimensionality, std::size_t Refinements>
+struct fast_euclidean_norm_functor<vector<Scalar, Dimensionality>, Refinements>
+{
+	static_assert(std::is_same<Scalar, single>::value || std::is_same<Scalar, double>::value, "scalar type must be single or double");
+	using scalar_type = Scalar;
+	using vector_type = vector<scalar_type, Dimensionality>;
+
+	/// @brief Get the maximal relative error.
+	/// @return the maximal relative error
+	static constexpr scalar_type error_bound()
+	{ return internal::rsqrt_error_bound<scalar_type>(Refinements); }
+
+	auto operator()(const vector_type& v) const
+	{
+		auto s = v.m_implementation.inner_product(v.m_implementation);
+		return s * internal::rsqrt_or_one<Refinements>(s);
+	}
+
+}; // struct fast_euclidean_norm_functor
+
 template <typename Scalar, std::size_t Dimensionality>
 struct manhattan_norm_functor<vector<Scalar, Dimensionality>>
 {
 	using scalar_type = Scalar;
 	using vector_type = vector<scalar_type, Dimensionality>;
 	
-	auto operator()(const vector_type& v) const
+	constexpr auto operator()(const vector_type& v) const
 	{ return impl(v); }
 
 private:
 	template <std::size_t...Is>
-	static scalar_type impl(const vector_type& v, std::index_sequence<Is...>)
-	{ return idlib::plus_fold_expr()(std::abs(v[Is])...); }
+	static constexpr scalar_type impl(const vector_type& v, std::index_sequence<Is...>)
+	{ return idlib::plus_fold_expr()(abs_functor<scalar_type>()(v[Is])...); }
 
-	static scalar_type impl(const vector_type& v)
+	static constexpr scalar_type impl(const vector_type& v)
 	{ return impl(v, std::make_index_sequence<vector_type::dimensionality()>{}); }
 
 }; // struct manhattan_norm_functor
@@ -586,15 +592,15 @@ struct maximum_norm_functor<vector<Scalar, Dimensionality>>
 	using scalar_type = Scalar;
 	using vector_type = vector<scalar_type, Dimensionality>;
 	
-	auto operator()(const vector_type& v) const
+	constexpr auto operator()(const vector_type& v) const
 	{ return impl(v); }
 
 private:
 	template <std::size_t...Is>
-	static scalar_type impl(const vector_type& v, std::index_sequence<Is...>)
-	{ return variadic::max(std::abs(v[Is])...); }
+	static constexpr scalar_type impl(const vector_type& v, std::index_sequence<Is...>)
+	{ return variadic::max(abs_functor<scalar_type>()(v[Is])...); }
 
-	static scalar_type impl(const vector_type& v)
+	static constexpr scalar_type impl(const vector_type& v)
 	{ return impl(v, std::make_index_sequence<vector_type::dimensionality()>{}); }
 
 }; // struct maximum_norm_functor
@@ -660,21 +666,50 @@ private:
 
 }; // struct normalize_functor
 
+/// @brief Specialization of idlib::normalize_functor for idlib::fast_euclidean_norm_functor.
+/// Multiplies by the approximated reciprocal norm.
+template <typename Scalar, std::size_t Dimensionality, std::size_t Refinements>
+struct normalize_functor<vector<Scalar, Dimensionality>, fast_euclidean_norm_functor<vector<Scalar, Dimensionality>, Refinements>>
+{
+	using scalar_type = Scalar;
+	using vector_type = vector<scalar_type, Dimensionality>;
+	using norm_type = fast_euclidean_norm_functor<vector_type, Refinements>;
+	using result_type = normalization_result<scalar_type, Dimensionality>;
+
+	auto operator()(const vector_type& v, const norm_type&) const
+	{ return impl(v); }
+
+private:
+	static result_type impl(const vector_type& v)
+	{
+		auto s = v.m_implementation.inner_product(v.m_implementation);
+		if (s == zero<scalar_type>())
+		{
+			return result_type(v, s);
+		}
+		else
+		{
+			return result_type(v * internal::rsqrt_or_one<Refinements>(s), one<scalar_type>());
+		}
+	}
+
+}; // struct normalize_functor
+
 /// @brief Specialization of idlib::max_element_functor for idlib::vector<Scalar, Dimensionality> values.
 template <typename Scalar, std::size_t Dimensionality>
 struct max_element_functor<vector<Scalar, Dimensionality>>
 {
 	using vector_type = vector<Scalar, Dimensionality>;
 
-	auto operator()(const vector_type& v) const
+	constexpr auto operator()(const vector_type& v) const
 	{ return impl(v); }
 	
 private:
 	template<std::size_t...Is>
-	auto impl(const vector_type& v, std::index_sequence<Is...>) const
+	constexpr auto impl(const vector_type& v, std::index_sequence<Is...>) const
 	{ return variadic::max((v[Is])...); }
 
-	auto impl(const vector_type& v) const
+	constexpr auto impl(const vector_type& v) const
 	{ return impl(v, std::make_index_sequence<Dimensionality>{}); }
 	
 }; // struct max_element_functor
@@ -685,15 +720,15 @@ struct min_element_functor<vector<Scalar, Dimensionality>>
 {
 	using vector_type = vector<Scalar, Dimensionality>;
 
-	auto operator()(const vector_type& v) const
+	constexpr auto operator()(const vector_type& v) const
 	{ return impl(v); }
 
 private:
 	template<std::size_t...Is>
-	auto impl(const vector_type& v, std::index_sequence<Is...>) const
+	constexpr auto impl(const vector_type& v, std::index_sequence<Is...>) const
 	{ return variadic::min((v[Is])...); }
 
-	auto impl(const vector_type& v) const
+	constexpr auto impl(const vector_type& v) const
 	{ return impl(v, std::make_index_sequence<vector_type::dimensionality()>{}); }
 
 }; // struct min_element_functor
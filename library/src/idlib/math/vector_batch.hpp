@@ -0,0 +1,384 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/math/vector_batch.hpp
+/// @brief Batches of \f$n\f$-dimensional vectors in structure-of-arrays layout.
+/// @author Michael Heilmann
+
+#pragma once
+
+#include "idlib/math/vector.hpp"
+#include "idlib/math/batch_kernel.hpp"
+#include "idlib/utility/aligned_allocator.hpp"
+#include "idlib/utility/invalid_argument_error.hpp"
+#include <vector>
+
+namespace idlib {
+
+/// @ingroup math
+/// @brief A batch of vectors.
+/// @detail
+/// The vectors are stored in structure-of-arrays layout:
+/// The \f$i\f$-th components of all vectors are stored contiguously in an array aligned to a 64 Byte boundary.
+/// The bulk operations on batches (idlib::add, idlib::subtract, idlib::scale, idlib::dot_product, idlib::cross_product,
+/// idlib::euclidean_norm, idlib::normalize, idlib::min and idlib::max) operate on these arrays using SIMD instructions
+/// if available (see idlib::internal::batch_kernel).
+/// @remark Batches are <a href=http://en.cppreference.com/w/cpp/concept/DefaultConstructible">DefaultConstructible</a>.
+/// @tparam Scalar the scalar type
+/// @tparam Dimensionality the dimensionality
+template <typename Scalar, size_t Dimensionality>
+struct vector_batch
+{
+public:
+	/// @brief The scalar type.
+	using scalar_type = Scalar;
+
+	/// @brief The vector type.
+	using vector_type = vector<scalar_type, Dimensionality>;
+
+	/// @brief The type of this template/template specialization.
+	using vector_batch_type = vector_batch<scalar_type, Dimensionality>;
+
+	/// @brief The alignment in Bytes of the component arrays.
+	static constexpr size_t alignment = 64;
+
+	/// @brief The type of a component array.
+	using component_array_type = std::vector<scalar_type, aligned_allocator<scalar_type, alignment>>;
+
+	/// @brief Get the dimensionality.
+	/// @return the dimensionality
+	static constexpr size_t dimensionality()
+	{ return Dimensionality; }
+
+private:
+	/// @brief The component arrays.
+	component_array_type m_components[Dimensionality];
+
+public:
+	/// @brief Default-construct this batch.
+	/// @post This batch is empty.
+	vector_batch()
+	{ /* Intentionally empty. */ }
+
+	/// @brief Construct this batch with the specified number of zero vectors.
+	/// @param size the number of vectors
+	explicit vector_batch(size_t size)
+	{ resize(size); }
+
+	/// @brief Construct this batch from a sequence of vectors.
+	/// @param vectors the vectors
+	explicit vector_batch(const std::vector<vector_type>& vectors)
+	{ assign(vectors); }
+
+	vector_batch(const vector_batch&) = default;
+	vector_batch(vector_batch&&) = default;
+	vector_batch& operator=(const vector_batch&) = default;
+	vector_batch& operator=(vector_batch&&) = default;
+
+public:
+	/// @brief Get the number of vectors in this batch.
+	/// @return the number of vectors
+	size_t size() const
+	{ return m_components[0].size(); }
+
+	/// @brief Get if this batch is empty.
+	/// @return @a true if this batch is empty, @a false otherwise
+	bool empty() const
+	{ return m_components[0].empty(); }
+
+	/// @brief Get the number of vectors this batch can hold without reallocating.
+	/// @return the capacity
+	size_t capacity() const
+	{ return m_components[0].capacity(); }
+
+	/// @brief Reserve storage for the specified number of vectors.
+	/// @param capacity the number of vectors
+	void reserve(size_t capacity)
+	{
+		for (auto& c : m_components)
+		{ c.reserve(capacity); }
+	}
+
+	/// @brief Resize this batch to the specified number of vectors.
+	/// @param size the number of vectors
+	/// @post If the batch grows, the new vectors are zero vectors.
+	void resize(size_t size)
+	{
+		for (auto& c : m_components)
+		{ c.resize(size, zero<scalar_type>()); }
+	}
+
+	/// @brief Remove all vectors from this batch.
+	void clear()
+	{
+		for (auto& c : m_components)
+		{ c.clear(); }
+	}
+
+	/// @brief Append a vector to this batch.
+	/// @param v the vector
+	void push_back(const vector_type& v)
+	{
+		for (size_t j = 0; j < Dimensionality; ++j)
+		{ m_components[j].push_back(v[j]); }
+	}
+
+	/// @brief Get the vector at the specified index.
+	/// @param index the index
+	/// @return the vector
+	/// @pre The index is within bounds.
+	vector_type get(size_t index) const
+	{ return get(index, std::make_index_sequence<Dimensionality>{}); }
+
+	/// @brief Set the vector at the specified index.
+	/// @param index the index
+	/// @param v the vector
+	/// @pre The index is within bounds.
+	void set(size_t index, const vector_type& v)
+	{
+		for (size_t j = 0; j < Dimensionality; ++j)
+		{ m_components[j][index] = v[j]; }
+	}
+
+	/// @{
+	/// @brief Get a pointer to the array of the components of the specified index.
+	/// @param component the component index
+	/// @return a pointer to the array of size() component values
+	/// @pre The component index is smaller than the dimensionality.
+	scalar_type *data(size_t component)
+	{ return m_components[component].data(); }
+
+	const scalar_type *data(size_t component) const
+	{ return m_components[component].data(); }
+	/// @}
+
+public:
+	/// @brief Assign this batch the vectors of a sequence of vectors.
+	/// @param vectors the vectors
+	void assign(const std::vector<vector_type>& vectors)
+	{
+		resize(vectors.size());
+		for (size_t j = 0; j < Dimensionality; ++j)
+		{
+			auto *c = m_components[j].data();
+			for (size_t i = 0, n = vectors.size(); i < n; ++i)
+			{ c[i] = vectors[i][j]; }
+		}
+	}
+
+	/// @brief Get the vectors of this batch as a sequence of vectors.
+	/// @return the vectors
+	std::vector<vector_type> get_vectors() const
+	{
+		std::vector<vector_type> vectors(size());
+		for (size_t j = 0; j < Dimensionality; ++j)
+		{
+			const auto *c = m_components[j].data();
+			for (size_t i = 0, n = vectors.size(); i < n; ++i)
+			{ vectors[i][j] = c[i]; }
+		}
+		return vectors;
+	}
+
+private:
+	template <std::size_t...Is>
+	vector_type get(size_t index, std::index_sequence<Is...>) const
+	{ return vector_type(m_components[Is][index]...); }
+
+}; // struct vector_batch
+
+namespace internal {
+
+template <typename Scalar, size_t Dimensionality>
+void assert_same_size(const vector_batch<Scalar, Dimensionality>& a, const vector_batch<Scalar, Dimensionality>& b)
+{
+	if (a.size() != b.size())
+	{ throw invalid_argument_error(__FILE__, __LINE__, "batches are of different sizes"); }
+}
+
+} // namespace internal
+
+/// @brief Compute the component-wise sums of the vectors of two batches.
+/// @param a, b the batches
+/// @param r the batch to assign the sums \f$r_i = a_i + b_i\f$ to. May be @a a or @a b.
+/// @throw idlib::invalid_argument_error @a a and @a b are of different sizes
+template <typename Scalar, size_t Dimensionality>
+void add(const vector_batch<Scalar, Dimensionality>& a, const vector_batch<Scalar, Dimensionality>& b, vector_batch<Scalar, Dimensionality>& r)
+{
+	internal::assert_same_size(a, b);
+	r.resize(a.size());
+	for (size_t j = 0; j < Dimensionality; ++j)
+	{ internal::batch_kernel<Scalar>::add(a.data(j), b.data(j), r.data(j), a.size()); }
+}
+
+/// @brief Compute the component-wise differences of the vectors of two batches.
+/// @param a, b the batches
+/// @param r the batch to assign the differences \f$r_i = a_i - b_i\f$ to. May be @a a or @a b.
+/// @throw idlib::invalid_argument_error @a a and @a b are of different sizes
+template <typename Scalar, size_t Dimensionality>
+void subtract(const vector_batch<Scalar, Dimensionality>& a, const vector_batch<Scalar, Dimensionality>& b, vector_batch<Scalar, Dimensionality>& r)
+{
+	internal::assert_same_size(a, b);
+	r.resize(a.size());
+	for (size_t j = 0; j < Dimensionality; ++j)
+	{ internal::batch_kernel<Scalar>::subtract(a.data(j), b.data(j), r.data(j), a.size()); }
+}
+
+/// @brief Multiply the vectors of a batch by a scalar.
+/// @param a the batch
+/// @param s the scalar
+/// @param r the batch to assign the products \f$r_i = a_i s\f$ to. May be @a a.
+template <typename Scalar, size_t Dimensionality>
+void scale(const vector_batch<Scalar, Dimensionality>& a, const Scalar& s, vector_batch<Scalar, Dimensionality>& r)
+{
+	r.resize(a.size());
+	for (size_t j = 0; j < Dimensionality; ++j)
+	{ internal::batch_kernel<Scalar>::multiply(a.data(j), s, r.data(j), a.size()); }
+}
+
+/// @brief Compute the dot products of the vectors of two batches.
+/// @param a, b the batches
+/// @param r the sequence to assign the dot products \f$r_i = a_i \cdot b_i\f$ to
+/// @throw idlib::invalid_argument_error @a a and @a b are of different sizes
+/// @remark The results are bit-identical to the results of idlib::dot_product for idlib::vector values.
+template <typename Scalar, size_t Dimensionality>
+void dot_product(const vector_batch<Scalar, Dimensionality>& a, const vector_batch<Scalar, Dimensionality>& b, std::vector<Scalar>& r)
+{
+	internal::assert_same_size(a, b);
+	r.resize(a.size());
+	// Sum right-to-left like idlib::plus_fold_expr.
+	internal::batch_kernel<Scalar>::multiply(a.data(Dimensionality - 1), b.data(Dimensionality - 1), r.data(), a.size());
+	for (size_t j = Dimensionality - 1; j > 0; --j)
+	{ internal::batch_kernel<Scalar>::multiply_add(a.data(j - 1), b.data(j - 1), r.data(), a.size()); }
+}
+
+/// @brief Compute the cross products of the vectors of two batches of 3-dimensional vectors.
+/// @param a, b the batches
+/// @param r the batch to assign the cross products \f$r_i = a_i \times b_i\f$ to. Must not be @a a or @a b.
+/// @throw idlib::invalid_argument_error @a a and @a b are of different sizes or @a r is @a a or @a b
+template <typename Scalar>
+void cross_product(const vector_batch<Scalar, 3>& a, const vector_batch<Scalar, 3>& b, vector_batch<Scalar, 3>& r)
+{
+	internal::assert_same_size(a, b);
+	if (&r == &a || &r == &b)
+	{ throw invalid_argument_error(__FILE__, __LINE__, "result batch is an argument batch"); }
+	r.resize(a.size());
+	const auto *ax = a.data(0), *ay = a.data(1), *az = a.data(2);
+	const auto *bx = b.data(0), *by = b.data(1), *bz = b.data(2);
+	using kernel = internal::batch_kernel<Scalar>;
+	kernel::multiply_subtract(ay, bz, az, by, r.data(0), a.size());
+	kernel::multiply_subtract(az, bx, ax, bz, r.data(1), a.size());
+	kernel::multiply_subtract(ax, by, ay, bx, r.data(2), a.size());
+}
+
+/// @brief Compute the Euclidean norms of the vectors of a batch.
+/// @param a the batch
+/// @param r the sequence to assign the Euclidean norms \f$r_i = |a_i|\f$ to
+/// @remark The results are bit-identical to the results of idlib::euclidean_norm for idlib::vector values.
+template <typename Scalar, size_t Dimensionality>
+void euclidean_norm(const vector_batch<Scalar, Dimensionality>& a, std::vector<Scalar>& r)
+{
+	dot_product(a, a, r);
+	internal::batch_kernel<Scalar>::sqrt(r.data(), r.data(), r.size());
+}
+
+/// @brief Normalize the vectors of a batch with respect to the Euclidean norm.
+/// @param a the batch
+/// @param r the batch to assign the normalized vectors \f$r_i = \frac{a_i}{|a_i|}\f$ to. May be @a a.
+/// @remark Zero vectors are retained i.e. if \f$|a_i| = 0\f$ then \f$r_i = a_i\f$.
+/// This corresponds to idlib::normalization_result::get_vector_or_default.
+/// @remark The results are bit-identical to the results of idlib::normalize for idlib::vector values and idlib::euclidean_norm_functor.
+template <typename Scalar, size_t Dimensionality>
+void normalize(const vector_batch<Scalar, Dimensionality>& a, vector_batch<Scalar, Dimensionality>& r)
+{
+	std::vector<Scalar> l;
+	euclidean_norm(a, l);
+	r.resize(a.size());
+	for (size_t j = 0; j < Dimensionality; ++j)
+	{ internal::batch_kernel<Scalar>::divide_or_retain(a.data(j), l.data(), r.data(j), a.size()); }
+}
+
+/// @brief Compute approximations of the Euclidean norms of the vectors of a batch.
+/// @param a the batch
+/// @param r the sequence to assign the approximated Euclidean norms to
+/// @remark The third argument selects the norm policy.
+/// @remark The results are bit-identical to the results of idlib::fast_euclidean_norm_functor for idlib::vector values.
+template <typename Scalar, size_t Dimensionality, size_t Refinements>
+void euclidean_norm(const vector_batch<Scalar, Dimensionality>& a, std::vector<Scalar>& r,
+                    const fast_euclidean_norm_functor<vector<Scalar, Dimensionality>, Refinements>&)
+{
+	std::vector<Scalar> y;
+	dot_product(a, a, r);
+	y.resize(r.size());
+	internal::batch_kernel<Scalar>::template rsqrt_or_one<Refinements>(r.data(), y.data(), r.size());
+	internal::batch_kernel<Scalar>::multiply(r.data(), y.data(), r.data(), r.size());
+}
+
+/// @brief Normalize the vectors of a batch with respect to an approximation of the Euclidean norm.
+/// @param a the batch
+/// @param r the batch to assign the normalized vectors to. May be @a a.
+/// @remark The third argument selects the norm policy.
+/// @remark Zero vectors are retained.
+/// @remark The results are bit-identical to the results of idlib::normalize for idlib::vector values and idlib::fast_euclidean_norm_functor.
+template <typename Scalar, size_t Dimensionality, size_t Refinements>
+void normalize(const vector_batch<Scalar, Dimensionality>& a, vector_batch<Scalar, Dimensionality>& r,
+               const fast_euclidean_norm_functor<vector<Scalar, Dimensionality>, Refinements>&)
+{
+	std::vector<Scalar> y;
+	dot_product(a, a, y);
+	internal::batch_kernel<Scalar>::template rsqrt_or_one<Refinements>(y.data(), y.data(), y.size());
+	r.resize(a.size());
+	for (size_t j = 0; j < Dimensionality; ++j)
+	{ internal::batch_kernel<Scalar>::multiply(a.data(j), y.data(), r.data(j), a.size()); }
+}
+
+/// @brief Compute the component-wise minima of the vectors of two batches.
+/// @param a, b the batches
+/// @param r the batch to assign the component-wise minima to. May be @a a or @a b.
+/// @throw idlib::invalid_argument_error @a a and @a b are of different sizes
+/// @remark The results are identical to the results of idlib::vector::min.
+template <typename Scalar, size_t Dimensionality>
+void min(const vector_batch<Scalar, Dimensionality>& a, const vector_batch<Scalar, Dimensionality>& b, vector_batch<Scalar, Dimensionality>& r)
+{
+	internal::assert_same_size(a, b);
+	r.resize(a.size());
+	for (size_t j = 0; j < Dimensionality; ++j)
+	{ internal::batch_kernel<Scalar>::min(a.data(j), b.data(j), r.data(j), a.size()); }
+}
+
+/// @brief Compute the component-wise maxima of the vectors of two batches.
+/// @param a, b the batches
+/// @param r the batch to assign the component-wise maxima to. May be @a a or @a b.
+/// @throw idlib::invalid_argument_error @a a and @a b are of different sizes
+/// @remark The results are identical to the results of idlib::vector::max.
+template <typename Scalar, size_t Dimensionality>
+void max(const vector_batch<Scalar, Dimensionality>& a, const vector_batch<Scalar, Dimensionality>& b, vector_batch<Scalar, Dimensionality>& r)
+{
+	internal::assert_same_size(a, b);
+	r.resize(a.size());
+	for (size_t j = 0; j < Dimensionality; ++j)
+	{ internal::batch_kernel<Scalar>::max(a.data(j), b.data(j), r.data(j), a.size()); }
+}
+
+} // namespace idlib
@@ -33,6 +33,7 @@
 #define IDLIB_PRIVATE (1)
 
 #include "idlib/range/iterator_range.hpp"
+#include "idlib/range/span.hpp"
 
 #undef IDLIB_PRIVATE
 #pragma pop_macro("IDLIB_PRIVATE")
@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/range/span.hpp
+/// @brief A non-owning view of a contiguous sequence of objects.
+/// @author Michael Heilmann
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/range.hpp` instead)
+#endif
+
+#include "idlib/utility/platform.hpp"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "idlib/range/header.in"
+
+/// @brief A non-owning view of a contiguous sequence of objects.
+/// @tparam T the element type. May be const-qualified.
+/// @DefaultConstructible
+/// @CopyConstructible
+template <typename T>
+struct span
+{
+public:
+	using element_type = T;
+	using value_type = std::remove_cv_t<T>;
+	using iterator_type = T *;
+
+private:
+	T *m_data;
+	std::size_t m_size;
+
+public:
+	/// @brief Default construct this span.
+	/// @post This span is empty.
+	span() :
+		m_data(nullptr), m_size(0)
+	{}
+
+	/// @brief Construct this span.
+	/// @param data a pointer to the first element
+	/// @param size the number of elements
+	span(T *data, std::size_t size) :
+		m_data(data), m_size(size)
+	{}
+
+	/// @brief Construct this span from a std::vector.
+	/// @param v the std::vector
+	template <typename Allocator>
+	span(std::vector<value_type, Allocator>& v) :
+		m_data(v.data()), m_size(v.size())
+	{}
+
+	/// @brief Construct this span from a std::vector.
+	/// @param v the std::vector
+	template <typename Allocator, typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+	span(const std::vector<value_type, Allocator>& v) :
+		m_data(v.data()), m_size(v.size())
+	{}
+
+	/// @brief Construct this span from an array.
+	/// @param a the array
+	template <std::size_t N>
+	span(T (&a)[N]) :
+		m_data(a), m_size(N)
+	{}
+
+	/// @brief Construct a span of const elements from a span of non-const elements.
+	/// @param other the other span
+	template <typename U, typename = std::enable_if_t<std::is_same<const U, T>::value>>
+	span(const span<U>& other) :
+		m_data(other.data()), m_size(other.size())
+	{}
+
+	span(const span&) = default;
+	span& operator=(const span&) = default;
+
+	/// @brief Get a pointer to the first element.
+	/// @return a pointer to the first element
+	T *data() const { return m_data; }
+
+	/// @brief Get the number of elements.
+	/// @return the number of elements
+	std::size_t size() const { return m_size; }
+
+	/// @brief Get if this span is empty.
+	/// @return @a true if this span is empty, @a false otherwise
+	bool empty() const { return 0 == m_size; }
+
+	/// @brief Get the element at the specified index.
+	/// @param index the index
+	/// @return a reference to the element
+	/// @pre The index is within bounds.
+	T& operator[](std::size_t index) const { return m_data[index]; }
+
+	/// @brief Get a subspan of this span.
+	/// @param offset the index of the first element of the subspan
+	/// @param count the number of elements of the subspan
+	/// @return the subspan
+	/// @pre <c>offset + count <= size()</c>
+	span subspan(std::size_t offset, std::size_t count) const { return span(m_data + offset, count); }
+
+	/// @{
+	/// @brief Get the iterator to the beginning.
+	/// @return the iterator to the beginning
+	iterator_type begin() const { return m_data; }
+	iterator_type cbegin() const { return m_data; }
+	/// @}
+
+	/// @{
+	/// @brief Get the iterator to the end.
+	/// @return the iterator to the end
+	iterator_type end() const { return m_data + m_size; }
+	iterator_type cend() const { return m_data + m_size; }
+	/// @}
+};
+
+/// @brief Create a span.
+/// @param data a pointer to the first element
+/// @param size the number of elements
+/// @return the span
+template <typename T>
+span<T> make_span(T *data, std::size_t size)
+{
+	return span<T>(data, size);
+}
+
+#include "idlib/range/footer.in"
@@ -49,7 +49,7 @@ struct convert<clamped_single_traits, uint8_traits>
 {
     clamped_single_traits::underlying_type operator()(const uint8_traits::underlying_type& source) const
     {
-        return std::max(std::min(clamped_single_traits::underlying_type(source) * 255.0f, 1.0f), 0.0f);
+        return std::max(std::min(clamped_single_traits::underlying_type(source) / 255.0f, 1.0f), 0.0f);
     }
 };
 
@@ -79,7 +79,7 @@ struct convert<clamped_double_traits, uint8_traits>
 {
     clamped_double_traits::underlying_type operator()(const uint8_traits::underlying_type& source) const
     {
-        return std::max(std::min(clamped_double_traits::underlying_type(source) * 255.0, 1.0), 0.0);
+        return std::max(std::min(clamped_double_traits::underlying_type(source) / 255.0, 1.0), 0.0);
     }
 };
 
@@ -41,6 +41,10 @@
 
 #include "idlib/utility/non_copyable.hpp"
 
+#include "idlib/utility/aligned_allocator.hpp"
+
+#include "idlib/utility/parallel_for.hpp"
+
 #include "idlib/utility/bitmask_type.hpp"
 
 #include "idlib/utility/exception.hpp"
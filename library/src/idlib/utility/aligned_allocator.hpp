@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/utility/aligned_allocator.hpp
+/// @brief An allocator for over-aligned storage.
+/// @author Michael Heilmann
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/idlib.hpp` instead)
+#endif
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "idlib/utility/header.in"
+
+/// @brief An allocator allocating storage aligned to a specified boundary.
+/// @detail Example usage
+/// @code
+/// std::vector<float, aligned_allocator<float, 64>> x;
+/// @endcode
+/// @tparam T the value type
+/// @tparam Alignment the alignment in Bytes. Must be a power of two and must not be smaller than the alignment of @a T.
+template <typename T, std::size_t Alignment>
+struct aligned_allocator
+{
+	static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+	static_assert(Alignment >= alignof(T), "alignment must not be smaller than the alignment of the value type");
+
+	/// @brief The value type.
+	using value_type = T;
+
+	/// @brief The alignment in Bytes.
+	static constexpr std::size_t alignment = Alignment;
+
+	template <typename U>
+	struct rebind
+	{ using other = aligned_allocator<U, Alignment>; };
+
+	aligned_allocator() noexcept = default;
+
+	template <typename U>
+	aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept
+	{}
+
+	/// @brief Allocate storage for the specified number of values.
+	/// @param n the number of values
+	/// @return a pointer to the storage
+	/// @throw std::bad_array_new_length the size of the storage in Bytes is not representable by std::size_t
+	/// @throw std::bad_alloc the allocation failed
+	T *allocate(std::size_t n)
+	{
+		if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+		{ throw std::bad_array_new_length(); }
+		return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+	}
+
+	/// @brief Deallocate storage allocated by this allocator.
+	/// @param p a pointer to the storage
+	/// @param n the number of values
+	void deallocate(T *p, std::size_t n) noexcept
+	{ ::operator delete(p, std::align_val_t(Alignment)); }
+
+	template <typename U>
+	bool operator==(const aligned_allocator<U, Alignment>&) const noexcept
+	{ return true; }
+
+	template <typename U>
+	bool operator!=(const aligned_allocator<U, Alignment>&) const noexcept
+	{ return false; }
+
+}; // struct aligned_allocator
+
+#include "idlib/utility/footer.in"
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @file idlib/utility/parallel_for.hpp
+/// @brief Minimal fork-join helpers for the bulk algorithms of Idlib.
+/// @author Michael Heilmann
+
+#pragma once
+
+#if !defined(IDLIB_PRIVATE) || IDLIB_PRIVATE != 1
+#error(do not include directly, include `idlib/idlib.hpp` instead)
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "idlib/utility/header.in"
+
+/// @brief Get the default number of threads of the bulk algorithms.
+/// @return the number of hardware threads, at least one
+inline std::size_t get_default_thread_count()
+{ return std::max<std::size_t>(1, std::thread::hardware_concurrency()); }
+
+/// @brief Invoke a function for disjoint subranges of a range of indices.
+/// @param begin, end the range of indices
+/// @param grain the minimal number of indices of a subrange
+/// @param thread_count the maximal number of threads to use, @a 0 selects idlib::get_default_thread_count()
+/// @param f a function invoked as <c>f(b, e, k)</c> for each subrange <c>[b, e)</c>,
+/// where @a k is the index of the subrange. The subranges are contiguous, ordered by @a k and cover the range.
+/// @return the number of subranges
+/// @remark The first subrange is processed by the calling thread.
+/// If a thread can not be started, the subranges of that thread and of all subsequent threads are processed by the calling thread.
+/// If @a f throws, the exception of the subrange with the smallest index is rethrown after all threads have terminated.
+template <typename F>
+std::size_t parallel_for(std::size_t begin, std::size_t end, std::size_t grain, std::size_t thread_count, F&& f)
+{
+	if (end <= begin) return 0;
+	if (thread_count == 0) thread_count = get_default_thread_count();
+	const std::size_t n = end - begin;
+	const std::size_t k = std::max<std::size_t>(1, std::min(thread_count, n / std::max<std::size_t>(1, grain)));
+	if (k == 1)
+	{
+		f(begin, end, std::size_t(0));
+		return 1;
+	}
+	std::vector<std::exception_ptr> errors(k);
+	std::vector<std::thread> threads;
+	threads.reserve(k - 1);
+	auto run = [&](std::size_t i)
+	{
+		try
+		{ f(begin + n * i / k, begin + n * (i + 1) / k, i); }
+		catch (...)
+		{ errors[i] = std::current_exception(); }
+	};
+	std::size_t started = 1;
+	try
+	{
+		for (; started < k; ++started)
+		{ threads.emplace_back(run, started); }
+	}
+	catch (const std::system_error&)
+	{}
+	run(0);
+	for (std::size_t i = started; i < k; ++i)
+	{ run(i); }
+	for (auto& thread : threads)
+	{ thread.join(); }
+	for (auto& error : errors)
+	{
+		if (error) std::rethrow_exception(error);
+	}
+	return k;
+}
+
+/// @brief Invoke two functions concurrently.
+/// @param f the function invoked by a new thread
+/// @param g the function invoked by the calling thread
+/// @remark If a function throws, its exception is rethrown after both functions have returned.
+/// The exception of @a f takes precedence.
+/// If the thread can not be started, @a f is invoked by the calling thread before @a g.
+template <typename F, typename G>
+void parallel_invoke(F&& f, G&& g)
+{
+	std::exception_ptr error;
+	const auto h = [&]()
+	{
+		try
+		{ f(); }
+		catch (...)
+		{ error = std::current_exception(); }
+	};
+	std::thread thread;
+	try
+	{ thread = std::thread(h); }
+	catch (const std::system_error&)
+	{
+		h();
+		try
+		{ g(); }
+		catch (...)
+		{
+			if (error) std::rethrow_exception(error);
+			throw;
+		}
+		if (error) std::rethrow_exception(error);
+		return;
+	}
+	try
+	{ g(); }
+	catch (...)
+	{
+		thread.join();
+		if (error) std::rethrow_exception(error);
+		throw;
+	}
+	thread.join();
+	if (error) std::rethrow_exception(error);
+}
+
+#include "idlib/utility/footer.in"
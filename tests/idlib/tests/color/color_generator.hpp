@@ -25,6 +25,9 @@
 #pragma once
 
 #include "idlib/idlib.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace idlib { namespace tests { namespace color {
 
@@ -67,4 +70,62 @@ struct color_generator<S, std::enable_if_t<idlib::is_any_of<S, idlib::Lb, idlib:
     }
 };
 
+/// @brief The component syntax of a color space.
+template <typename S>
+using syntax_t = typename idlib::internal::component_syntax<S>::type;
+
+/// @brief Get the component values of a color.
+template <typename S>
+std::vector<typename syntax_t<S>::underlying_type> get_component_values(const idlib::color<S>& x)
+{
+    if constexpr (idlib::internal::is_l<S>::value) return { x.get_l() };
+    else if constexpr (idlib::internal::is_la<S>::value) return { x.get_l(), x.get_a() };
+    else if constexpr (idlib::internal::is_rgb<S>::value) return { x.get_r(), x.get_g(), x.get_b() };
+    else return { x.get_r(), x.get_g(), x.get_b(), x.get_a() };
+}
+
+/// @brief Create a color from component values.
+template <typename S>
+idlib::color<S> make_color(const typename syntax_t<S>::underlying_type *c)
+{
+    if constexpr (idlib::internal::is_l<S>::value) return idlib::color<S>(c[0]);
+    else if constexpr (idlib::internal::is_la<S>::value) return idlib::color<S>(c[0], c[1]);
+    else if constexpr (idlib::internal::is_rgb<S>::value) return idlib::color<S>(c[0], c[1], c[2]);
+    else return idlib::color<S>(c[0], c[1], c[2], c[3]);
+}
+
+/// @brief Create random colors.
+/// Clamped single component values include the values at and next to the boundaries of the uint8 conversion.
+template <typename S>
+std::vector<idlib::color<S>> random_colors(idlib::rng& rng, std::size_t n)
+{
+    using component_type = typename syntax_t<S>::underlying_type;
+    std::vector<component_type> special;
+    if constexpr (std::is_same<component_type, single>::value)
+    {
+        for (int k = 0; k <= 256; ++k)
+        {
+            const single v = static_cast<single>(k) / 256.0f;
+            special.push_back(std::min(v, 1.0f));
+            special.push_back(std::nextafter(std::min(v, 1.0f), 0.0f));
+        }
+    }
+    std::vector<component_type> c(n * S::count);
+    for (auto& v : c)
+    {
+        if constexpr (std::is_same<component_type, single>::value)
+        {
+            v = rng.next(idlib::interval<int>(0, 1)) == 0
+              ? special[rng.next(idlib::interval<int>(0, int(special.size()) - 1))]
+              : idlib::random<single>(&rng, idlib::interval<single>(0.0f, 1.0f));
+        }
+        else
+        { v = static_cast<component_type>(rng.next(idlib::interval<int>(0, 255))); }
+    }
+    std::vector<idlib::color<S>> colors;
+    for (std::size_t i = 0; i < n; ++i)
+    { colors.push_back(make_color<S>(c.data() + i * S::count)); }
+    return colors;
+}
+
 } } } // namespace idlib::tests::color
@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "gtest/gtest.h"
+#include "idlib/tests/color/color_generator.hpp"
+
+namespace idlib { namespace tests { namespace color {
+
+namespace composite {
+
+using operator_type = idlib::composite_operator;
+
+static const operator_type operators[] =
+{
+    operator_type::over,
+    operator_type::in,
+    operator_type::out,
+    operator_type::atop,
+    operator_type::exclusive_or,
+    operator_type::multiply,
+    operator_type::screen,
+    operator_type::add,
+};
+
+/// @brief The value of a component composited by an operator, computed in double precision without clamping.
+/// @param s, d the source and destination component values
+/// @param as, ad the source and destination alpha values
+/// @param one the value of maximal intensity
+static double reference(operator_type op, double s, double d, double as, double ad, double one)
+{
+    switch (op)
+    {
+        case operator_type::over: return s + d * (one - as) / one;
+        case operator_type::in: return s * ad / one;
+        case operator_type::out: return s * (one - ad) / one;
+        case operator_type::atop: return (s * ad + d * (one - as)) / one;
+        case operator_type::exclusive_or: return (s * (one - ad) + d * (one - as)) / one;
+        case operator_type::multiply: return (s * d + s * (one - ad) + d * (one - as)) / one;
+        case operator_type::screen: return s + d - s * d / one;
+        case operator_type::add: return std::min(s + d, one);
+        default: throw std::logic_error("unreachable code reached");
+    };
+}
+
+/// @brief The maximal distance of a uint8 result of an operator from the exact value.
+static double tolerance(operator_type op)
+{
+    switch (op)
+    {
+        case operator_type::atop: case operator_type::exclusive_or: return 1.0;
+        case operator_type::multiply: return 1.5;
+        default: return 0.5;
+    };
+}
+
+/// @brief Create random colors with premultiplied alpha.
+template <typename S>
+std::vector<idlib::color<S>> random_premultiplied_colors(idlib::rng& rng, std::size_t n)
+{
+    auto x = random_colors<S>(rng, n);
+    idlib::premultiply<S>(x, x);
+    return x;
+}
+
+/// @brief Assert the compositing of uint8 colors is the compositing of the component values within the tolerance of the operator.
+void check_uint8(operator_type op, std::size_t n, std::size_t thread_count)
+{
+    using S = idlib::RGBAb;
+    idlib::rng rng(2018);
+    const auto x = random_premultiplied_colors<S>(rng, n), y = random_premultiplied_colors<S>(rng, n);
+    std::vector<idlib::color<S>> z(n);
+    idlib::composite<S>(op, x, y, z, thread_count);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto a = get_component_values(x[i]), b = get_component_values(y[i]), c = get_component_values(z[i]);
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            const double e = std::min(std::max(reference(op, a[k], b[k], a[3], b[3], 255.0), 0.0), 255.0);
+            ASSERT_LE(std::abs(c[k] - e), tolerance(op)) << "operator " << int(op) << ", color " << i << ", component " << k;
+        }
+    }
+}
+
+/// @brief Assert the compositing of clamped single colors is the compositing of the component values.
+void check_single(operator_type op, std::size_t n, std::size_t thread_count)
+{
+    using S = idlib::RGBAf;
+    idlib::rng rng(2018);
+    const auto x = random_premultiplied_colors<S>(rng, n), y = random_premultiplied_colors<S>(rng, n);
+    std::vector<idlib::color<S>> z(n);
+    idlib::composite<S>(op, x, y, z, thread_count);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto a = get_component_values(x[i]), b = get_component_values(y[i]), c = get_component_values(z[i]);
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            const double e = std::min(std::max(reference(op, a[k], b[k], a[3], b[3], 1.0), 0.0), 1.0);
+            ASSERT_NEAR(c[k], e, 1.0e-6) << "operator " << int(op) << ", color " << i << ", component " << k;
+        }
+    }
+}
+
+TEST(composite, uint8)
+{
+    for (auto op : operators)
+    { check_uint8(op, 1031, 1); }
+}
+
+TEST(composite, single)
+{
+    for (auto op : operators)
+    { check_single(op, 1031, 1); }
+}
+
+TEST(composite, over_opaque_and_transparent)
+{
+    idlib::rng rng(2018);
+    auto x = random_premultiplied_colors<idlib::RGBAb>(rng, 1031);
+    const auto y = random_premultiplied_colors<idlib::RGBAb>(rng, 1031);
+    std::vector<idlib::color<idlib::RGBAb>> z(x.size());
+    for (auto& c : x) c = idlib::color<idlib::RGBAb>(c.get_r(), c.get_g(), c.get_b(), 255);
+    idlib::composite<idlib::RGBAb>(operator_type::over, x, y, z);
+    ASSERT_EQ(z, x);
+    for (auto& c : x) c = idlib::color<idlib::RGBAb>(0, 0, 0, 0);
+    idlib::composite<idlib::RGBAb>(operator_type::over, x, y, z);
+    ASSERT_EQ(z, y);
+}
+
+TEST(composite, in_place_and_parallel)
+{
+    const std::size_t n = 3 * idlib::internal::composite_grain + 17;
+    check_uint8(operator_type::over, n, 4);
+    check_single(operator_type::multiply, n, 4);
+    idlib::rng rng(2018);
+    auto x = random_premultiplied_colors<idlib::RGBAf>(rng, 1031);
+    const auto y = random_premultiplied_colors<idlib::RGBAf>(rng, 1031), u = x;
+    std::vector<idlib::color<idlib::RGBAf>> z(x.size());
+    idlib::composite<idlib::RGBAf>(operator_type::screen, x, y, z);
+    idlib::composite<idlib::RGBAf>(operator_type::screen, x, y, x);
+    ASSERT_EQ(x, z);
+}
+
+TEST(composite, errors)
+{
+    std::vector<idlib::color<idlib::RGBAf>> x(3), y(2), z(3);
+    ASSERT_THROW((idlib::composite<idlib::RGBAf>(operator_type::over, x, y, z)), idlib::invalid_argument_error);
+    ASSERT_THROW((idlib::composite<idlib::RGBAf>(static_cast<operator_type>(-1), x, x, z)), idlib::invalid_argument_error);
+    ASSERT_THROW((idlib::premultiply<idlib::RGBAf>(x, y)), idlib::invalid_argument_error);
+    ASSERT_THROW((idlib::unpremultiply<idlib::RGBAf>(x, y)), idlib::invalid_argument_error);
+}
+
+TEST(premultiply, uint8)
+{
+    // All pairs of a component value and an alpha value.
+    std::vector<idlib::color<idlib::RGBAb>> x;
+    for (int a = 0; a < 256; ++a)
+    {
+        for (int c = 0; c < 256; ++c)
+        { x.push_back(idlib::color<idlib::RGBAb>(c, 255 - c, c, a)); }
+    }
+    std::vector<idlib::color<idlib::RGBAb>> y(x.size()), z(x.size());
+    idlib::premultiply<idlib::RGBAb>(x, y);
+    idlib::unpremultiply<idlib::RGBAb>(y, z);
+    const auto exact = [](int c, int a) { return static_cast<int>(std::floor(c * a / 255.0 + 0.5)); };
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        const int a = x[i].get_a();
+        ASSERT_EQ(y[i].get_a(), a);
+        ASSERT_EQ(y[i].get_r(), exact(x[i].get_r(), a)) << i;
+        ASSERT_EQ(y[i].get_g(), exact(x[i].get_g(), a)) << i;
+        ASSERT_EQ(z[i].get_a(), a);
+        // Unpremultiplying is exactly rounded for all component values not greater than the alpha value.
+        const int r = y[i].get_r(), g = y[i].get_g();
+        ASSERT_EQ(z[i].get_r(), a == 0 ? 0 : static_cast<int>(std::floor(r * 255.0 / a + 0.5))) << i;
+        ASSERT_EQ(z[i].get_g(), a == 0 ? 0 : static_cast<int>(std::floor(g * 255.0 / a + 0.5))) << i;
+        if (a == 255)
+        { ASSERT_EQ(z[i], x[i]); }
+    }
+}
+
+TEST(premultiply, single)
+{
+    idlib::rng rng(2018);
+    const auto x = random_colors<idlib::RGBAf>(rng, 1031);
+    std::vector<idlib::color<idlib::RGBAf>> y(x.size()), z(x.size());
+    idlib::premultiply<idlib::RGBAf>(x, y);
+    idlib::unpremultiply<idlib::RGBAf>(y, z);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        const single a = x[i].get_a();
+        ASSERT_EQ(y[i], idlib::color<idlib::RGBAf>(x[i].get_r() * a, x[i].get_g() * a, x[i].get_b() * a, a));
+        if (a > 0.0f)
+        {
+            const auto& v = y[i];
+            ASSERT_EQ(z[i], idlib::color<idlib::RGBAf>(std::min(v.get_r() / a, 1.0f), std::min(v.get_g() / a, 1.0f), std::min(v.get_b() / a, 1.0f), a));
+        }
+        else
+        { ASSERT_EQ(z[i], idlib::color<idlib::RGBAf>(0.0f, 0.0f, 0.0f, 0.0f)); }
+    }
+}
+
+} // namespace composite
+
+} } } // namespace idlib::tests::color
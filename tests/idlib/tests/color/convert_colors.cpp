@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "gtest/gtest.h"
+#include "idlib/tests/color/color_generator.hpp"
+
+namespace idlib { namespace tests { namespace color {
+
+namespace convert_colors {
+
+/// @brief Get the color space with the same components as a color space but with the other component syntax.
+template <typename S> struct other_syntax;
+template <> struct other_syntax<idlib::Lb> { using type = idlib::Lf; };
+template <> struct other_syntax<idlib::Lf> { using type = idlib::Lb; };
+template <> struct other_syntax<idlib::LAb> { using type = idlib::LAf; };
+template <> struct other_syntax<idlib::LAf> { using type = idlib::LAb; };
+template <> struct other_syntax<idlib::RGBb> { using type = idlib::RGBf; };
+template <> struct other_syntax<idlib::RGBf> { using type = idlib::RGBb; };
+template <> struct other_syntax<idlib::RGBAb> { using type = idlib::RGBAf; };
+template <> struct other_syntax<idlib::RGBAf> { using type = idlib::RGBAb; };
+
+/// @brief Convert a color to a color of the same syntax using the constructors of the colors.
+template <typename T, typename S>
+idlib::color<T> reshape(const idlib::color<S>& x)
+{
+    using C = idlib::color<T>;
+    if constexpr (std::is_same<T, S>::value)
+    { return x; }
+    else if constexpr (T::has_a && !S::has_a)
+    { return C(reshape<idlib::pure_color_space_t<T>>(x), syntax_t<T>::range().max()); }
+    else if constexpr (!T::has_a && S::has_a)
+    { return reshape<T>(idlib::color<idlib::pure_color_space_t<S>>(x)); }
+    else
+    { return C(x); }
+}
+
+/// @brief Convert a color using the constructors of the colors.
+template <typename T, typename S>
+idlib::color<T> reference(const idlib::color<S>& x)
+{
+    if constexpr (std::is_same<syntax_t<T>, syntax_t<S>>::value)
+    { return reshape<T>(x); }
+    else
+    { return reshape<T>(idlib::color<typename other_syntax<S>::type>(x)); }
+}
+
+/// @brief Assert the span conversion is identical to the conversion by the constructors of the colors.
+template <typename T, typename S>
+void check(std::size_t n, std::size_t thread_count)
+{
+    idlib::rng rng(2018);
+    const auto x = random_colors<S>(rng, n);
+    std::vector<idlib::color<T>> y(n);
+    idlib::convert_colors<T, S>(x, y, thread_count);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto a = get_component_values(y[i]), b = get_component_values(reference<T>(x[i]));
+        for (std::size_t k = 0; k < a.size(); ++k)
+        { ASSERT_EQ(a[k], b[k]) << "color " << i << ", component " << k; }
+    }
+}
+
+/// @brief Check the conversions from a source color space to all target color spaces it can be converted to.
+template <typename S>
+void check_all(std::size_t n, std::size_t thread_count)
+{
+    check<idlib::Lb, S>(n, thread_count);
+    check<idlib::Lf, S>(n, thread_count);
+    check<idlib::LAb, S>(n, thread_count);
+    check<idlib::LAf, S>(n, thread_count);
+    check<idlib::RGBb, S>(n, thread_count);
+    check<idlib::RGBf, S>(n, thread_count);
+    check<idlib::RGBAb, S>(n, thread_count);
+    check<idlib::RGBAf, S>(n, thread_count);
+}
+
+template <typename S>
+void check_all_rgb(std::size_t n, std::size_t thread_count)
+{
+    check<idlib::RGBb, S>(n, thread_count);
+    check<idlib::RGBf, S>(n, thread_count);
+    check<idlib::RGBAb, S>(n, thread_count);
+    check<idlib::RGBAf, S>(n, thread_count);
+}
+
+TEST(convert_colors, from_l)
+{
+    check_all<idlib::Lb>(1031, 1);
+    check_all<idlib::Lf>(1031, 1);
+}
+
+TEST(convert_colors, from_la)
+{
+    check_all<idlib::LAb>(1031, 1);
+    check_all<idlib::LAf>(1031, 1);
+}
+
+TEST(convert_colors, from_rgb)
+{
+    check_all_rgb<idlib::RGBb>(1031, 1);
+    check_all_rgb<idlib::RGBf>(1031, 1);
+}
+
+TEST(convert_colors, from_rgba)
+{
+    check_all_rgb<idlib::RGBAb>(1031, 1);
+    check_all_rgb<idlib::RGBAf>(1031, 1);
+}
+
+TEST(convert_colors, uint8_table)
+{
+    // The table must reproduce the scalar conversion for every uint8 value.
+    const auto& table = idlib::internal::get_uint8_to_clamped_single_table();
+    for (int i = 0; i < 256; ++i)
+    {
+        const single v = idlib::type::convert<idlib::type::clamped_single_traits, idlib::type::uint8_traits>()(static_cast<std::uint8_t>(i));
+        ASSERT_EQ(table[i], v);
+    }
+}
+
+TEST(convert_colors, uint8_values)
+{
+    // uint8 values are mapped to the quotient of the value and 255.
+    const auto& table = idlib::internal::get_uint8_to_clamped_single_table();
+    for (int i = 0; i < 256; ++i)
+    { ASSERT_EQ(table[i], static_cast<single>(i) / 255.0f) << i; }
+    ASSERT_EQ(table[0], 0.0f);
+    ASSERT_EQ(table[128], 128.0f / 255.0f);
+    ASSERT_EQ(table[255], 1.0f);
+    const std::vector<idlib::color<idlib::RGBAb>> x = { idlib::color<idlib::RGBAb>(1, 64, 128, 191) };
+    std::vector<idlib::color<idlib::RGBAf>> y(1);
+    idlib::convert_colors<idlib::RGBAf, idlib::RGBAb>(x, y);
+    ASSERT_EQ(y[0], idlib::color<idlib::RGBAf>(1.0f / 255.0f, 64.0f / 255.0f, 128.0f / 255.0f, 191.0f / 255.0f));
+    // The conversion from clamped single values floors 256 times the value and hence restores the uint8 values.
+    std::vector<idlib::color<idlib::RGBAb>> z(1);
+    idlib::convert_colors<idlib::RGBAb, idlib::RGBAf>(y, z);
+    ASSERT_EQ(z, x);
+}
+
+TEST(convert_colors, parallel)
+{
+    const std::size_t n = 3 * idlib::internal::convert_colors_grain + 17;
+    check<idlib::RGBAb, idlib::RGBAf>(n, 4);
+    check<idlib::RGBAf, idlib::RGBAb>(n, 4);
+    check<idlib::RGBAb, idlib::RGBf>(n, 4);
+}
+
+TEST(convert_colors, empty)
+{
+    std::vector<idlib::color<idlib::RGBAf>> x;
+    std::vector<idlib::color<idlib::RGBAb>> y;
+    idlib::convert_colors<idlib::RGBAb, idlib::RGBAf>(x, y);
+}
+
+TEST(convert_colors, size_mismatch)
+{
+    std::vector<idlib::color<idlib::RGBAf>> x(3);
+    std::vector<idlib::color<idlib::RGBAb>> y(2);
+    ASSERT_THROW((idlib::convert_colors<idlib::RGBAb, idlib::RGBAf>(x, y)), idlib::invalid_argument_error);
+}
+
+} // namespace convert_colors
+
+} } } // namespace idlib::tests::color
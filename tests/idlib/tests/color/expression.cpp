@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+
+namespace idlib { namespace tests { namespace color { namespace expression {
+
+/// @brief Assert lazily evaluated color expressions are identical to eagerly evaluated color expressions.
+/// In particular, the component values saturate like the component values of eagerly evaluated color expressions.
+TEST(expression, rgbf_rgbab)
+{
+	using RGBf = idlib::color<idlib::RGBf>;
+	using RGBAb = idlib::color<idlib::RGBAb>;
+	RGBf a(0.75f, 0.25f, 0.5f), b(0.5f, 0.5f, 0.125f), c(0.25f, 1.0f, 0.0f);
+	RGBf x = idlib::lazy(a) + b - c;
+	ASSERT_EQ(x, a + b - c);
+	RGBAb d(200, 10, 128, 255), e(100, 20, 64, 1), f(50, 30, 32, 128);
+	RGBAb y = idlib::lazy(d) + e - f;
+	ASSERT_EQ(y, d + e - f);
+	RGBAb z = idlib::lazy(d) - e + f;
+	ASSERT_EQ(z, d - e + f);
+}
+
+} } } } // namespace idlib::tests::color::expression
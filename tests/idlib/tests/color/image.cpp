@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <cstdint>
+#include <cstdio>
+
+namespace idlib { namespace tests { namespace color {
+
+namespace image {
+
+using rgbab = idlib::color<idlib::RGBAb>;
+using rgbf = idlib::color<idlib::RGBf>;
+
+/// @brief A color which identifies the pixel at the given coordinates.
+static rgbab get_pattern(std::size_t x, std::size_t y)
+{ return rgbab(std::uint8_t(x), std::uint8_t(y), std::uint8_t(x + y), 255); }
+
+template <idlib::image_layout Layout>
+static void fill_pattern(const idlib::image_view<idlib::RGBAb, Layout>& view)
+{
+    for (std::size_t y = 0; y < view.height(); ++y)
+        for (std::size_t x = 0; x < view.width(); ++x)
+            view.set(x, y, get_pattern(x, y));
+}
+
+template <idlib::image_layout Layout, bool IsConst>
+static void check_pattern(const idlib::image_view<idlib::RGBAb, Layout, IsConst>& view, std::size_t x0, std::size_t y0)
+{
+    for (std::size_t y = 0; y < view.height(); ++y)
+        for (std::size_t x = 0; x < view.width(); ++x)
+            ASSERT_EQ(view.get(x, y), get_pattern(x0 + x, y0 + y)) << "pixel " << x << ", " << y;
+}
+
+TEST(image, rows_are_aligned)
+{
+    idlib::image<idlib::RGBf> a(17, 5);
+    ASSERT_EQ(0, (a.stride() * sizeof(rgbf)) % 64);
+    ASSERT_LE(a.width(), a.stride());
+    for (std::size_t y = 0; y < a.height(); ++y)
+        ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(a.view().row(y).data()) % 64);
+    idlib::image<idlib::RGBf, idlib::image_layout::planar> b(17, 5);
+    for (std::size_t k = 0; k < 3; ++k)
+        for (std::size_t y = 0; y < b.height(); ++y)
+            ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(b.view().row(k, y).data()) % 64);
+}
+
+TEST(image, default_color)
+{
+    idlib::image<idlib::RGBAb> a(3, 2);
+    idlib::image<idlib::RGBAb, idlib::image_layout::planar> b(3, 2);
+    for (std::size_t y = 0; y < 2; ++y)
+        for (std::size_t x = 0; x < 3; ++x)
+        {
+            ASSERT_EQ(a.get(x, y), rgbab());
+            ASSERT_EQ(b.get(x, y), rgbab());
+        }
+}
+
+TEST(image, interleaved_get_set)
+{
+    idlib::image<idlib::RGBAb> a(33, 7);
+    fill_pattern(a.view());
+    check_pattern(a.view(), 0, 0);
+    ASSERT_EQ(a.view()(5, 3), get_pattern(5, 3));
+    ASSERT_EQ(a.view().row(3)[5], get_pattern(5, 3));
+}
+
+TEST(image, planar_get_set)
+{
+    idlib::image<idlib::RGBAb, idlib::image_layout::planar> a(33, 7);
+    fill_pattern(a.view());
+    check_pattern(a.view(), 0, 0);
+    ASSERT_EQ(a.view().row(0, 3)[5], 5);
+    ASSERT_EQ(a.view().row(1, 3)[5], 3);
+    ASSERT_EQ(a.view().row(2, 3)[5], 8);
+    ASSERT_EQ(a.view().row(3, 3)[5], 255);
+}
+
+TEST(image, sub_views)
+{
+    idlib::image<idlib::RGBAb> a(33, 7);
+    idlib::image<idlib::RGBAb, idlib::image_layout::planar> b(33, 7);
+    fill_pattern(a.view());
+    fill_pattern(b.view());
+    const auto u = a.view().view(4, 2, 10, 5);
+    const auto v = b.view().view(4, 2, 10, 5);
+    check_pattern(u, 4, 2);
+    check_pattern(v, 4, 2);
+    // Views do not copy pixels.
+    u.set(0, 0, rgbab::red());
+    v.set(0, 0, rgbab::red());
+    ASSERT_EQ(a.get(4, 2), rgbab::red());
+    ASSERT_EQ(b.get(4, 2), rgbab::red());
+    // Views of views.
+    check_pattern(u.view(1, 1, 3, 3), 5, 3);
+    ASSERT_TRUE(a.view().view(33, 7, 0, 0).empty());
+    ASSERT_THROW(a.view().view(4, 2, 30, 5), idlib::out_of_bounds_error);
+    ASSERT_THROW(b.view().view(0, 7, 1, 1), idlib::out_of_bounds_error);
+}
+
+TEST(image, const_views)
+{
+    idlib::image<idlib::RGBAb> a(33, 7), c(33, 7);
+    idlib::image<idlib::RGBAb, idlib::image_layout::planar> b(33, 7);
+    fill_pattern(a.view());
+    fill_pattern(b.view());
+    const auto& x = a;
+    const auto& y = b;
+    const idlib::image<idlib::RGBAb>::const_view_type u = x.view();
+    static_assert(std::is_same<decltype(u.row(0)), idlib::span<const rgbab>>::value, "rows of constant views are constant");
+    static_assert(std::is_same<decltype(y.view().row(0, 0)), idlib::span<const std::uint8_t>>::value, "rows of constant views are constant");
+    check_pattern(u, 0, 0);
+    check_pattern(y.view().view(4, 2, 10, 5), 4, 2);
+    ASSERT_EQ(u(5, 3), get_pattern(5, 3));
+    ASSERT_EQ(u.data(), a.view().data());
+    idlib::copy_pixels(y.view(), c.view());
+    check_pattern(c.view(), 0, 0);
+}
+
+TEST(image, copy_pixels)
+{
+    idlib::image<idlib::RGBAb> a(100, 9), c(100, 9);
+    idlib::image<idlib::RGBAb, idlib::image_layout::planar> b(100, 9), d(100, 9);
+    fill_pattern(a.view());
+    idlib::copy_pixels(a.view(), b.view());
+    idlib::copy_pixels(b.view(), d.view());
+    idlib::copy_pixels(d.view(), c.view(), 3);
+    check_pattern(c.view(), 0, 0);
+    ASSERT_THROW(idlib::copy_pixels(a.view(), b.view().view(0, 0, 10, 9)), idlib::invalid_argument_error);
+}
+
+TEST(image, transform_pixels)
+{
+    idlib::image<idlib::RGBAb> a(600, 300);
+    idlib::image<idlib::RGBAb, idlib::image_layout::planar> b(600, 300);
+    fill_pattern(a.view());
+    fill_pattern(b.view());
+    const auto f = [](const rgbab& c) { return idlib::invert(c); };
+    idlib::transform_pixels(a.view().view(10, 20, 500, 200), f, 4);
+    idlib::transform_pixels(b.view().view(10, 20, 500, 200), f, 4);
+    for (std::size_t y = 0; y < 300; ++y)
+        for (std::size_t x = 0; x < 600; ++x)
+        {
+            const bool inside = 10 <= x && x < 510 && 20 <= y && y < 220;
+            const rgbab e = inside ? f(get_pattern(x, y)) : get_pattern(x, y);
+            ASSERT_EQ(a.get(x, y), e);
+            ASSERT_EQ(b.get(x, y), e);
+        }
+}
+
+TEST(image, mapped)
+{
+    const std::string pathname = ::testing::TempDir() + "idlib-image-test.bin";
+    std::remove(pathname.c_str());
+    {
+        idlib::image<idlib::RGBAb> a(21, 4, pathname);
+        ASSERT_TRUE(a.is_mapped());
+        fill_pattern(a.view());
+    }
+    {
+        // The pixels persist in the file.
+        idlib::image<idlib::RGBAb> a(21, 4, pathname);
+        check_pattern(a.view(), 0, 0);
+        idlib::image<idlib::RGBAb> b(std::move(a));
+        check_pattern(b.view(), 0, 0);
+    }
+    std::remove(pathname.c_str());
+}
+
+} // namespace image
+
+} } } // namespace idlib::tests::color
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "gtest/gtest.h"
+#include "idlib/tests/color/color_generator.hpp"
+
+namespace idlib { namespace tests { namespace color {
+
+namespace lerp {
+
+/// @brief The fixed-point interpolation of a uint8 value.
+static std::uint8_t reference(std::uint8_t x, std::uint8_t y, std::uint16_t w)
+{ return static_cast<std::uint8_t>((x * (256 - w) + y * w + 128) / 256); }
+
+/// @brief Assert the span interpolation of uint8 colors is the fixed-point interpolation of the components.
+template <typename S>
+void check_uint8(std::size_t n, single mu, std::size_t thread_count)
+{
+    idlib::rng rng(2018);
+    const auto x = random_colors<S>(rng, n), y = random_colors<S>(rng, n);
+    std::vector<idlib::color<S>> z(n);
+    idlib::lerp<S>(x, y, mu, z, thread_count);
+    const auto w = static_cast<std::uint16_t>(std::floor(mu * 256.0f + 0.5f));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto a = get_component_values(x[i]), b = get_component_values(y[i]), c = get_component_values(z[i]);
+        for (std::size_t k = 0; k < c.size(); ++k)
+        {
+            ASSERT_EQ(c[k], reference(a[k], b[k], w)) << "color " << i << ", component " << k;
+            // Within one of the exact value.
+            const double e = a[k] * (1.0 - w / 256.0) + b[k] * (w / 256.0);
+            ASSERT_LE(std::abs(c[k] - e), 1.0);
+        }
+    }
+}
+
+/// @brief Assert the span interpolation of clamped single colors is identical to idlib::lineary_interpolate.
+template <typename S>
+void check_single(std::size_t n, single mu, std::size_t thread_count)
+{
+    idlib::rng rng(2018);
+    const auto x = random_colors<S>(rng, n), y = random_colors<S>(rng, n);
+    std::vector<idlib::color<S>> z(n);
+    idlib::lerp<S>(x, y, mu, z, thread_count);
+    for (std::size_t i = 0; i < n; ++i)
+    { ASSERT_EQ(z[i], idlib::lineary_interpolate(x[i], y[i], mu)) << "color " << i; }
+}
+
+static const single mus[] = { 0.0f, 1.0f, 0.5f, 0.25f, 0.3f, 0.999f, 1.0f / 512.0f };
+
+TEST(lerp, uint8)
+{
+    for (auto mu : mus)
+    {
+        check_uint8<idlib::Lb>(1031, mu, 1);
+        check_uint8<idlib::LAb>(1031, mu, 1);
+        check_uint8<idlib::RGBb>(1031, mu, 1);
+        check_uint8<idlib::RGBAb>(1031, mu, 1);
+    }
+}
+
+TEST(lerp, single)
+{
+    for (auto mu : mus)
+    {
+        check_single<idlib::Lf>(1031, mu, 1);
+        check_single<idlib::LAf>(1031, mu, 1);
+        check_single<idlib::RGBf>(1031, mu, 1);
+        check_single<idlib::RGBAf>(1031, mu, 1);
+    }
+}
+
+TEST(lerp, endpoints)
+{
+    idlib::rng rng(2018);
+    const auto x = random_colors<idlib::RGBAb>(rng, 100), y = random_colors<idlib::RGBAb>(rng, 100);
+    std::vector<idlib::color<idlib::RGBAb>> z(100);
+    idlib::lerp<idlib::RGBAb>(x, y, 0.0f, z);
+    ASSERT_EQ(z, x);
+    idlib::lerp<idlib::RGBAb>(x, y, 1.0f, z);
+    ASSERT_EQ(z, y);
+}
+
+TEST(lerp, in_place_and_parallel)
+{
+    const std::size_t n = 3 * idlib::internal::lerp_grain + 17;
+    check_uint8<idlib::RGBAb>(n, 0.75f, 4);
+    check_single<idlib::RGBAf>(n, 0.75f, 4);
+    idlib::rng rng(2018);
+    auto x = random_colors<idlib::RGBAf>(rng, 1000);
+    const auto y = random_colors<idlib::RGBAf>(rng, 1000), u = x;
+    idlib::lerp<idlib::RGBAf>(x, y, 0.5f, x);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    { ASSERT_EQ(x[i], idlib::lineary_interpolate(u[i], y[i], 0.5f)); }
+}
+
+TEST(lerp, errors)
+{
+    std::vector<idlib::color<idlib::RGBAf>> x(3), y(2), z(3);
+    ASSERT_THROW((idlib::lerp<idlib::RGBAf>(x, y, 0.5f, z)), idlib::invalid_argument_error);
+    ASSERT_THROW((idlib::lerp<idlib::RGBAf>(x, x, 1.5f, z)), idlib::out_of_bounds_error);
+}
+
+/// @brief Assert the gradient of clamped single colors is identical to idlib::lineary_interpolate.
+template <typename S>
+void check_gradient_single(std::size_t n, std::size_t thread_count)
+{
+    idlib::rng rng(2018);
+    const auto c = random_colors<S>(rng, 2);
+    std::vector<idlib::color<S>> z(n);
+    idlib::gradient<S>(c[0], c[1], z, thread_count);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const single mu = n == 1 ? 0.0f : static_cast<single>(i) / static_cast<single>(n - 1);
+        ASSERT_EQ(z[i], idlib::lineary_interpolate(c[0], c[1], mu)) << "color " << i;
+    }
+}
+
+/// @brief Assert the gradient of uint8 colors is the fixed-point interpolation with exactly rounded weights.
+template <typename S>
+void check_gradient_uint8(std::size_t n, std::size_t thread_count)
+{
+    idlib::rng rng(2018);
+    const auto c = random_colors<S>(rng, 2);
+    std::vector<idlib::color<S>> z(n);
+    idlib::gradient<S>(c[0], c[1], z, thread_count);
+    const auto a = get_component_values(c[0]), b = get_component_values(c[1]);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto w = n == 1 ? std::uint16_t(0) : static_cast<std::uint16_t>(std::floor(256.0 * i / (n - 1) + 0.5));
+        const auto v = get_component_values(z[i]);
+        for (std::size_t k = 0; k < v.size(); ++k)
+        { ASSERT_EQ(v[k], reference(a[k], b[k], w)) << "color " << i << ", component " << k; }
+    }
+    ASSERT_EQ(z.front(), c[0]);
+    if (n > 1)
+    { ASSERT_EQ(z.back(), c[1]); }
+}
+
+TEST(gradient, single)
+{
+    for (std::size_t n : { 1, 2, 3, 255, 1031 })
+    {
+        check_gradient_single<idlib::Lf>(n, 1);
+        check_gradient_single<idlib::LAf>(n, 1);
+        check_gradient_single<idlib::RGBf>(n, 1);
+        check_gradient_single<idlib::RGBAf>(n, 1);
+    }
+    check_gradient_single<idlib::RGBAf>(3 * idlib::internal::lerp_grain + 17, 4);
+}
+
+TEST(gradient, uint8)
+{
+    for (std::size_t n : { 1, 2, 3, 255, 1031 })
+    {
+        check_gradient_uint8<idlib::Lb>(n, 1);
+        check_gradient_uint8<idlib::LAb>(n, 1);
+        check_gradient_uint8<idlib::RGBb>(n, 1);
+        check_gradient_uint8<idlib::RGBAb>(n, 1);
+    }
+    check_gradient_uint8<idlib::RGBAb>(3 * idlib::internal::lerp_grain + 17, 4);
+}
+
+} // namespace lerp
+
+} } } // namespace idlib::tests::color
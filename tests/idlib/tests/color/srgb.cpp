@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "gtest/gtest.h"
+#include "idlib/tests/color/color_generator.hpp"
+#include <cmath>
+
+namespace idlib { namespace tests { namespace color {
+
+namespace srgb {
+
+/// @brief The sRGB encoding of a linear value rounded to the nearest uint8 value computed in double precision.
+std::uint8_t encode(single x)
+{
+    const double v = std::min(std::max(static_cast<double>(x), 0.0), 1.0);
+    return static_cast<std::uint8_t>(std::floor(255.0 * idlib::internal::srgb_encode(v) + 0.5));
+}
+
+/// @brief Get the linear component values of a color.
+/// The RGB components of sRGB colors are decoded, the A component and the components of linear colors are converted.
+template <typename S>
+std::vector<single> get_linear_values(const idlib::color<S>& x)
+{
+    std::vector<single> v;
+    const auto c = get_component_values(x);
+    for (std::size_t k = 0; k < c.size(); ++k)
+    {
+        if constexpr (std::is_same<syntax_t<S>, idlib::type::clamped_single_traits>::value)
+        { v.push_back(c[k]); }
+        else if (idlib::internal::is_srgb<S>::value && !(S::has_a && k + 1 == c.size()))
+        { v.push_back(static_cast<single>(idlib::internal::srgb_decode(c[k] / 255.0))); }
+        else
+        { v.push_back(idlib::type::convert<idlib::type::clamped_single_traits, idlib::type::uint8_traits>()(c[k])); }
+    }
+    return v;
+}
+
+/// @brief Assert the span conversion from an sRGB color space to a clamped single color space decodes the component values.
+template <typename T, typename S>
+void check_decode(std::size_t n, std::size_t thread_count)
+{
+    idlib::rng rng(2018);
+    const auto x = random_colors<S>(rng, n);
+    std::vector<idlib::color<T>> y(n);
+    idlib::convert_colors<T, S>(x, y, thread_count);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto a = get_component_values(y[i]), b = get_linear_values(x[i]);
+        for (std::size_t k = 0; k < 3; ++k)
+        { ASSERT_EQ(a[k], b[k]) << "color " << i << ", component " << k; }
+        if (T::has_a)
+        {
+            // The A component is linear: uint8 values are divided by 255.
+            const single expected = S::has_a ? static_cast<single>(get_component_values(x[i])[3]) / 255.0f : 1.0f;
+            ASSERT_EQ(a[3], expected) << "color " << i;
+            ASSERT_EQ(a[3], S::has_a ? b[S::count - 1] : 1.0f) << "color " << i;
+        }
+    }
+}
+
+/// @brief Assert the span conversion from a clamped single color space to an sRGB color space encodes the component values.
+template <typename T, typename S>
+void check_encode(std::size_t n, std::size_t thread_count)
+{
+    idlib::rng rng(2018);
+    const auto x = random_colors<S>(rng, n);
+    std::vector<idlib::color<T>> y(n);
+    idlib::convert_colors<T, S>(x, y, thread_count);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto a = get_component_values(y[i]), b = get_component_values(x[i]);
+        for (std::size_t k = 0; k < 3; ++k)
+        { ASSERT_EQ(a[k], encode(b[S::has_l ? 0 : k])) << "color " << i << ", component " << k; }
+        if (T::has_a)
+        {
+            using convert = idlib::type::convert<idlib::type::uint8_traits, idlib::type::clamped_single_traits>;
+            const std::uint8_t expected = S::has_a ? convert()(b[S::count - 1]) : 255;
+            ASSERT_EQ(a[3], expected) << "color " << i;
+        }
+    }
+}
+
+TEST(srgb, decode_table)
+{
+    const auto& table = idlib::internal::get_srgb_decode_table();
+    for (int q = 0; q < 256; ++q)
+    { ASSERT_EQ(table[q], static_cast<single>(idlib::internal::srgb_decode(q / 255.0))) << q; }
+}
+
+TEST(srgb, encode_round_trip)
+{
+    // Every sRGB uint8 value must survive decoding and encoding.
+    const auto& table = idlib::internal::get_srgb_decode_table();
+    for (int q = 0; q < 256; ++q)
+    { ASSERT_EQ(idlib::internal::srgb_encode_uint8(table[q]), q); }
+}
+
+TEST(srgb, encode_thresholds)
+{
+    // The scalar and the SIMD encoding must be exact at and next to every rounding boundary.
+    const auto& t = idlib::internal::get_srgb_encode_thresholds();
+    std::vector<single> x;
+    for (std::size_t q = 1; q < t.size(); ++q)
+    {
+        single v = t[q];
+        for (int k = 0; k < 4; ++k) v = std::nextafter(v, 0.0f);
+        for (int k = 0; k < 9; ++k, v = std::nextafter(v, 1.0f)) x.push_back(v);
+    }
+    x.push_back(0.0f);
+    x.push_back(1.0f);
+    x.push_back(-1.0f);
+    x.push_back(2.0f);
+    x.push_back(std::numeric_limits<single>::quiet_NaN());
+    std::vector<std::uint8_t> y(x.size());
+    idlib::internal::srgb_encode_uint8<1, false>(x.data(), y.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        const std::uint8_t expected = std::isnan(x[i]) ? 0 : encode(x[i]);
+        ASSERT_EQ(idlib::internal::srgb_encode_uint8(x[i]), expected) << x[i];
+        ASSERT_EQ(y[i], expected) << x[i];
+    }
+}
+
+TEST(srgb, encode_random)
+{
+    idlib::rng rng(2018);
+    std::vector<single> x(1 << 16);
+    for (auto& v : x)
+    { v = idlib::random<single>(&rng, idlib::interval<single>(0.0f, 1.0f)); }
+    std::vector<std::uint8_t> y(x.size());
+    idlib::internal::srgb_encode_uint8<1, false>(x.data(), y.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    { ASSERT_EQ(y[i], encode(x[i])) << x[i]; }
+}
+
+TEST(srgb, convert_colors_decode)
+{
+    check_decode<idlib::RGBAf, idlib::sRGBAb>(1031, 1);
+    check_decode<idlib::RGBf, idlib::sRGBAb>(1031, 1);
+    check_decode<idlib::RGBAf, idlib::sRGBb>(1031, 1);
+    check_decode<idlib::RGBf, idlib::sRGBb>(1031, 1);
+}
+
+TEST(srgb, convert_colors_encode)
+{
+    check_encode<idlib::sRGBAb, idlib::RGBAf>(1031, 1);
+    check_encode<idlib::sRGBAb, idlib::RGBf>(1031, 1);
+    check_encode<idlib::sRGBAb, idlib::Lf>(1031, 1);
+    check_encode<idlib::sRGBb, idlib::RGBAf>(1031, 1);
+    check_encode<idlib::sRGBb, idlib::RGBf>(1031, 1);
+    check_encode<idlib::sRGBb, idlib::LAf>(1031, 1);
+}
+
+TEST(srgb, convert_colors_parallel)
+{
+    const std::size_t n = 3 * idlib::internal::convert_colors_grain + 17;
+    check_decode<idlib::RGBAf, idlib::sRGBAb>(n, 4);
+    check_encode<idlib::sRGBAb, idlib::RGBAf>(n, 4);
+}
+
+TEST(srgb, encode_linear_a)
+{
+    // The SIMD encoding and the scalar encoding must clamp A values like RGB values.
+    const single inf = std::numeric_limits<single>::infinity(), nan = std::numeric_limits<single>::quiet_NaN();
+    const std::vector<single> a = { -1.0f, 2.0f, nan, inf, -inf, -0.0f, 0.5f, 1.0f };
+    const std::vector<std::uint8_t> expected = { 0, 255, 0, 255, 0, 0, 128, 255 };
+    std::vector<single> x;
+    for (auto v : a)
+    { x.insert(x.end(), { 0.5f, 0.25f, 0.75f, v }); }
+    std::vector<std::uint8_t> y(x.size()), z(4);
+    idlib::internal::srgb_encode_uint8<4, true>(x.data(), y.data(), x.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        idlib::internal::srgb_encode_uint8<4, true>(x.data() + 4 * i, z.data(), 4);
+        for (std::size_t k = 0; k < 4; ++k)
+        { ASSERT_EQ(y[4 * i + k], z[k]) << "color " << i << ", component " << k; }
+        ASSERT_EQ(z[3], expected[i]) << a[i];
+        ASSERT_EQ(idlib::internal::linear_encode_uint8(a[i]), expected[i]) << a[i];
+    }
+}
+
+/// @brief Assert the conversion constructor produces the same colors as the span conversion.
+template <typename T, typename S>
+void check_constructor(std::size_t n)
+{
+    idlib::rng rng(2018);
+    const auto x = random_colors<S>(rng, n);
+    std::vector<idlib::color<T>> y(n);
+    idlib::convert_colors<T, S>(x, y, 1);
+    for (std::size_t i = 0; i < n; ++i)
+    { ASSERT_EQ(get_component_values(idlib::color<T>(x[i])), get_component_values(y[i])) << "color " << i; }
+}
+
+TEST(srgb, conversion_constructor)
+{
+    check_constructor<idlib::sRGBb, idlib::RGBf>(1031);
+    check_constructor<idlib::sRGBAb, idlib::RGBAf>(1031);
+    check_constructor<idlib::RGBf, idlib::sRGBb>(1031);
+    check_constructor<idlib::RGBAf, idlib::sRGBAb>(1031);
+    ASSERT_EQ(idlib::color<idlib::sRGBb>(idlib::color<idlib::RGBf>(0.5f, 0.5f, 0.5f)).get_r(), 188);
+    // sRGB colors are not converted from and to linear byte colors.
+    static_assert(!std::is_constructible<idlib::color<idlib::sRGBb>, idlib::color<idlib::RGBb>>::value, "");
+    static_assert(!std::is_constructible<idlib::color<idlib::sRGBAb>, idlib::color<idlib::RGBAb>>::value, "");
+    static_assert(!std::is_constructible<idlib::color<idlib::RGBb>, idlib::color<idlib::sRGBb>>::value, "");
+}
+
+} // namespace srgb
+
+} } } // namespace idlib::tests::color
@@ -55,4 +55,77 @@ TEST(arithmetic_tuple_test, binary_star)
 	ASSERT_EQ(z, w);
 }
 
+/// @brief Assert the operations of the arithmetic tuple types for which SIMD-backed kernels are provided
+/// produce bit-identical results to the element-wise scalar operations.
+template <typename E, std::size_t S>
+void assert_same_as_scalar()
+{
+	using tuple_type = idlib::arithmetic_tuple<E, S, idlib::zero_functor<E>>;
+	static_assert(alignof(tuple_type) >= alignof(E), "tuple type is underaligned");
+	idlib::rng rng(2018);
+	auto interval = idlib::interval<E>(E(-1000), E(+1000));
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		auto x = tuple_type::generate([&rng, &interval](size_t) { return rng.next(interval); });
+		auto y = tuple_type::generate([&rng, &interval](size_t) { return rng.next(interval); });
+		auto s = rng.next(interval);
+		if (s == idlib::zero<E>()) s = idlib::one<E>();
+		auto sum = x + y, difference = x - y, product = x * s, quotient = x / s, negation = -x;
+		E inner_product = x[S - 1] * y[S - 1];
+		for (size_t j = S - 1; j > 0; --j)
+		{ inner_product = x[j - 1] * y[j - 1] + inner_product; }
+		for (size_t j = 0; j < S; ++j)
+		{
+			ASSERT_EQ(sum[j], x[j] + y[j]);
+			ASSERT_EQ(difference[j], x[j] - y[j]);
+			ASSERT_EQ(product[j], x[j] * s);
+			ASSERT_EQ(quotient[j], x[j] / s);
+			ASSERT_EQ(negation[j], -x[j]);
+		}
+		ASSERT_EQ(x.inner_product(y), inner_product);
+		ASSERT_TRUE(x == x);
+		ASSERT_FALSE(x != x);
+		auto z = x;
+		z[S - 1] = z[S - 1] + idlib::one<E>();
+		ASSERT_FALSE(x == z);
+		ASSERT_TRUE(x != z);
+		z[S - 1] = std::numeric_limits<E>::quiet_NaN();
+		ASSERT_FALSE(z == z);
+		ASSERT_TRUE(z != z);
+	}
+}
+
+TEST(arithmetic_tuple_test, single_3)
+{ assert_same_as_scalar<single, 3>(); }
+
+TEST(arithmetic_tuple_test, single_4)
+{ assert_same_as_scalar<single, 4>(); }
+
+TEST(arithmetic_tuple_test, double_2)
+{ assert_same_as_scalar<double, 2>(); }
+
+TEST(arithmetic_tuple_test, double_4)
+{ assert_same_as_scalar<double, 4>(); }
+
+/// @brief Assert @a single tuples of size @a 3 are unpadded and their operations do not write adjacent tuples.
+TEST(arithmetic_tuple_test, single_3_layout)
+{
+	using tuple_type = idlib::arithmetic_tuple<single, 3, idlib::zero_functor<single>>;
+	static_assert(sizeof(tuple_type) == 3 * sizeof(single), "tuple type is padded");
+	tuple_type x[3] = { tuple_type(1.0f, 2.0f, 3.0f), tuple_type(4.0f, 5.0f, 6.0f), tuple_type(7.0f, 8.0f, 9.0f) };
+	x[1] += x[0];
+	x[1] /= 0.5f;
+	x[1] = tuple_type(x[1][0], x[1][1], x[1][2]);
+	ASSERT_EQ(x[0], tuple_type(1.0f, 2.0f, 3.0f));
+	ASSERT_EQ(x[1], tuple_type(10.0f, 14.0f, 18.0f));
+	ASSERT_EQ(x[2], tuple_type(7.0f, 8.0f, 9.0f));
+}
+
+/// @brief Assert the default-constructed tuple is the zero tuple.
+TEST(arithmetic_tuple_test, default_construction)
+{
+	idlib::arithmetic_tuple<single, 3, idlib::zero_functor<single>> x, y(0.0f, 0.0f, 0.0f);
+	ASSERT_EQ(x, y);
+}
+
 } } } // namespace idlib::math::tests
@@ -0,0 +1,266 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <algorithm>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using vector_3s = idlib::vector<single, 3>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using ray_3s = idlib::ray<point_3s>;
+using bvh_3s = idlib::bvh<point_3s, size_t>;
+
+static std::vector<box_3s> random_boxes(idlib::rng& rng, size_t n, single extent)
+{
+	std::vector<box_3s> boxes;
+	for (size_t i = 0; i < n; ++i)
+	{
+		auto a = idlib::random<point_3s>(&rng, idlib::interval<single>(-100.0f, +100.0f));
+		auto s = idlib::random<vector_3s>(&rng, idlib::interval<single>(0.0f, extent));
+		boxes.emplace_back(a, a + s);
+	}
+	return boxes;
+}
+
+static std::vector<size_t> iota(size_t n)
+{
+	std::vector<size_t> v(n);
+	for (size_t i = 0; i < n; ++i) v[i] = i;
+	return v;
+}
+
+template <typename Query>
+static std::vector<size_t> collect(const bvh_3s& bvh, const Query& query)
+{
+	std::vector<size_t> result;
+	bvh.query(query, [&result](const box_3s&, size_t p) { result.push_back(p); });
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+/// @brief Reference slab test of a ray against a box.
+static bool reference_hit(const ray_3s& r, const box_3s& b)
+{
+	single t0 = 0.0f, t1 = std::numeric_limits<single>::infinity();
+	for (size_t i = 0; i < 3; ++i)
+	{
+		single o = r.get_origin()[i], d = r.get_direction()[i];
+		if (d == 0.0f)
+		{
+			if (o < b.get_min()[i] || o > b.get_max()[i]) return false;
+			continue;
+		}
+		single a = (b.get_min()[i] - o) * (1.0f / d), c = (b.get_max()[i] - o) * (1.0f / d);
+		t0 = std::max(t0, std::min(a, c));
+		t1 = std::min(t1, std::max(a, c));
+		if (t0 > t1) return false;
+	}
+	return true;
+}
+
+/// @brief Assert the nodes enclose their children and each primitive is referenced by exactly one leaf.
+static void assert_well_formed(const bvh_3s& bvh, const bvh_3s::payload_type count, size_t max_leaf_size)
+{
+	const auto& nodes = bvh.get_nodes();
+	std::vector<size_t> references(count, 0);
+	std::vector<std::pair<size_t, size_t>> stack{ { 0, 0 } };
+	while (!stack.empty())
+	{
+		auto x = stack.back();
+		stack.pop_back();
+		ASSERT_LE(x.second, bvh_3s::max_depth);
+		const auto& n = nodes[x.first];
+		auto encloses = [&n](const point_3s& min, const point_3s& max)
+		{
+			for (size_t i = 0; i < 3; ++i)
+			{
+				if (n.min[i] > min[i] || n.max[i] < max[i]) return false;
+			}
+			return true;
+		};
+		if (n.is_leaf())
+		{
+			ASSERT_LE(n.count, std::max<size_t>(max_leaf_size, 1));
+			for (size_t i = n.index; i < n.index + n.count; ++i)
+			{
+				ASSERT_TRUE(encloses(bvh.get_boxes()[i].get_min(), bvh.get_boxes()[i].get_max()));
+				references[bvh.get_payloads()[i]]++;
+			}
+			continue;
+		}
+		for (size_t c : { x.first + 1, size_t(n.index) })
+		{
+			point_3s min(nodes[c].min[0], nodes[c].min[1], nodes[c].min[2]),
+			         max(nodes[c].max[0], nodes[c].max[1], nodes[c].max[2]);
+			ASSERT_TRUE(encloses(min, max));
+			stack.emplace_back(c, x.second + 1);
+		}
+	}
+	for (auto r : references) ASSERT_EQ(r, 1);
+}
+
+/// @brief Assert box, point and ray queries visit exactly the primitives a brute-force scan finds.
+TEST(bvh, queries)
+{
+	idlib::rng rng(idlib::rng_engine::xoshiro256_star_star, 2018);
+	auto boxes = random_boxes(rng, 5000, 10.0f);
+	auto payloads = iota(boxes.size());
+	bvh_3s bvh(boxes, payloads);
+	ASSERT_EQ(bvh.size(), boxes.size());
+	assert_well_formed(bvh, boxes.size(), idlib::bvh_options().max_leaf_size);
+	for (size_t k = 0; k < 200; ++k)
+	{
+		auto q = random_boxes(rng, 1, 30.0f)[0];
+		auto p = idlib::random<point_3s>(&rng, idlib::interval<single>(-100.0f, +100.0f));
+		ray_3s r(idlib::random<point_3s>(&rng, idlib::interval<single>(-150.0f, +150.0f)),
+		         idlib::random<vector_3s>(&rng, idlib::interval<single>(-1.0f, +1.0f)));
+		std::vector<size_t> a, b, c;
+		for (size_t i = 0; i < boxes.size(); ++i)
+		{
+			if (idlib::is_intersecting(boxes[i], q)) a.push_back(i);
+			if (idlib::is_enclosing(boxes[i], p)) b.push_back(i);
+			if (reference_hit(r, boxes[i])) c.push_back(i);
+		}
+		ASSERT_EQ(collect(bvh, q), a);
+		ASSERT_EQ(collect(bvh, p), b);
+		std::vector<size_t> d;
+		bvh.query(r, [&d](const box_3s&, size_t p, single t) { ASSERT_GE(t, 0.0f); d.push_back(p); });
+		std::sort(d.begin(), d.end());
+		ASSERT_EQ(d, c);
+	}
+}
+
+/// @brief Assert rays are clipped by the maximal distance and the entry distance is reported.
+TEST(bvh, ray_distance)
+{
+	std::vector<box_3s> boxes;
+	for (int i = 0; i < 10; ++i)
+	{ boxes.emplace_back(point_3s(single(10 * i), -1.0f, -1.0f), point_3s(single(10 * i + 1), +1.0f, +1.0f)); }
+	auto payloads = iota(boxes.size());
+	idlib::bvh_options options;
+	options.max_leaf_size = 1;
+	bvh_3s bvh(boxes, payloads, options);
+	ray_3s r(point_3s(-5.0f, 0.0f, 0.0f), vector_3s(1.0f, 0.0f, 0.0f));
+	std::vector<std::pair<size_t, single>> hits;
+	bvh.query(r, [&hits](const box_3s&, size_t p, single t) { hits.emplace_back(p, t); }, 45.0f);
+	std::sort(hits.begin(), hits.end());
+	ASSERT_EQ(hits.size(), 5);
+	for (size_t i = 0; i < hits.size(); ++i)
+	{
+		ASSERT_EQ(hits[i].first, i);
+		ASSERT_EQ(hits[i].second, single(10 * i + 5));
+	}
+	// Nearest first traversal.
+	hits.clear();
+	bvh.query(r, [&hits](const box_3s&, size_t p, single t) { hits.emplace_back(p, t); });
+	ASSERT_EQ(hits.size(), 10);
+	ASSERT_EQ(hits.front().first, 0);
+}
+
+/// @brief Assert the hierarchy does not depend on the number of threads.
+TEST(bvh, deterministic_parallel_build)
+{
+	idlib::rng rng(idlib::rng_engine::xoshiro256_star_star, 2018);
+	auto boxes = random_boxes(rng, 200000, 1.0f);
+	auto payloads = iota(boxes.size());
+	idlib::bvh_options options;
+	options.thread_count = 1;
+	bvh_3s a(boxes, payloads, options);
+	options.thread_count = 4;
+	bvh_3s b(boxes, payloads, options);
+	ASSERT_EQ(a.get_payloads(), b.get_payloads());
+	ASSERT_EQ(a.get_nodes().size(), b.get_nodes().size());
+	for (size_t i = 0; i < a.get_nodes().size(); ++i)
+	{
+		const auto& x = a.get_nodes()[i];
+		const auto& y = b.get_nodes()[i];
+		ASSERT_EQ(x.index, y.index);
+		ASSERT_EQ(x.count, y.count);
+		for (size_t j = 0; j < 3; ++j)
+		{
+			ASSERT_EQ(x.min[j], y.min[j]);
+			ASSERT_EQ(x.max[j], y.max[j]);
+		}
+	}
+	assert_well_formed(b, boxes.size(), options.max_leaf_size);
+}
+
+/// @brief Assert coincident boxes are split by the median fallback.
+TEST(bvh, coincident_boxes)
+{
+	std::vector<box_3s> boxes(1000, box_3s(point_3s(0.0f, 0.0f, 0.0f), point_3s(1.0f, 1.0f, 1.0f)));
+	auto payloads = iota(boxes.size());
+	bvh_3s bvh(boxes, payloads);
+	assert_well_formed(bvh, boxes.size(), idlib::bvh_options().max_leaf_size);
+	ASSERT_EQ(collect(bvh, point_3s(0.5f, 0.5f, 0.5f)), payloads);
+	ASSERT_EQ(bvh.get_bounds(), boxes[0]);
+}
+
+/// @brief Assert boxes with NaN or infinite coordinates do not break the build of the hierarchy.
+TEST(bvh, non_finite_boxes)
+{
+	idlib::rng rng(2018);
+	auto boxes = random_boxes(rng, 1000, 10.0f);
+	const single nan = std::numeric_limits<single>::quiet_NaN(), inf = std::numeric_limits<single>::infinity();
+	boxes[10] = box_3s(point_3s(nan, 0.0f, nan), point_3s(nan, 1.0f, nan));
+	boxes[20] = box_3s(point_3s(-inf, 0.0f, 0.0f), point_3s(1.0f, 1.0f, 1.0f));
+	boxes[30] = box_3s(point_3s(0.0f, 0.0f, 0.0f), point_3s(inf, inf, 1.0f));
+	auto payloads = iota(boxes.size());
+	bvh_3s bvh(boxes, payloads);
+	assert_well_formed(bvh, boxes.size(), idlib::bvh_options().max_leaf_size);
+	// Whether the box with NaN coordinates is found is unspecified.
+	std::vector<size_t> expected;
+	const point_3s p(0.5f, 0.5f, 0.5f);
+	for (size_t i = 0; i < boxes.size(); ++i)
+	{
+		if (i != 10 && idlib::is_enclosing(boxes[i], p)) expected.push_back(i);
+	}
+	auto result = collect(bvh, p);
+	result.erase(std::remove(result.begin(), result.end(), size_t(10)), result.end());
+	ASSERT_EQ(result, expected);
+}
+
+/// @brief Assert empty hierarchies and invalid arguments.
+TEST(bvh, empty_and_invalid)
+{
+	bvh_3s bvh;
+	ASSERT_TRUE(bvh.empty());
+	ASSERT_TRUE(collect(bvh, point_3s(0.0f, 0.0f, 0.0f)).empty());
+	ASSERT_THROW(bvh.get_bounds(), idlib::invalid_argument_error);
+	std::vector<box_3s> boxes(2);
+	std::vector<size_t> payloads(1);
+	ASSERT_THROW(bvh_3s(boxes, payloads), idlib::invalid_argument_error);
+	payloads.resize(2);
+	idlib::bvh_options options;
+	options.max_leaf_size = 0;
+	ASSERT_THROW(bvh_3s(boxes, payloads, options), idlib::invalid_argument_error);
+	options.max_leaf_size = 1;
+	options.bin_count = 65;
+	ASSERT_THROW(bvh_3s(boxes, payloads, options), idlib::invalid_argument_error);
+}
+
+} } } // namespace idlib::math::tests
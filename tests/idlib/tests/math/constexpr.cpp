@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+
+namespace idlib { namespace math { namespace tests {
+
+using vector_3s = idlib::vector<single, 3>;
+using vector_4d = idlib::vector<double, 4>;
+using point_3s = idlib::point<vector_3s>;
+
+// Assert vectors, points, and their functors are usable in constant expressions.
+static_assert(vector_3s::unit(1) == vector_3s(0.0f, 1.0f, 0.0f), "unexpected unit vector");
+static_assert(idlib::zero<vector_3s>() == vector_3s(), "unexpected zero vector");
+static_assert(idlib::one<vector_4d>() == vector_4d(1.0, 1.0, 1.0, 1.0), "unexpected one vector");
+static_assert(vector_3s(1.0f, 2.0f, 3.0f) + vector_3s(1.0f, 1.0f, 1.0f) * 2.0f == vector_3s(3.0f, 4.0f, 5.0f), "unexpected sum");
+static_assert(-vector_4d(1.0, -2.0, 3.0, -4.0) / 2.0 == vector_4d(-0.5, 1.0, -1.5, 2.0), "unexpected quotient");
+static_assert(idlib::dot_product(vector_3s(1.0f, 2.0f, 3.0f), vector_3s(4.0f, 5.0f, 6.0f)) == 32.0f, "unexpected dot product");
+static_assert(idlib::cross_product(vector_3s::unit(0), vector_3s::unit(1)) == vector_3s::unit(2), "unexpected cross product");
+static_assert(idlib::squared_euclidean_norm(vector_3s(2.0f, 3.0f, 6.0f)) == 49.0f, "unexpected squared Euclidean norm");
+static_assert(idlib::euclidean_norm(vector_3s(2.0f, 3.0f, 6.0f)) == 7.0f, "unexpected Euclidean norm");
+static_assert(idlib::manhattan_norm(vector_3s(-2.0f, 3.0f, -6.0f)) == 11.0f, "unexpected Manhattan norm");
+static_assert(idlib::maximum_norm(vector_3s(-2.0f, 3.0f, -6.0f)) == 6.0f, "unexpected maximum norm");
+static_assert(point_3s(1.0f, 2.0f, 3.0f) + vector_3s::unit(0) == point_3s(2.0f, 2.0f, 3.0f), "unexpected translated point");
+static_assert(point_3s(1.0f, 2.0f, 3.0f) - point_3s() == vector_3s(1.0f, 2.0f, 3.0f), "unexpected difference");
+static_assert(idlib::zero<point_3s>().x() == 0.0f, "unexpected zero point");
+
+/// @brief Assert the results of constant evaluation are identical to the results of evaluation at run-time.
+TEST(constexpr_test, vector_3s)
+{
+	constexpr vector_3s a(1.5f, -2.25f, 3.1f), b(0.3f, 7.7f, -1.9f);
+	constexpr auto c = a + b * 2.7f - a / 4.1f;
+	constexpr auto d = idlib::dot_product(a, b);
+	constexpr auto e = idlib::euclidean_norm(a);
+	constexpr auto f = idlib::manhattan_norm(-b);
+	volatile single u = 2.7f, v = 4.1f;
+	single s = u, t = v;
+	vector_3s x = a, y = b;
+	ASSERT_EQ(c, x + y * s - x / t);
+	ASSERT_EQ(d, idlib::dot_product(x, y));
+	ASSERT_EQ(e, idlib::euclidean_norm(x));
+	ASSERT_EQ(f, idlib::manhattan_norm(-y));
+}
+
+TEST(constexpr_test, vector_4d)
+{
+	constexpr vector_4d a(1.5, -2.25, 3.1, 0.7), b(0.3, 7.7, -1.9, 1e-3);
+	constexpr auto c = -(a - b) * 0.1;
+	constexpr auto d = idlib::squared_euclidean_norm(c);
+	volatile double u = 0.1;
+	double s = u;
+	vector_4d x = a, y = b;
+	ASSERT_EQ(c, -(x - y) * s);
+	ASSERT_EQ(d, idlib::squared_euclidean_norm(-(x - y) * s));
+}
+
+/// @brief Assert the square root used in constant expressions is correctly rounded
+/// and handles zeroes, infinity, NaN, and negative values like std::sqrt.
+template <typename T>
+void assert_constant_sqrt()
+{
+	idlib::rng rng(2018);
+	for (size_t i = 0; i < 10000; ++i)
+	{
+		T x = rng.next(idlib::interval<T>(T(0), T(1000)));
+		x = x * x * x * x * x;
+		ASSERT_EQ(idlib::internal::constant_sqrt(x), std::sqrt(x));
+		x = x * std::numeric_limits<T>::min();
+		ASSERT_EQ(idlib::internal::constant_sqrt(x), std::sqrt(x));
+	}
+	ASSERT_EQ(idlib::internal::constant_sqrt(std::numeric_limits<T>::max()), std::sqrt(std::numeric_limits<T>::max()));
+	ASSERT_EQ(idlib::internal::constant_sqrt(std::numeric_limits<T>::denorm_min()), std::sqrt(std::numeric_limits<T>::denorm_min()));
+	ASSERT_EQ(idlib::internal::constant_sqrt(std::numeric_limits<T>::infinity()), std::numeric_limits<T>::infinity());
+	ASSERT_TRUE(std::signbit(idlib::internal::constant_sqrt(-T(0))));
+	ASSERT_TRUE(std::isnan(idlib::internal::constant_sqrt(-T(1))));
+	ASSERT_TRUE(std::isnan(idlib::internal::constant_sqrt(std::numeric_limits<T>::quiet_NaN())));
+}
+
+TEST(constexpr_test, sqrt_single)
+{ assert_constant_sqrt<single>(); }
+
+TEST(constexpr_test, sqrt_double)
+{ assert_constant_sqrt<double>(); }
+
+} } } // namespace idlib::math::tests
@@ -0,0 +1,395 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+/// @file idlib/tests/math/differential.cpp
+/// @brief Cross-checks of the batched and SIMD geometry functions against the scalar reference functors.
+/// @detail
+/// Each test generates regular, degenerate and non-finite inputs (see geometry_generator.hpp),
+/// and asserts that the fast path and the reference compute identical results.
+/// The throughput of the fast paths and the references is measured by the benchmarks.
+/// Results are identical if their bits are equal or if both are NaN.
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include "idlib/tests/math/geometry_generator.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using generator_3s = geometry_generator<point_3s>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using cube_3s = idlib::axis_aligned_cube<point_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+using plane_3s = idlib::plane<point_3s>;
+using ray_3s = idlib::ray<point_3s>;
+using line_3s = idlib::line<point_3s>;
+using frustum_3s = idlib::frustum<point_3s>;
+using batch_3s = idlib::vector_batch<single, 3>;
+
+/// @brief The number of rays of a ray packet.
+static constexpr std::size_t packet_width = 8;
+
+static const char *get_name(geometry_class c)
+{
+	switch (c)
+	{
+		case geometry_class::regular: return "regular";
+		case geometry_class::degenerate: return "degenerate";
+		default: return "non-finite";
+	};
+}
+
+static bool is_identical(single x, single y)
+{ return (idlib::is_not_a_number(x) && idlib::is_not_a_number(y)) || std::memcmp(&x, &y, sizeof(single)) == 0; }
+
+static bool is_identical(int x, int y)
+{ return x == y; }
+
+/// @brief Assert the results of the reference and the fast path are identical.
+template <typename T>
+static void assert_identical(const std::vector<T>& reference, const std::vector<T>& fast, geometry_class c)
+{
+	ASSERT_EQ(reference.size(), fast.size());
+	for (std::size_t i = 0; i < reference.size(); ++i)
+	{ ASSERT_TRUE(is_identical(reference[i], fast[i])) << get_name(c) << " input " << i << ": " << reference[i] << " vs. " << fast[i]; }
+}
+
+/// @brief Cross-check a fast path against a reference for all classes of inputs.
+/// @param make_input a function invoked as <c>make_input(c)</c> returning the input for a class of geometries
+/// @param reference, fast functions invoked as <c>f(input)</c> returning a vector of results
+template <typename MakeInput, typename Reference, typename Fast>
+static void cross_check(MakeInput&& make_input, Reference&& reference, Fast&& fast)
+{
+	for (geometry_class c : geometry_classes)
+	{
+		const auto input = make_input(c);
+		assert_identical(reference(input), fast(input), c);
+		if (::testing::Test::HasFatalFailure()) return;
+	}
+}
+
+/// @brief Rays and packets of these rays.
+struct ray_input
+{
+	std::vector<ray_3s> rays;
+	std::vector<idlib::ray_packet<point_3s, packet_width>> packets;
+};
+
+static ray_input make_rays(generator_3s& g, geometry_class c, std::size_t n)
+{
+	ray_input input;
+	input.rays = g.generate<ray_3s>(n, c);
+	for (std::size_t i = 0; i + packet_width <= n; i += packet_width)
+	{ input.packets.emplace_back(idlib::span<const ray_3s>(input.rays.data() + i, packet_width)); }
+	return input;
+}
+
+/// @brief Cross-check the intersection of ray packets with geometries against the intersection of single rays.
+template <typename G>
+static void cross_check_ray_packets()
+{
+	generator_3s g(2018);
+	cross_check(
+		[&g](geometry_class c) { return std::make_pair(make_rays(g, c, 4096), g.generate<G>(16, c)); },
+		[](const auto& input)
+		{
+			std::vector<single> distances;
+			for (const auto& geometry : input.second)
+			{
+				for (const auto& r : input.first.rays) distances.push_back(idlib::intersect(r, geometry).get_distance());
+			}
+			return distances;
+		},
+		[](const auto& input)
+		{
+			std::vector<single> distances;
+			for (const auto& geometry : input.second)
+			{
+				for (const auto& packet : input.first.packets)
+				{
+					const auto r = idlib::intersect(packet, geometry);
+					distances.insert(distances.end(), r.get_distances(), r.get_distances() + packet_width);
+				}
+			}
+			return distances;
+		});
+}
+
+TEST(differential, ray_packet_axis_aligned_box)
+{ cross_check_ray_packets<box_3s>(); }
+
+TEST(differential, ray_packet_axis_aligned_cube)
+{ cross_check_ray_packets<cube_3s>(); }
+
+TEST(differential, ray_packet_sphere)
+{ cross_check_ray_packets<sphere_3s>(); }
+
+TEST(differential, ray_packet_plane)
+{ cross_check_ray_packets<plane_3s>(); }
+
+/// @brief Get frusta with the planes of a class of geometries and a perspective frustum.
+static std::vector<frustum_3s> make_frusta(generator_3s& g, geometry_class c)
+{
+	std::vector<frustum_3s> frusta;
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		std::array<plane_3s, 6> planes;
+		for (auto& p : planes) p = g.plane(c);
+		frusta.emplace_back(planes);
+	}
+	frusta.emplace_back(idlib::matrix<single, 4, 4>(0.1f, 0.0f, 0.0f, 0.0f,
+	                                                0.0f, 0.1f, 0.0f, 0.0f,
+	                                                0.0f, 0.0f, -1.002f, -2.002f,
+	                                                0.0f, 0.0f, -1.0f, 0.0f));
+	return frusta;
+}
+
+/// @brief Get the bits of a bitmask as a vector.
+static void append_bits(const std::vector<std::uint32_t>& bits, std::size_t n, std::vector<int>& result)
+{
+	for (std::size_t i = 0; i < n; ++i) result.push_back(int((bits[i / 32] >> (i % 32)) & 1));
+}
+
+/// @brief Frusta and spheres in structure-of-arrays layout.
+struct sphere_input
+{
+	std::vector<frustum_3s> frusta;
+	std::vector<sphere_3s> spheres;
+	batch_3s centers;
+	std::vector<single> radii;
+};
+
+TEST(differential, cull_spheres)
+{
+	generator_3s g(2019);
+	cross_check(
+		[&g](geometry_class c)
+		{
+			sphere_input input{ make_frusta(g, c), g.generate<sphere_3s>(4099, c), batch_3s(), std::vector<single>() };
+			for (const auto& s : input.spheres)
+			{
+				input.centers.push_back(idlib::semantic_cast<idlib::vector<single, 3>>(s.get_center()));
+				input.radii.push_back(s.get_radius());
+			}
+			return input;
+		},
+		[](const sphere_input& input)
+		{
+			std::vector<int> result;
+			for (const auto& f : input.frusta)
+			{
+				for (const auto& s : input.spheres) result.push_back(idlib::is_intersecting(f, s) ? 1 : 0);
+			}
+			return result;
+		},
+		[](const sphere_input& input)
+		{
+			std::vector<int> result;
+			std::vector<std::uint32_t> bits((input.spheres.size() + 31) / 32);
+			for (const auto& f : input.frusta)
+			{
+				idlib::cull_spheres(f, input.centers, input.radii, bits, 1);
+				append_bits(bits, input.spheres.size(), result);
+			}
+			return result;
+		});
+}
+
+/// @brief Frusta and boxes in structure-of-arrays layout.
+struct box_input
+{
+	std::vector<frustum_3s> frusta;
+	std::vector<box_3s> boxes;
+	batch_3s min, max;
+};
+
+TEST(differential, cull_boxes)
+{
+	generator_3s g(2020);
+	cross_check(
+		[&g](geometry_class c)
+		{
+			box_input input{ make_frusta(g, c), g.generate<box_3s>(4099, c), batch_3s(), batch_3s() };
+			for (const auto& b : input.boxes)
+			{
+				input.min.push_back(idlib::semantic_cast<idlib::vector<single, 3>>(b.get_min()));
+				input.max.push_back(idlib::semantic_cast<idlib::vector<single, 3>>(b.get_max()));
+			}
+			return input;
+		},
+		[](const box_input& input)
+		{
+			std::vector<int> result;
+			for (const auto& f : input.frusta)
+			{
+				for (const auto& b : input.boxes) result.push_back(idlib::is_intersecting(f, b) ? 1 : 0);
+			}
+			return result;
+		},
+		[](const box_input& input)
+		{
+			std::vector<int> result;
+			std::vector<std::uint32_t> bits((input.boxes.size() + 31) / 32);
+			for (const auto& f : input.frusta)
+			{
+				idlib::cull_boxes(f, input.min, input.max, bits, 1);
+				append_bits(bits, input.boxes.size(), result);
+			}
+			return result;
+		});
+}
+
+/// @brief Get boxes clipped to a parent box.
+/// @remark Quantization requires finite boxes enclosed by the parent box, hence non-finite boxes are replaced by the parent box.
+static std::vector<box_3s> clip(const std::vector<box_3s>& boxes, const box_3s& parent)
+{
+	std::vector<box_3s> result;
+	for (const auto& b : boxes)
+	{
+		point_3s min = parent.get_min(), max = parent.get_max();
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			if (!std::isfinite(b.get_min()[i]) || !std::isfinite(b.get_max()[i])) continue;
+			min[i] = std::min(std::max(b.get_min()[i], parent.get_min()[i]), parent.get_max()[i]);
+			max[i] = std::max(std::min(b.get_max()[i], parent.get_max()[i]), parent.get_min()[i]);
+		}
+		result.emplace_back(min, max);
+	}
+	return result;
+}
+
+template <typename I>
+static void cross_check_quantized_boxes()
+{
+	using quantizer_type = idlib::box_quantizer<point_3s, I>;
+	generator_3s g(2021);
+	const box_3s parent(point_3s(-60.0f, -60.0f, -60.0f), point_3s(60.0f, 60.0f, 60.0f));
+	const quantizer_type quantizer(parent);
+	const auto make_input = [&](geometry_class c)
+	{
+		idlib::quantized_box_batch<point_3s, I> boxes;
+		quantizer.encode(clip(g.generate<box_3s>(4099, c), parent), boxes, 1);
+		std::vector<idlib::quantized_box<point_3s, I>> queries;
+		for (const auto& b : g.generate<box_3s>(8, c))
+		{
+			idlib::quantized_box<point_3s, I> q;
+			if (quantizer.encode_intersection(clip(std::vector<box_3s>{ b }, parent)[0], q)) queries.push_back(q);
+		}
+		return std::make_pair(boxes, queries);
+	};
+	cross_check(make_input,
+		[](const auto& input)
+		{
+			std::vector<int> result;
+			for (const auto& q : input.second)
+			{
+				for (std::size_t i = 0; i < input.first.size(); ++i) result.push_back(idlib::is_intersecting(input.first.get(i), q) ? 1 : 0);
+			}
+			return result;
+		},
+		[](const auto& input)
+		{
+			std::vector<int> result;
+			std::vector<std::uint32_t> bits((input.first.size() + 31) / 32);
+			for (const auto& q : input.second)
+			{
+				idlib::is_intersecting(input.first, q, bits, 1);
+				append_bits(bits, input.first.size(), result);
+			}
+			return result;
+		});
+	cross_check(make_input,
+		[&quantizer](const auto& input)
+		{
+			std::vector<single> result;
+			for (std::size_t i = 0; i < input.first.size(); ++i)
+			{
+				const auto b = quantizer.decode(input.first.get(i));
+				for (std::size_t j = 0; j < 3; ++j) result.push_back(b.get_min()[j]);
+				for (std::size_t j = 0; j < 3; ++j) result.push_back(b.get_max()[j]);
+			}
+			return result;
+		},
+		[&quantizer](const auto& input)
+		{
+			batch_3s min, max;
+			quantizer.decode(input.first, min, max, 1);
+			std::vector<single> result;
+			for (std::size_t i = 0; i < input.first.size(); ++i)
+			{
+				for (std::size_t j = 0; j < 3; ++j) result.push_back(min.data(j)[i]);
+				for (std::size_t j = 0; j < 3; ++j) result.push_back(max.data(j)[i]);
+			}
+			return result;
+		});
+}
+
+TEST(differential, quantized_box_uint16)
+{ cross_check_quantized_boxes<std::uint16_t>(); }
+
+TEST(differential, quantized_box_uint8)
+{ cross_check_quantized_boxes<std::uint8_t>(); }
+
+/// @brief Cross-check the box of the end points of lines against the component-wise minima and maxima.
+/// @remark idlib::enclose_points requires finite points, hence non-finite lines are replaced by degenerate lines.
+TEST(differential, enclose_points)
+{
+	generator_3s g(2022);
+	cross_check(
+		[&g](geometry_class c)
+		{
+			std::vector<point_3s> points;
+			for (const auto& l : g.generate<line_3s>(8191, c == geometry_class::non_finite ? geometry_class::degenerate : c))
+			{
+				points.push_back(l.get_a());
+				points.push_back(l.get_b());
+			}
+			return points;
+		},
+		[](const auto& input)
+		{
+			std::vector<single> result(6);
+			for (std::size_t j = 0; j < 3; ++j)
+			{
+				result[j] = result[3 + j] = input[0][j];
+				for (const auto& p : input)
+				{
+					result[j] = std::min(result[j], p[j]);
+					result[3 + j] = std::max(result[3 + j], p[j]);
+				}
+			}
+			return result;
+		},
+		[](const auto& input)
+		{
+			const auto b = idlib::enclose_points<point_3s>(input, 1);
+			return std::vector<single>{ b.get_min()[0], b.get_min()[1], b.get_min()[2], b.get_max()[0], b.get_max()[1], b.get_max()[2] };
+		});
+}
+
+} } } // namespace idlib::math::tests
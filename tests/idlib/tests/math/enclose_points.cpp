@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <algorithm>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using point_2d = idlib::point<idlib::vector<double, 2>>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+using sphere_2d = idlib::sphere<point_2d>;
+
+template <typename P>
+static std::vector<P> random_points(std::size_t n, typename P::scalar_type extent)
+{
+	idlib::rng rng(2018);
+	std::vector<P> points;
+	for (std::size_t i = 0; i < n; ++i)
+	{ points.push_back(idlib::random<P>(&rng, idlib::interval<typename P::scalar_type>(-extent, +extent))); }
+	return points;
+}
+
+template <typename P>
+static bool is_enclosing(const idlib::sphere<P>& s, const std::vector<P>& points)
+{
+	return std::all_of(points.cbegin(), points.cend(), [&s](const P& p)
+	{ return idlib::squared_euclidean_norm(p - s.get_center()) <= s.get_radius_squared(); });
+}
+
+/// @brief Assert the box is the box of the component-wise minima and maxima,
+/// in particular for numbers of points which are not multiples of the SIMD width.
+TEST(enclose_points, box)
+{
+	for (std::size_t n : { 1, 2, 3, 7, 8, 9, 17, 1000, 200003 })
+	{
+		const auto points = random_points<point_3s>(n, 100.0f);
+		point_3s lower = points[0], upper = points[0];
+		for (const auto& p : points)
+		{
+			for (std::size_t c = 0; c < 3; ++c)
+			{
+				lower[c] = std::min(lower[c], p[c]);
+				upper[c] = std::max(upper[c], p[c]);
+			}
+		}
+		const box_3s expected(lower, upper);
+		ASSERT_EQ(expected, idlib::enclose_points<point_3s>(points, 1));
+		ASSERT_EQ(expected, idlib::enclose_points<point_3s>(points, 4));
+	}
+	const std::vector<point_2d> points{ point_2d(1.0, -1.0), point_2d(-2.0, 5.0), point_2d(3.0, 0.0) };
+	ASSERT_EQ(idlib::axis_aligned_box<point_2d>(point_2d(-2.0, -1.0), point_2d(3.0, 5.0)), idlib::enclose_points<point_2d>(points));
+}
+
+/// @brief Assert the spheres enclose the points and the sphere of Welzl's algorithm is not greater than the sphere of Ritter's algorithm.
+TEST(enclose_points, sphere)
+{
+	for (std::size_t n : { 1, 2, 5, 100, 200003 })
+	{
+		const auto points = random_points<point_3s>(n, 100.0f);
+		for (std::size_t thread_count : { 1, 4 })
+		{
+			const sphere_3s r = idlib::enclose_points_ritter<point_3s>(points, thread_count);
+			const sphere_3s w = idlib::enclose_points_welzl<point_3s>(points, thread_count);
+			ASSERT_TRUE(is_enclosing(r, points));
+			ASSERT_TRUE(is_enclosing(w, points));
+			ASSERT_LE(w.get_radius(), r.get_radius() * 1.0001f);
+		}
+	}
+	const auto points = random_points<point_2d>(10000, 1.0);
+	ASSERT_TRUE(is_enclosing(idlib::enclose_points_ritter<point_2d>(points), points));
+	ASSERT_TRUE(is_enclosing(idlib::enclose_points_welzl<point_2d>(points), points));
+}
+
+/// @brief Assert the minimal enclosing spheres of known configurations.
+TEST(enclose_points, welzl)
+{
+	// The points on the boundary of the unit circle and points inside of the circle.
+	std::vector<point_2d> points{ point_2d(0.0, 0.0), point_2d(0.5, 0.5), point_2d(0.0, 1.0), point_2d(1.0, 0.0),
+	                              point_2d(-0.5, 0.0), point_2d(0.0, -1.0), point_2d(-1.0, 0.0), point_2d(0.1, -0.7) };
+	sphere_2d s = idlib::enclose_points_welzl<point_2d>(points);
+	ASSERT_NEAR(0.0, s.get_center().x(), 1e-12);
+	ASSERT_NEAR(0.0, s.get_center().y(), 1e-12);
+	ASSERT_NEAR(1.0, s.get_radius(), 1e-12);
+	// An obtuse triangle: the sphere is determined by its longest edge.
+	points = { point_2d(-2.0, 0.0), point_2d(2.0, 0.0), point_2d(0.0, 0.5) };
+	s = idlib::enclose_points_welzl<point_2d>(points);
+	ASSERT_NEAR(0.0, s.get_center().x(), 1e-12);
+	ASSERT_NEAR(0.0, s.get_center().y(), 1e-12);
+	ASSERT_NEAR(2.0, s.get_radius(), 1e-12);
+	// The vertices of a regular tetrahedron.
+	const std::vector<point_3s> tetrahedron{ point_3s(1.0f, 1.0f, 1.0f), point_3s(1.0f, -1.0f, -1.0f),
+	                                         point_3s(-1.0f, 1.0f, -1.0f), point_3s(-1.0f, -1.0f, 1.0f) };
+	const sphere_3s t = idlib::enclose_points_welzl<point_3s>(tetrahedron);
+	ASSERT_NEAR(0.0f, idlib::euclidean_norm(t.get_center() - point_3s(0.0f, 0.0f, 0.0f)), 1e-5f);
+	ASSERT_NEAR(std::sqrt(3.0f), t.get_radius(), 1e-5f);
+	// Coincident and collinear points.
+	const std::vector<point_3s> coincident(5, point_3s(1.0f, 2.0f, 3.0f));
+	ASSERT_EQ(0.0f, idlib::enclose_points_welzl<point_3s>(coincident).get_radius());
+	const std::vector<point_3s> collinear{ point_3s(0.0f, 0.0f, 0.0f), point_3s(1.0f, 0.0f, 0.0f), point_3s(4.0f, 0.0f, 0.0f), point_3s(2.0f, 0.0f, 0.0f) };
+	ASSERT_NEAR(2.0f, idlib::enclose_points_welzl<point_3s>(collinear).get_radius(), 1e-5f);
+}
+
+TEST(enclose_points, invalid_arguments)
+{
+	const std::vector<point_3s> points;
+	ASSERT_THROW(idlib::enclose_points<point_3s>(points), idlib::invalid_argument_error);
+	ASSERT_THROW(idlib::enclose_points_ritter<point_3s>(points), idlib::invalid_argument_error);
+	ASSERT_THROW(idlib::enclose_points_welzl<point_3s>(points), idlib::invalid_argument_error);
+}
+
+} } } // namespace idlib::math::tests
@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+
+namespace idlib { namespace math { namespace tests {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+
+/// @brief Assert lazily evaluated vector expressions are identical to eagerly evaluated vector expressions.
+TEST(expression, vector)
+{
+	idlib::rng rng(2018);
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		auto a = idlib::random<vector_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f)),
+			 b = idlib::random<vector_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f)),
+			 c = idlib::random<vector_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f)),
+			 d = idlib::random<vector_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f));
+		single s = rng.next(idlib::interval<single>(-10.0f, +10.0f));
+		vector_3s x = idlib::lazy(a) + idlib::lazy(b) * s - c;
+		ASSERT_EQ(x, a + b * s - c);
+		vector_3s y = -(idlib::lazy(a) - b) * s + (idlib::lazy(c) + d) - a * 2.0f;
+		ASSERT_EQ(y, -(a - b) * s + (c + d) - a * 2.0f);
+		ASSERT_EQ(idlib::evaluate(idlib::lazy(a) + b + c + d), a + b + c + d);
+	}
+}
+
+/// @brief Assert lazily evaluated point expressions are identical to eagerly evaluated point expressions.
+TEST(expression, point)
+{
+	idlib::rng rng(2018);
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		auto p = idlib::random<point_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f)),
+			 q = idlib::random<point_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f));
+		auto u = idlib::random<vector_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f)),
+			 v = idlib::random<vector_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f));
+		point_3s x = idlib::lazy(p) + u - v;
+		ASSERT_EQ(x, p + u - v);
+		vector_3s y = idlib::lazy(p) - q + u * 0.5f;
+		ASSERT_EQ(y, p - q + u * 0.5f);
+	}
+}
+
+} } } // namespace idlib::math::tests
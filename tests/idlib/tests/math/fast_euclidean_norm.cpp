@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+
+namespace idlib { namespace math { namespace tests {
+
+/// @brief Assert the relative errors of the approximated norms and normalized vectors are within the error bounds
+/// and the batch variants produce the same results as the functions on individual vectors.
+template <typename Scalar, size_t Refinements>
+void assert_fast_euclidean_norm()
+{
+	using vector_type = idlib::vector<Scalar, 3>;
+	using norm_type = idlib::fast_euclidean_norm_functor<vector_type, Refinements>;
+	static constexpr Scalar bound = norm_type::error_bound();
+	idlib::rng rng(2018);
+	std::vector<vector_type> vectors;
+	for (int e = -15; e <= 15; ++e)
+	{
+		auto scale = std::pow(Scalar(10), Scalar(e));
+		for (size_t i = 0; i < 1000; ++i)
+		{ vectors.push_back(idlib::random<vector_type>(&rng, idlib::interval<Scalar>(Scalar(-1), Scalar(+1))) * scale); }
+	}
+	vectors.push_back(idlib::zero<vector_type>());
+	for (const auto& v : vectors)
+	{
+		auto l = idlib::euclidean_norm(v), m = idlib::fast_euclidean_norm<Refinements>(v);
+		auto u = idlib::normalize(v, idlib::euclidean_norm_functor<vector_type>()).get_vector_or_default(),
+			 w = idlib::normalize(v, norm_type()).get_vector_or_default();
+		if (l == Scalar(0))
+		{
+			ASSERT_EQ(m, Scalar(0));
+			ASSERT_EQ(w, v);
+			ASSERT_THROW(idlib::normalize(v, norm_type()).get_vector(), std::domain_error);
+			continue;
+		}
+		ASSERT_LE(std::abs(m - l), bound * l);
+		for (size_t j = 0; j < 3; ++j)
+		{ ASSERT_LE(std::abs(w[j] - u[j]), bound * std::abs(u[j])); }
+	}
+	idlib::vector_batch<Scalar, 3> a(vectors), r;
+	std::vector<Scalar> s;
+	idlib::euclidean_norm(a, s, norm_type());
+	idlib::normalize(a, r, norm_type());
+	for (size_t i = 0; i < vectors.size(); ++i)
+	{
+		ASSERT_EQ(s[i], idlib::fast_euclidean_norm<Refinements>(vectors[i]));
+		ASSERT_EQ(r.get(i), idlib::normalize(vectors[i], norm_type()).get_vector_or_default());
+	}
+}
+
+TEST(fast_euclidean_norm, single_0)
+{ assert_fast_euclidean_norm<single, 0>(); }
+
+TEST(fast_euclidean_norm, single_1)
+{ assert_fast_euclidean_norm<single, 1>(); }
+
+TEST(fast_euclidean_norm, single_2)
+{ assert_fast_euclidean_norm<single, 2>(); }
+
+TEST(fast_euclidean_norm, double_0)
+{ assert_fast_euclidean_norm<double, 0>(); }
+
+TEST(fast_euclidean_norm, double_1)
+{ assert_fast_euclidean_norm<double, 1>(); }
+
+TEST(fast_euclidean_norm, double_2)
+{ assert_fast_euclidean_norm<double, 2>(); }
+
+} } } // namespace idlib::math::tests
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <algorithm>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using vector_3s = idlib::vector<single, 3>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using cube_3s = idlib::axis_aligned_cube<point_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+using frustum_3s = idlib::frustum<point_3s>;
+using matrix_4s = idlib::matrix<single, 4, 4>;
+using batch_3s = idlib::vector_batch<single, 3>;
+
+/// @brief Get a perspective projection looking along the negative z-axis with a field of view of 90 degrees.
+static matrix_4s perspective(single near_distance, single far_distance)
+{
+	const single a = -(far_distance + near_distance) / (far_distance - near_distance);
+	const single b = -2.0f * far_distance * near_distance / (far_distance - near_distance);
+	return matrix_4s(1.0f, 0.0f, 0.0f, 0.0f,
+	                 0.0f, 1.0f, 0.0f, 0.0f,
+	                 0.0f, 0.0f, a, b,
+	                 0.0f, 0.0f, -1.0f, 0.0f);
+}
+
+/// @brief Assert spheres and boxes inside, outside and intersecting the planes of frusta.
+TEST(frustum, is_intersecting)
+{
+	// The default frustum is the cube [-1,+1]^3.
+	const frustum_3s c;
+	ASSERT_EQ(c, frustum_3s(idlib::one<matrix_4s>()));
+	ASSERT_TRUE(idlib::is_intersecting(c, sphere_3s(point_3s(0.0f, 0.0f, 0.0f), 0.5f)));
+	ASSERT_TRUE(idlib::is_intersecting(c, sphere_3s(point_3s(1.5f, 0.0f, 0.0f), 0.5f)));
+	ASSERT_FALSE(idlib::is_intersecting(c, sphere_3s(point_3s(1.5f, 0.0f, 0.0f), 0.25f)));
+	ASSERT_TRUE(idlib::is_intersecting(box_3s(point_3s(0.5f, 0.5f, 0.5f), point_3s(3.0f, 3.0f, 3.0f)), c));
+	ASSERT_FALSE(idlib::is_intersecting(box_3s(point_3s(-3.0f, -3.0f, 1.5f), point_3s(3.0f, 3.0f, 3.0f)), c));
+	// A perspective frustum with the near plane at 1 and the far plane at 100.
+	const frustum_3s p(perspective(1.0f, 100.0f));
+	ASSERT_TRUE(idlib::is_intersecting(p, sphere_3s(point_3s(0.0f, 0.0f, -10.0f), 0.1f)));
+	ASSERT_FALSE(idlib::is_intersecting(p, sphere_3s(point_3s(0.0f, 0.0f, -0.5f), 0.1f)));
+	ASSERT_FALSE(idlib::is_intersecting(p, sphere_3s(point_3s(0.0f, 0.0f, 10.0f), 1.0f)));
+	ASSERT_FALSE(idlib::is_intersecting(p, sphere_3s(point_3s(0.0f, 0.0f, -110.0f), 1.0f)));
+	ASSERT_FALSE(idlib::is_intersecting(p, sphere_3s(point_3s(20.0f, 0.0f, -10.0f), 1.0f)));
+	ASSERT_TRUE(idlib::is_intersecting(p, sphere_3s(point_3s(10.5f, 0.0f, -10.0f), 1.0f)));
+	ASSERT_TRUE(idlib::is_intersecting(sphere_3s(point_3s(-10.5f, 0.0f, -10.0f), 1.0f), p));
+	ASSERT_FALSE(idlib::is_intersecting(p, box_3s(point_3s(11.5f, -1.0f, -11.0f), point_3s(12.0f, 1.0f, -9.0f))));
+	ASSERT_TRUE(idlib::is_intersecting(p, box_3s(point_3s(9.0f, -1.0f, -11.0f), point_3s(12.0f, 1.0f, -9.0f))));
+}
+
+/// @brief Assert the bulk culling computes the bits of idlib::is_intersecting with one and more threads.
+/// The number of geometries is not a multiple of the number of bits of a word.
+TEST(frustum, cull)
+{
+	idlib::rng rng(2018);
+	const frustum_3s f(perspective(1.0f, 50.0f));
+	const size_t n = 200001;
+	batch_3s centers, min, max;
+	std::vector<single> radii;
+	std::vector<sphere_3s> spheres;
+	std::vector<box_3s> boxes;
+	for (size_t i = 0; i < n; ++i)
+	{
+		auto c = idlib::random<point_3s>(&rng, idlib::interval<single>(-60.0f, +60.0f));
+		auto r = idlib::random<single>(&rng, idlib::interval<single>(0.0f, 4.0f));
+		spheres.emplace_back(c, r);
+		boxes.emplace_back(c - idlib::one<vector_3s>() * r, c + idlib::one<vector_3s>() * (0.5f * r));
+		centers.push_back(idlib::semantic_cast<vector_3s>(c));
+		radii.push_back(r);
+		min.push_back(idlib::semantic_cast<vector_3s>(boxes.back().get_min()));
+		max.push_back(idlib::semantic_cast<vector_3s>(boxes.back().get_max()));
+	}
+	for (size_t thread_count : { 1, 4 })
+	{
+		std::vector<uint32_t> visible_spheres((n + 31) / 32, 0xffffffff), visible_boxes((n + 31) / 32, 0xffffffff);
+		idlib::cull_spheres(f, centers, radii, visible_spheres, thread_count);
+		idlib::cull_boxes(f, min, max, visible_boxes, thread_count);
+		size_t count = 0;
+		for (size_t i = 0; i < n; ++i)
+		{
+			const bool s = ((visible_spheres[i / 32] >> (i % 32)) & 1) != 0;
+			const bool b = ((visible_boxes[i / 32] >> (i % 32)) & 1) != 0;
+			ASSERT_EQ(s, idlib::is_intersecting(f, spheres[i])) << i;
+			ASSERT_EQ(b, idlib::is_intersecting(f, boxes[i])) << i;
+			count += s ? 1 : 0;
+		}
+		ASSERT_GT(count, 0);
+		ASSERT_LT(count, n);
+		// The bits beyond the geometries are cleared.
+		ASSERT_EQ(visible_spheres.back() >> (n % 32), 0);
+		ASSERT_EQ(visible_boxes.back() >> (n % 32), 0);
+	}
+}
+
+/// @brief Assert a loose octree finds the boxes intersecting a frustum.
+TEST(frustum, loose_octree)
+{
+	idlib::rng rng(2018);
+	const frustum_3s f(perspective(1.0f, 30.0f));
+	idlib::loose_octree<point_3s> octree(cube_3s(point_3s(0.0f, 0.0f, 0.0f), 64.0f));
+	std::vector<uint32_t> expected;
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		auto a = idlib::random<point_3s>(&rng, idlib::interval<single>(-32.0f, +32.0f));
+		const box_3s b(a, a + idlib::random<vector_3s>(&rng, idlib::interval<single>(0.0f, 2.0f)));
+		const auto h = octree.insert(b);
+		if (idlib::is_intersecting(f, b)) expected.push_back(h);
+	}
+	std::vector<uint32_t> found, planes;
+	octree.query(f, [&found](uint32_t h, const box_3s&) { found.push_back(h); });
+	octree.query_planes(idlib::span<const idlib::plane<point_3s>>(f.get_planes().data(), 6), [&planes](uint32_t h, const box_3s&) { planes.push_back(h); });
+	std::sort(expected.begin(), expected.end());
+	std::sort(found.begin(), found.end());
+	std::sort(planes.begin(), planes.end());
+	ASSERT_FALSE(expected.empty());
+	ASSERT_EQ(found, expected);
+	ASSERT_EQ(planes, expected);
+}
+
+/// @brief Assert invalid arguments are rejected.
+TEST(frustum, invalid_arguments)
+{
+	const frustum_3s f;
+	batch_3s a(33), b(32);
+	std::vector<single> radii(32);
+	std::vector<uint32_t> visible(1);
+	ASSERT_THROW(idlib::cull_spheres(f, a, radii, visible), idlib::invalid_argument_error);
+	ASSERT_THROW(idlib::cull_boxes(f, a, b, visible), idlib::invalid_argument_error);
+	ASSERT_THROW(idlib::cull_boxes(f, a, a, visible), idlib::invalid_argument_error);
+	ASSERT_THROW(frustum_3s(idlib::zero<matrix_4s>()), std::domain_error);
+}
+
+} } } // namespace idlib::math::tests
@@ -0,0 +1,208 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "idlib/idlib.hpp"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace idlib { namespace math { namespace tests {
+
+/// @brief The classes of generated geometries.
+enum class geometry_class
+{
+	/// @brief Geometries in general position.
+	regular,
+	/// @brief Geometries with zero extents, coincident coordinates, axis parallel directions, signed zeros and denormals.
+	degenerate,
+	/// @brief Geometries with a NaN or an infinite value.
+	non_finite,
+};
+
+/// @brief The classes of generated geometries.
+static const geometry_class geometry_classes[] = { geometry_class::regular, geometry_class::degenerate, geometry_class::non_finite };
+
+/// @brief Generates random spheres, axis aligned boxes, axis aligned cubes, planes, rays and lines for differential tests.
+/// @tparam P the point type
+template <typename P>
+struct geometry_generator
+{
+	using point_type = P;
+	using vector_type = typename P::vector_type;
+	using scalar_type = typename P::scalar_type;
+	using sphere_type = idlib::sphere<P>;
+	using box_type = idlib::axis_aligned_box<P>;
+	using cube_type = idlib::axis_aligned_cube<P>;
+	using plane_type = idlib::plane<P>;
+	using ray_type = idlib::ray<P>;
+	using line_type = idlib::line<P>;
+
+	/// @param seed the seed
+	/// @param extent the coordinates of regular geometries are within \f$[-e,+e]\f$
+	explicit geometry_generator(std::uint64_t seed, scalar_type extent = scalar_type(100))
+		: m_rng(idlib::rng_engine::xoshiro256_star_star, seed), m_extent(extent)
+	{}
+
+	/// @brief Get a random integer within \f$[0,n)\f$.
+	int index(int n)
+	{ return m_rng.next(idlib::interval<int>(0, n - 1)); }
+
+	/// @brief Get a coordinate.
+	/// @remark Degenerate coordinates are on a coarse grid such that coordinates of different geometries coincide.
+	scalar_type coordinate(geometry_class c)
+	{
+		const scalar_type x = m_rng.next(idlib::interval<scalar_type>(-m_extent, +m_extent));
+		if (c != geometry_class::degenerate) return x;
+		switch (index(4))
+		{
+			case 0: return index(2) ? scalar_type(0) : -scalar_type(0);
+			case 1: return index(2) ? std::numeric_limits<scalar_type>::denorm_min() : -std::numeric_limits<scalar_type>::denorm_min();
+			default: return std::round(x / (m_extent / scalar_type(4))) * (m_extent / scalar_type(4));
+		};
+	}
+
+	/// @brief Get a non-negative value such as a radius.
+	scalar_type magnitude(geometry_class c)
+	{
+		switch (c)
+		{
+			case geometry_class::regular: return m_rng.next(idlib::interval<scalar_type>(scalar_type(0), m_extent / scalar_type(4)));
+			case geometry_class::degenerate: return index(2) ? scalar_type(0) : std::numeric_limits<scalar_type>::denorm_min();
+			default: return index(2) ? std::numeric_limits<scalar_type>::quiet_NaN() : std::numeric_limits<scalar_type>::infinity();
+		};
+	}
+
+	/// @brief Get a NaN, a positive infinity or a negative infinity.
+	scalar_type non_finite()
+	{
+		switch (index(3))
+		{
+			case 0: return std::numeric_limits<scalar_type>::quiet_NaN();
+			case 1: return +std::numeric_limits<scalar_type>::infinity();
+			default: return -std::numeric_limits<scalar_type>::infinity();
+		};
+	}
+
+	/// @brief Get a point.
+	/// @remark One coordinate of a non-finite point is not finite.
+	point_type point(geometry_class c)
+	{
+		point_type p;
+		for (std::size_t i = 0; i < P::dimensionality(); ++i) p[i] = coordinate(c);
+		if (c == geometry_class::non_finite) p[index(int(P::dimensionality()))] = non_finite();
+		return p;
+	}
+
+	/// @brief Get a direction vector which is not the zero vector.
+	/// @remark Degenerate directions are parallel to one or more axes.
+	vector_type direction(geometry_class c)
+	{
+		while (true)
+		{
+			vector_type d;
+			for (std::size_t i = 0; i < P::dimensionality(); ++i) d[i] = m_rng.next(idlib::interval<scalar_type>(scalar_type(-1), scalar_type(+1)));
+			if (c == geometry_class::degenerate)
+			{
+				const std::size_t k = std::size_t(index(int(P::dimensionality())));
+				for (std::size_t i = 0; i < P::dimensionality(); ++i)
+				{
+					if (i != k && index(3) != 0) d[i] = index(2) ? scalar_type(0) : -scalar_type(0);
+				}
+			}
+			if (c == geometry_class::non_finite) d[index(int(P::dimensionality()))] = non_finite();
+			if (!(idlib::squared_euclidean_norm(d) > scalar_type(0.0001)) && c != geometry_class::non_finite) continue;
+			return d;
+		}
+	}
+
+	sphere_type sphere(geometry_class c)
+	{
+		if (c == geometry_class::non_finite && index(2))
+		{ return sphere_type(point(geometry_class::regular), magnitude(c)); }
+		return sphere_type(point(c), magnitude(c == geometry_class::non_finite ? geometry_class::regular : c));
+	}
+
+	/// @remark Degenerate boxes have zero extents along some axes.
+	box_type box(geometry_class c)
+	{
+		const point_type a = point(c);
+		point_type b = point(c == geometry_class::non_finite ? geometry_class::regular : c);
+		if (c == geometry_class::degenerate)
+		{
+			for (std::size_t i = 0; i < P::dimensionality(); ++i)
+			{
+				if (index(2)) b[i] = a[i];
+			}
+		}
+		return box_type(a, b);
+	}
+
+	cube_type cube(geometry_class c)
+	{
+		if (c == geometry_class::non_finite && index(2))
+		{ return cube_type(point(geometry_class::regular), magnitude(c)); }
+		return cube_type(point(c), magnitude(c == geometry_class::non_finite ? geometry_class::regular : c));
+	}
+
+	/// @remark Degenerate planes are axis aligned through points on the grid.
+	plane_type plane(geometry_class c)
+	{ return plane_type(point(c), direction(c)); }
+
+	ray_type ray(geometry_class c)
+	{ return ray_type(point(c), direction(c)); }
+
+	/// @remark The end points of degenerate lines may coincide.
+	line_type line(geometry_class c)
+	{
+		const point_type a = point(c);
+		return line_type(a, c == geometry_class::degenerate && index(2) ? a : point(c));
+	}
+
+	/// @brief Get @a n geometries.
+	/// @tparam G the geometry type
+	template <typename G>
+	std::vector<G> generate(std::size_t n, geometry_class c)
+	{
+		std::vector<G> geometries;
+		for (std::size_t i = 0; i < n; ++i) geometries.push_back(get(c, static_cast<const G *>(nullptr)));
+		return geometries;
+	}
+
+private:
+	sphere_type get(geometry_class c, const sphere_type *) { return sphere(c); }
+	box_type get(geometry_class c, const box_type *) { return box(c); }
+	cube_type get(geometry_class c, const cube_type *) { return cube(c); }
+	plane_type get(geometry_class c, const plane_type *) { return plane(c); }
+	ray_type get(geometry_class c, const ray_type *) { return ray(c); }
+	line_type get(geometry_class c, const line_type *) { return line(c); }
+	point_type get(geometry_class c, const point_type *) { return point(c); }
+
+	idlib::rng m_rng;
+	scalar_type m_extent;
+
+}; // struct geometry_generator
+
+} } } // namespace idlib::math::tests
@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <algorithm>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using vector_3s = idlib::vector<single, 3>;
+using neighbor_s = idlib::kd_tree_neighbor<single>;
+
+static std::vector<point_3s> random_points(idlib::rng& rng, std::size_t n, single extent)
+{
+	std::vector<point_3s> points;
+	for (std::size_t i = 0; i < n; ++i)
+	{ points.push_back(idlib::random<point_3s>(&rng, idlib::interval<single>(-extent, +extent))); }
+	return points;
+}
+
+/// @brief Get the distances of all points from a query point in ascending order.
+template <typename Norm>
+static std::vector<single> brute_force(const std::vector<point_3s>& points, const point_3s& q)
+{
+	std::vector<single> distances;
+	for (const auto& p : points) distances.push_back(Norm()(p - q));
+	std::sort(distances.begin(), distances.end());
+	return distances;
+}
+
+/// @brief Assert the neighbors of k-NN and radius queries are the neighbors found by brute force.
+template <typename Norm>
+static void assert_queries(std::size_t n, std::size_t leaf_size, std::size_t thread_count)
+{
+	idlib::rng rng(2018);
+	const auto points = random_points(rng, n, 100.0f);
+	const auto queries = random_points(rng, 50, 110.0f);
+	const idlib::kd_tree<point_3s, Norm> tree(points, leaf_size, thread_count);
+	ASSERT_EQ(n, tree.size());
+	std::vector<neighbor_s> neighbors;
+	for (const auto& q : queries)
+	{
+		const auto expected = brute_force<Norm>(points, q);
+		for (std::size_t k : { 1, 7, 64 })
+		{
+			tree.query_nearest(q, k, neighbors);
+			ASSERT_EQ(std::min(k, n), neighbors.size());
+			for (std::size_t i = 0; i < neighbors.size(); ++i)
+			{
+				ASSERT_EQ(expected[i], neighbors[i].distance);
+				ASSERT_EQ(Norm()(points[neighbors[i].index] - q), neighbors[i].distance);
+			}
+		}
+		const single radius = expected[std::min<std::size_t>(n - 1, 20)];
+		tree.query_radius(q, radius, neighbors);
+		const std::size_t count = std::upper_bound(expected.cbegin(), expected.cend(), radius) - expected.cbegin();
+		ASSERT_EQ(count, neighbors.size());
+		for (const auto& neighbor : neighbors)
+		{
+			ASSERT_LE(neighbor.distance, radius);
+			ASSERT_EQ(Norm()(points[neighbor.index] - q), neighbor.distance);
+		}
+	}
+}
+
+TEST(kd_tree, squared_euclidean_norm)
+{
+	assert_queries<idlib::squared_euclidean_norm_functor<vector_3s>>(1, 8, 1);
+	assert_queries<idlib::squared_euclidean_norm_functor<vector_3s>>(5, 8, 1);
+	assert_queries<idlib::squared_euclidean_norm_functor<vector_3s>>(1000, 1, 1);
+	assert_queries<idlib::squared_euclidean_norm_functor<vector_3s>>(10007, 8, 4);
+}
+
+TEST(kd_tree, other_norms)
+{
+	assert_queries<idlib::manhattan_norm_functor<vector_3s>>(3001, 4, 2);
+	assert_queries<idlib::maximum_norm_functor<vector_3s>>(3001, 16, 2);
+}
+
+/// @brief Assert queries of a tree with many equal points.
+TEST(kd_tree, duplicates)
+{
+	std::vector<point_3s> points(100, point_3s(1.0f, 2.0f, 3.0f));
+	points.push_back(point_3s(5.0f, 2.0f, 3.0f));
+	const idlib::kd_tree<point_3s> tree(points, 2);
+	std::vector<neighbor_s> neighbors;
+	tree.query_nearest(point_3s(6.0f, 2.0f, 3.0f), 2, neighbors);
+	ASSERT_EQ(2, neighbors.size());
+	ASSERT_EQ(100, neighbors[0].index);
+	ASSERT_EQ(1.0f, neighbors[0].distance);
+	ASSERT_EQ(25.0f, neighbors[1].distance);
+	tree.query_radius(point_3s(1.0f, 2.0f, 3.0f), 0.0f, neighbors);
+	ASSERT_EQ(100, neighbors.size());
+}
+
+/// @brief Assert batched queries return the results of single queries.
+TEST(kd_tree, batched_queries)
+{
+	idlib::rng rng(2018);
+	const auto points = random_points(rng, 5000, 100.0f);
+	const auto queries = random_points(rng, 1000, 100.0f);
+	const idlib::kd_tree<point_3s> tree(points);
+	const std::size_t k = 5;
+	std::vector<neighbor_s> result(queries.size() * k);
+	tree.query_nearest(queries, k, result, 4);
+	std::vector<std::vector<neighbor_s>> radius_result;
+	tree.query_radius(queries, 100.0f, radius_result, 4);
+	ASSERT_EQ(queries.size(), radius_result.size());
+	std::vector<neighbor_s> neighbors;
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		tree.query_nearest(queries[i], k, neighbors);
+		for (std::size_t j = 0; j < k; ++j)
+		{ ASSERT_EQ(neighbors[j].distance, result[i * k + j].distance); }
+		tree.query_radius(queries[i], 100.0f, neighbors);
+		ASSERT_EQ(neighbors.size(), radius_result[i].size());
+	}
+	// Missing neighbors are padded.
+	const idlib::kd_tree<point_3s> small_tree(std::vector<point_3s>{ point_3s(0.0f, 0.0f, 0.0f) });
+	result.resize(3);
+	small_tree.query_nearest(std::vector<point_3s>{ point_3s(1.0f, 0.0f, 0.0f) }, 3, result);
+	ASSERT_EQ(0, result[0].index);
+	ASSERT_EQ(idlib::kd_tree<point_3s>::invalid_index, result[1].index);
+	ASSERT_EQ(std::numeric_limits<single>::infinity(), result[2].distance);
+}
+
+TEST(kd_tree, invalid_arguments)
+{
+	const idlib::kd_tree<point_3s> empty_tree;
+	std::vector<neighbor_s> neighbors;
+	empty_tree.query_nearest(point_3s(0.0f, 0.0f, 0.0f), 3, neighbors);
+	ASSERT_TRUE(neighbors.empty());
+	const std::vector<point_3s> points{ point_3s(0.0f, 0.0f, 0.0f) };
+	ASSERT_THROW(idlib::kd_tree<point_3s>(points, 0), idlib::invalid_argument_error);
+	const std::vector<point_3s> nan_points{ point_3s(0.0f, std::numeric_limits<single>::quiet_NaN(), 0.0f) };
+	ASSERT_THROW(idlib::kd_tree<point_3s>{ nan_points }, idlib::invalid_argument_error);
+	const idlib::kd_tree<point_3s> tree(points);
+	std::vector<neighbor_s> result(2);
+	ASSERT_THROW(tree.query_nearest(points, 3, result), idlib::invalid_argument_error);
+}
+
+} } } // namespace idlib::math::tests
@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <algorithm>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using vector_3s = idlib::vector<single, 3>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using cube_3s = idlib::axis_aligned_cube<point_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+using plane_3s = idlib::plane<point_3s>;
+using octree_3s = idlib::loose_octree<point_3s>;
+
+static box_3s random_box(idlib::rng& rng, single extent, single size)
+{
+	auto a = idlib::random<point_3s>(&rng, idlib::interval<single>(-extent, +extent));
+	auto s = idlib::random<vector_3s>(&rng, idlib::interval<single>(0.0f, size));
+	return box_3s(a, a + s);
+}
+
+/// @brief Visit the boxes of an octree intersecting a query geometry and return their sorted handles.
+template <typename Q>
+static std::vector<uint32_t> query(const octree_3s& octree, const Q& q)
+{
+	std::vector<uint32_t> found;
+	octree.query(q, [&found](uint32_t h, const box_3s&) { found.push_back(h); });
+	std::sort(found.begin(), found.end());
+	return found;
+}
+
+/// @brief Find the boxes intersecting a query geometry by testing all boxes.
+template <typename Q>
+static std::vector<uint32_t> brute_force(const octree_3s& octree, const std::vector<uint32_t>& handles, const Q& q)
+{
+	std::vector<uint32_t> found;
+	for (auto h : handles)
+	{
+		if (idlib::is_intersecting(q, octree.get(h))) found.push_back(h);
+	}
+	std::sort(found.begin(), found.end());
+	return found;
+}
+
+/// @brief Assert the sphere and box queries find the boxes found by testing all boxes.
+/// Some boxes are outside of the bounds and some are larger than the bounds.
+TEST(loose_octree, queries)
+{
+	idlib::rng rng(2018);
+	octree_3s octree(cube_3s(point_3s(0.0f, 0.0f, 0.0f), 64.0f), 6);
+	std::vector<uint32_t> handles;
+	for (size_t i = 0; i < 2000; ++i) handles.push_back(octree.insert(random_box(rng, 40.0f, 3.0f)));
+	handles.push_back(octree.insert(random_box(rng, 40.0f, 100.0f)));
+	ASSERT_EQ(octree.size(), handles.size());
+	for (size_t i = 0; i < 50; ++i)
+	{
+		const auto b = random_box(rng, 40.0f, 10.0f);
+		ASSERT_EQ(query(octree, b), brute_force(octree, handles, b));
+		const sphere_3s s(idlib::random<point_3s>(&rng, idlib::interval<single>(-40.0f, +40.0f)), 6.0f);
+		const auto found = query(octree, s);
+		ASSERT_EQ(found, brute_force(octree, handles, s));
+	}
+	// The loose cubes enclose their boxes unless the boxes are stored in the root.
+	for (auto h : handles)
+	{
+		const auto c = octree.get_loose_cube(h);
+		if (c.get_size() == 128.0f) continue;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			ASSERT_LE(c.get_min()[i], octree.get(h).get_min()[i] + 1e-4f);
+			ASSERT_GE(c.get_max()[i], octree.get(h).get_max()[i] - 1e-4f);
+		}
+	}
+}
+
+/// @brief Assert the plane query visits exactly the boxes not outside of any plane.
+TEST(loose_octree, planes)
+{
+	idlib::rng rng(2018);
+	octree_3s octree(cube_3s(point_3s(0.0f, 0.0f, 0.0f), 64.0f));
+	std::vector<uint32_t> handles;
+	for (size_t i = 0; i < 2000; ++i) handles.push_back(octree.insert(random_box(rng, 32.0f, 2.0f)));
+	// A frustum-like wedge with the normals pointing inwards.
+	const std::vector<plane_3s> planes
+	{
+		plane_3s(1.0f, 0.0f, 0.2f, 5.0f),
+		plane_3s(-1.0f, 0.0f, 0.2f, 5.0f),
+		plane_3s(0.0f, 1.0f, 0.2f, 5.0f),
+		plane_3s(0.0f, -1.0f, 0.2f, 5.0f),
+		plane_3s(0.0f, 0.0f, 1.0f, 0.0f),
+		plane_3s(0.0f, 0.0f, -1.0f, 20.0f),
+	};
+	std::vector<uint32_t> expected, found;
+	for (auto h : handles)
+	{
+		const auto& b = octree.get(h);
+		bool outside = false;
+		for (const auto& p : planes)
+		{
+			single d = p.get_distance();
+			for (size_t i = 0; i < 3; ++i) d += p.get_normal()[i] * (p.get_normal()[i] >= 0.0f ? b.get_max()[i] : b.get_min()[i]);
+			outside = outside || d < 0.0f;
+		}
+		if (!outside) expected.push_back(h);
+	}
+	octree.query_planes(planes, [&found](uint32_t h, const box_3s&) { found.push_back(h); });
+	std::sort(found.begin(), found.end());
+	ASSERT_FALSE(expected.empty());
+	ASSERT_LT(expected.size(), handles.size());
+	ASSERT_EQ(found, expected);
+}
+
+/// @brief Assert the queries remain correct and the nodes are released if boxes are moved and removed.
+TEST(loose_octree, move_and_remove)
+{
+	idlib::rng rng(2018);
+	octree_3s octree(cube_3s(point_3s(0.0f, 0.0f, 0.0f), 64.0f));
+	std::vector<uint32_t> handles;
+	for (size_t i = 0; i < 1000; ++i) handles.push_back(octree.insert(random_box(rng, 30.0f, 2.0f)));
+	for (size_t step = 0; step < 10; ++step)
+	{
+		for (auto h : handles)
+		{
+			auto d = idlib::random<vector_3s>(&rng, idlib::interval<single>(-1.0f, +1.0f));
+			const auto& b = octree.get(h);
+			octree.move(h, box_3s(b.get_min() + d, b.get_max() + d));
+		}
+		const sphere_3s s(idlib::random<point_3s>(&rng, idlib::interval<single>(-30.0f, +30.0f)), 10.0f);
+		ASSERT_EQ(query(octree, s), brute_force(octree, handles, s));
+	}
+	// The number of nodes is bounded.
+	const auto usage = octree.get_memory_usage();
+	ASSERT_EQ(usage.object_count, handles.size());
+	ASSERT_LE(usage.node_count, 1 + handles.size() * octree.get_max_depth());
+	ASSERT_GT(usage.get_bytes_per_object(), 0);
+	// Remove every other box.
+	std::vector<uint32_t> remaining;
+	for (size_t i = 0; i < handles.size(); ++i)
+	{
+		if (i % 2 == 0) octree.remove(handles[i]);
+		else remaining.push_back(handles[i]);
+	}
+	ASSERT_FALSE(octree.contains(handles[0]));
+	ASSERT_EQ(octree.size(), remaining.size());
+	const box_3s all(point_3s(-100.0f, -100.0f, -100.0f), point_3s(100.0f, 100.0f, 100.0f));
+	ASSERT_EQ(query(octree, all), remaining);
+	// Compaction releases storage and keeps the handles.
+	const size_t node_count = octree.get_node_count();
+	octree.compact();
+	ASSERT_EQ(octree.get_node_count(), node_count);
+	ASSERT_EQ(query(octree, all), remaining);
+	ASSERT_LE(octree.get_memory_usage().get_bytes(), usage.get_bytes());
+	// Removing all boxes releases all nodes but the root.
+	for (auto h : remaining) octree.remove(h);
+	ASSERT_TRUE(octree.empty());
+	ASSERT_EQ(octree.get_node_count(), 1);
+}
+
+/// @brief Assert invalid arguments are rejected.
+TEST(loose_octree, invalid_arguments)
+{
+	const single nan = std::numeric_limits<single>::quiet_NaN();
+	ASSERT_THROW(octree_3s(cube_3s(point_3s(0.0f, 0.0f, 0.0f), 0.0f)), idlib::invalid_argument_error);
+	ASSERT_THROW(octree_3s(cube_3s(point_3s(nan, 0.0f, 0.0f), 1.0f)), idlib::invalid_argument_error);
+	ASSERT_THROW(octree_3s(cube_3s(point_3s(0.0f, 0.0f, 0.0f), 1.0f), octree_3s::max_max_depth + 1), idlib::invalid_argument_error);
+	octree_3s octree(cube_3s(point_3s(0.0f, 0.0f, 0.0f), 1.0f));
+	ASSERT_THROW(octree.insert(box_3s(point_3s(nan, 0.0f, 0.0f), point_3s(1.0f, 1.0f, 1.0f))), idlib::invalid_argument_error);
+	ASSERT_THROW(octree.get(0), idlib::invalid_argument_error);
+	ASSERT_THROW(octree.move(0, box_3s()), idlib::invalid_argument_error);
+	ASSERT_THROW(octree.remove(0), idlib::invalid_argument_error);
+	const std::vector<plane_3s> planes(33);
+	ASSERT_THROW(octree.query_planes(planes, [](uint32_t, const box_3s&) {}), idlib::invalid_argument_error);
+}
+
+} } } // namespace idlib::math::tests
@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+
+namespace idlib { namespace math { namespace tests {
+
+using vector_3s = idlib::vector<single, 3>;
+using point_3s = idlib::point<vector_3s>;
+using matrix_4s = idlib::matrix<single, 4, 4>;
+
+template <typename Scalar>
+static idlib::matrix<Scalar, 4, 4> random_matrix(idlib::rng& rng, const idlib::interval<Scalar>& interval)
+{
+	idlib::matrix<Scalar, 4, 4> m;
+	for (size_t i = 0; i < 16; ++i)
+	{ m.data()[i] = rng.next(interval); }
+	return m;
+}
+
+/// @brief Random matrix with small integral elements such that products and sums are exact.
+static matrix_4s random_integral_matrix(idlib::rng& rng)
+{
+	matrix_4s m;
+	for (size_t i = 0; i < 16; ++i)
+	{ m.data()[i] = static_cast<single>(rng.next(idlib::interval<int>(-8, +8))); }
+	return m;
+}
+
+/// @brief Assert the SIMD and the scalar kernels produce bit-identical results.
+template <typename Scalar>
+static void assert_same_as_scalar()
+{
+	using kernel = idlib::internal::matrix4_kernel<Scalar>;
+	using scalar_kernel = idlib::internal::matrix4_kernel<Scalar, bool>;
+	idlib::rng rng(2018);
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		auto a = random_matrix<Scalar>(rng, idlib::interval<Scalar>(-100, +100)),
+		     b = random_matrix<Scalar>(rng, idlib::interval<Scalar>(-100, +100));
+		idlib::matrix<Scalar, 4, 4> x, y;
+		kernel::multiply(a.data(), b.data(), x.data());
+		scalar_kernel::multiply(a.data(), b.data(), y.data());
+		ASSERT_EQ(x, y);
+		ASSERT_EQ(kernel::inverse(a.data(), x.data()), scalar_kernel::inverse(a.data(), y.data()));
+		ASSERT_EQ(x, y);
+	}
+}
+
+TEST(matrix_4s, same_as_scalar)
+{ assert_same_as_scalar<single>(); }
+
+TEST(matrix_4d, same_as_scalar)
+{ assert_same_as_scalar<double>(); }
+
+TEST(matrix_4s, identity)
+{
+	idlib::rng rng(2018);
+	auto a = random_integral_matrix(rng);
+	auto i = idlib::one<matrix_4s>();
+	ASSERT_EQ(i * a, a);
+	ASSERT_EQ(a * i, a);
+	ASSERT_EQ(a.transpose().transpose(), a);
+	ASSERT_EQ(a.get_row(1), a.transpose().get_column(1));
+}
+
+TEST(matrix_4s, product)
+{
+	idlib::rng rng(2018);
+	for (size_t n = 0; n < 100; ++n)
+	{
+		auto a = random_integral_matrix(rng), b = random_integral_matrix(rng);
+		auto c = a * b;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			for (size_t k = 0; k < 4; ++k)
+			{ ASSERT_EQ(c(i, k), idlib::dot_product(a.get_row(i), b.get_column(k))); }
+		}
+		// (a b)^T = b^T a^T
+		ASSERT_EQ(c.transpose(), b.transpose() * a.transpose());
+	}
+}
+
+TEST(matrix_4d, inverse)
+{
+	using matrix_4d = idlib::matrix<double, 4, 4>;
+	idlib::rng rng(2018);
+	for (size_t n = 0; n < 100; ++n)
+	{
+		auto a = random_matrix<double>(rng, idlib::interval<double>(-1, +1)) + idlib::one<matrix_4d>() * 4.0;
+		auto r = idlib::invert(a);
+		auto e = a * r.get_matrix() - idlib::one<matrix_4d>();
+		for (size_t i = 0; i < 16; ++i)
+		{ ASSERT_LT(std::abs(e.data()[i]), 1.0e-12); }
+	}
+	auto r = idlib::invert(idlib::zero<matrix_4d>());
+	ASSERT_EQ(r.get_determinant(), 0.0);
+	ASSERT_THROW(r.get_matrix(), std::domain_error);
+}
+
+/// @brief Assert the target points are the source points transformed by the element-wise scalar computation.
+template <typename Scalar, typename P>
+static void assert_transformed(const idlib::matrix<Scalar, 4, 4>& m, const std::vector<P>& source, const std::vector<P>& target)
+{
+	for (size_t i = 0; i < source.size(); ++i)
+	{
+		const auto& p = source[i];
+		for (size_t j = 0; j < 3; ++j)
+		{ ASSERT_EQ(target[i][j], ((m(j, 0) * p[0] + m(j, 1) * p[1]) + m(j, 2) * p[2]) + m(j, 3)); }
+	}
+}
+
+TEST(matrix_4s, transform_points)
+{
+	idlib::rng rng(2018);
+	auto m = idlib::rotation(idlib::normalize(vector_3s(1.0f, 2.0f, 3.0f), idlib::euclidean_norm_functor<vector_3s>()).get_vector(),
+	                         idlib::angle<single, idlib::radians>(0.5f));
+	m = idlib::translate(m, vector_3s(1.0f, -2.0f, 3.0f));
+	std::vector<point_3s> p, q(1001);
+	for (size_t i = 0; i < 1001; ++i)
+	{ p.push_back(idlib::random<point_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f))); }
+	idlib::transform_points(m, idlib::span<const point_3s>(p), idlib::span<point_3s>(q));
+	for (size_t i = 0; i < p.size(); ++i)
+	{ ASSERT_EQ(q[i], idlib::transform_point(m, p[i])); }
+	assert_transformed(m, p, q);
+	idlib::transform_points(m, idlib::span<point_3s>(p));
+	ASSERT_EQ(p, q);
+	ASSERT_THROW(idlib::transform_points(m, idlib::span<const point_3s>(p), idlib::span<point_3s>(q).subspan(0, 1)), idlib::invalid_argument_error);
+}
+
+TEST(matrix_4d, transform_points)
+{
+	using point_3d = idlib::point<idlib::vector<double, 3>>;
+	idlib::rng rng(2018);
+	auto m = random_matrix<double>(rng, idlib::interval<double>(-1, +1));
+	std::vector<point_3d> p, q(1001);
+	for (size_t i = 0; i < 1001; ++i)
+	{ p.push_back(idlib::random<point_3d>(&rng, idlib::interval<double>(-1000.0, +1000.0))); }
+	idlib::transform_points(m, idlib::span<const point_3d>(p), idlib::span<point_3d>(q));
+	assert_transformed(m, p, q);
+}
+
+TEST(matrix_4s, translate)
+{
+	idlib::rng rng(2018);
+	auto m = idlib::scaling(vector_3s(2.0f, 4.0f, 8.0f));
+	auto t = vector_3s(1.0f, -2.0f, 3.0f);
+	auto p = point_3s(1.0f, 2.0f, 3.0f);
+	ASSERT_EQ(idlib::transform_point(idlib::translate(m, t), p), idlib::translate(idlib::transform_point(m, p), t));
+	ASSERT_EQ(idlib::transform_point(idlib::translation(t), p), idlib::translate(p, t));
+	ASSERT_EQ(idlib::transform_vector(idlib::translation(t), t), t);
+}
+
+} } } // namespace idlib::math::tests
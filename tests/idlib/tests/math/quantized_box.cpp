@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <algorithm>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using vector_3s = idlib::vector<single, 3>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using batch_3s = idlib::vector_batch<single, 3>;
+
+static_assert(sizeof(idlib::quantized_box<point_3s, std::uint16_t>) == 12, "unexpected size");
+static_assert(sizeof(idlib::quantized_box<point_3s, std::uint8_t>) == 6, "unexpected size");
+
+static box_3s random_box(idlib::rng& rng, const box_3s& parent, single size)
+{
+	point_3s a;
+	for (std::size_t i = 0; i < 3; ++i)
+	{ a[i] = idlib::random<single>(&rng, idlib::interval<single>(parent.get_min()[i], parent.get_max()[i] - size)); }
+	const auto s = idlib::random<vector_3s>(&rng, idlib::interval<single>(0.0f, size));
+	return box_3s(a, a + s);
+}
+
+static bool is_enclosing(const box_3s& a, const box_3s& b)
+{
+	for (std::size_t i = 0; i < 3; ++i)
+	{
+		if (a.get_min()[i] > b.get_min()[i] || a.get_max()[i] < b.get_max()[i]) return false;
+	}
+	return true;
+}
+
+/// @brief Assert the decoded boxes enclose the boxes, the batched operations match the single operations
+/// and the intersection test of quantized boxes is conservative.
+template <typename I>
+static void assert_quantization(const box_3s& parent, std::size_t n)
+{
+	idlib::rng rng(2018);
+	const idlib::box_quantizer<point_3s, I> quantizer(parent);
+	std::vector<box_3s> boxes;
+	for (std::size_t i = 0; i < n; ++i) boxes.push_back(random_box(rng, parent, 5.0f));
+	boxes.push_back(parent);
+	idlib::quantized_box_batch<point_3s, I> quantized;
+	quantizer.encode(boxes, quantized, 4);
+	ASSERT_EQ(boxes.size(), quantized.size());
+	batch_3s min, max;
+	quantizer.decode(quantized, min, max, 4);
+	for (std::size_t i = 0; i < boxes.size(); ++i)
+	{
+		const auto q = quantizer.encode(boxes[i]);
+		ASSERT_EQ(q, quantized.get(i));
+		const auto d = quantizer.decode(q);
+		ASSERT_TRUE(is_enclosing(d, boxes[i]));
+		ASSERT_TRUE(is_enclosing(parent, d));
+		for (std::size_t j = 0; j < 3; ++j)
+		{
+			ASSERT_EQ(d.get_min()[j], min.data(j)[i]);
+			ASSERT_EQ(d.get_max()[j], max.data(j)[i]);
+		}
+	}
+	for (std::size_t k = 0; k < 20; ++k)
+	{
+		const box_3s query = random_box(rng, box_3s(parent.get_min() - vector_3s(10.0f, 10.0f, 10.0f), parent.get_max() + vector_3s(10.0f, 10.0f, 10.0f)), 40.0f);
+		idlib::quantized_box<point_3s, I> q;
+		if (!quantizer.encode_intersection(query, q))
+		{
+			ASSERT_FALSE(idlib::is_intersecting(parent, query));
+			continue;
+		}
+		std::vector<std::uint32_t> bits((boxes.size() + 31) / 32);
+		idlib::is_intersecting(quantized, q, bits, 4);
+		for (std::size_t i = 0; i < boxes.size(); ++i)
+		{
+			const bool bit = ((bits[i / 32] >> (i % 32)) & 1) != 0;
+			ASSERT_EQ(idlib::is_intersecting(quantized.get(i), q), bit);
+			if (idlib::is_intersecting(boxes[i], query))
+			{ ASSERT_TRUE(bit); }
+		}
+		if (boxes.size() % 32 != 0)
+		{ ASSERT_EQ(0, bits.back() >> (boxes.size() % 32)); }
+	}
+}
+
+TEST(quantized_box, uint16)
+{
+	assert_quantization<std::uint16_t>(box_3s(point_3s(-100.0f, -50.0f, 0.0f), point_3s(100.0f, 50.0f, 1000.0f)), 1000);
+	assert_quantization<std::uint16_t>(box_3s(point_3s(1e6f, 1e6f, 1e6f), point_3s(1e6f + 100.0f, 1e6f + 100.0f, 1e6f + 100.0f)), 77);
+}
+
+TEST(quantized_box, uint8)
+{
+	assert_quantization<std::uint8_t>(box_3s(point_3s(-100.0f, -50.0f, 0.0f), point_3s(100.0f, 50.0f, 1000.0f)), 1000);
+	assert_quantization<std::uint8_t>(box_3s(point_3s(0.1f, 0.2f, 0.3f), point_3s(123.4f, 56.7f, 89.1f)), 33);
+}
+
+/// @brief Assert a query box which is disjoint from the parent box is rejected and a flat parent box is supported.
+TEST(quantized_box, degenerate)
+{
+	const idlib::box_quantizer<point_3s, std::uint16_t> quantizer(box_3s(point_3s(0.0f, 0.0f, 0.0f), point_3s(10.0f, 10.0f, 0.0f)));
+	idlib::quantized_box<point_3s, std::uint16_t> q;
+	ASSERT_FALSE(quantizer.encode_intersection(box_3s(point_3s(20.0f, 0.0f, 0.0f), point_3s(30.0f, 1.0f, 1.0f)), q));
+	const box_3s flat(point_3s(1.0f, 2.0f, 0.0f), point_3s(3.0f, 4.0f, 0.0f));
+	const auto d = quantizer.decode(quantizer.encode(flat));
+	ASSERT_TRUE(is_enclosing(d, flat));
+	ASSERT_EQ(0.0f, d.get_min()[2]);
+	ASSERT_EQ(0.0f, d.get_max()[2]);
+}
+
+TEST(quantized_box, invalid_arguments)
+{
+	using quantized_box_type = idlib::quantized_box<point_3s, std::uint8_t>;
+	ASSERT_THROW(quantized_box_type({ 1, 0, 0 }, { 0, 0, 0 }), std::domain_error);
+	const box_3s parent(point_3s(0.0f, 0.0f, 0.0f), point_3s(1.0f, 1.0f, 1.0f));
+	const idlib::box_quantizer<point_3s, std::uint8_t> quantizer(parent);
+	ASSERT_THROW(quantizer.encode(box_3s(point_3s(0.5f, 0.5f, 0.5f), point_3s(1.5f, 1.0f, 1.0f))), idlib::invalid_argument_error);
+	const single infinity = std::numeric_limits<single>::infinity();
+	ASSERT_THROW((idlib::box_quantizer<point_3s, std::uint8_t>(box_3s(point_3s(0.0f, 0.0f, 0.0f), point_3s(infinity, 1.0f, 1.0f)))), idlib::invalid_argument_error);
+	idlib::quantized_box_batch<point_3s, std::uint8_t> batch;
+	batch.resize(33);
+	std::vector<std::uint32_t> bits(1);
+	ASSERT_THROW(idlib::is_intersecting(batch, quantized_box_type(), bits), idlib::invalid_argument_error);
+}
+
+} } } // namespace idlib::math::tests
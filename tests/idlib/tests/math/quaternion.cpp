@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+
+namespace idlib { namespace math { namespace tests {
+
+template <typename Scalar>
+static idlib::quaternion<Scalar> random_unit_quaternion(idlib::rng& rng)
+{
+	auto interval = idlib::interval<Scalar>(-1, +1);
+	idlib::quaternion<Scalar> q(rng.next(interval), rng.next(interval), rng.next(interval), rng.next(interval));
+	return q / idlib::euclidean_norm(q);
+}
+
+template <typename Scalar>
+static Scalar max_difference(const idlib::quaternion<Scalar>& a, const idlib::quaternion<Scalar>& b)
+{
+	Scalar d = 0;
+	for (size_t i = 0; i < 4; ++i)
+	{ d = std::max(d, std::abs(a[i] - b[i])); }
+	return d;
+}
+
+/// @brief Spherical linear interpolation along the shortest arc computed with trigonometric functions.
+static idlib::quaternion<double> exact_slerp(const idlib::quaternion<double>& x, idlib::quaternion<double> y, double t)
+{
+	double c = idlib::dot_product(x, y);
+	if (c < 0) { y = -y; c = -c; }
+	double a = std::acos(std::min(c, 1.0));
+	if (a < 1.0e-9) return x;
+	return x * (std::sin((1 - t) * a) / std::sin(a)) + y * (std::sin(t * a) / std::sin(a));
+}
+
+TEST(quaternion, rotate)
+{
+	using vector_3d = idlib::vector<double, 3>;
+	auto axis = idlib::normalize(vector_3d(1.0, -2.0, 3.0), idlib::euclidean_norm_functor<vector_3d>()).get_vector();
+	auto angle = idlib::angle<double, idlib::radians>(0.75);
+	idlib::quaternion<double> q(axis, angle);
+	auto m = idlib::rotation(axis, angle), n = idlib::rotation(q);
+	for (size_t i = 0; i < 16; ++i)
+	{ ASSERT_NEAR(m.data()[i], n.data()[i], 1.0e-12); }
+	auto v = vector_3d(4.0, 5.0, -6.0), w = idlib::rotate(q, v), u = idlib::transform_vector(m, v);
+	for (size_t i = 0; i < 3; ++i)
+	{ ASSERT_NEAR(w[i], u[i], 1.0e-12); }
+	// The product of two rotations.
+	auto p = idlib::quaternion<double>(vector_3d(0.0, 0.0, 1.0), angle);
+	auto a = idlib::rotate(p * q, v), b = idlib::rotate(p, idlib::rotate(q, v));
+	for (size_t i = 0; i < 3; ++i)
+	{ ASSERT_NEAR(a[i], b[i], 1.0e-12); }
+	// The conjugate is the inverse.
+	ASSERT_LT(max_difference(q * q.conjugate(), idlib::one<idlib::quaternion<double>>()), 1.0e-15);
+}
+
+TEST(quaternion, interpolate)
+{
+	idlib::rng rng(2018);
+	double e = 0;
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		auto x = random_unit_quaternion<double>(rng), y = random_unit_quaternion<double>(rng);
+		auto t = rng.next(idlib::interval<double>(0, 1));
+		e = std::max(e, max_difference(idlib::slerp(x, y, idlib::mu<double>(t)), exact_slerp(x, y, t)));
+		ASSERT_EQ(idlib::lineary_interpolate(x, y, t), idlib::nlerp(x, y, idlib::mu<double>(t)));
+		ASSERT_NEAR(idlib::euclidean_norm(idlib::nlerp(x, y, idlib::mu<double>(t))), 1.0, 1.0e-15);
+	}
+	ASSERT_LT(e, 1.0e-7);
+	auto x = random_unit_quaternion<double>(rng), y = random_unit_quaternion<double>(rng);
+	ASSERT_LT(max_difference(idlib::slerp(x, y, idlib::mu<double>(0)), x), 1.0e-15);
+	ASSERT_LT(std::min(max_difference(idlib::slerp(x, y, idlib::mu<double>(1)), y),
+	                   max_difference(idlib::slerp(x, y, idlib::mu<double>(1)), -y)), 1.0e-6);
+}
+
+/// @brief Assert the bulk operations produce the same results as the operations on individual quaternions.
+template <typename Scalar>
+static void assert_batch_same_as_scalar()
+{
+	idlib::rng rng(2018);
+	std::vector<idlib::quaternion<Scalar>> u, v;
+	std::vector<idlib::vector<Scalar, 3>> w;
+	for (size_t i = 0; i < 1001; ++i)
+	{
+		u.push_back(random_unit_quaternion<Scalar>(rng));
+		v.push_back(random_unit_quaternion<Scalar>(rng));
+		w.push_back(idlib::random<idlib::vector<Scalar, 3>>(&rng, idlib::interval<Scalar>(-100, +100)));
+	}
+	idlib::quaternion_batch<Scalar> a(u), b(v), r;
+	idlib::mu<Scalar> t(Scalar(0.25));
+	idlib::nlerp(a, b, t, r);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(r.get(i), idlib::nlerp(u[i], v[i], t));
+	idlib::slerp(a, b, t, r);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(r.get(i), idlib::slerp(u[i], v[i], t));
+	idlib::vector_batch<Scalar, 3> c(w), d;
+	idlib::rotate(a, c, d);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(d.get(i), idlib::rotate(u[i], w[i]));
+	// In-place.
+	idlib::slerp(a, b, t, a);
+	ASSERT_EQ(a.get_quaternions(), r.get_quaternions());
+	ASSERT_THROW(idlib::nlerp(a, idlib::quaternion_batch<Scalar>(1), t, r), idlib::invalid_argument_error);
+}
+
+TEST(quaternion_batch, same_as_scalar_single)
+{ assert_batch_same_as_scalar<single>(); }
+
+TEST(quaternion_batch, same_as_scalar_double)
+{ assert_batch_same_as_scalar<double>(); }
+
+} } } // namespace idlib::math::tests
@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <atomic>
+#include <climits>
+#include <thread>
+
+namespace idlib { namespace math { namespace tests {
+
+/// @brief Assert the engines generate the values of the reference implementations.
+TEST(random, engine_reference_values)
+{
+	idlib::splitmix64 a(0);
+	ASSERT_EQ(a(), UINT64_C(0xe220a8397b1dcdaf));
+	ASSERT_EQ(a(), UINT64_C(0x6e789e6aa1b965f4));
+	idlib::xoshiro256_star_star b(0);
+	ASSERT_EQ(b(), UINT64_C(0x99ec5f36cb75f2b4));
+	ASSERT_EQ(b(), UINT64_C(0xbf6e1f784956452a));
+	ASSERT_EQ(b(), UINT64_C(0x1a5f849d4933e6e0));
+	idlib::pcg64 c(0);
+	ASSERT_EQ(c(), UINT64_C(0xe24b31ff3208bf03));
+	ASSERT_EQ(c(), UINT64_C(0x6023534aa8869143));
+	ASSERT_EQ(c(), UINT64_C(0x592945df5568aa7b));
+	// Seeding restarts the sequence.
+	b.seed(0);
+	ASSERT_EQ(b(), UINT64_C(0x99ec5f36cb75f2b4));
+	c.seed(0);
+	ASSERT_EQ(c(), UINT64_C(0xe24b31ff3208bf03));
+}
+
+/// @brief Assert idlib::philox4x32 computes the known answers of the reference implementation (Random123).
+TEST(random, philox4x32_reference_values)
+{
+	using counter = idlib::philox4x32::counter_type;
+	using key = idlib::philox4x32::key_type;
+	ASSERT_EQ(idlib::philox4x32::block(counter{ 0, 0, 0, 0 }, key{ 0, 0 }),
+	          (counter{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }));
+	ASSERT_EQ(idlib::philox4x32::block(counter{ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, key{ 0xffffffff, 0xffffffff }),
+	          (counter{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }));
+	ASSERT_EQ(idlib::philox4x32::block(counter{ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, key{ 0xa4093822, 0x299f31d0 }),
+	          (counter{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }));
+	// The engine enumerates the blocks of the counters (i, 0, stream, 0), two values per block.
+	idlib::philox4x32 e(0);
+	ASSERT_EQ(e(), UINT64_C(0xe169c58d6627e8d5));
+	ASSERT_EQ(e(), UINT64_C(0x9b00dbd8bc57ac4c));
+}
+
+/// @brief Assert discarding values is equivalent to generating them.
+TEST(random, discard)
+{
+	for (std::uint64_t n : { 0, 1, 2, 3, 100, 101 })
+	{
+		for (std::uint64_t m : { 0, 1 })
+		{
+			idlib::philox4x32 a(7, 3), b(7, 3);
+			for (std::uint64_t i = 0; i < m; ++i) { a(); b(); }
+			for (std::uint64_t i = 0; i < n; ++i) a();
+			b.discard(n);
+			ASSERT_EQ(a(), b());
+			ASSERT_EQ(a(), b());
+		}
+		idlib::rng c(idlib::rng_engine::xoshiro256_star_star, 7), d(idlib::rng_engine::xoshiro256_star_star, 7);
+		const idlib::interval<double> i(0.0, 1.0);
+		for (std::uint64_t j = 0; j < n; ++j) c.next(i);
+		d.discard(n);
+		ASSERT_EQ(c.next(i), d.next(i));
+	}
+}
+
+/// @brief Assert streams are distinct and only the engine idlib::rng_engine::philox4x32 accepts streams other than 0.
+TEST(random, streams)
+{
+	const idlib::interval<double> i(0.0, 1.0);
+	idlib::rng a(idlib::rng_engine::philox4x32, 1, 0), b(idlib::rng_engine::philox4x32, 1, 1),
+	           c(idlib::rng_engine::philox4x32, 1, 1);
+	ASSERT_EQ(b.get_stream(), 1);
+	ASSERT_NE(a.next(i), b.next(i));
+	c.next(i);
+	// Re-seeding retains the stream.
+	c.seed(1);
+	ASSERT_EQ(c.get_stream(), 1);
+	idlib::rng d(idlib::rng_engine::philox4x32, 1, 1);
+	ASSERT_EQ(c.next(i), d.next(i));
+	ASSERT_NO_THROW(idlib::rng(idlib::rng_engine::pcg64, 1, 0));
+	ASSERT_THROW(idlib::rng(idlib::rng_engine::pcg64, 1, 1), idlib::invalid_argument_error);
+	ASSERT_THROW(idlib::rng(idlib::rng_engine::mersenne_twister, 1, 1), idlib::invalid_argument_error);
+}
+
+/// @brief Compute values of tasks with a number of threads, each task using its own stream.
+static std::vector<double> compute_tasks(size_t number_of_threads)
+{
+	static const size_t number_of_tasks = 64, values_per_task = 100;
+	std::vector<double> values(number_of_tasks * values_per_task);
+	std::atomic<size_t> next_task(0);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < number_of_threads; ++i)
+	{
+		threads.emplace_back([&values, &next_task]()
+		{
+			for (size_t task; (task = next_task++) < number_of_tasks;)
+			{
+				idlib::rng rng(idlib::rng_engine::philox4x32, 42, task);
+				rng.fill(idlib::span<double>(values.data() + task * values_per_task, values_per_task), idlib::interval<double>(-1.0, +1.0));
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+	return values;
+}
+
+/// @brief Assert the values of the tasks do not depend on the number of threads.
+TEST(random, streams_are_independent_of_the_number_of_threads)
+{
+	auto x = compute_tasks(1);
+	ASSERT_EQ(x, compute_tasks(2));
+	ASSERT_EQ(x, compute_tasks(4));
+}
+
+template <typename T>
+void assert_fill(idlib::rng_engine engine, const idlib::interval<T>& interval)
+{
+	static const size_t n = 1001;
+	std::vector<T> values(n);
+	idlib::rng a(engine, 17), b(engine, 17);
+	ASSERT_EQ(a.get_engine(), engine);
+	a.fill(idlib::span<T>(values), interval);
+	for (size_t i = 0; i < n; ++i)
+	{
+		ASSERT_EQ(values[i], b.next(interval));
+		ASSERT_LE(interval.lower(), values[i]);
+		ASSERT_LE(values[i], interval.upper());
+	}
+	// Re-seeding restarts the sequence.
+	a.seed(17);
+	for (size_t i = 0; i < n; ++i)
+	{ ASSERT_EQ(values[i], a.next(interval)); }
+}
+
+template <typename T>
+void assert_fill(const idlib::interval<T>& interval)
+{
+	assert_fill(idlib::rng_engine::mersenne_twister, interval);
+	assert_fill(idlib::rng_engine::xoshiro256_star_star, interval);
+	assert_fill(idlib::rng_engine::pcg64, interval);
+	assert_fill(idlib::rng_engine::philox4x32, interval);
+}
+
+/// @brief Assert fill generates the same values as next and the values are within the bounds.
+TEST(random, fill)
+{
+	assert_fill(idlib::interval<single>(-1.0f, +1.0f));
+	assert_fill(idlib::interval<single>(0.1f, 0.1f));
+	assert_fill(idlib::interval<single>(1.0f, 1.0f + FLT_EPSILON));
+	assert_fill(idlib::interval<double>(-1000.0, +1.0));
+	assert_fill(idlib::interval<double>(0.1, 0.1));
+	assert_fill(idlib::interval<quadruple>(-1.0L, +1.0L));
+	assert_fill(idlib::interval<int>(-3, +5));
+	assert_fill(idlib::interval<int>(7, 7));
+	assert_fill(idlib::interval<int>(INT_MIN, INT_MAX));
+	assert_fill(idlib::interval<int>(INT_MIN, INT_MAX - 1));
+}
+
+/// @brief Assert random number generators with the same seed generate the same values and
+/// random number generators with different seeds or different engines generate different values.
+TEST(random, seeding)
+{
+	const idlib::interval<double> i(0.0, 1.0);
+	idlib::rng a(1), b(1), c(2), d(idlib::rng_engine::pcg64, 1), e;
+	ASSERT_EQ(a.get_engine(), idlib::rng::default_engine);
+	auto x = a.next(i);
+	ASSERT_EQ(x, b.next(i));
+	ASSERT_NE(x, c.next(i));
+	ASSERT_NE(x, d.next(i));
+	idlib::rng f;
+	ASSERT_NE(e.next(i), f.next(i));
+}
+
+/// @brief Assert the values are uniformly distributed.
+TEST(random, distribution)
+{
+	static const size_t n = 100000;
+	for (auto engine : { idlib::rng_engine::mersenne_twister, idlib::rng_engine::xoshiro256_star_star, idlib::rng_engine::pcg64, idlib::rng_engine::philox4x32 })
+	{
+		idlib::rng rng(engine, 5);
+		std::vector<single> x(n);
+		rng.fill(idlib::span<single>(x), idlib::interval<single>(2.0f, 4.0f));
+		double sum = 0.0;
+		for (auto v : x) sum += v;
+		ASSERT_NEAR(sum / n, 3.0, 0.01);
+		std::vector<int> y(n);
+		int count[3] = { 0, 0, 0 };
+		rng.fill(idlib::span<int>(y), idlib::interval<int>(-1, +1));
+		for (auto v : y) count[v + 1]++;
+		for (auto c : count) ASSERT_NEAR(c, n / 3, n / 100);
+	}
+}
+
+} } } // namespace idlib::math::tests
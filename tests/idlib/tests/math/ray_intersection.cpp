@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <cstring>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using vector_3s = idlib::vector<single, 3>;
+using ray_3s = idlib::ray<point_3s>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using cube_3s = idlib::axis_aligned_cube<point_3s>;
+using sphere_3s = idlib::sphere<point_3s>;
+using plane_3s = idlib::plane<point_3s>;
+
+static const single inf = std::numeric_limits<single>::infinity();
+
+/// @brief Assert the distances of rays hitting, missing and starting inside of boxes and cubes.
+TEST(ray_intersection, axis_aligned_box)
+{
+	const box_3s b(point_3s(1.0f, -1.0f, -1.0f), point_3s(3.0f, +1.0f, +1.0f));
+	ASSERT_EQ(idlib::intersect(ray_3s(point_3s(-1.0f, 0.0f, 0.0f), vector_3s(1.0f, 0.0f, 0.0f)), b).get_distance(), 2.0f);
+	ASSERT_EQ(idlib::intersect(ray_3s(point_3s(2.0f, 0.0f, 0.0f), vector_3s(1.0f, 0.0f, 0.0f)), b).get_distance(), 0.0f);
+	ASSERT_FALSE(idlib::intersect(ray_3s(point_3s(-1.0f, 0.0f, 0.0f), vector_3s(-1.0f, 0.0f, 0.0f)), b).is_hit());
+	// Parallel to the slabs of the y and z axes, origin outside of the slab of the y axis.
+	ASSERT_FALSE(idlib::intersect(ray_3s(point_3s(-1.0f, 2.0f, 0.0f), vector_3s(1.0f, 0.0f, 0.0f)), b).is_hit());
+	// Diagonal.
+	auto r = idlib::intersect(ray_3s(point_3s(0.0f, -2.0f, 0.0f), vector_3s(1.0f, 1.0f, 0.0f)), b);
+	ASSERT_TRUE(r.is_hit());
+	ASSERT_FLOAT_EQ(r.get_distance(), std::sqrt(2.0f));
+	const cube_3s c(point_3s(2.0f, 0.0f, 0.0f), 2.0f);
+	ASSERT_EQ(idlib::intersect(ray_3s(point_3s(-1.0f, 0.0f, 0.0f), vector_3s(1.0f, 0.0f, 0.0f)), c).get_distance(), 2.0f);
+}
+
+/// @brief Assert the distances of rays hitting, missing and starting inside of spheres.
+TEST(ray_intersection, sphere)
+{
+	const sphere_3s s(point_3s(5.0f, 0.0f, 0.0f), 2.0f);
+	ASSERT_EQ(idlib::intersect(ray_3s(point_3s(0.0f, 0.0f, 0.0f), vector_3s(1.0f, 0.0f, 0.0f)), s).get_distance(), 3.0f);
+	ASSERT_EQ(idlib::intersect(ray_3s(point_3s(4.0f, 0.0f, 0.0f), vector_3s(0.0f, 1.0f, 0.0f)), s).get_distance(), 0.0f);
+	ASSERT_FALSE(idlib::intersect(ray_3s(point_3s(0.0f, 0.0f, 0.0f), vector_3s(-1.0f, 0.0f, 0.0f)), s).is_hit());
+	ASSERT_FALSE(idlib::intersect(ray_3s(point_3s(0.0f, 3.0f, 0.0f), vector_3s(1.0f, 0.0f, 0.0f)), s).is_hit());
+}
+
+/// @brief Assert the distances of rays hitting, missing and parallel to planes.
+TEST(ray_intersection, plane)
+{
+	const plane_3s p(point_3s(0.0f, 0.0f, 4.0f), vector_3s(0.0f, 0.0f, 1.0f));
+	ASSERT_EQ(idlib::intersect(ray_3s(point_3s(1.0f, 2.0f, 0.0f), vector_3s(0.0f, 0.0f, 1.0f)), p).get_distance(), 4.0f);
+	ASSERT_EQ(idlib::intersect(ray_3s(point_3s(1.0f, 2.0f, 8.0f), vector_3s(0.0f, 0.0f, -1.0f)), p).get_distance(), 4.0f);
+	ASSERT_FALSE(idlib::intersect(ray_3s(point_3s(1.0f, 2.0f, 0.0f), vector_3s(0.0f, 0.0f, -1.0f)), p).is_hit());
+	ASSERT_FALSE(idlib::intersect(ray_3s(point_3s(1.0f, 2.0f, 4.0f), vector_3s(1.0f, 0.0f, 0.0f)), p).is_hit());
+}
+
+/// @brief Generate random rays. Every third ray is parallel to a coordinate plane.
+template <typename Ray>
+static std::vector<Ray> random_rays(idlib::rng& rng, size_t n)
+{
+	using P = typename Ray::point_type;
+	using V = typename Ray::vector_type;
+	using S = typename Ray::scalar_type;
+	std::vector<Ray> rays;
+	while (rays.size() < n)
+	{
+		auto d = idlib::random<V>(&rng, idlib::interval<S>(S(-1), S(+1)));
+		if (rays.size() % 3 == 0) d[rays.size() % 2] = S(0);
+		if (d == idlib::zero<V>()) continue;
+		rays.emplace_back(idlib::random<P>(&rng, idlib::interval<S>(S(-10), S(+10))), d);
+	}
+	return rays;
+}
+
+/// @brief Assert the packet distances are bit-identical to the single ray distances.
+template <typename P, std::size_t Width, typename Geometry>
+static void assert_packet_identical(const std::vector<idlib::ray<P>>& rays, const Geometry& g)
+{
+	using S = typename P::scalar_type;
+	for (size_t k = 0; k + Width <= rays.size(); k += Width)
+	{
+		idlib::ray_packet<P, Width> packet(idlib::span<const idlib::ray<P>>(rays.data() + k, Width));
+		auto r = idlib::intersect(packet, g);
+		std::uint64_t mask = 0;
+		for (size_t i = 0; i < Width; ++i)
+		{
+			S expected = idlib::intersect(rays[k + i], g).get_distance(), actual = r.get_distance(i);
+			ASSERT_EQ(0, std::memcmp(&expected, &actual, sizeof(S))) << expected << " " << actual;
+			mask |= std::uint64_t(expected != std::numeric_limits<S>::infinity() ? 1 : 0) << i;
+		}
+		ASSERT_EQ(r.get_mask(), mask);
+	}
+}
+
+template <typename S, std::size_t Width>
+static void assert_packets_identical()
+{
+	using P = idlib::point<idlib::vector<S, 3>>;
+	idlib::rng rng(idlib::rng_engine::xoshiro256_star_star, 2018);
+	const auto rays = random_rays<idlib::ray<P>>(rng, 16 * Width);
+	for (int i = 0; i < 16; ++i)
+	{
+		const auto a = idlib::random<P>(&rng, idlib::interval<S>(S(-5), S(+5)));
+		const auto b = idlib::random<P>(&rng, idlib::interval<S>(S(-5), S(+5)));
+		assert_packet_identical<P, Width>(rays, idlib::axis_aligned_box<P>(a, b));
+		assert_packet_identical<P, Width>(rays, idlib::axis_aligned_cube<P>(a, S(3)));
+		assert_packet_identical<P, Width>(rays, idlib::sphere<P>(a, S(4)));
+		assert_packet_identical<P, Width>(rays, idlib::plane<P>(a, b - a));
+	}
+}
+
+TEST(ray_intersection, packets_single)
+{
+	assert_packets_identical<single, 1>();
+	assert_packets_identical<single, 3>();
+	assert_packets_identical<single, 4>();
+	assert_packets_identical<single, 8>();
+	assert_packets_identical<single, 16>();
+}
+
+TEST(ray_intersection, packets_double)
+{
+	assert_packets_identical<double, 2>();
+	assert_packets_identical<double, 4>();
+}
+
+TEST(ray_intersection, packet_width_mismatch)
+{
+	std::vector<ray_3s> rays(3, ray_3s(point_3s(0.0f, 0.0f, 0.0f), vector_3s(1.0f, 0.0f, 0.0f)));
+	ASSERT_THROW((idlib::ray_packet<point_3s, 4>(rays)), idlib::invalid_argument_error);
+}
+
+} } } // namespace idlib::math::tests
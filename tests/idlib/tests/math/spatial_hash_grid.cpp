@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <algorithm>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using vector_3s = idlib::vector<single, 3>;
+using sphere_3s = idlib::sphere<point_3s>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using sphere_grid_3s = idlib::spatial_hash_grid<sphere_3s>;
+using box_grid_3s = idlib::spatial_hash_grid<box_3s>;
+using pair_type = sphere_grid_3s::pair_type;
+
+static std::vector<sphere_3s> random_spheres(idlib::rng& rng, size_t n, single extent, single radius)
+{
+	std::vector<sphere_3s> spheres;
+	for (size_t i = 0; i < n; ++i)
+	{
+		auto c = idlib::random<point_3s>(&rng, idlib::interval<single>(-extent, +extent));
+		spheres.emplace_back(c, idlib::random<single>(&rng, idlib::interval<single>(0.0f, radius)));
+	}
+	return spheres;
+}
+
+static std::vector<uint32_t> iota(size_t n)
+{
+	std::vector<uint32_t> v(n);
+	for (size_t i = 0; i < n; ++i) v[i] = uint32_t(i);
+	return v;
+}
+
+template <typename G>
+static std::vector<pair_type> find_pairs(idlib::spatial_hash_grid<G>& grid, size_t thread_count = 1)
+{
+	std::vector<pair_type> pairs(grid.find_pairs(idlib::span<pair_type>(), thread_count));
+	size_t n = grid.find_pairs(pairs, thread_count);
+	EXPECT_EQ(n, pairs.size());
+	std::sort(pairs.begin(), pairs.end());
+	return pairs;
+}
+
+/// @brief Find the pairs of intersecting geometries by testing all pairs.
+template <typename G>
+static std::vector<pair_type> brute_force(const std::vector<G>& geometries, const std::vector<uint32_t>& handles)
+{
+	std::vector<pair_type> pairs;
+	for (size_t i = 0; i < geometries.size(); ++i)
+	{
+		for (size_t j = i + 1; j < geometries.size(); ++j)
+		{
+			if (idlib::is_intersecting(geometries[i], geometries[j]))
+			{ pairs.emplace_back(std::min(handles[i], handles[j]), std::max(handles[i], handles[j])); }
+		}
+	}
+	std::sort(pairs.begin(), pairs.end());
+	return pairs;
+}
+
+/// @brief Assert the pairs of intersecting spheres are the pairs found by testing all pairs.
+/// The cell sizes are such that most spheres are larger than a cell, all spheres are smaller than a cell,
+/// and all spheres are in one cell.
+TEST(spatial_hash_grid, sphere_pairs)
+{
+	idlib::rng rng(2018);
+	auto spheres = random_spheres(rng, 2000, 50.0f, 4.0f);
+	auto expected = brute_force(spheres, iota(spheres.size()));
+	ASSERT_FALSE(expected.empty());
+	for (single cell_size : { 3.0f, 8.5f, 1000.0f })
+	{
+		sphere_grid_3s grid(cell_size);
+		std::vector<uint32_t> handles(spheres.size());
+		grid.insert(spheres, handles);
+		ASSERT_EQ(grid.size(), spheres.size());
+		ASSERT_EQ(handles, iota(spheres.size()));
+		ASSERT_EQ(find_pairs(grid), expected);
+		ASSERT_EQ(find_pairs(grid, 4), expected);
+	}
+}
+
+/// @brief Assert the pairs remain correct if spheres are moved and removed.
+TEST(spatial_hash_grid, move_and_remove)
+{
+	idlib::rng rng(2018);
+	auto spheres = random_spheres(rng, 1000, 30.0f, 2.0f);
+	sphere_grid_3s grid(2.0f);
+	std::vector<uint32_t> handles;
+	for (const auto& s : spheres) handles.push_back(grid.insert(s));
+	for (size_t step = 0; step < 5; ++step)
+	{
+		// Move some spheres individually and all others in bulk.
+		for (auto& s : spheres)
+		{ s.set_center(s.get_center() + idlib::random<vector_3s>(&rng, idlib::interval<single>(-1.5f, +1.5f))); }
+		for (size_t i = 0; i < 100; ++i) grid.move(handles[i], spheres[i]);
+		const size_t n = spheres.size() - 100;
+		grid.move(idlib::span<const uint32_t>(handles).subspan(100, n), idlib::span<const sphere_3s>(spheres).subspan(100, n), 4);
+		for (size_t i = 0; i < spheres.size(); ++i) ASSERT_EQ(grid.get(handles[i]), spheres[i]);
+		ASSERT_EQ(find_pairs(grid), brute_force(spheres, handles));
+	}
+	// Remove every third sphere.
+	std::vector<sphere_3s> remaining;
+	std::vector<uint32_t> remaining_handles;
+	for (size_t i = 0; i < spheres.size(); ++i)
+	{
+		if (i % 3 == 0)
+		{ grid.remove(handles[i]); }
+		else
+		{
+			remaining.push_back(spheres[i]);
+			remaining_handles.push_back(handles[i]);
+		}
+	}
+	ASSERT_EQ(grid.size(), remaining.size());
+	ASSERT_EQ(find_pairs(grid), brute_force(remaining, remaining_handles));
+	// Removed handles are reused.
+	ASSERT_FALSE(grid.contains(handles[0]));
+	auto h = grid.insert(spheres[0]);
+	ASSERT_LT(h, spheres.size());
+	grid.clear();
+	ASSERT_TRUE(grid.empty());
+	ASSERT_EQ(grid.get_cell_count(), 0);
+}
+
+/// @brief Assert the pairs of intersecting boxes and box queries.
+TEST(spatial_hash_grid, boxes)
+{
+	idlib::rng rng(2018);
+	std::vector<box_3s> boxes;
+	for (size_t i = 0; i < 1500; ++i)
+	{
+		auto a = idlib::random<point_3s>(&rng, idlib::interval<single>(-40.0f, +40.0f));
+		boxes.emplace_back(a, a + idlib::random<vector_3s>(&rng, idlib::interval<single>(0.0f, 6.0f)));
+	}
+	box_grid_3s grid(4.0f);
+	std::vector<uint32_t> handles(boxes.size());
+	grid.insert(boxes, handles);
+	ASSERT_EQ(find_pairs(grid), brute_force(boxes, handles));
+	// Small and large queries use different strategies.
+	for (single extent : { 5.0f, 500.0f })
+	{
+		box_3s q(point_3s(-extent, -3.0f, -extent), point_3s(extent, 7.0f, extent));
+		std::vector<uint32_t> expected, found;
+		for (size_t i = 0; i < boxes.size(); ++i)
+		{
+			if (idlib::is_intersecting(q, boxes[i])) expected.push_back(handles[i]);
+		}
+		grid.query(q, [&found](uint32_t h, const box_3s&) { found.push_back(h); });
+		std::sort(found.begin(), found.end());
+		ASSERT_EQ(found, expected);
+	}
+}
+
+/// @brief Assert a buffer too small receives a subset of the pairs and the number of all pairs is returned.
+TEST(spatial_hash_grid, small_buffer)
+{
+	idlib::rng rng(2018);
+	auto spheres = random_spheres(rng, 1000, 20.0f, 2.0f);
+	sphere_grid_3s grid(2.0f);
+	std::vector<uint32_t> handles(spheres.size());
+	grid.insert(spheres, handles);
+	auto all = find_pairs(grid);
+	ASSERT_GT(all.size(), 10);
+	std::vector<pair_type> some(10);
+	ASSERT_EQ(grid.find_pairs(some), all.size());
+	for (const auto& p : some)
+	{ ASSERT_TRUE(std::binary_search(all.begin(), all.end(), p)); }
+}
+
+/// @brief Assert invalid arguments are rejected.
+TEST(spatial_hash_grid, invalid_arguments)
+{
+	ASSERT_THROW(sphere_grid_3s(0.0f), idlib::invalid_argument_error);
+	ASSERT_THROW(sphere_grid_3s(-1.0f), idlib::invalid_argument_error);
+	ASSERT_THROW(sphere_grid_3s(std::numeric_limits<single>::quiet_NaN()), idlib::invalid_argument_error);
+	sphere_grid_3s grid(1.0f);
+	auto h = grid.insert(sphere_3s(point_3s(0.0f, 0.0f, 0.0f), 1.0f));
+	ASSERT_THROW(grid.move(h + 1, sphere_3s()), idlib::invalid_argument_error);
+	ASSERT_THROW(grid.insert(sphere_3s(point_3s(std::numeric_limits<single>::quiet_NaN(), 0.0f, 0.0f), 1.0f)),
+	             idlib::invalid_argument_error);
+	ASSERT_EQ(grid.size(), 1);
+	std::vector<sphere_3s> spheres(2);
+	std::vector<uint32_t> handles(1);
+	ASSERT_THROW(grid.insert(spheres, handles), idlib::invalid_argument_error);
+	grid.remove(h);
+	ASSERT_THROW(grid.remove(h), idlib::invalid_argument_error);
+	ASSERT_THROW(grid.get(h), idlib::invalid_argument_error);
+}
+
+} } } // namespace idlib::math::tests
@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+#include <algorithm>
+#include <set>
+
+namespace idlib { namespace math { namespace tests {
+
+using point_3s = idlib::point<idlib::vector<single, 3>>;
+using vector_3s = idlib::vector<single, 3>;
+using box_3s = idlib::axis_aligned_box<point_3s>;
+using sap_3s = idlib::sweep_and_prune<point_3s>;
+using pair_type = sap_3s::pair_type;
+
+static box_3s random_box(idlib::rng& rng, single extent, single size)
+{
+	auto a = idlib::random<point_3s>(&rng, idlib::interval<single>(-extent, +extent));
+	auto s = idlib::random<vector_3s>(&rng, idlib::interval<single>(0.0f, size));
+	return box_3s(a, a + s);
+}
+
+/// @brief Find the pairs of intersecting boxes of a SAP by testing all pairs.
+static std::set<pair_type> brute_force(const sap_3s& sap, const std::vector<uint32_t>& handles)
+{
+	std::set<pair_type> pairs;
+	for (size_t i = 0; i < handles.size(); ++i)
+	{
+		for (size_t j = i + 1; j < handles.size(); ++j)
+		{
+			if (idlib::is_intersecting(sap.get(handles[i]), sap.get(handles[j])))
+			{ pairs.emplace(std::min(handles[i], handles[j]), std::max(handles[i], handles[j])); }
+		}
+	}
+	return pairs;
+}
+
+/// @brief Update a SAP and apply the reported differences to a set of pairs.
+static void update(sap_3s& sap, std::set<pair_type>& pairs)
+{
+	std::vector<pair_type> added, removed;
+	const auto& counters = sap.update(added, removed);
+	ASSERT_EQ(added.size(), counters.added_count);
+	ASSERT_EQ(removed.size(), counters.removed_count);
+	for (const auto& p : removed)
+	{
+		ASSERT_LT(p.first, p.second);
+		ASSERT_EQ(1, pairs.erase(p));
+	}
+	for (const auto& p : added)
+	{
+		ASSERT_LT(p.first, p.second);
+		ASSERT_TRUE(pairs.insert(p).second);
+	}
+	ASSERT_EQ(pairs.size(), counters.pair_count);
+	ASSERT_EQ(pairs.size(), sap.get_pair_count());
+}
+
+TEST(sweep_and_prune, coherent_motion)
+{
+	idlib::rng rng(2018);
+	sap_3s sap;
+	std::vector<uint32_t> handles;
+	for (size_t i = 0; i < 512; ++i)
+	{ handles.push_back(sap.insert(random_box(rng, 20.0f, 4.0f))); }
+	std::set<pair_type> pairs;
+	update(sap, pairs);
+	ASSERT_TRUE(sap.get_counters().rebuilt);
+	ASSERT_EQ(brute_force(sap, handles), pairs);
+	ASSERT_FALSE(pairs.empty());
+	for (size_t frame = 0; frame < 16; ++frame)
+	{
+		for (auto h : handles)
+		{
+			auto d = idlib::random<vector_3s>(&rng, idlib::interval<single>(-0.5f, +0.5f));
+			const auto& b = sap.get(h);
+			sap.move(h, box_3s(b.get_min() + d, b.get_max() + d));
+		}
+		update(sap, pairs);
+		ASSERT_FALSE(sap.get_counters().rebuilt);
+		ASSERT_GT(sap.get_counters().swap_count, 0);
+		ASSERT_EQ(brute_force(sap, handles), pairs);
+	}
+	std::vector<pair_type> visited;
+	sap.for_each_pair([&](const pair_type& p) { visited.push_back(p); });
+	ASSERT_EQ(std::vector<pair_type>(pairs.begin(), pairs.end()), (std::sort(visited.begin(), visited.end()), visited));
+	for (const auto& p : pairs)
+	{
+		ASSERT_TRUE(sap.is_overlapping(p.first, p.second));
+		ASSERT_TRUE(sap.is_overlapping(p.second, p.first));
+	}
+	// Without changes, an update reports no differences.
+	update(sap, pairs);
+	ASSERT_EQ(0, sap.get_counters().swap_count);
+	ASSERT_EQ(0, sap.get_counters().added_count + sap.get_counters().removed_count);
+}
+
+TEST(sweep_and_prune, insert_and_remove)
+{
+	idlib::rng rng(2018);
+	sap_3s sap;
+	std::vector<uint32_t> handles;
+	for (size_t i = 0; i < 256; ++i)
+	{ handles.push_back(sap.insert(random_box(rng, 16.0f, 4.0f))); }
+	std::set<pair_type> pairs;
+	update(sap, pairs);
+	// Few insertions enter the order by insertion sort.
+	for (size_t i = 0; i < 8; ++i)
+	{ handles.push_back(sap.insert(random_box(rng, 16.0f, 4.0f))); }
+	update(sap, pairs);
+	ASSERT_FALSE(sap.get_counters().rebuilt);
+	ASSERT_EQ(brute_force(sap, handles), pairs);
+	// The pairs of removed boxes are reported as removed.
+	std::vector<uint32_t> remaining;
+	for (size_t i = 0; i < handles.size(); ++i)
+	{
+		if (i % 3 == 0) sap.remove(handles[i]);
+		else remaining.push_back(handles[i]);
+	}
+	ASSERT_FALSE(sap.contains(handles[0]));
+	ASSERT_EQ(remaining.size(), sap.size());
+	update(sap, pairs);
+	ASSERT_EQ(brute_force(sap, remaining), pairs);
+	for (const auto& p : pairs)
+	{
+		ASSERT_NE(0, p.first % 3);
+	}
+	// Insert, move and remove between two updates.
+	handles = remaining;
+	const auto h = sap.insert(random_box(rng, 16.0f, 4.0f));
+	sap.move(handles[0], random_box(rng, 16.0f, 4.0f));
+	sap.remove(h);
+	handles.push_back(sap.insert(box_3s(point_3s(-100.0f, -100.0f, -100.0f), point_3s(100.0f, 100.0f, 100.0f))));
+	update(sap, pairs);
+	ASSERT_EQ(brute_force(sap, handles), pairs);
+	// Handles of removed boxes are reused after an update.
+	ASSERT_EQ(h, sap.insert(random_box(rng, 16.0f, 4.0f)));
+	sap.clear();
+	ASSERT_TRUE(sap.empty());
+	ASSERT_EQ(0, sap.get_pair_count());
+}
+
+TEST(sweep_and_prune, touching_boxes)
+{
+	sap_3s sap;
+	const auto a = sap.insert(box_3s(point_3s(0.0f, 0.0f, 0.0f), point_3s(1.0f, 1.0f, 1.0f)));
+	const auto b = sap.insert(box_3s(point_3s(1.0f, 0.0f, 0.0f), point_3s(2.0f, 1.0f, 1.0f)));
+	std::set<pair_type> pairs;
+	update(sap, pairs);
+	ASSERT_TRUE(sap.is_overlapping(a, b));
+	sap.move(b, box_3s(point_3s(1.5f, 0.0f, 0.0f), point_3s(2.0f, 1.0f, 1.0f)));
+	update(sap, pairs);
+	ASSERT_FALSE(sap.is_overlapping(a, b));
+	ASSERT_EQ(1, sap.get_counters().swap_count);
+	sap.move(b, box_3s(point_3s(1.0f, 0.0f, 0.0f), point_3s(2.0f, 1.0f, 1.0f)));
+	update(sap, pairs);
+	ASSERT_TRUE(sap.is_overlapping(a, b));
+}
+
+TEST(sweep_and_prune, invalid_arguments)
+{
+	sap_3s sap;
+	const single nan = std::numeric_limits<single>::quiet_NaN();
+	const single inf = std::numeric_limits<single>::infinity();
+	ASSERT_THROW(sap.insert(box_3s(point_3s(nan, 0.0f, 0.0f), point_3s(1.0f, 1.0f, 1.0f))), idlib::invalid_argument_error);
+	ASSERT_THROW(sap.insert(box_3s(point_3s(0.0f, 0.0f, 0.0f), point_3s(1.0f, inf, 1.0f))), idlib::invalid_argument_error);
+	ASSERT_THROW(sap.get(0), idlib::invalid_argument_error);
+	ASSERT_THROW(sap.move(0, box_3s()), idlib::invalid_argument_error);
+	ASSERT_THROW(sap.remove(0), idlib::invalid_argument_error);
+	ASSERT_TRUE(sap.empty());
+}
+
+} } } // namespace idlib::math::tests
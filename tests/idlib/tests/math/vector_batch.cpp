@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Idlib: A C++ utility library
+// Copyright (C) 2017-2018 Michael Heilmann
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "idlib/idlib.hpp"
+
+namespace idlib { namespace math { namespace tests {
+
+using vector_3s = idlib::vector<single, 3>;
+using vector_batch_3s = idlib::vector_batch<single, 3>;
+
+static std::vector<vector_3s> random_vectors(idlib::rng& rng, size_t n)
+{
+	std::vector<vector_3s> vectors;
+	for (size_t i = 0; i < n; ++i)
+	{ vectors.push_back(idlib::random<vector_3s>(&rng, idlib::interval<single>(-1000.0f, +1000.0f))); }
+	return vectors;
+}
+
+/// @brief Assert conversion from and to sequences of vectors preserves the vectors.
+TEST(vector_batch_3s, conversion)
+{
+	idlib::rng rng(2018);
+	auto v = random_vectors(rng, 1001);
+	vector_batch_3s a(v);
+	ASSERT_EQ(a.size(), v.size());
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(a.data(0)) % vector_batch_3s::alignment, 0);
+	ASSERT_EQ(a.get_vectors(), v);
+	for (size_t i = 0; i < v.size(); ++i)
+	{ ASSERT_EQ(a.get(i), v[i]); }
+	a.push_back(idlib::one<vector_3s>());
+	ASSERT_EQ(a.size(), v.size() + 1);
+	ASSERT_EQ(a.get(v.size()), idlib::one<vector_3s>());
+}
+
+/// @brief Assert the bulk operations produce the same results as the operations on individual vectors.
+TEST(vector_batch_3s, bulk_operations)
+{
+	idlib::rng rng(2018);
+	auto u = random_vectors(rng, 1001), v = random_vectors(rng, 1001);
+	u[7] = idlib::zero<vector_3s>();
+	vector_batch_3s a(u), b(v), r;
+	std::vector<single> s;
+
+	idlib::add(a, b, r);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(r.get(i), u[i] + v[i]);
+	idlib::subtract(a, b, r);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(r.get(i), u[i] - v[i]);
+	idlib::scale(a, 3.5f, r);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(r.get(i), u[i] * 3.5f);
+	idlib::cross_product(a, b, r);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(r.get(i), idlib::cross_product(u[i], v[i]));
+	idlib::min(a, b, r);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(r.get(i), u[i].min(v[i]));
+	idlib::max(a, b, r);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(r.get(i), u[i].max(v[i]));
+	idlib::dot_product(a, b, s);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(s[i], idlib::dot_product(u[i], v[i]));
+	idlib::euclidean_norm(a, s);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(s[i], idlib::euclidean_norm(u[i]));
+	idlib::normalize(a, r);
+	for (size_t i = 0; i < u.size(); ++i)
+	{
+		auto x = idlib::normalize(u[i], idlib::euclidean_norm_functor<vector_3s>{});
+		ASSERT_EQ(r.get(i), x.get_vector_or_default());
+	}
+	// In-place operation.
+	idlib::add(a, b, a);
+	for (size_t i = 0; i < u.size(); ++i) ASSERT_EQ(a.get(i), u[i] + v[i]);
+}
+
+/// @brief Assert batches of different sizes are rejected.
+TEST(vector_batch_3s, size_mismatch)
+{
+	vector_batch_3s a(3), b(4), r;
+	ASSERT_THROW(idlib::add(a, b, r), idlib::invalid_argument_error);
+	ASSERT_THROW(idlib::cross_product(a, a, a), idlib::invalid_argument_error);
+}
+
+/// @brief Assert the allocator of the component arrays rejects sizes overflowing std::size_t.
+TEST(vector_batch_3s, allocation_overflow)
+{
+	idlib::aligned_allocator<single, 32> allocator;
+	ASSERT_THROW(allocator.allocate(std::numeric_limits<size_t>::max() / sizeof(single) + 1), std::bad_array_new_length);
+}
+
+} } } // namespace idlib::math::tests